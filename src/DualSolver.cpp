@@ -242,23 +242,26 @@ bool DualSolver::hasHyperplaneBeenAdded(double hash, int constraintIndex)
     if(env->settings->getSetting<int>("TreeStrategy", "Dual") == static_cast<int>(ES_TreeStrategy::SingleTree))
         return false;
 
-    for(auto& H : generatedHyperplanes)
+    updateGeneratedHyperplaneIndex();
+
+    return (generatedHyperplaneIndex.contains(constraintIndex, hash));
+}
+
+void DualSolver::updateGeneratedHyperplaneIndex()
+{
+    if(generatedHyperplaneIndex.size() > generatedHyperplanes.size())
+        generatedHyperplaneIndex.clear();
+
+    for(size_t i = generatedHyperplaneIndex.size(); i < generatedHyperplanes.size(); i++)
     {
-        if((H.source == E_HyperplaneSource::ObjectiveRootsearch
-               || H.source == E_HyperplaneSource::ObjectiveCuttingPlane)
-            && constraintIndex == -1 && Utilities::isAlmostEqual(H.pointHash, hash, 1e-8))
-        {
-            return (true);
-        }
-        else if(H.source != E_HyperplaneSource::ObjectiveRootsearch
-            && H.source != E_HyperplaneSource::ObjectiveCuttingPlane && H.sourceConstraint->index == constraintIndex
-            && Utilities::isAlmostEqual(H.pointHash, hash, 1e-8))
-        {
-            return (true);
-        }
-    }
+        auto& H = generatedHyperplanes[i];
 
-    return (false);
+        if(H.source == E_HyperplaneSource::ObjectiveRootsearch
+            || H.source == E_HyperplaneSource::ObjectiveCuttingPlane)
+            generatedHyperplaneIndex.add(-1, H.pointHash);
+        else
+            generatedHyperplaneIndex.add(H.sourceConstraint->index, H.pointHash);
+    }
 }
 
 void DualSolver::addIntegerCut(IntegerCut integerCut)
@@ -319,15 +322,99 @@ void DualSolver::addGeneratedIntegerCut(IntegerCut integerCut)
 
 bool DualSolver::hasIntegerCutBeenAdded(double hash)
 {
-    for(auto& IC : generatedIntegerCuts)
+    updateGeneratedIntegerCutIndex();
+
+    return (generatedIntegerCutIndex.contains(-1, hash));
+}
+
+void DualSolver::updateGeneratedIntegerCutIndex()
+{
+    if(generatedIntegerCutIndex.size() > generatedIntegerCuts.size())
+        generatedIntegerCutIndex.clear();
+
+    for(size_t i = generatedIntegerCutIndex.size(); i < generatedIntegerCuts.size(); i++)
+        generatedIntegerCutIndex.add(-1, generatedIntegerCuts[i].pointHash);
+}
+
+size_t HashedCutIndex::KeyHasher::operator()(const Key& key) const
+{
+    size_t seed = std::hash<long long>()(key.bucket);
+    seed ^= std::hash<int>()(key.constraintIndex) + 0x9e3779b9 + (seed << 6) + (seed >> 2);
+    seed ^= std::hash<int>()(key.sign) + 0x9e3779b9 + (seed << 6) + (seed >> 2);
+    return (seed);
+}
+
+HashedCutIndex::Key HashedCutIndex::getKey(int constraintIndex, double hash) const
+{
+    // Infinite hashes are almost equal to all finite ones, and zero only to itself
+    if(std::isinf(hash))
+        return (Key { constraintIndex, 2, 0 });
+
+    if(hash == 0.0)
+        return (Key { constraintIndex, 0, 0 });
+
+    auto bucket = static_cast<long long>(std::floor(std::log(std::abs(hash)) / (2.0 * tolerance)));
+    return (Key { constraintIndex, hash > 0 ? 1 : -1, bucket });
+}
+
+void HashedCutIndex::add(int constraintIndex, double hash)
+{
+    numberOfHashes++;
+
+    if(std::isnan(hash))
+        return;
+
+    buckets[getKey(constraintIndex, hash)].push_back(hash);
+}
+
+bool HashedCutIndex::contains(int constraintIndex, double hash) const
+{
+    if(!std::isfinite(hash) || buckets.empty())
+        return (false);
+
+    auto isInBucket = [&](const Key& key)
     {
-        if(Utilities::isAlmostEqual(IC.pointHash, hash, 1e-8))
+        auto bucket = buckets.find(key);
+
+        if(bucket == buckets.end())
+            return (false);
+
+        for(auto& H : bucket->second)
         {
-            return (true);
+            if(Utilities::isAlmostEqual(H, hash, tolerance))
+                return (true);
         }
-    }
 
-    return (false);
+        return (false);
+    };
+
+    if(isInBucket(Key { constraintIndex, 2, 0 }))
+        return (true);
+
+    auto key = getKey(constraintIndex, hash);
+
+    if(isInBucket(key))
+        return (true);
+
+    // If |x - y| <= tolerance * |x|, then |log|x| - log|y|| <= -log(1 - tolerance) < 2 * tolerance, so an almost equal
+    // hash of the same sign is in a neighbouring bucket
+    if(key.sign == 0)
+        return (false);
+
+    key.bucket--;
+
+    if(isInBucket(key))
+        return (true);
+
+    key.bucket += 2;
+
+    return (isInBucket(key));
+}
+
+void HashedCutIndex::clear()
+{
+    numberOfHashes = 0;
+    buckets.clear();
 }
 
 } // namespace SHOT
\ No newline at end of file
@@ -12,8 +12,51 @@
 #include "Environment.h"
 #include "Structs.h"
 
+#include <unordered_map>
+
 namespace SHOT
 {
+// An index of the point hashes of the cuts added for each constraint (or -1 for the objective), which finds whether a
+// hash is almost equal to an added one, i.e. Utilities::isAlmostEqual(added, hash, tolerance) holds, without comparing
+// to all added hashes. The hashes are put in buckets according to their sign and log(|hash|) quantized with twice the
+// tolerance, so almost equal hashes are always in the same or in neighbouring buckets.
+class HashedCutIndex
+{
+public:
+    HashedCutIndex(double tolerance = 1e-8) : tolerance(tolerance) {};
+
+    void add(int constraintIndex, double hash);
+    bool contains(int constraintIndex, double hash) const;
+    void clear();
+
+    // The number of added hashes, including those that can never be equal to another one (NaN)
+    size_t size() const { return (numberOfHashes); };
+
+private:
+    struct Key
+    {
+        int constraintIndex;
+        int sign;
+        long long bucket;
+
+        bool operator==(const Key& other) const
+        {
+            return (constraintIndex == other.constraintIndex && sign == other.sign && bucket == other.bucket);
+        }
+    };
+
+    struct KeyHasher
+    {
+        size_t operator()(const Key& key) const;
+    };
+
+    Key getKey(int constraintIndex, double hash) const;
+
+    double tolerance;
+    size_t numberOfHashes = 0;
+    std::unordered_map<Key, std::vector<double>, KeyHasher> buckets;
+};
+
 class DualSolver
 {
 public:
@@ -50,6 +93,14 @@ public:
 
 private:
     EnvironmentPtr env;
+
+    // The indexes are updated with the cuts pushed to the vectors above since the last lookup, and rebuilt if the
+    // vectors have been cleared
+    HashedCutIndex generatedHyperplaneIndex;
+    HashedCutIndex generatedIntegerCutIndex;
+
+    void updateGeneratedHyperplaneIndex();
+    void updateGeneratedIntegerCutIndex();
 };
 
 } // namespace SHOT
\ No newline at end of file
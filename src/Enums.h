@@ -317,7 +317,8 @@ enum class ES_RootsearchConstraintStrategy
 enum class ES_RootsearchMethod
 {
     BoostTOMS748,
-    BoostBisection
+    BoostBisection,
+    Multisection
 };
 
 enum class ES_MIPSolver
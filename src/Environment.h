@@ -13,6 +13,7 @@
 #include <memory>
 
 #include "Structs.h"
+#include "ThreadPool.h"
 
 namespace SHOT
 {
@@ -40,6 +41,10 @@ public:
 
     std::shared_ptr<IRootsearchMethod> rootsearchMethod;
 
+    // Shared by the parts of SHOT that perform tasks in parallel (but not by the subsolvers), so that they together do
+    // not use more threads than given by the setting NumberOfThreads
+    ThreadPool threadPool;
+
     SolutionStatistics solutionStatistics;
 
 private:
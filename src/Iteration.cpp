@@ -15,6 +15,17 @@
 namespace SHOT
 {
 
+template <typename T> static void writeValue(std::ostream& stream, T value)
+{
+    stream.write(reinterpret_cast<const char*>(&value), sizeof(T));
+}
+
+static void writeVector(std::ostream& stream, const VectorDouble& values)
+{
+    writeValue<uint32_t>(stream, values.size());
+    stream.write(reinterpret_cast<const char*>(values.data()), values.size() * sizeof(double));
+}
+
 Iteration::Iteration(EnvironmentPtr envPtr)
 {
     env = envPtr;
@@ -83,4 +94,49 @@ int Iteration::getSolutionPointWithSmallestDeviationIndex()
 
     return (tmpIdx);
 }
+
+void Iteration::compact()
+{
+    for(auto& SP : solutionPoints)
+        VectorDouble().swap(SP.point);
+
+    VectorDouble().swap(constraintDeviations);
+    std::vector<VectorDouble>().swap(hyperplanePoints);
+
+    isCompacted = true;
+}
+
+void Iteration::writeBinary(std::ostream& stream)
+{
+    writeValue<int32_t>(stream, iterationNumber);
+    writeValue<int32_t>(stream, static_cast<int>(solutionStatus));
+    writeValue<uint8_t>(stream, isDualProblemDiscrete);
+    writeValue<double>(stream, objectiveValue);
+    writeValue<double>(stream, currentObjectiveBounds.first);
+    writeValue<double>(stream, currentObjectiveBounds.second);
+    writeValue<double>(stream, maxDeviation);
+    writeValue<int32_t>(stream, maxDeviationConstraint);
+    writeValue<double>(stream, solutionTime);
+    writeValue<int32_t>(stream, numHyperplanesAdded);
+    writeValue<int32_t>(stream, totNumHyperplanes);
+
+    writeValue<uint32_t>(stream, solutionPoints.size());
+
+    for(auto& SP : solutionPoints)
+    {
+        writeValue<double>(stream, SP.objectiveValue);
+        writeValue<int32_t>(stream, SP.maxDeviation.index);
+        writeValue<double>(stream, SP.maxDeviation.value);
+        writeValue<uint8_t>(stream, SP.isRelaxedPoint);
+        writeValue<double>(stream, SP.hashValue);
+        writeVector(stream, SP.point);
+    }
+
+    writeVector(stream, constraintDeviations);
+
+    writeValue<uint32_t>(stream, hyperplanePoints.size());
+
+    for(auto& P : hyperplanePoints)
+        writeVector(stream, P);
+}
 } // namespace SHOT
\ No newline at end of file
@@ -9,6 +9,8 @@
 */
 
 #pragma once
+#include <ostream>
+
 #include "Structs.h"
 #include "Enums.h"
 #include "Environment.h"
@@ -66,6 +68,16 @@ public:
     SolutionPoint getSolutionPointWithSmallestDeviation();
     int getSolutionPointWithSmallestDeviationIndex();
 
+    // True if the memory used by the points has been released, see Results::createIteration. The solution points are
+    // kept with their objective values, deviations and hashes, but without the variable values.
+    bool isCompacted = false;
+
+    // Releases the variable values of the solution points, the constraint deviations and the hyperplane points
+    void compact();
+
+    // Writes the iteration as a record in the iteration history file, see Results::createIteration
+    void writeBinary(std::ostream& stream);
+
 private:
     EnvironmentPtr env;
 };
@@ -12,6 +12,7 @@
 #include "../Environment.h"
 #include "../Enums.h"
 #include "../Structs.h"
+#include "../SparseVector.h"
 
 #include <map>
 #include <optional>
@@ -74,12 +75,12 @@ public:
     virtual void writePresolvedToFile(std::string filename) = 0;
 
     virtual std::vector<SolutionPoint> getAllVariableSolutions() = 0;
-    virtual int addLinearConstraint(std::map<int, double>& elements, double constant, std::string name) = 0;
+    virtual int addLinearConstraint(SparseIndexVector& elements, double constant, std::string name) = 0;
     virtual int addLinearConstraint(
-        const std::map<int, double>& elements, double constant, std::string name, bool isGreaterThan)
+        const SparseIndexVector& elements, double constant, std::string name, bool isGreaterThan)
         = 0;
     virtual int addLinearConstraint(
-        const std::map<int, double>& elements, double constant, std::string name, bool isGreaterThan, bool allowRepair)
+        const SparseIndexVector& elements, double constant, std::string name, bool isGreaterThan, bool allowRepair)
         = 0;
 
     virtual bool addSpecialOrderedSet(E_SOSType type, VectorInteger variableIndexes, VectorDouble variableWeights = {})
@@ -106,11 +107,20 @@ public:
     virtual void presolveAndUpdateBounds() = 0;
     virtual std::pair<VectorDouble, VectorDouble> presolveAndGetNewBounds() = 0;
 
+    // Minimizes (or maximizes) the variable over the continuous relaxation of the problem, and returns the optimal
+    // value if one was found. The objective function of the problem is replaced.
+    virtual std::optional<double> calculateVariableBound(int varIndex, bool isLowerBound) = 0;
+
     virtual bool createHyperplane(Hyperplane hyperplane) = 0;
+
+    // Adds the hyperplane with linear terms and constant already calculated by createHyperplaneTerms
+    virtual bool createHyperplane(Hyperplane hyperplane, std::pair<SparseIndexVector, double> terms) = 0;
     virtual bool createInteriorHyperplane(Hyperplane hyperplane) = 0;
     virtual bool createIntegerCut(IntegerCut& integerCut) = 0;
 
-    virtual std::optional<std::pair<std::map<int, double>, double>> createHyperplaneTerms(Hyperplane hyperplane) = 0;
+    virtual std::optional<std::pair<SparseIndexVector, double>> createHyperplaneTerms(Hyperplane hyperplane) = 0;
+
+    virtual void updateHyperplanePool(const std::vector<SolutionPoint>& solutionPoints) = 0;
 
     virtual bool supportsQuadraticObjective() = 0;
     virtual bool supportsQuadraticConstraints() = 0;
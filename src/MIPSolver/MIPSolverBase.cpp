@@ -114,8 +114,6 @@ std::vector<SolutionPoint> MIPSolverBase::getAllVariableSolutions()
 
 bool MIPSolverBase::createHyperplane(Hyperplane hyperplane)
 {
-    auto currIter = env->results->getCurrentIteration(); // The unsolved new iteration
-
     auto optional = createHyperplaneTerms(hyperplane);
 
     if(!optional)
@@ -123,7 +121,12 @@ bool MIPSolverBase::createHyperplane(Hyperplane hyperplane)
         return (false);
     }
 
-    auto tmpPair = optional.value();
+    return (createHyperplane(hyperplane, std::move(optional.value())));
+}
+
+bool MIPSolverBase::createHyperplane(Hyperplane hyperplane, std::pair<SparseIndexVector, double> tmpPair)
+{
+    auto currIter = env->results->getCurrentIteration(); // The unsolved new iteration
 
     for(auto& E : tmpPair.first)
     {
@@ -174,15 +177,95 @@ bool MIPSolverBase::createHyperplane(Hyperplane hyperplane)
     identifier += "_" + std::to_string(constraintCounter);
     constraintCounter++;
 
-    if(addLinearConstraint(tmpPair.first, tmpPair.second, identifier, false, !hyperplane.isSourceConvex) < 0)
+    int constraintIndex
+        = addLinearConstraint(tmpPair.first, tmpPair.second, identifier, false, !hyperplane.isSourceConvex);
+
+    if(constraintIndex < 0)
         return (false);
 
+    // Only hyperplanes for convex constraints are valid for the whole problem, so the others are never removed
+    if(hyperplane.isSourceConvex && env->settings->getSetting<bool>("HyperplaneCuts.Purge.Use", "Dual"))
+    {
+        hyperplanePool.push_back(
+            PooledHyperplane { constraintIndex, tmpPair.first, tmpPair.second, currIter->iterationNumber });
+    }
+
     return (true);
 }
 
-std::optional<std::pair<std::map<int, double>, double>> MIPSolverBase::createHyperplaneTerms(Hyperplane hyperplane)
+void MIPSolverBase::updateHyperplanePool(const std::vector<SolutionPoint>& solutionPoints)
 {
-    std::map<int, double> elements;
+    if(hyperplanePool.empty() || solutionPoints.empty())
+        return;
+
+    int iterationNumber = env->results->getCurrentIteration()->iterationNumber;
+    int maxInactiveIterations = env->settings->getSetting<int>("HyperplaneCuts.Purge.InactiveIterations", "Dual");
+    double activityTolerance = env->settings->getSetting<double>("HyperplaneCuts.Purge.ActivityTolerance", "Dual");
+
+    int numberOfRemoved = 0;
+    int numberOfReadded = 0;
+    int numberOfActive = 0;
+
+    for(auto& H : hyperplanePool)
+    {
+        // The largest value of the hyperplane in the solutions, i.e. the smallest slack
+        double maxValue = SHOT_DBL_MIN;
+
+        for(auto& SOL : solutionPoints)
+        {
+            double value = H.constant;
+
+            for(auto& E : H.elements)
+            {
+                if(E.first < (int)SOL.point.size())
+                    value += E.second * SOL.point[E.first];
+            }
+
+            maxValue = std::max(maxValue, value);
+        }
+
+        if(H.isActive)
+        {
+            if(maxValue >= -activityTolerance)
+            {
+                H.lastActiveIteration = iterationNumber;
+            }
+            else if(H.isPurgeable && iterationNumber - H.lastActiveIteration >= maxInactiveIterations)
+            {
+                if(updateConstraintUpperBound(H.constraintIndex, SHOT_DBL_MAX))
+                {
+                    H.isActive = false;
+                    numberOfRemoved++;
+                }
+            }
+        }
+        else if(maxValue > activityTolerance)
+        {
+            // A hyperplane that is needed again is kept in the problem from now on to avoid cycling
+            if(updateConstraintUpperBound(H.constraintIndex, -H.constant))
+            {
+                H.isActive = true;
+                H.isPurgeable = false;
+                H.lastActiveIteration = iterationNumber;
+                numberOfReadded++;
+            }
+        }
+
+        if(H.isActive)
+            numberOfActive++;
+    }
+
+    if(numberOfRemoved > 0 || numberOfReadded > 0)
+    {
+        env->output->outputDebug(
+            fmt::format("        Hyperplane pool: {} removed and {} added back, {} of {} in the MIP problem",
+                numberOfRemoved, numberOfReadded, numberOfActive, hyperplanePool.size()));
+    }
+}
+
+std::optional<std::pair<SparseIndexVector, double>> MIPSolverBase::createHyperplaneTerms(Hyperplane hyperplane)
+{
+    SparseIndexVector elements;
     double constant = 0.0;
     SparseVariableVector gradient;
     double signFactor = 1.0; // Will be -1.0 for greater than constraints
@@ -251,18 +334,14 @@ std::optional<std::pair<std::map<int, double>, double>> MIPSolverBase::createHyp
             + " elements.");
     }
 
+    elements.reserve(elements.size() + gradient.size());
+
     for(auto const& G : gradient)
     {
         double coefficient = signFactor * G.second;
         int variableIndex = G.first->index;
 
-        auto element = elements.emplace(variableIndex, coefficient);
-
-        if(!element.second)
-        {
-            // Element already exists for the variable
-            element.first->second += coefficient;
-        }
+        elements.add(variableIndex, coefficient);
 
         constant += signFactor * (-G.second) * hyperplane.generatedPoint.at(variableIndex);
 
@@ -270,10 +349,10 @@ std::optional<std::pair<std::map<int, double>, double>> MIPSolverBase::createHyp
             + std::to_string(hyperplane.generatedPoint.at(variableIndex)) + ": " + std::to_string(coefficient));
     }
 
-    std::optional<std::pair<std::map<int, double>, double>> optional;
+    std::optional<std::pair<SparseIndexVector, double>> optional;
 
     if(elements.size() > 0)
-        optional = std::make_pair(elements, constant);
+        optional = std::make_pair(std::move(elements), constant);
 
     elements.clear();
 
@@ -365,7 +444,7 @@ void MIPSolverBase::presolveAndUpdateBounds()
 
         if(newBounds.first.at(i) > currBounds.first)
             newLB = true;
-        if(newBounds.second.at(i) > currBounds.second)
+        if(newBounds.second.at(i) < currBounds.second)
             newUB = true;
 
         if(newLB)
@@ -26,6 +26,17 @@
 
 namespace SHOT
 {
+// A hyperplane added to the MIP problem in createHyperplane, with its activity in the MIP solutions
+struct PooledHyperplane
+{
+    int constraintIndex;
+    SparseIndexVector elements;
+    double constant;
+    int lastActiveIteration;
+    bool isActive = true;
+    bool isPurgeable = true;
+};
+
 class MIPSolverBase
 {
 private:
@@ -38,6 +49,8 @@ private:
 
     bool warningMessageShownLargeRHS = false;
 
+    std::vector<PooledHyperplane> hyperplanePool;
+
 protected:
     int numberOfVariables = 0;
     int numberOfConstraints = 0;
@@ -58,13 +71,23 @@ public:
     ~MIPSolverBase();
 
     virtual bool createHyperplane(Hyperplane hyperplane);
+    virtual bool createHyperplane(Hyperplane hyperplane, std::pair<SparseIndexVector, double> terms);
 
     virtual bool createInteriorHyperplane(Hyperplane hyperplane);
 
-    std::optional<std::pair<std::map<int, double>, double>> createHyperplaneTerms(Hyperplane hyperplane);
+    std::optional<std::pair<SparseIndexVector, double>> createHyperplaneTerms(Hyperplane hyperplane);
 
     virtual void setCutOffAsConstraint(double cutOff) = 0;
 
+    // Updates the activity of the hyperplanes in the pool in the given MIP solutions. Hyperplanes that have not been
+    // active for a number of iterations are removed from the MIP problem by relaxing their right-hand side, and removed
+    // hyperplanes that are violated in any of the solutions are added back. Since only hyperplanes from convex sources
+    // are removed, the MIP problem is always a relaxation and its objective bound remains valid.
+    virtual void updateHyperplanePool(const std::vector<SolutionPoint>& solutionPoints);
+
+    // Changes the right-hand side of the <= constraint with the given index, SHOT_DBL_MAX removes the bound
+    virtual bool updateConstraintUpperBound(int constraintIndex, double upperBound) = 0;
+
     virtual E_DualProblemClass getProblemClass();
     virtual bool getDiscreteVariableStatus();
 
@@ -86,12 +109,12 @@ public:
     virtual void unfixVariables();
     virtual void updateVariableBound(int varIndex, double lowerBound, double upperBound) = 0;
 
-    virtual int addLinearConstraint(std::map<int, double>& elements, double constant, std::string name) = 0;
+    virtual int addLinearConstraint(SparseIndexVector& elements, double constant, std::string name) = 0;
     virtual int addLinearConstraint(
-        const std::map<int, double>& elements, double constant, std::string name, bool isGreaterThan)
+        const SparseIndexVector& elements, double constant, std::string name, bool isGreaterThan)
         = 0;
     virtual int addLinearConstraint(
-        const std::map<int, double>& elements, double constant, std::string name, bool isGreaterThan, bool allowRepair)
+        const SparseIndexVector& elements, double constant, std::string name, bool isGreaterThan, bool allowRepair)
         = 0;
 
     virtual bool addSpecialOrderedSet(E_SOSType type, VectorInteger variableIndexes, VectorDouble variableWeights = {})
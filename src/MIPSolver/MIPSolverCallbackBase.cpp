@@ -11,6 +11,7 @@
 #include "MIPSolverCallbackBase.h"
 #include "../EventHandler.h"
 #include "../Iteration.h"
+#include "../Output.h"
 #include "../Report.h"
 #include "../Results.h"
 #include "../Settings.h"
@@ -20,12 +21,28 @@
 namespace SHOT
 {
 
+void MIPSolverCallbackBase::initializeHandles()
+{
+    settingIterationLimit = env->settings->getSettingHandle<int>("IterationLimit", "Termination");
+    settingFixedIntegerUse = env->settings->getSettingHandle<bool>("FixedInteger.Use", "Primal");
+    settingFixedIntegerCallStrategy = env->settings->getSettingHandle<int>("FixedInteger.CallStrategy", "Primal");
+    settingFixedIntegerDualPointGap
+        = env->settings->getSettingHandle<double>("FixedInteger.DualPointGap.Relative", "Primal");
+    settingFixedIntegerIterationFrequency
+        = env->settings->getSettingHandle<int>("FixedInteger.Frequency.Iteration", "Primal");
+    settingFixedIntegerTimeFrequency = env->settings->getSettingHandle<double>("FixedInteger.Frequency.Time", "Primal");
+
+    timerTotal = env->timing->getTimerID("Total");
+    timerPrimalStrategy = env->timing->getTimerID("PrimalStrategy");
+    timerPrimalBoundStrategyNLP = env->timing->getTimerID("PrimalBoundStrategyNLP");
+}
+
 bool MIPSolverCallbackBase::checkIterationLimit()
 {
     if(env->tasks->isTerminated())
         return (true);
 
-    auto mainlimit = env->settings->getSetting<int>("IterationLimit", "Termination");
+    auto mainlimit = settingIterationLimit.get();
 
     if(mainlimit == SHOT_INT_MAX)
         return (false);
@@ -50,22 +67,22 @@ bool MIPSolverCallbackBase::checkUserTermination()
 
 bool MIPSolverCallbackBase::checkFixedNLPStrategy(SolutionPoint point)
 {
-    if(!env->settings->getSetting<bool>("FixedInteger.Use", "Primal"))
+    if(!settingFixedIntegerUse.get())
     {
         return (false);
     }
 
-    env->timing->startTimer("PrimalStrategy");
-    env->timing->startTimer("PrimalBoundStrategyNLP");
+    env->timing->startTimer(timerPrimalStrategy);
+    env->timing->startTimer(timerPrimalBoundStrategyNLP);
 
     bool callNLPSolver = false;
 
-    auto userSettingStrategy = env->settings->getSetting<int>("FixedInteger.CallStrategy", "Primal");
+    auto userSettingStrategy = settingFixedIntegerCallStrategy.get();
 
     auto dualBound = env->results->getCurrentDualBound();
 
     if(std::abs(point.objectiveValue - dualBound) / ((1e-10) + std::abs(dualBound))
-        < env->settings->getSetting<double>("FixedInteger.DualPointGap.Relative", "Primal"))
+        < settingFixedIntegerDualPointGap.get())
     {
         callNLPSolver = true;
     }
@@ -77,14 +94,14 @@ bool MIPSolverCallbackBase::checkFixedNLPStrategy(SolutionPoint point)
         || userSettingStrategy == static_cast<int>(ES_PrimalNLPStrategy::IterationOrTimeAndAllFeasibleSolutions))
     {
         if(env->solutionStatistics.numberOfIterationsWithoutNLPCallMIP
-            >= env->settings->getSetting<int>("FixedInteger.Frequency.Iteration", "Primal"))
+            >= settingFixedIntegerIterationFrequency.get())
         {
             env->output->outputDebug(
                 "        Activating fixed NLP primal strategy since max iterations since last call has been reached.");
             callNLPSolver = true;
         }
-        else if(env->timing->getElapsedTime("Total") - env->solutionStatistics.timeLastFixedNLPCall
-            > env->settings->getSetting<double>("FixedInteger.Frequency.Time", "Primal"))
+        else if(env->timing->getElapsedTime(timerTotal) - env->solutionStatistics.timeLastFixedNLPCall
+            > settingFixedIntegerTimeFrequency.get())
         {
             env->output->outputDebug(
                 "        Activating fixed NLP primal strategy since max time limit since last call has been reached.");
@@ -97,12 +114,35 @@ bool MIPSolverCallbackBase::checkFixedNLPStrategy(SolutionPoint point)
         env->solutionStatistics.numberOfIterationsWithoutNLPCallMIP++;
     }
 
-    env->timing->stopTimer("PrimalBoundStrategyNLP");
-    env->timing->stopTimer("PrimalStrategy");
+    env->timing->stopTimer(timerPrimalBoundStrategyNLP);
+    env->timing->stopTimer(timerPrimalStrategy);
 
     return (callNLPSolver);
 }
 
+void MIPSolverCallbackBase::scaleBadlyScaledHyperplane(std::pair<SparseIndexVector, double>& hyperplaneTerms)
+{
+    // Small fix to fix badly scaled cuts.
+    // TODO: this should be made so it also takes into account small/large coefficients of the linear terms
+    if(std::abs(hyperplaneTerms.second) > 1e15)
+    {
+        double scalingFactor = std::abs(hyperplaneTerms.second) - 1e15;
+
+        for(auto& E : hyperplaneTerms.first)
+            E.second /= scalingFactor;
+
+        hyperplaneTerms.second /= scalingFactor;
+
+        if(!warningMessageShownLargeRHS)
+        {
+            env->output->outputWarning(
+                "        Large values found in RHS of cut, you might want to consider reducing the "
+                "bounds of the nonlinear variables.");
+            warningMessageShownLargeRHS = true;
+        }
+    }
+}
+
 void MIPSolverCallbackBase::printIterationReport(SolutionPoint solution, std::string threadId)
 {
     auto currIter = env->results->getCurrentIteration();
@@ -117,11 +157,12 @@ void MIPSolverCallbackBase::printIterationReport(SolutionPoint solution, std::st
         tmpType << "CB";
     }
 
-    env->report->outputIterationDetail(currIter->iterationNumber, tmpType.str(), env->timing->getElapsedTime("Total"),
-        this->lastNumAddedHyperplanes, currIter->totNumHyperplanes, env->results->getCurrentDualBound(),
-        env->results->getPrimalBound(), env->results->getAbsoluteGlobalObjectiveGap(),
-        env->results->getRelativeGlobalObjectiveGap(), solution.objectiveValue, solution.maxDeviation.index,
-        solution.maxDeviation.value, E_IterationLineType::DualCallback);
+    env->report->outputIterationDetail(currIter->iterationNumber, tmpType.str(),
+        env->timing->getElapsedTime(timerTotal), this->lastNumAddedHyperplanes, currIter->totNumHyperplanes,
+        env->results->getCurrentDualBound(), env->results->getPrimalBound(),
+        env->results->getAbsoluteGlobalObjectiveGap(), env->results->getRelativeGlobalObjectiveGap(),
+        solution.objectiveValue, solution.maxDeviation.index, solution.maxDeviation.value,
+        E_IterationLineType::DualCallback);
 
     this->lastNumAddedHyperplanes = 0;
 }
@@ -11,6 +11,8 @@
 #pragma once
 
 #include "../Environment.h"
+#include "../Settings.h"
+#include "../Timing.h"
 
 #include "../Tasks/TaskSelectHyperplanePointsObjectiveFunction.h"
 #include "../Tasks/TaskSelectPrimalCandidatesFromRootsearch.h"
@@ -49,6 +51,21 @@ protected:
     std::shared_ptr<TaskSelectPrimalCandidatesFromRootsearch> taskSelectPrimalSolutionFromRootsearch;
     std::shared_ptr<TaskUpdateInteriorPoint> tUpdateInteriorPoint;
 
+    // The settings and timers below are used in every callback, so they are resolved once when the callback is created
+    SettingHandle<int> settingIterationLimit;
+    SettingHandle<bool> settingFixedIntegerUse;
+    SettingHandle<int> settingFixedIntegerCallStrategy;
+    SettingHandle<double> settingFixedIntegerDualPointGap;
+    SettingHandle<int> settingFixedIntegerIterationFrequency;
+    SettingHandle<double> settingFixedIntegerTimeFrequency;
+
+    TimerID timerTotal;
+    TimerID timerPrimalStrategy;
+    TimerID timerPrimalBoundStrategyNLP;
+
+    // Must be called by the derived classes after the environment has been set
+    void initializeHandles();
+
     bool checkFixedNLPStrategy(SolutionPoint point);
 
     bool checkIterationLimit();
@@ -57,6 +74,9 @@ protected:
 
     void addLazyConstraint(std::vector<SolutionPoint> candidatePoints);
 
+    // Scales the linear terms and the constant of a hyperplane if the constant is very large
+    void scaleBadlyScaledHyperplane(std::pair<SparseIndexVector, double>& hyperplaneTerms);
+
     void printIterationReport(SolutionPoint solution, std::string threadId);
 
     EnvironmentPtr env;
@@ -37,7 +37,11 @@ class TerminationEventHandler : public CbcEventHandler, public MIPSolverCallback
 {
 
 public:
-    TerminationEventHandler(EnvironmentPtr envPtr) { env = envPtr; };
+    TerminationEventHandler(EnvironmentPtr envPtr)
+    {
+        env = envPtr;
+        initializeHandles();
+    };
 
     virtual ~TerminationEventHandler() {};
 
@@ -69,7 +73,20 @@ public:
 
 static int dummyCallback(CbcModel* /*model*/, int /*whereFrom*/) { return 0; }
 
-MIPSolverCbc::MIPSolverCbc(EnvironmentPtr envPtr) { env = envPtr; }
+MIPSolverCbc::MIPSolverCbc(EnvironmentPtr envPtr)
+{
+    env = envPtr;
+
+    settingShowOutput = env->settings->getSettingHandle<bool>("Console.DualSolver.Show", "Output");
+    settingDebugEnable = env->settings->getSettingHandle<bool>("Debug.Enable", "Output");
+    settingDebugPath = env->settings->getSettingHandle<std::string>("Debug.Path", "Output");
+
+    settingAutoScale = env->settings->getSettingHandle<bool>("Cbc.AutoScale", "Subsolver");
+    settingNodeStrategy = env->settings->getSettingHandle<int>("Cbc.NodeStrategy", "Subsolver");
+    settingScaling = env->settings->getSettingHandle<int>("Cbc.Scaling", "Subsolver");
+    settingStrategy = env->settings->getSettingHandle<int>("Cbc.Strategy", "Subsolver");
+    settingUseIncumbentAsMIPStart = env->settings->getSettingHandle<bool>("Cbc.UseIncumbentAsMIPStart", "Subsolver");
+}
 
 MIPSolverCbc::~MIPSolverCbc() = default;
 
@@ -288,7 +305,7 @@ bool MIPSolverCbc::finalizeProblem()
         CbcSolverUsefulData solverData;
         CbcMain0(*cbcModel, solverData);
 
-        if(!env->settings->getSetting<bool>("Console.DualSolver.Show", "Output"))
+        if(!settingShowOutput.get())
         {
             cbcModel->setLogLevel(0);
             osiInterface->setHintParam(OsiDoReducePrint, false, OsiHintTry);
@@ -346,7 +363,7 @@ void MIPSolverCbc::initializeSolverSettings()
 }
 
 int MIPSolverCbc::addLinearConstraint(
-    const std::map<int, double>& elements, double constant, std::string name, bool isGreaterThan, bool allowRepair)
+    const SparseIndexVector& elements, double constant, std::string name, bool isGreaterThan, bool allowRepair)
 {
     try
     {
@@ -523,25 +540,54 @@ E_ProblemSolutionStatus MIPSolverCbc::getSolutionStatus()
     return (MIPSolutionStatus);
 }
 
-E_ProblemSolutionStatus MIPSolverCbc::solveProblem()
+std::vector<const char*> MIPSolverCbc::getSolverArguments()
 {
-    E_ProblemSolutionStatus MIPSolutionStatus;
-    cachedSolutionHasChanged = true;
+    auto argumentSettings = std::make_tuple(settingAutoScale.get(), settingNodeStrategy.get(), settingScaling.get(),
+        settingStrategy.get(), numberOfThreads);
+
+    if(solverArguments.empty() || argumentSettings != solverArgumentSettings)
+    {
+        solverArgumentSettings = argumentSettings;
+        updateSolverArguments();
+    }
+
+    timeLimitArgument = fmt::format("{}", this->timeLimit);
 
-    const int numArguments = 17;
-    char* argv[numArguments];
+    std::vector<const char*> argv;
+    argv.reserve(solverArguments.size() + additionalSolverArguments.size() + 4);
+
+    for(auto& A : solverArguments)
+        argv.push_back(A.c_str());
+
+    argv.push_back("-sec");
+    argv.push_back(timeLimitArgument.c_str());
+
+    for(auto& A : additionalSolverArguments)
+        argv.push_back(A.c_str());
+
+    argv.push_back("-solve");
+    argv.push_back("-quit");
+
+    return (argv);
+}
+
+void MIPSolverCbc::updateSolverArguments()
+{
+    VectorString& arguments = solverArguments;
     std::string arg;
 
-    argv[0] = strdup("");
-    argv[1] = strdup("-autoscale");
-    if(env->settings->getSetting<bool>("Cbc.AutoScale", "Subsolver"))
-        argv[2] = strdup("on");
+    arguments.clear();
+
+    arguments.push_back("");
+    arguments.push_back("-autoscale");
+    if(settingAutoScale.get())
+        arguments.push_back("on");
     else
-        argv[2] = strdup("off");
+        arguments.push_back("off");
 
-    argv[3] = strdup("-nodestrategy");
+    arguments.push_back("-nodestrategy");
 
-    switch(env->settings->getSetting<int>("Cbc.NodeStrategy", "Subsolver"))
+    switch(settingNodeStrategy.get())
     {
     case 0:
         arg = "depth";
@@ -576,11 +622,11 @@ E_ProblemSolutionStatus MIPSolverCbc::solveProblem()
         break;
     }
 
-    argv[4] = strdup(arg.c_str());
+    arguments.push_back(arg);
 
-    argv[5] = strdup("-scaling");
+    arguments.push_back("-scaling");
 
-    switch(env->settings->getSetting<int>("Cbc.Scaling", "Subsolver"))
+    switch(settingScaling.get())
     {
     case 0:
         arg = "automatic";
@@ -611,93 +657,135 @@ E_ProblemSolutionStatus MIPSolverCbc::solveProblem()
         break;
     }
 
-    argv[6] = strdup(arg.c_str());
+    arguments.push_back(arg);
 
-    argv[7] = strdup("-strategy");
-    arg = std::to_string(env->settings->getSetting<int>("Cbc.Strategy", "Subsolver"));
-    argv[8] = strdup(arg.c_str());
+    arguments.push_back("-strategy");
+    arguments.push_back(std::to_string(settingStrategy.get()));
 
     /*
         TODO: Adding cutoffs seems to have stability-issues (status changes from unbounded -> infeasible in some
         cases, cf. https://github.com/coin-or/SHOT/issues/133). As the cutoff is added as a constraint, this can be
         deactivated here.
 
-        argv[9] = strdup("-cutoff");
+        arguments.push_back("-cutoff");
 
         if(this->cutOff > 1e100)
-            arg = "1e100";
+            arguments.push_back("1e100");
         else if(this->cutOff < -1e100)
-            arg = "-1e100";
+            arguments.push_back("-1e100");
         else
-            arg = fmt::format("{}", this->cutOff);
-
-        argv[10] = strdup(arg.c_str());*/
-
-    argv[9] = strdup("-sec");
-    arg = fmt::format("{}", this->timeLimit);
-    argv[10] = strdup(arg.c_str());
+            arguments.push_back(fmt::format("{}", this->cutOff));*/
 
     // pass threads option if not running single-threaded (101 = 1 thread + deterministic multithreading)
     if(numberOfThreads != 1 && numberOfThreads != 101)
     {
-        argv[11] = strdup("-threads");
-        arg = std::to_string(numberOfThreads);
-        argv[12] = strdup(arg.c_str());
+        arguments.push_back("-threads");
+        arguments.push_back(std::to_string(numberOfThreads));
+    }
+}
+
+void MIPSolverCbc::warmStartRelaxation()
+{
+    // The copy of the model Cbc solves gets the basis of the persistent model, so by reoptimizing the relaxation in the
+    // latter from its basis in the previous iteration, Cbc does not have to solve the root relaxation from scratch
+    try
+    {
+        if(isRelaxationSolved)
+            osiInterface->resolve();
+        else
+            osiInterface->initialSolve();
 
-        argv[13] = strdup("-solve");
-        argv[14] = strdup("-quit");
-        argv[15] = strdup("");
-        argv[16] = strdup("");
+        isRelaxationSolved = true;
     }
-    else
+    catch(CoinError& e)
     {
-        argv[11] = strdup("-solve");
-        argv[12] = strdup("-quit");
-        argv[13] = strdup("");
-        argv[14] = strdup("");
-        argv[15] = strdup("");
-        argv[16] = strdup("");
+        env->output->outputDebug("        Could not warm start the relaxation in Cbc: " + e.message());
+        isRelaxationSolved = false;
     }
+}
 
-    try
-    {
-        cbcModel = std::make_unique<CbcModel>(*osiInterface);
+void MIPSolverCbc::saveIncumbent()
+{
+    incumbent.clear();
 
-        initializeSolverSettings();
+    if(!discreteVariablesActivated || !settingUseIncumbentAsMIPStart.get())
+        return;
 
-        // Adding the MIP start provided, so far only if there are no special variable types included, since the MIP
-        // start functionality in Cbc version 2 is unstable
-        if(MIPStart.size() > 0
-            && (env->reformulatedProblem->properties.numberOfSemiintegerVariables
-                    + env->reformulatedProblem->properties.numberOfSemicontinuousVariables
-                    + env->reformulatedProblem->properties.numberOfSpecialOrderedSets
-                == 0))
-            cbcModel->setMIPStart(MIPStart);
+    if(auto bestSolution = cbcModel->bestSolution(); bestSolution != nullptr)
+        incumbent.assign(bestSolution, bestSolution + cbcModel->getNumCols());
+}
 
-        // Create and add lotsize objects
-        if(!lotsizes.empty())
+void MIPSolverCbc::addMIPStartAndLotsizes()
+{
+    // Adding the MIP start provided, so far only if there are no special variable types included, since the MIP
+    // start functionality in Cbc version 2 is unstable
+    if(env->reformulatedProblem->properties.numberOfSemiintegerVariables
+            + env->reformulatedProblem->properties.numberOfSemicontinuousVariables
+            + env->reformulatedProblem->properties.numberOfSpecialOrderedSets
+        == 0)
+    {
+        if(MIPStart.size() > 0)
         {
-            std::vector<CbcObject*> cbcobjects;
-            cbcobjects.reserve(lotsizes.size());
+            cbcModel->setMIPStart(MIPStart);
+        }
+        else if(discreteVariablesActivated && incumbent.size() == variableNames.size())
+        {
+            // Cbc fixes the discrete variables to their values in the previous incumbent and resolves the LP, which
+            // gives a feasible solution to the updated dual problem if the new hyperplanes allow one
+            std::vector<std::pair<std::string, double>> incumbentStart;
+            incumbentStart.reserve(incumbent.size());
 
-            for(const auto& l : lotsizes)
-            {
-                if(l.second[2] == l.second[3]) // special case where second interval is singleton, too
-                    cbcobjects.push_back(new CbcLotsize(cbcModel.get(), l.first, 2, l.second.data() + 1, false));
-                else
-                    cbcobjects.push_back(new CbcLotsize(cbcModel.get(), l.first, 2, l.second.data(), true));
-            }
+            for(size_t i = 0; i < incumbent.size(); i++)
+                incumbentStart.emplace_back(variableNames.at(i), incumbent.at(i));
+
+            cbcModel->setMIPStart(incumbentStart);
+        }
+    }
 
-            cbcModel->addObjects(cbcobjects.size(), cbcobjects.data());
+    // Create and add lotsize objects
+    if(!lotsizes.empty())
+    {
+        std::vector<CbcObject*> cbcobjects;
+        cbcobjects.reserve(lotsizes.size());
 
-            for(CbcObject* o : cbcobjects)
-                delete o;
+        for(const auto& l : lotsizes)
+        {
+            if(l.second[2] == l.second[3]) // special case where second interval is singleton, too
+                cbcobjects.push_back(new CbcLotsize(cbcModel.get(), l.first, 2, l.second.data() + 1, false));
+            else
+                cbcobjects.push_back(new CbcLotsize(cbcModel.get(), l.first, 2, l.second.data(), true));
         }
 
+        cbcModel->addObjects(cbcobjects.size(), cbcobjects.data());
+
+        for(CbcObject* o : cbcobjects)
+            delete o;
+    }
+}
+
+E_ProblemSolutionStatus MIPSolverCbc::solveProblem()
+{
+    E_ProblemSolutionStatus MIPSolutionStatus;
+    cachedSolutionHasChanged = true;
+
+    std::vector<const char*> argv;
+
+    try
+    {
+        warmStartRelaxation();
+
+        cbcModel = std::make_unique<CbcModel>(*osiInterface);
+
+        initializeSolverSettings();
+
+        argv = getSolverArguments();
+
+        addMIPStartAndLotsizes();
+
         CbcSolverUsefulData solverData;
         CbcMain0(*cbcModel, solverData);
 
-        if(!env->settings->getSetting<bool>("Console.DualSolver.Show", "Output"))
+        if(!settingShowOutput.get())
         {
             cbcModel->setLogLevel(0);
             osiInterface->setHintParam(OsiDoReducePrint, false, OsiHintTry);
@@ -708,9 +796,11 @@ E_ProblemSolutionStatus MIPSolverCbc::solveProblem()
         TerminationEventHandler eventHandler(env);
         cbcModel->passInEventHandler(&eventHandler);
 
-        CbcMain1(numArguments, const_cast<const char**>(argv), *cbcModel, dummyCallback, solverData);
+        CbcMain1(argv.size(), argv.data(), *cbcModel, dummyCallback, solverData);
 
         MIPSolutionStatus = getSolutionStatus();
+
+        saveIncumbent();
     }
     catch(std::exception& e)
     {
@@ -733,7 +823,7 @@ E_ProblemSolutionStatus MIPSolverCbc::solveProblem()
             CbcSolverUsefulData solverData;
             CbcMain0(*cbcModel, solverData);
 
-            if(!env->settings->getSetting<bool>("Console.DualSolver.Show", "Output"))
+            if(!settingShowOutput.get())
             {
                 cbcModel->setLogLevel(0);
                 osiInterface->setHintParam(OsiDoReducePrint, false, OsiHintTry);
@@ -741,7 +831,7 @@ E_ProblemSolutionStatus MIPSolverCbc::solveProblem()
 
             osiInterface->setDblParam(OsiObjOffset, this->objectiveConstant);
 
-            CbcMain1(numArguments, const_cast<const char**>(argv), *cbcModel, dummyCallback, solverData);
+            CbcMain1(argv.size(), argv.data(), *cbcModel, dummyCallback, solverData);
 
             MIPSolutionStatus = getSolutionStatus();
 
@@ -791,11 +881,10 @@ E_ProblemSolutionStatus MIPSolverCbc::solveProblem()
 
         if(problemUpdated)
         {
-            if(env->settings->getSetting<bool>("Debug.Enable", "Output"))
+            if(settingDebugEnable.get())
             {
 
-                auto filename = fmt::format("{}/dualiter{}_unbounded.lp",
-                    env->settings->getSetting<std::string>("Debug.Path", "Output"),
+                auto filename = fmt::format("{}/dualiter{}_unbounded.lp", settingDebugPath.get(),
                     env->results->getCurrentIteration()->iterationNumber - 1);
 
                 try
@@ -816,7 +905,7 @@ E_ProblemSolutionStatus MIPSolverCbc::solveProblem()
             CbcSolverUsefulData solverData;
             CbcMain0(*cbcModel, solverData);
 
-            if(!env->settings->getSetting<bool>("Console.DualSolver.Show", "Output"))
+            if(!settingShowOutput.get())
             {
                 cbcModel->setLogLevel(0);
                 osiInterface->setHintParam(OsiDoReducePrint, false, OsiHintTry);
@@ -824,7 +913,7 @@ E_ProblemSolutionStatus MIPSolverCbc::solveProblem()
 
             osiInterface->setDblParam(OsiObjOffset, this->objectiveConstant);
 
-            CbcMain1(numArguments, const_cast<const char**>(argv), *cbcModel, dummyCallback, solverData);
+            CbcMain1(argv.size(), argv.data(), *cbcModel, dummyCallback, solverData);
 
             MIPSolutionStatus = getSolutionStatus();
 
@@ -841,9 +930,6 @@ E_ProblemSolutionStatus MIPSolverCbc::solveProblem()
         }
     }
 
-    for(int i = numArguments - 1; i >= 0; --i)
-        free(argv[i]);
-
     return (MIPSolutionStatus);
 }
 
@@ -879,7 +965,7 @@ bool MIPSolverCbc::repairInfeasibility()
         }
 
         // Saves the relaxation weights to a file
-        if(env->settings->getSetting<bool>("Debug.Enable", "Output"))
+        if(settingDebugEnable.get())
         {
             VectorString constraints(relaxParameters.size());
 
@@ -889,8 +975,7 @@ bool MIPSolverCbc::repairInfeasibility()
                 constraints[i] = osiInterface->getRowName(repairConstraints[i]);
             }
 
-            auto filename = fmt::format("{}/dualiter{}_infeasrelaxweights.txt",
-                env->settings->getSetting<std::string>("Debug.Path", "Output"),
+            auto filename = fmt::format("{}/dualiter{}_infeasrelaxweights.txt", settingDebugPath.get(),
                 env->results->getCurrentIteration()->iterationNumber - 1);
 
             Utilities::saveVariablePointVectorToFile(relaxParameters, constraints, filename);
@@ -918,10 +1003,9 @@ bool MIPSolverCbc::repairInfeasibility()
             }
         }
 
-        if(env->settings->getSetting<bool>("Debug.Enable", "Output"))
+        if(settingDebugEnable.get())
         {
-            auto filename = fmt::format("{}/dualiter{}_infeasrelax.lp",
-                env->settings->getSetting<std::string>("Debug.Path", "Output"),
+            auto filename = fmt::format("{}/dualiter{}_infeasrelax.lp", settingDebugPath.get(),
                 env->results->getCurrentIteration()->iterationNumber - 1);
 
             try
@@ -942,7 +1026,7 @@ bool MIPSolverCbc::repairInfeasibility()
         CbcSolverUsefulData solverData;
         CbcMain0(*cbcModel, solverData);
 
-        if(!env->settings->getSetting<bool>("Console.DualSolver.Show", "Output"))
+        if(!settingShowOutput.get())
         {
             cbcModel->setLogLevel(0);
             osiInterface->setHintParam(OsiDoReducePrint, false, OsiHintTry);
@@ -952,137 +1036,9 @@ bool MIPSolverCbc::repairInfeasibility()
 
         cachedSolutionHasChanged = true;
 
-        const int numArguments = 17;
-        char* argv[numArguments];
-        std::string arg;
-
-        argv[0] = strdup("");
-        argv[1] = strdup("-autoscale");
-        if(env->settings->getSetting<bool>("Cbc.AutoScale", "Subsolver"))
-            argv[2] = strdup("on");
-        else
-            argv[2] = strdup("off");
-
-        argv[3] = strdup("-nodestrategy");
-
-        switch(env->settings->getSetting<int>("Cbc.NodeStrategy", "Subsolver"))
-        {
-        case 0:
-            arg = "depth";
-            break;
-
-        case 1:
-            arg = "downdepth";
-            break;
-
-        case 2:
-            arg = "downfewest";
-            break;
+        auto argv = getSolverArguments();
 
-        case 3:
-            arg = "fewest";
-            break;
-
-        case 4:
-            arg = "hybrid";
-            break;
-
-        case 5:
-            arg = "updepth";
-            break;
-
-        case 6:
-            arg = "upfewest";
-            break;
-
-        default:
-            arg = "hybrid";
-            break;
-        }
-
-        argv[4] = strdup(arg.c_str());
-
-        argv[5] = strdup("-scaling");
-
-        switch(env->settings->getSetting<int>("Cbc.Scaling", "Subsolver"))
-        {
-        case 0:
-            arg = "automatic";
-            break;
-
-        case 1:
-            arg = "dynamic";
-            break;
-
-        case 2:
-            arg = "equilibrium";
-            break;
-
-        case 3:
-            arg = "geometric";
-            break;
-
-        case 4:
-            arg = "off";
-            break;
-
-        case 5:
-            arg = "rowsonly";
-            break;
-
-        default:
-            arg = "automatic";
-            break;
-        }
-
-        argv[6] = strdup(arg.c_str());
-
-        argv[7] = strdup("-strategy");
-        arg = std::to_string(env->settings->getSetting<int>("Cbc.Strategy", "Subsolver"));
-        argv[8] = strdup(arg.c_str());
-
-        /*
-        argv[9] = strdup("-cutoff");
-
-        if(this->cutOff > 1e100)
-            arg = "1e100";
-        else if(this->cutOff < -1e100)
-            arg = "-1e100";
-        else
-            arg = fmt::format("{}", this->cutOff);
-
-        argv[10] = strdup(arg.c_str());*/
-
-        argv[9] = strdup("-sec");
-        arg = fmt::format("{}", this->timeLimit);
-        argv[10] = strdup(arg.c_str());
-
-        // pass threads option if not running single-threaded (101 = 1 thread + deterministic multithreading)
-        if(numberOfThreads != 1 && numberOfThreads != 101)
-        {
-            argv[11] = strdup("-threads");
-            arg = std::to_string(numberOfThreads);
-            argv[12] = strdup(arg.c_str());
-
-            argv[13] = strdup("-solve");
-            argv[14] = strdup("-quit");
-            argv[15] = strdup("");
-            argv[16] = strdup("");
-        }
-        else
-        {
-            argv[11] = strdup("-solve");
-            argv[12] = strdup("-quit");
-            argv[13] = strdup("");
-            argv[14] = strdup("");
-            argv[15] = strdup("");
-            argv[16] = strdup("");
-        }
-
-        CbcMain1(numArguments, const_cast<const char**>(argv), *cbcModel, dummyCallback, solverData);
-
-        for(int i = numArguments - 1; i >= 0; --i)
-            free(argv[i]);
+        CbcMain1(argv.size(), argv.data(), *cbcModel, dummyCallback, solverData);
 
         auto MIPSolutionStatus = getSolutionStatus();
 
@@ -1124,10 +1080,9 @@ bool MIPSolverCbc::repairInfeasibility()
 
         env->results->getCurrentIteration()->numberOfInfeasibilityRepairedConstraints = numRepairs;
 
-        if(env->settings->getSetting<bool>("Debug.Enable", "Output"))
+        if(settingDebugEnable.get())
         {
-            auto filename = fmt::format("{}/dualiter{}_infeasrelax.lp",
-                env->settings->getSetting<std::string>("Debug.Path", "Output"),
+            auto filename = fmt::format("{}/dualiter{}_infeasrelax.lp", settingDebugPath.get(),
                 env->results->getCurrentIteration()->iterationNumber - 1);
 
             writeProblemToFile(filename);
@@ -1258,6 +1213,25 @@ void MIPSolverCbc::setCutOffAsConstraint([[maybe_unused]] double cutOff)
     }
 }
 
+bool MIPSolverCbc::updateConstraintUpperBound(int constraintIndex, double upperBound)
+{
+    try
+    {
+        osiInterface->setRowUpper(
+            constraintIndex, upperBound == SHOT_DBL_MAX ? osiInterface->getInfinity() : upperBound);
+        modelUpdated = true;
+    }
+    catch(std::exception& e)
+    {
+        env->output->outputError("        Error when updating upper bound for constraint index "
+                + std::to_string(constraintIndex) + " in Cbc",
+            e.what());
+        return (false);
+    }
+
+    return (true);
+}
+
 void MIPSolverCbc::addMIPStart(VectorDouble point)
 {
     MIPStart.clear();
@@ -1300,21 +1274,9 @@ double MIPSolverCbc::getObjectiveValue(int solIdx)
 
     double objectiveValue = NAN;
 
-    // Cannot trust Cbc to give the correct sign of the objective back se we recalculate it
     try
     {
-        auto variableSolution = getVariableSolution(solIdx);
-        double factor = (isMinimizationProblem) ? 1.0 : -1.0;
-
-        objectiveValue = factor * coinModel->objectiveOffset();
-
-        for(int i = 0; i < objectiveLinearExpression.getNumElements(); i++)
-        {
-            objectiveValue += factor * objectiveLinearExpression.getElements()[i]
-                * variableSolution[objectiveLinearExpression.getIndices()[i]];
-        }
-
-        objectiveValue += this->objectiveConstant;
+        objectiveValue = calculateObjectiveValue(getVariableSolution(solIdx));
     }
     catch(std::exception& e)
     {
@@ -1326,6 +1288,24 @@ double MIPSolverCbc::getObjectiveValue(int solIdx)
     return (objectiveValue);
 }
 
+double MIPSolverCbc::calculateObjectiveValue(const VectorDouble& solution)
+{
+    // Cannot trust Cbc to give the correct sign of the objective back se we recalculate it
+    double factor = (isMinimizationProblem) ? 1.0 : -1.0;
+
+    double objectiveValue = factor * coinModel->objectiveOffset();
+
+    for(int i = 0; i < objectiveLinearExpression.getNumElements(); i++)
+    {
+        objectiveValue += factor * objectiveLinearExpression.getElements()[i]
+            * solution[objectiveLinearExpression.getIndices()[i]];
+    }
+
+    objectiveValue += this->objectiveConstant;
+
+    return (objectiveValue);
+}
+
 void MIPSolverCbc::deleteMIPStarts() { MIPStart.clear(); }
 
 bool MIPSolverCbc::createIntegerCut(IntegerCut& integerCut)
@@ -1705,6 +1685,42 @@ std::pair<VectorDouble, VectorDouble> MIPSolverCbc::presolveAndGetNewBounds()
     return (std::make_pair(variableLowerBounds, variableUpperBounds));
 }
 
+std::optional<double> MIPSolverCbc::calculateVariableBound(int varIndex, bool isLowerBound)
+{
+    cachedSolutionHasChanged = true;
+
+    // The LP is solved directly by Clp, since Cbc is not needed for it and CbcMain is not thread-safe
+    try
+    {
+        for(int i = 0; i < osiInterface->getNumCols(); i++)
+            osiInterface->setObjCoeff(i, 0.0);
+
+        osiInterface->setObjCoeff(varIndex, isLowerBound ? 1.0 : -1.0);
+        osiInterface->setObjSense(1.0);
+        osiInterface->setDblParam(OsiObjOffset, 0.0);
+
+        isMinimizationProblem = isLowerBound;
+        objectiveConstant = 0.0;
+
+        // Cbc is not used, so its time limit must be given to Clp
+        osiInterface->getModelPtr()->setMaximumSeconds(timeLimit);
+
+        osiInterface->resolve();
+
+        if(!osiInterface->isProvenOptimal())
+            return (std::nullopt);
+
+        return (isLowerBound ? osiInterface->getObjValue() : -osiInterface->getObjValue());
+    }
+    catch(CoinError& e)
+    {
+        env->output->outputError(
+            "        Error when calculating bound for variable with index " + std::to_string(varIndex), e.message());
+    }
+
+    return (std::nullopt);
+}
+
 void MIPSolverCbc::writePresolvedToFile([[maybe_unused]] std::string filename)
 {
     // Not implemented
@@ -1733,7 +1749,7 @@ std::string MIPSolverCbc::getSolverVersion() { return (CBC_VERSION); }
 
 int CbcMessageHandler::print()
 {
-    if(!env->settings->getSetting<bool>("Console.DualSolver.Show", "Output"))
+    if(!settingShowOutput.get())
         return 0;
 
     std::string message(CoinMessageHandler::messageBuffer());
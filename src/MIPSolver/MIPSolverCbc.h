@@ -10,8 +10,10 @@
 
 #pragma once
 #include "MIPSolverBase.h"
+#include "../Settings.h"
 
 #include <optional>
+#include <tuple>
 
 #include "CoinPackedVector.hpp"
 #include "CoinMessageHandler.hpp"
@@ -28,16 +30,25 @@ class CbcMessageHandler : public CoinMessageHandler
 {
 private:
     EnvironmentPtr env;
+    SettingHandle<bool> settingShowOutput;
 
 public:
-    CbcMessageHandler(EnvironmentPtr envPtr) : CoinMessageHandler() { env = envPtr; }
+    CbcMessageHandler(EnvironmentPtr envPtr) : CoinMessageHandler()
+    {
+        env = envPtr;
+        settingShowOutput = env->settings->getSettingHandle<bool>("Console.DualSolver.Show", "Output");
+    }
 
-    CbcMessageHandler(const CbcMessageHandler& r) : CoinMessageHandler(r), env(r.env) { }
+    CbcMessageHandler(const CbcMessageHandler& r)
+        : CoinMessageHandler(r), env(r.env), settingShowOutput(r.settingShowOutput)
+    {
+    }
 
     CbcMessageHandler& operator=(const CbcMessageHandler& r)
     {
         CoinMessageHandler::operator=(r);
         env = r.env;
+        settingShowOutput = r.settingShowOutput;
         return *this;
     }
 
@@ -46,7 +57,7 @@ public:
     virtual int print();
 };
 
-class MIPSolverCbc : public IMIPSolver, MIPSolverBase
+class MIPSolverCbc : public IMIPSolver, public MIPSolverBase
 {
 public:
     MIPSolverCbc(EnvironmentPtr envPtr);
@@ -76,18 +87,18 @@ public:
     void writeProblemToFile(std::string filename) override;
     void writePresolvedToFile(std::string filename) override;
 
-    int addLinearConstraint(std::map<int, double>& elements, double constant, std::string name) override
+    int addLinearConstraint(SparseIndexVector& elements, double constant, std::string name) override
     {
         return (addLinearConstraint(elements, constant, name, false, true));
     }
 
     int addLinearConstraint(
-        const std::map<int, double>& elements, double constant, std::string name, bool isGreaterThan) override
+        const SparseIndexVector& elements, double constant, std::string name, bool isGreaterThan) override
     {
         return (addLinearConstraint(elements, constant, name, isGreaterThan, true));
     }
 
-    int addLinearConstraint(const std::map<int, double>& elements, double constant, std::string name,
+    int addLinearConstraint(const SparseIndexVector& elements, double constant, std::string name,
         bool isGreaterThan, bool allowRepair) override;
 
     bool addSpecialOrderedSet(
@@ -95,6 +106,11 @@ public:
 
     bool createHyperplane(Hyperplane hyperplane) override { return (MIPSolverBase::createHyperplane(hyperplane)); }
 
+    bool createHyperplane(Hyperplane hyperplane, std::pair<SparseIndexVector, double> terms) override
+    {
+        return (MIPSolverBase::createHyperplane(hyperplane, terms));
+    }
+
     bool createIntegerCut(IntegerCut& integerCut) override;
 
     bool createInteriorHyperplane(Hyperplane hyperplane) override
@@ -102,11 +118,16 @@ public:
         return (MIPSolverBase::createInteriorHyperplane(hyperplane));
     }
 
-    std::optional<std::pair<std::map<int, double>, double>> createHyperplaneTerms(Hyperplane hyperplane) override
+    std::optional<std::pair<SparseIndexVector, double>> createHyperplaneTerms(Hyperplane hyperplane) override
     {
         return (MIPSolverBase::createHyperplaneTerms(hyperplane));
     }
 
+    void updateHyperplanePool(const std::vector<SolutionPoint>& solutionPoints) override
+    {
+        MIPSolverBase::updateHyperplanePool(solutionPoints);
+    }
+
     void fixVariable(int varIndex, double value) override;
 
     void fixVariables(VectorInteger variableIndexes, VectorDouble variableValues) override
@@ -126,6 +147,8 @@ public:
 
     std::pair<VectorDouble, VectorDouble> presolveAndGetNewBounds() override;
 
+    std::optional<double> calculateVariableBound(int varIndex, bool isLowerBound) override;
+
     void activateDiscreteVariables(bool activate) override;
     bool getDiscreteVariableStatus() override { return (MIPSolverBase::getDiscreteVariableStatus()); }
 
@@ -144,6 +167,9 @@ public:
     double getObjectiveValue(int solIdx) override;
     double getObjectiveValue() override { return (MIPSolverBase::getObjectiveValue()); }
 
+    // Calculates the objective value of the dual problem in a point, since Cbc cannot be trusted to give it
+    double calculateObjectiveValue(const VectorDouble& solution);
+
     int increaseSolutionLimit(int increment) override;
     void setSolutionLimit(long limit) override;
     int getSolutionLimit() override;
@@ -152,6 +178,8 @@ public:
 
     void setCutOff(double cutOff) override;
     void setCutOffAsConstraint(double cutOff) override;
+
+    bool updateConstraintUpperBound(int constraintIndex, double upperBound) override;
     void addMIPStart(VectorDouble point) override;
     void deleteMIPStarts() override;
 
@@ -185,7 +213,21 @@ public:
 
     std::string getSolverVersion() override;
 
-private:
+protected:
+    // The arguments to CbcMain1, the part given by the settings is only recreated when these have changed. The
+    // returned pointers are valid until the next call.
+    std::vector<const char*> getSolverArguments();
+
+    // Arguments added by derived classes before the problem is solved
+    VectorString additionalSolverArguments;
+
+    // Adds the MIP start and the lotsize objects for semicontinuous and semiinteger variables to the Cbc model. If no
+    // MIP start has been provided, the incumbent from the previous solve is used instead.
+    void addMIPStartAndLotsizes();
+
+    void warmStartRelaxation();
+    void saveIncumbent();
+
     std::unique_ptr<OsiClpSolverInterface> osiInterface;
     std::unique_ptr<CbcModel> cbcModel;
     std::unique_ptr<CoinModel> coinModel;
@@ -200,9 +242,28 @@ private:
     double objectiveConstant = 0.0;
 
     std::vector<std::pair<std::string, double>> MIPStart;
+    VectorDouble incumbent;
+
+    bool isRelaxationSolved = false;
+
+    VectorString solverArguments;
+    std::tuple<bool, int, int, int, int> solverArgumentSettings;
+    std::string timeLimitArgument;
+
+    void updateSolverArguments();
 
     std::vector<E_VariableType> variableTypes;
     std::vector<std::pair<int, std::array<double, 4>>> lotsizes;
+
+    // Settings that are read each time the problem is solved
+    SettingHandle<bool> settingShowOutput;
+    SettingHandle<bool> settingDebugEnable;
+    SettingHandle<std::string> settingDebugPath;
+    SettingHandle<bool> settingAutoScale;
+    SettingHandle<int> settingNodeStrategy;
+    SettingHandle<int> settingScaling;
+    SettingHandle<int> settingStrategy;
+    SettingHandle<bool> settingUseIncumbentAsMIPStart;
 };
 
 } // namespace SHOT
\ No newline at end of file
@@ -0,0 +1,622 @@
+/**
+   The Supporting Hyperplane Optimization Toolkit (SHOT).
+
+   @author Andreas Lundell, Åbo Akademi University
+
+   @section LICENSE
+   This software is licensed under the Eclipse Public License 2.0.
+   Please see the README and LICENSE files for more information.
+*/
+
+#include "MIPSolverCbcSingleTree.h"
+
+#include "../DualSolver.h"
+#include "../Iteration.h"
+#include "../Output.h"
+#include "../PrimalSolver.h"
+#include "../Results.h"
+#include "../Settings.h"
+#include "../TaskHandler.h"
+#include "../Timing.h"
+#include "../Utilities.h"
+
+#include "../Model/Problem.h"
+
+#include "CoinModel.hpp"
+#include "CbcModel.hpp"
+#include "CbcSolver.hpp"
+#include "CbcTree.hpp"
+#include "OsiClpSolverInterface.hpp"
+#include "OsiCuts.hpp"
+#include "OsiRowCut.hpp"
+
+namespace SHOT
+{
+
+static int dummyCallback(CbcModel* /*model*/, int /*whereFrom*/) { return 0; }
+
+MIPSolverCbcSingleTree::MIPSolverCbcSingleTree(EnvironmentPtr envPtr) : MIPSolverCbc(envPtr)
+{
+    // Preprocessing would change the variables in the model Cbc solves, so the hyperplanes could no longer be
+    // expressed in it
+    additionalSolverArguments = { "-preprocess", "off" };
+}
+
+MIPSolverCbcSingleTree::~MIPSolverCbcSingleTree() = default;
+
+void MIPSolverCbcSingleTree::checkParameters() { MIPSolverCbc::checkParameters(); }
+
+void MIPSolverCbcSingleTree::initializeSolverSettings()
+{
+    MIPSolverCbc::initializeSolverSettings();
+
+    // The lazy cuts are generated in the same callback object for all nodes, so Cbc cannot use several threads
+    numberOfThreads = 1;
+}
+
+E_ProblemSolutionStatus MIPSolverCbcSingleTree::solveProblem()
+{
+    E_ProblemSolutionStatus MIPSolutionStatus;
+    cachedSolutionHasChanged = true;
+
+    if(!callback)
+        callback = std::make_unique<CbcCallbackSingleTree>(env);
+
+    MIPSolutionStatus = solveWithLazyCuts();
+
+    // To find a feasible point for an unbounded dual problem
+    if(MIPSolutionStatus == E_ProblemSolutionStatus::Unbounded)
+    {
+        VectorInteger variablesWithChangedBounds;
+        bool problemUpdated = false;
+
+        if((env->reformulatedProblem->objectiveFunction->properties.classification
+                   == E_ObjectiveFunctionClassification::Linear
+               && std::dynamic_pointer_cast<LinearObjectiveFunction>(env->reformulatedProblem->objectiveFunction)
+                      ->isDualUnbounded())
+            || (env->reformulatedProblem->objectiveFunction->properties.classification
+                    == E_ObjectiveFunctionClassification::Quadratic
+                && std::dynamic_pointer_cast<QuadraticObjectiveFunction>(env->reformulatedProblem->objectiveFunction)
+                       ->isDualUnbounded()))
+        {
+            for(auto& V : env->reformulatedProblem->allVariables)
+            {
+                if(V->isDualUnbounded())
+                {
+                    // Temporarily introduce bounds [-1e20,1e20] for unbounded variables in objective
+                    updateVariableBound(V->index, -1e20, 1e20);
+                    variablesWithChangedBounds.push_back(V->index);
+                    problemUpdated = true;
+                }
+            }
+        }
+        else if(env->reformulatedProblem->objectiveFunction->properties.classification
+                >= E_ObjectiveFunctionClassification::QuadraticConsideredAsNonlinear
+            && hasDualAuxiliaryObjectiveVariable())
+        {
+            // The auxiliary variable in the dual problem is unbounded
+            updateVariableBound(getDualAuxiliaryObjectiveVariableIndex(), -getUnboundedVariableBoundValue() / 10e40,
+                getUnboundedVariableBoundValue() / 10e40);
+            problemUpdated = true;
+        }
+
+        if(problemUpdated)
+        {
+            MIPSolutionStatus = solveWithLazyCuts();
+
+            for(auto& I : variablesWithChangedBounds)
+            {
+                updateVariableBound(I, env->reformulatedProblem->getVariableLowerBound(I),
+                    env->reformulatedProblem->getVariableUpperBound(I));
+            }
+
+            env->results->getCurrentIteration()->hasInfeasibilityRepairBeenPerformed = true;
+        }
+    }
+
+    return (MIPSolutionStatus);
+}
+
+E_ProblemSolutionStatus MIPSolverCbcSingleTree::solveWithLazyCuts()
+{
+    E_ProblemSolutionStatus MIPSolutionStatus;
+
+    try
+    {
+        warmStartRelaxation();
+
+        cbcModel = std::make_unique<CbcModel>(*osiInterface);
+
+        initializeSolverSettings();
+
+        auto argv = getSolverArguments();
+
+        addMIPStartAndLotsizes();
+
+        CbcSolverUsefulData solverData;
+        CbcMain0(*cbcModel, solverData);
+
+        if(!settingShowOutput.get())
+        {
+            cbcModel->setLogLevel(0);
+            osiInterface->setHintParam(OsiDoReducePrint, false, OsiHintTry);
+        }
+
+        osiInterface->setDblParam(OsiObjOffset, this->objectiveConstant);
+
+        CbcEventHandlerSingleTree eventHandler(callback.get());
+        cbcModel->passInEventHandler(&eventHandler);
+
+        // The generator is called in every node and also for every new integer solution found, which is rejected by
+        // Cbc if a violated cut is returned
+        CbcLazyCutGenerator lazyCutGenerator(callback.get());
+        cbcModel->addCutGenerator(&lazyCutGenerator, 1, "SHOT", true, true);
+
+        CbcMain1(argv.size(), argv.data(), *cbcModel, dummyCallback, solverData);
+
+        MIPSolutionStatus = getSolutionStatus();
+    }
+    catch(std::exception& e)
+    {
+        env->output->outputError("        Error when solving subproblem with Cbc", e.what());
+        MIPSolutionStatus = E_ProblemSolutionStatus::Error;
+    }
+
+    return (MIPSolutionStatus);
+}
+
+void CbcLazyCutGenerator::generateCuts(
+    const OsiSolverInterface& si, OsiCuts& cs, [[maybe_unused]] const CglTreeInfo info)
+{
+    callback->generateLazyCuts(si, cs);
+}
+
+CbcEventHandler::CbcAction CbcEventHandlerSingleTree::event(CbcEvent whichEvent)
+{
+    if(whichEvent == CbcEventHandler::CbcEvent::node && callback->updateNodeInformation(model_))
+    {
+        return (CbcEventHandler::CbcAction::stop);
+    }
+
+    return (CbcEventHandler::CbcAction::noAction);
+}
+
+CbcCallbackSingleTree::CbcCallbackSingleTree(EnvironmentPtr envPtr)
+{
+    env = envPtr;
+    initializeHandles();
+
+    integerTolerance = env->settings->getSetting<double>("Tolerance.Integer", "Primal");
+
+    lastUpdatedPrimal = env->results->getPrimalBound();
+    isMinimization = env->reformulatedProblem->objectiveFunction->properties.isMinimize;
+
+    env->solutionStatistics.iterationLastLazyAdded = 0;
+
+    if(env->reformulatedProblem->properties.numberOfNonlinearConstraints > 0)
+    {
+        if(static_cast<ES_HyperplaneCutStrategy>(env->settings->getSetting<int>("CutStrategy", "Dual"))
+            == ES_HyperplaneCutStrategy::ESH)
+        {
+            tUpdateInteriorPoint = std::make_shared<TaskUpdateInteriorPoint>(env);
+            taskSelectHPPts = std::make_shared<TaskSelectHyperplanePointsESH>(env);
+        }
+        else
+        {
+            taskSelectHPPts = std::make_shared<TaskSelectHyperplanePointsECP>(env);
+        }
+    }
+
+    auto NLPProblemSource = static_cast<ES_PrimalNLPProblemSource>(
+        env->settings->getSetting<int>("FixedInteger.SourceProblem", "Primal"));
+
+    if(NLPProblemSource == ES_PrimalNLPProblemSource::Both
+        || NLPProblemSource == ES_PrimalNLPProblemSource::OriginalProblem)
+    {
+        taskSelectPrimNLPOriginal = std::make_shared<TaskSelectPrimalCandidatesFromNLP>(env, false);
+    }
+
+    if(NLPProblemSource == ES_PrimalNLPProblemSource::Both
+        || NLPProblemSource == ES_PrimalNLPProblemSource::ReformulatedProblem)
+    {
+        taskSelectPrimNLPReformulated = std::make_shared<TaskSelectPrimalCandidatesFromNLP>(env, true);
+    }
+
+    if(env->reformulatedProblem->objectiveFunction->properties.classification
+        > E_ObjectiveFunctionClassification::Quadratic)
+    {
+        taskSelectHPPtsByObjectiveRootsearch = std::make_shared<TaskSelectHyperplanePointsObjectiveFunction>(env);
+    }
+
+    if(env->settings->getSetting<bool>("Rootsearch.Use", "Primal")
+        && env->reformulatedProblem->properties.numberOfNonlinearConstraints > 0)
+    {
+        taskSelectPrimalSolutionFromRootsearch = std::make_shared<TaskSelectPrimalCandidatesFromRootsearch>(env);
+    }
+}
+
+bool CbcCallbackSingleTree::updateNodeInformation(CbcModel* model)
+{
+    try
+    {
+        lastExploredNodes = model->getNodeCount();
+        lastOpenNodes = (model->tree() != nullptr) ? model->tree()->size() : 0;
+
+        // Check if better dual bound, Cbc always minimizes
+        double tmpDualObjBound = model->getBestPossibleObjValue();
+
+        if(!isMinimization)
+            tmpDualObjBound *= -1.0;
+
+        if((isMinimization && tmpDualObjBound > env->results->getCurrentDualBound())
+            || (!isMinimization && tmpDualObjBound < env->results->getCurrentDualBound()))
+        {
+            VectorDouble doubleSolution; // Empty since we have no point
+
+            DualSolution sol = { doubleSolution, E_DualSolutionSource::MIPSolverBound, tmpDualObjBound,
+                env->results->getCurrentIteration()->iterationNumber, false };
+            env->dualSolver->addDualSolutionCandidate(sol);
+        }
+    }
+    catch(std::exception& e)
+    {
+        env->output->outputError("        Cbc error when updating node information in event handler", e.what());
+    }
+
+    if(env->results->isAbsoluteObjectiveGapToleranceMet() || env->results->isRelativeObjectiveGapToleranceMet()
+        || checkIterationLimit() || checkUserTermination())
+    {
+        return (true);
+    }
+
+    return (false);
+}
+
+void CbcCallbackSingleTree::generateLazyCuts(const OsiSolverInterface& solver, OsiCuts& cuts)
+{
+    try
+    {
+        int numModelVars = solver.getNumCols();
+        const double* columnSolution = solver.getColSolution();
+
+        for(int i = 0; i < numModelVars; i++)
+        {
+            if(solver.isInteger(i) && std::abs(columnSolution[i] - std::round(columnSolution[i])) > integerTolerance)
+            {
+                int numberOfVariables = (env->dualSolver->MIPSolver->hasDualAuxiliaryObjectiveVariable())
+                    ? numModelVars - 1
+                    : numModelVars;
+
+                addRelaxedPointHyperplanes(VectorDouble(columnSolution, columnSolution + numberOfVariables), cuts);
+                return;
+            }
+        }
+
+        VectorDouble modelSolution(columnSolution, columnSolution + numModelVars);
+        double objectiveValue = static_cast<MIPSolverCbc*>(env->dualSolver->MIPSolver.get())
+                                    ->calculateObjectiveValue(modelSolution);
+
+        // Check for new primal solution
+        if((isMinimization && objectiveValue < env->results->getPrimalBound())
+            || (!isMinimization && objectiveValue > env->results->getPrimalBound()))
+        {
+            int numberOfVariables = env->problem->properties.numberOfVariables;
+            VectorDouble primalSolution(columnSolution, columnSolution + numberOfVariables);
+
+            SolutionPoint tmpPt;
+
+            if(env->problem->properties.numberOfNonlinearConstraints > 0)
+            {
+                auto maxDev
+                    = env->problem->getMaxNumericConstraintValue(primalSolution, env->problem->nonlinearConstraints);
+                tmpPt.maxDeviation = PairIndexValue(maxDev.constraint->index, maxDev.normalizedValue);
+            }
+            else
+            {
+                tmpPt.maxDeviation = PairIndexValue(-1, 0.0);
+            }
+
+            tmpPt.iterFound = env->results->getCurrentIteration()->iterationNumber;
+            tmpPt.objectiveValue = env->problem->objectiveFunction->calculateValue(primalSolution);
+            tmpPt.point = primalSolution;
+
+            env->primalSolver->addPrimalSolutionCandidate(tmpPt, E_PrimalSolutionSource::MIPCallback);
+        }
+
+        auto currIter = env->results->getCurrentIteration();
+
+        if(currIter->isSolved)
+        {
+            env->results->createIteration();
+            currIter = env->results->getCurrentIteration();
+            currIter->isDualProblemDiscrete = true;
+            currIter->dualProblemClass = env->dualSolver->MIPSolver->getProblemClass();
+        }
+
+        int numberOfVariables
+            = (env->dualSolver->MIPSolver->hasDualAuxiliaryObjectiveVariable()) ? numModelVars - 1 : numModelVars;
+
+        VectorDouble solution(columnSolution, columnSolution + numberOfVariables);
+
+        SolutionPoint solutionCandidate;
+
+        if(env->reformulatedProblem->properties.numberOfNonlinearConstraints > 0)
+        {
+            auto maxDev = env->reformulatedProblem->getMaxNumericConstraintValue(
+                solution, env->reformulatedProblem->nonlinearConstraints);
+
+            solutionCandidate.maxDeviation = PairIndexValue(maxDev.constraint->index, maxDev.normalizedValue);
+        }
+        else
+        {
+            solutionCandidate.maxDeviation = PairIndexValue(-1, 0.0);
+        }
+
+        solutionCandidate.point = solution;
+        solutionCandidate.objectiveValue = objectiveValue;
+        solutionCandidate.iterFound = env->results->getCurrentIteration()->iterationNumber;
+
+        std::vector<SolutionPoint> candidatePoints { solutionCandidate };
+
+        addLazyConstraint(candidatePoints, cuts);
+
+        currIter->maxDeviation = solutionCandidate.maxDeviation.value;
+        currIter->maxDeviationConstraint = solutionCandidate.maxDeviation.index;
+        currIter->solutionStatus = E_ProblemSolutionStatus::Feasible;
+        currIter->objectiveValue = objectiveValue;
+
+        currIter->numberOfExploredNodes = lastExploredNodes - env->solutionStatistics.numberOfExploredNodes;
+        env->solutionStatistics.numberOfExploredNodes = lastExploredNodes;
+        currIter->numberOfOpenNodes = lastOpenNodes;
+
+        auto bounds = std::make_pair(env->results->getCurrentDualBound(), env->results->getPrimalBound());
+        currIter->currentObjectiveBounds = bounds;
+
+        if(env->settings->getSetting<bool>("Rootsearch.Use", "Primal")
+            && env->reformulatedProblem->properties.numberOfNonlinearConstraints > 0)
+        {
+            taskSelectPrimalSolutionFromRootsearch.get()->run(candidatePoints);
+            env->primalSolver->checkPrimalSolutionCandidates();
+        }
+
+        if(checkFixedNLPStrategy(candidatePoints.at(0)))
+        {
+            if(taskSelectPrimNLPOriginal)
+            {
+                env->primalSolver->addFixedNLPCandidate(candidatePoints.at(0).point, E_PrimalNLPSource::FirstSolution,
+                    objectiveValue, env->results->getCurrentIteration()->iterationNumber,
+                    candidatePoints.at(0).maxDeviation);
+
+                taskSelectPrimNLPOriginal->run();
+                env->primalSolver->fixedPrimalNLPCandidates.clear();
+            }
+
+            if(taskSelectPrimNLPReformulated)
+            {
+                env->primalSolver->addFixedNLPCandidate(candidatePoints.at(0).point, E_PrimalNLPSource::FirstSolution,
+                    objectiveValue, env->results->getCurrentIteration()->iterationNumber,
+                    candidatePoints.at(0).maxDeviation);
+
+                taskSelectPrimNLPReformulated->run();
+                env->primalSolver->fixedPrimalNLPCandidates.clear();
+            }
+
+            env->primalSolver->checkPrimalSolutionCandidates();
+        }
+
+        if(env->settings->getSetting<bool>("HyperplaneCuts.UseIntegerCuts", "Dual"))
+        {
+            int addedIntegerCuts = 0;
+
+            for(auto& IC : env->dualSolver->integerCutWaitingList)
+            {
+                if(this->createIntegerCut(IC, cuts))
+                {
+                    env->dualSolver->addGeneratedIntegerCut(IC);
+                    addedIntegerCuts++;
+                }
+            }
+
+            if(addedIntegerCuts > 0)
+                env->output->outputDebug(fmt::format("        Added {} integer cut(s)", addedIntegerCuts));
+
+            env->dualSolver->integerCutWaitingList.clear();
+        }
+
+        currIter->isSolved = true;
+
+        auto threadId = "";
+        printIterationReport(candidatePoints.at(0), threadId);
+    }
+    catch(std::exception& e)
+    {
+        env->output->outputError("        Cbc error when generating lazy cuts", e.what());
+    }
+}
+
+void CbcCallbackSingleTree::addRelaxedPointHyperplanes(const VectorDouble& solution, OsiCuts& cuts)
+{
+    if(env->results->getCurrentIteration()->relaxedLazyHyperplanesAdded
+        >= env->settings->getSetting<int>("Relaxation.MaxLazyConstraints", "Dual"))
+        return;
+
+    int waitingListSize = env->dualSolver->hyperplaneWaitingList.size();
+
+    SolutionPoint solutionRelaxed;
+
+    if(env->reformulatedProblem->properties.numberOfNonlinearConstraints > 0)
+    {
+        auto maxDev = env->reformulatedProblem->getMaxNumericConstraintValue(
+            solution, env->reformulatedProblem->nonlinearConstraints);
+        solutionRelaxed.maxDeviation = PairIndexValue(maxDev.constraint->index, maxDev.normalizedValue);
+    }
+    else
+    {
+        solutionRelaxed.maxDeviation = PairIndexValue(-1, 0.0);
+    }
+
+    solutionRelaxed.point = solution;
+    solutionRelaxed.objectiveValue = env->reformulatedProblem->objectiveFunction->calculateValue(solution);
+    solutionRelaxed.iterFound = env->results->getCurrentIteration()->iterationNumber;
+    solutionRelaxed.isRelaxedPoint = true;
+
+    std::vector<SolutionPoint> solutionPoints = { solutionRelaxed };
+
+    addLazyConstraint(solutionPoints, cuts);
+
+    env->results->getCurrentIteration()->relaxedLazyHyperplanesAdded
+        += (env->dualSolver->hyperplaneWaitingList.size() - waitingListSize);
+}
+
+bool CbcCallbackSingleTree::createHyperplane(Hyperplane hyperplane, OsiCuts& cuts)
+{
+    try
+    {
+        auto optionalHyperplanes = env->dualSolver->MIPSolver->createHyperplaneTerms(hyperplane);
+
+        if(!optionalHyperplanes)
+        {
+            return (false);
+        }
+
+        auto tmpPair = optionalHyperplanes.value();
+
+        for(auto& E : tmpPair.first)
+        {
+            if(E.second != E.second) // Check for NaN
+            {
+                env->output->outputError("        Warning: hyperplane for constraint "
+                    + std::to_string(hyperplane.sourceConstraint->index)
+                    + " not generated, NaN found in linear terms for variable "
+                    + env->problem->getVariable(E.first)->name);
+                return (false);
+            }
+        }
+
+        scaleBadlyScaledHyperplane(tmpPair);
+
+        std::vector<int> indexes;
+        VectorDouble coefficients;
+
+        indexes.reserve(tmpPair.first.size());
+        coefficients.reserve(tmpPair.first.size());
+
+        for(auto& P : tmpPair.first)
+        {
+            indexes.push_back(P.first);
+            coefficients.push_back(P.second);
+        }
+
+        // The hyperplanes are valid in the whole tree, so Cbc keeps them in its global cut pool
+        OsiRowCut cut;
+        cut.setRow(indexes.size(), indexes.data(), coefficients.data(), false);
+        cut.setLb(-COIN_DBL_MAX);
+        cut.setUb(-tmpPair.second);
+        cut.setGloballyValid(true);
+
+        cuts.insert(cut);
+
+        env->dualSolver->addGeneratedHyperplane(hyperplane);
+    }
+    catch(std::exception& e)
+    {
+        env->output->outputError("        Cbc error when creating lazy hyperplane", e.what());
+        return (false);
+    }
+
+    return (true);
+}
+
+bool CbcCallbackSingleTree::createIntegerCut(IntegerCut& integerCut, OsiCuts& cuts)
+{
+    if(!integerCut.areAllVariablesBinary)
+    {
+        env->output->outputDebug("        Integer cut for nonbinary variables not supported in single-tree strategy.");
+        return (false);
+    }
+
+    try
+    {
+        std::vector<int> indexes;
+        VectorDouble coefficients;
+        double lowerBound = 1.0;
+        size_t index = 0;
+
+        for(auto& VAR : env->reformulatedProblem->allVariables)
+        {
+            if(!(VAR->properties.type == E_VariableType::Binary || VAR->properties.type == E_VariableType::Integer
+                   || VAR->properties.type == E_VariableType::Semiinteger))
+                continue;
+
+            int variableValue = integerCut.variableValues[index];
+
+            if(variableValue == VAR->upperBound)
+            {
+                indexes.push_back(VAR->index);
+                coefficients.push_back(-1.0);
+                lowerBound -= variableValue;
+            }
+            else if(variableValue == VAR->lowerBound)
+            {
+                indexes.push_back(VAR->index);
+                coefficients.push_back(1.0);
+            }
+
+            index++;
+        }
+
+        OsiRowCut cut;
+        cut.setRow(indexes.size(), indexes.data(), coefficients.data(), false);
+        cut.setLb(lowerBound);
+        cut.setUb(COIN_DBL_MAX);
+        cut.setGloballyValid(true);
+
+        cuts.insert(cut);
+    }
+    catch(std::exception& e)
+    {
+        env->output->outputError("        Cbc error when adding lazy integer cut", e.what());
+        return (false);
+    }
+
+    return (true);
+}
+
+void CbcCallbackSingleTree::addLazyConstraint(std::vector<SolutionPoint> candidatePoints, OsiCuts& cuts)
+{
+    try
+    {
+        if(env->reformulatedProblem->properties.numberOfNonlinearConstraints > 0)
+        {
+            if(static_cast<ES_HyperplaneCutStrategy>(env->settings->getSetting<int>("CutStrategy", "Dual"))
+                == ES_HyperplaneCutStrategy::ESH)
+            {
+                tUpdateInteriorPoint->run();
+                static_cast<TaskSelectHyperplanePointsESH*>(taskSelectHPPts.get())->run(candidatePoints);
+            }
+            else
+            {
+                static_cast<TaskSelectHyperplanePointsECP*>(taskSelectHPPts.get())->run(candidatePoints);
+            }
+        }
+
+        if(env->reformulatedProblem->objectiveFunction->properties.classification
+            > E_ObjectiveFunctionClassification::Quadratic)
+        {
+            taskSelectHPPtsByObjectiveRootsearch->run(candidatePoints);
+        }
+
+        for(auto& hp : env->dualSolver->hyperplaneWaitingList)
+        {
+            if(this->createHyperplane(hp, cuts))
+                this->lastNumAddedHyperplanes++;
+        }
+
+        env->dualSolver->hyperplaneWaitingList.clear();
+    }
+    catch(std::exception& e)
+    {
+        env->output->outputError("        Cbc error when invoking adding lazy constraint", e.what());
+    }
+}
+} // namespace SHOT
\ No newline at end of file
@@ -0,0 +1,101 @@
+/**
+   The Supporting Hyperplane Optimization Toolkit (SHOT).
+
+   @author Andreas Lundell, Åbo Akademi University
+
+   @section LICENSE
+   This software is licensed under the Eclipse Public License 2.0.
+   Please see the README and LICENSE files for more information.
+*/
+
+#pragma once
+#include "MIPSolverBase.h"
+#include "MIPSolverCbc.h"
+#include "MIPSolverCallbackBase.h"
+
+#include "CbcEventHandler.hpp"
+#include "CglCutGenerator.hpp"
+
+class OsiCuts;
+class OsiSolverInterface;
+
+namespace SHOT
+{
+
+// Cbc works on copies of its cut generators and event handlers, so these only refer to this object, which keeps the
+// state of the single-tree strategy during the solution process
+class CbcCallbackSingleTree : public MIPSolverCallbackBase
+{
+public:
+    CbcCallbackSingleTree(EnvironmentPtr envPtr);
+    ~CbcCallbackSingleTree() override = default;
+
+    // Called with the LP solution in a node. If it is integer-feasible it is treated as a new solution to the dual
+    // problem and cut off with hyperplanes, otherwise hyperplanes are added for it as in the relaxed nodes in the
+    // other single-tree implementations
+    void generateLazyCuts(const OsiSolverInterface& solver, OsiCuts& cuts);
+
+    // Called in each node, returns true if Cbc should terminate
+    bool updateNodeInformation(CbcModel* model);
+
+private:
+    int lastExploredNodes = 0;
+    int lastOpenNodes = 0;
+
+    double integerTolerance;
+
+    bool createHyperplane(Hyperplane hyperplane, OsiCuts& cuts);
+
+    bool createIntegerCut(IntegerCut& integerCut, OsiCuts& cuts);
+
+    void addLazyConstraint(std::vector<SolutionPoint> candidatePoints, OsiCuts& cuts);
+
+    void addRelaxedPointHyperplanes(const VectorDouble& solution, OsiCuts& cuts);
+};
+
+class CbcLazyCutGenerator : public CglCutGenerator
+{
+public:
+    CbcLazyCutGenerator(CbcCallbackSingleTree* callback) : CglCutGenerator(), callback(callback) {};
+
+    CglCutGenerator* clone() const override { return (new CbcLazyCutGenerator(*this)); }
+
+    void generateCuts(const OsiSolverInterface& si, OsiCuts& cs, const CglTreeInfo info = CglTreeInfo()) override;
+
+    bool mayGenerateRowCutsInTree() const override { return (true); }
+
+private:
+    CbcCallbackSingleTree* callback;
+};
+
+class CbcEventHandlerSingleTree : public CbcEventHandler
+{
+public:
+    CbcEventHandlerSingleTree(CbcCallbackSingleTree* callback) : CbcEventHandler(), callback(callback) {};
+
+    CbcEventHandler* clone() const override { return (new CbcEventHandlerSingleTree(*this)); }
+
+    CbcAction event(CbcEvent whichEvent) override;
+
+private:
+    CbcCallbackSingleTree* callback;
+};
+
+class MIPSolverCbcSingleTree : public MIPSolverCbc
+{
+public:
+    MIPSolverCbcSingleTree(EnvironmentPtr envPtr);
+    ~MIPSolverCbcSingleTree() override;
+
+    void checkParameters() override;
+
+    void initializeSolverSettings() override;
+
+    E_ProblemSolutionStatus solveProblem() override;
+
+private:
+    E_ProblemSolutionStatus solveWithLazyCuts();
+
+    std::unique_ptr<CbcCallbackSingleTree> callback;
+};
+} // namespace SHOT
\ No newline at end of file
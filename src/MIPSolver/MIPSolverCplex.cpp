@@ -27,6 +27,7 @@ UserTerminationCallbackI::UserTerminationCallbackI(EnvironmentPtr envPtr, IloEnv
     : IloCplex::MIPInfoCallbackI(iloEnv)
 {
     env = envPtr;
+    initializeHandles();
 }
 
 IloCplex::CallbackI* UserTerminationCallbackI::duplicateCallback() const
@@ -495,7 +496,7 @@ void MIPSolverCplex::initializeSolverSettings()
 }
 
 int MIPSolverCplex::addLinearConstraint(
-    const std::map<int, double>& elements, double constant, std::string name, bool isGreaterThan, bool allowRepair)
+    const SparseIndexVector& elements, double constant, std::string name, bool isGreaterThan, bool allowRepair)
 {
     try
     {
@@ -557,7 +558,8 @@ int MIPSolverCplex::addLinearConstraint(
         return (-1);
     }
 
-    return (cplexInstance.getNrows() - 1);
+    // The index in cplexConstrs, which also contains the quadratic constraints that are not counted as rows
+    return (cplexConstrs.getSize() - 1);
 }
 
 bool MIPSolverCplex::addSpecialOrderedSet(E_SOSType type, VectorInteger variableIndexes, VectorDouble variableWeights)
@@ -1251,6 +1253,24 @@ void MIPSolverCplex::setCutOffAsConstraint(double cutOff)
     }
 }
 
+bool MIPSolverCplex::updateConstraintUpperBound(int constraintIndex, double upperBound)
+{
+    try
+    {
+        cplexConstrs[constraintIndex].setUB(upperBound == SHOT_DBL_MAX ? IloInfinity : upperBound);
+        modelUpdated = true;
+    }
+    catch(IloException& e)
+    {
+        env->output->outputError(
+            "        Error when updating upper bound for constraint index " + std::to_string(constraintIndex),
+            e.getMessage());
+        return (false);
+    }
+
+    return (true);
+}
+
 void MIPSolverCplex::addMIPStart(VectorDouble point)
 {
     IloNumArray startVal(cplexEnv);
@@ -1518,6 +1538,38 @@ std::pair<VectorDouble, VectorDouble> MIPSolverCplex::presolveAndGetNewBounds()
     }
 }
 
+std::optional<double> MIPSolverCplex::calculateVariableBound(int varIndex, bool isLowerBound)
+{
+    cachedSolutionHasChanged = true;
+
+    try
+    {
+        if(modelUpdated)
+        {
+            cplexInstance.extract(cplexModel);
+            modelUpdated = false;
+        }
+
+        auto objective = cplexInstance.getObjective();
+        objective.setExpr(cplexVars[varIndex]);
+        objective.setSense(isLowerBound ? IloObjective::Minimize : IloObjective::Maximize);
+        isMinimizationProblem = isLowerBound;
+
+        if(!cplexInstance.solve() || cplexInstance.getStatus() != IloAlgorithm::Optimal)
+            return (std::nullopt);
+
+        return (cplexInstance.getObjValue());
+    }
+    catch(IloException& e)
+    {
+        env->output->outputError(
+            "        Error when calculating bound for variable with index " + std::to_string(varIndex),
+            e.getMessage());
+    }
+
+    return (std::nullopt);
+}
+
 void MIPSolverCplex::writePresolvedToFile([[maybe_unused]] std::string filename)
 {
     try
@@ -28,6 +28,7 @@ HCallbackI::HCallbackI(EnvironmentPtr envPtr, IloEnv iloEnv, IloNumVarArray xx2)
     : IloCplex::HeuristicCallbackI(iloEnv), cplexVars(xx2)
 {
     env = envPtr;
+    initializeHandles();
 
     lastUpdatedPrimal = env->results->getPrimalBound();
 
@@ -160,6 +161,7 @@ void HCallbackI::main() // Called at each node...
 InfoCallbackI::InfoCallbackI(EnvironmentPtr envPtr, IloEnv iloEnv) : IloCplex::MIPInfoCallbackI(iloEnv)
 {
     env = envPtr;
+    initializeHandles();
 }
 
 IloCplex::CallbackI* InfoCallbackI::duplicateCallback() const { return (new(getEnv()) InfoCallbackI(*this)); }
@@ -212,6 +214,7 @@ CtCallbackI::CtCallbackI(EnvironmentPtr envPtr, IloEnv iloEnv, IloNumVarArray xx
     : IloCplex::LazyConstraintCallbackI(iloEnv), cplexVars(xx2)
 {
     env = envPtr;
+    initializeHandles();
 
     std::lock_guard<std::mutex> lock(
         (static_cast<MIPSolverCplexSingleTreeLegacy*>(env->dualSolver->MIPSolver.get()))->callbackMutex2);
@@ -540,25 +543,7 @@ bool CtCallbackI::createHyperplane(Hyperplane hyperplane)
         }
     }
 
-    // Small fix to fix badly scaled cuts.
-    // TODO: this should be made so it also takes into account small/large coefficients of the linear terms
-    if(abs(tmpPair.second) > 1e15)
-    {
-        double scalingFactor = abs(tmpPair.second) - 1e15;
-
-        for(auto& E : tmpPair.first)
-            E.second /= scalingFactor;
-
-        tmpPair.second /= scalingFactor;
-
-        if(!warningMessageShownLargeRHS)
-        {
-            env->output->outputWarning(
-                "        Large values found in RHS of cut, you might want to consider reducing the "
-                "bounds of the nonlinear variables.");
-            warningMessageShownLargeRHS = true;
-        }
-    }
+    scaleBadlyScaledHyperplane(tmpPair);
 
     auto currIter = env->results->getCurrentIteration(); // The unsolved new iteration
 
@@ -448,7 +448,7 @@ void MIPSolverGurobi::initializeSolverSettings()
 }
 
 int MIPSolverGurobi::addLinearConstraint(
-    const std::map<int, double>& elements, double constant, std::string name, bool isGreaterThan, bool allowRepair)
+    const SparseIndexVector& elements, double constant, std::string name, bool isGreaterThan, bool allowRepair)
 {
     try
     {
@@ -1182,6 +1182,25 @@ void MIPSolverGurobi::setCutOffAsConstraint(double cutOff)
     }
 }
 
+bool MIPSolverGurobi::updateConstraintUpperBound(int constraintIndex, double upperBound)
+{
+    try
+    {
+        auto constraint = gurobiModel->getConstr(constraintIndex);
+        constraint.set(GRB_DoubleAttr_RHS, upperBound == SHOT_DBL_MAX ? GRB_INFINITY : upperBound);
+        modelUpdated = true;
+    }
+    catch(GRBException& e)
+    {
+        env->output->outputError(
+            "        Error when updating upper bound for constraint index " + std::to_string(constraintIndex),
+            e.getMessage());
+        return (false);
+    }
+
+    return (true);
+}
+
 void MIPSolverGurobi::addMIPStart(VectorDouble point)
 {
     try
@@ -1434,6 +1453,39 @@ std::pair<VectorDouble, VectorDouble> MIPSolverGurobi::presolveAndGetNewBounds()
     return (std::make_pair(variableLowerBounds, variableUpperBounds));
 }
 
+std::optional<double> MIPSolverGurobi::calculateVariableBound(int varIndex, bool isLowerBound)
+{
+    cachedSolutionHasChanged = true;
+
+    try
+    {
+        if(modelUpdated)
+        {
+            gurobiModel->update();
+            modelUpdated = false;
+        }
+
+        gurobiModel->setObjective(
+            GRBLinExpr(gurobiModel->getVar(varIndex)), isLowerBound ? GRB_MINIMIZE : GRB_MAXIMIZE);
+        isMinimizationProblem = isLowerBound;
+
+        gurobiModel->optimize();
+
+        if(gurobiModel->get(GRB_IntAttr_Status) != GRB_OPTIMAL)
+            return (std::nullopt);
+
+        return (gurobiModel->get(GRB_DoubleAttr_ObjVal));
+    }
+    catch(GRBException& e)
+    {
+        env->output->outputError(
+            "        Error when calculating bound for variable with index " + std::to_string(varIndex),
+            e.getMessage());
+    }
+
+    return (std::nullopt);
+}
+
 int MIPSolverGurobi::getNumberOfExploredNodes()
 {
     try
@@ -1455,6 +1507,7 @@ std::string MIPSolverGurobi::getSolverVersion()
 GurobiCallbackMultiTree::GurobiCallbackMultiTree(EnvironmentPtr envPtr)
 {
     env = envPtr;
+    initializeHandles();
     showOutput = env->settings->getSetting<bool>("Console.DualSolver.Show", "Output");
 }
 
@@ -60,18 +60,18 @@ public:
     void writeProblemToFile(std::string filename) override;
     void writePresolvedToFile(std::string filename) override;
 
-    int addLinearConstraint(std::map<int, double>& elements, double constant, std::string name) override
+    int addLinearConstraint(SparseIndexVector& elements, double constant, std::string name) override
     {
         return (addLinearConstraint(elements, constant, name, false, true));
     }
 
     int addLinearConstraint(
-        const std::map<int, double>& elements, double constant, std::string name, bool isGreaterThan) override
+        const SparseIndexVector& elements, double constant, std::string name, bool isGreaterThan) override
     {
         return (addLinearConstraint(elements, constant, name, isGreaterThan, true));
     }
 
-    int addLinearConstraint(const std::map<int, double>& elements, double constant, std::string name,
+    int addLinearConstraint(const SparseIndexVector& elements, double constant, std::string name,
         bool isGreaterThan, bool allowRepair) override;
 
     bool addSpecialOrderedSet(
@@ -79,6 +79,11 @@ public:
 
     bool createHyperplane(Hyperplane hyperplane) override { return (MIPSolverBase::createHyperplane(hyperplane)); }
 
+    bool createHyperplane(Hyperplane hyperplane, std::pair<SparseIndexVector, double> terms) override
+    {
+        return (MIPSolverBase::createHyperplane(hyperplane, terms));
+    }
+
     bool createIntegerCut(IntegerCut& integerCut) override;
 
     bool createInteriorHyperplane(Hyperplane hyperplane) override
@@ -86,11 +91,16 @@ public:
         return (MIPSolverBase::createInteriorHyperplane(hyperplane));
     }
 
-    std::optional<std::pair<std::map<int, double>, double>> createHyperplaneTerms(Hyperplane hyperplane) override
+    std::optional<std::pair<SparseIndexVector, double>> createHyperplaneTerms(Hyperplane hyperplane) override
     {
         return (MIPSolverBase::createHyperplaneTerms(hyperplane));
     }
 
+    void updateHyperplanePool(const std::vector<SolutionPoint>& solutionPoints) override
+    {
+        MIPSolverBase::updateHyperplanePool(solutionPoints);
+    }
+
     void fixVariable(int varIndex, double value) override;
 
     void fixVariables(VectorInteger variableIndexes, VectorDouble variableValues) override
@@ -110,6 +120,8 @@ public:
 
     std::pair<VectorDouble, VectorDouble> presolveAndGetNewBounds() override;
 
+    std::optional<double> calculateVariableBound(int varIndex, bool isLowerBound) override;
+
     void activateDiscreteVariables(bool activate) override;
     bool getDiscreteVariableStatus() override { return (MIPSolverBase::getDiscreteVariableStatus()); }
 
@@ -137,6 +149,8 @@ public:
     void setCutOff(double cutOff) override;
     void setCutOffAsConstraint(double cutOff) override;
 
+    bool updateConstraintUpperBound(int constraintIndex, double upperBound) override;
+
     void addMIPStart(VectorDouble point) override;
     void deleteMIPStarts() override;
 
@@ -504,25 +504,7 @@ bool GurobiCallbackSingleTree::createHyperplane(Hyperplane hyperplane)
             }
         }
 
-        // Small fix to fix badly scaled cuts.
-        // TODO: this should be made so it also takes into account small/large coefficients of the linear terms
-        if(abs(tmpPair.second) > 1e15)
-        {
-            double scalingFactor = abs(tmpPair.second) - 1e15;
-
-            for(auto& E : tmpPair.first)
-                E.second /= scalingFactor;
-
-            tmpPair.second /= scalingFactor;
-
-            if(!warningMessageShownLargeRHS)
-            {
-                env->output->outputWarning(
-                    "        Large values found in RHS of cut, you might want to consider reducing the "
-                    "bounds of the nonlinear variables.");
-                warningMessageShownLargeRHS = true;
-            }
-        }
+        scaleBadlyScaledHyperplane(tmpPair);
 
         GRBLinExpr expr = 0;
 
@@ -547,6 +529,7 @@ bool GurobiCallbackSingleTree::createHyperplane(Hyperplane hyperplane)
 GurobiCallbackSingleTree::GurobiCallbackSingleTree(GRBVar* xvars, EnvironmentPtr envPtr)
 {
     env = envPtr;
+    initializeHandles();
     vars = xvars;
 
     showOutput = env->settings->getSetting<bool>("Console.DualSolver.Show", "Output");
@@ -23,7 +23,9 @@ double AuxiliaryVariable::calculate(const VectorDouble& point) const
     value += monomialTerms.calculate(point);
     value += signomialTerms.calculate(point);
 
-    if(nonlinearExpression)
+    if(nonlinearExpressionTape.isCompiled())
+        value += nonlinearExpressionTape.calculate(point);
+    else if(nonlinearExpression)
         value += nonlinearExpression->calculate(point);
 
     return value;
@@ -13,6 +13,7 @@
 #include "../Structs.h"
 #include "../Enums.h"
 #include "NonlinearExpressions.h"
+#include "ExpressionTape.h"
 #include "Terms.h"
 #include "Variables.h"
 
@@ -29,6 +30,7 @@ public:
     MonomialTerms monomialTerms;
     SignomialTerms signomialTerms;
     NonlinearExpressionPtr nonlinearExpression;
+    ExpressionTape nonlinearExpressionTape;
 
     AuxiliaryVariable()
     {
@@ -157,8 +157,11 @@ std::shared_ptr<std::vector<std::pair<VariablePtr, VariablePtr>>> NumericConstra
 
 NumericConstraintValue NumericConstraint::calculateNumericValue(const VectorDouble& point, double correction)
 {
-    double value = calculateFunctionValue(point) - correction;
+    return (getNumericValue(calculateFunctionValue(point) - correction));
+}
 
+NumericConstraintValue NumericConstraint::getNumericValue(double value)
+{
     NumericConstraintValue constrValue;
     constrValue.constraint = getPointer();
     constrValue.functionValue = value;
@@ -212,6 +215,20 @@ double LinearConstraint::calculateFunctionValue(const VectorDouble& point)
     return value;
 }
 
+void LinearConstraint::calculateFunctionValues(const PointBatch& points, VectorDouble& values)
+{
+    values.assign(points.size(), 0.0);
+    points.addValues(linearTerms, values);
+
+    for(auto& V : values)
+        V += constant;
+}
+
+void LinearConstraint::calculateNonlinearFunctionValues(const PointBatch& points, VectorDouble& values)
+{
+    values.assign(points.size(), 0.0);
+}
+
 Interval LinearConstraint::calculateFunctionValue(const IntervalVector& intervalVector)
 {
     Interval value = linearTerms.calculate(intervalVector);
@@ -239,7 +256,7 @@ SparseVariableVector LinearConstraint::calculateGradient(const VectorDouble& poi
     SparseVariableVector gradient = linearTerms.calculateGradient(point);
 
     if(eraseZeroes)
-        Utilities::erase_if<VariablePtr, double>(gradient, 0.0);
+        gradient.erase(0.0);
 
     return gradient;
 }
@@ -305,6 +322,7 @@ void QuadraticConstraint::add(QuadraticTerms terms)
     {
         quadraticTerms = terms;
         properties.hasQuadraticTerms = true;
+        quadraticMatrix.clear();
     }
     else
     {
@@ -319,16 +337,41 @@ void QuadraticConstraint::add(QuadraticTermPtr term)
 {
     quadraticTerms.push_back(term);
     properties.hasQuadraticTerms = true;
+    quadraticMatrix.clear();
+}
+
+void QuadraticConstraint::updateQuadraticMatrix()
+{
+    if(quadraticTerms.size() > 0)
+        quadraticMatrix.compile(quadraticTerms);
+    else
+        quadraticMatrix.clear();
 }
 
 double QuadraticConstraint::calculateFunctionValue(const VectorDouble& point)
 {
     double value = LinearConstraint::calculateFunctionValue(point);
-    value += quadraticTerms.calculate(point);
+
+    if(quadraticMatrix.isCompiled())
+        value += quadraticMatrix.calculate(point);
+    else
+        value += quadraticTerms.calculate(point);
 
     return value;
 }
 
+void QuadraticConstraint::calculateFunctionValues(const PointBatch& points, VectorDouble& values)
+{
+    LinearConstraint::calculateFunctionValues(points, values);
+    points.addValues(quadraticTerms, values);
+}
+
+void QuadraticConstraint::calculateNonlinearFunctionValues(const PointBatch& points, VectorDouble& values)
+{
+    LinearConstraint::calculateNonlinearFunctionValues(points, values);
+    points.addValues(quadraticTerms, values);
+}
+
 Interval QuadraticConstraint::calculateFunctionValue(const IntervalVector& intervalVector)
 {
     Interval value = LinearConstraint::calculateFunctionValue(intervalVector);
@@ -353,10 +396,14 @@ void QuadraticConstraint::takeOwnership(ProblemPtr owner)
 
 SparseVariableVector QuadraticConstraint::calculateGradient(const VectorDouble& point, bool eraseZeroes = true)
 {
-    SparseVariableVector linearGradient = LinearConstraint::calculateGradient(point, eraseZeroes);
-    SparseVariableVector quadraticGradient = quadraticTerms.calculateGradient(point);
+    SparseVariableVector gradient = LinearConstraint::calculateGradient(point, eraseZeroes);
+
+    if(quadraticMatrix.isCompiled())
+        gradient.add(quadraticMatrix.calculateGradient(point));
+    else
+        gradient.add(quadraticTerms.calculateGradient(point));
 
-    return (Utilities::combineSparseVariableVectors(linearGradient, quadraticGradient));
+    return (gradient);
 }
 
 void QuadraticConstraint::initializeGradientSparsityPattern()
@@ -384,6 +431,9 @@ void QuadraticConstraint::initializeGradientSparsityPattern()
 SparseVariableMatrix QuadraticConstraint::calculateHessian(
     [[maybe_unused]] const VectorDouble& point, [[maybe_unused]] bool eraseZeroes = true)
 {
+    if(quadraticMatrix.isCompiled())
+        return (quadraticMatrix.getHessian());
+
     SparseVariableMatrix hessian;
 
     for(auto& T : quadraticTerms)
@@ -394,13 +444,7 @@ SparseVariableMatrix QuadraticConstraint::calculateHessian(
         if(T->firstVariable == T->secondVariable) // variable squared
         {
             auto value = 2 * T->coefficient;
-            auto element = hessian.emplace(std::make_pair(T->firstVariable, T->secondVariable), value);
-
-            if(!element.second)
-            {
-                // Element already exists for the variable
-                element.first->second += value;
-            }
+            hessian.add(std::make_pair(T->firstVariable, T->secondVariable), value);
         }
         else
         {
@@ -408,24 +452,12 @@ SparseVariableMatrix QuadraticConstraint::calculateHessian(
             if(T->firstVariable->index < T->secondVariable->index)
             {
                 auto value = T->coefficient;
-                auto element = hessian.emplace(std::make_pair(T->firstVariable, T->secondVariable), value);
-
-                if(!element.second)
-                {
-                    // Element already exists for the variable
-                    element.first->second += value;
-                }
+                hessian.add(std::make_pair(T->firstVariable, T->secondVariable), value);
             }
             else
             {
                 auto value = T->coefficient;
-                auto element = hessian.emplace(std::make_pair(T->secondVariable, T->firstVariable), value);
-
-                if(!element.second)
-                {
-                    // Element already exists for the variable
-                    element.first->second += value;
-                }
+                hessian.add(std::make_pair(T->secondVariable, T->firstVariable), value);
             }
         }
     }
@@ -580,6 +612,8 @@ void NonlinearConstraint::add(NonlinearExpressionPtr expression)
         nonlinearExpression = expression;
     }
 
+    nonlinearExpressionTape.clear();
+
     properties.hasNonlinearExpression = true;
     properties.classification = E_ConstraintClassification::Nonlinear;
 }
@@ -589,6 +623,42 @@ void NonlinearConstraint::updateFactorableFunction()
     factorableFunction = std::make_shared<FactorableFunction>(nonlinearExpression->getFactorableFunction());
 }
 
+void NonlinearConstraint::updateExpressionTape() { nonlinearExpressionTape.compile(nonlinearExpression); }
+
+void NonlinearConstraint::updateADFunction(bool optimizeTape)
+{
+    std::vector<FactorableFunction> independentVariables(variablesInNonlinearExpression.size());
+    std::vector<FactorableFunction*> problemVariables;
+
+    // The variables in the expression are temporarily redirected to the independent variables of this tape
+    for(size_t i = 0; i < variablesInNonlinearExpression.size(); i++)
+    {
+        auto& VAR = variablesInNonlinearExpression[i];
+
+        independentVariables[i] = 3.0;
+        problemVariables.push_back(VAR->factorableFunctionVariable);
+        VAR->factorableFunctionVariable = &independentVariables[i];
+    }
+
+    startFactorableFunctionRecording();
+    CppAD::Independent(independentVariables);
+
+    std::vector<FactorableFunction> dependentVariables { nonlinearExpression->getFactorableFunction() };
+
+    ADFunction = std::make_shared<CppAD::ADFun<double>>();
+    ADFunction->Dependent(independentVariables, dependentVariables);
+    stopFactorableFunctionRecording();
+
+    if(optimizeTape)
+        ADFunction->optimize();
+
+    for(size_t i = 0; i < variablesInNonlinearExpression.size(); i++)
+        variablesInNonlinearExpression[i]->factorableFunctionVariable = problemVariables[i];
+
+    nonlinearGradientSparsityMapGenerated = false;
+    nonlinearHessianSparsityMapGenerated = false;
+}
+
 double NonlinearConstraint::calculateFunctionValue(const VectorDouble& point)
 {
     double value = QuadraticConstraint::calculateFunctionValue(point);
@@ -600,11 +670,50 @@ double NonlinearConstraint::calculateFunctionValue(const VectorDouble& point)
         value += signomialTerms.calculate(point);
 
     if(this->properties.hasNonlinearExpression)
-        value += nonlinearExpression->calculate(point);
+    {
+        if(nonlinearExpressionTape.isCompiled())
+            value += nonlinearExpressionTape.calculate(point);
+        else
+            value += nonlinearExpression->calculate(point);
+    }
 
     return value;
 }
 
+void NonlinearConstraint::calculateFunctionValues(const PointBatch& points, VectorDouble& values)
+{
+    QuadraticConstraint::calculateFunctionValues(points, values);
+    addNonlinearValues(points, values);
+}
+
+void NonlinearConstraint::calculateNonlinearFunctionValues(const PointBatch& points, VectorDouble& values)
+{
+    QuadraticConstraint::calculateNonlinearFunctionValues(points, values);
+    addNonlinearValues(points, values);
+}
+
+void NonlinearConstraint::addNonlinearValues(const PointBatch& points, VectorDouble& values)
+{
+    if(this->properties.hasMonomialTerms)
+        points.addValues(monomialTerms, values);
+
+    if(this->properties.hasSignomialTerms)
+        points.addValues(signomialTerms, values);
+
+    if(this->properties.hasNonlinearExpression)
+    {
+        if(nonlinearExpressionTape.isCompiled())
+        {
+            points.addValues(nonlinearExpressionTape, values);
+        }
+        else
+        {
+            for(size_t p = 0; p < points.size(); p++)
+                values[p] += nonlinearExpression->calculate(points.getPoint(p));
+        }
+    }
+}
+
 Interval NonlinearConstraint::calculateFunctionValue(const IntervalVector& intervalVector)
 {
     Interval value = QuadraticConstraint::calculateFunctionValue(intervalVector);
@@ -646,21 +755,7 @@ Interval NonlinearConstraint::getConstraintFunctionBounds()
 
 SparseVariableVector NonlinearConstraint::calculateGradient(const VectorDouble& point, bool eraseZeroes = true)
 {
-    SparseVariableVector gradient = QuadraticConstraint::calculateGradient(point, eraseZeroes);
-
-    SparseVariableVector monomialGradient;
-
-    if(this->properties.hasMonomialTerms)
-    {
-        monomialGradient = monomialTerms.calculateGradient(point);
-    }
-
-    SparseVariableVector signomialGradient;
-
-    if(this->properties.hasSignomialTerms)
-    {
-        signomialGradient = signomialTerms.calculateGradient(point);
-    }
+    SparseVariableVector gradient = calculateGradientWithoutNonlinearExpression(point);
 
     if(this->properties.hasNonlinearExpression)
     {
@@ -669,15 +764,18 @@ SparseVariableVector NonlinearConstraint::calculateGradient(const VectorDouble&
 
         if(auto sharedOwnerProblem = ownerProblem.lock())
         {
-            int numberOfNonlinearVariables = sharedOwnerProblem->properties.numberOfVariablesInNonlinearExpressions;
+            // The independent variables of the tape, ordered as on the tape
+            auto& tapeVariables
+                = ADFunction ? variablesInNonlinearExpression : sharedOwnerProblem->nonlinearExpressionVariables;
+            auto& tape = ADFunction ? *ADFunction : sharedOwnerProblem->ADFunctions;
 
-            std::vector<double> pointNonlinearSubset(numberOfNonlinearVariables, 0.0);
+            std::vector<double> pointNonlinearSubset(tapeVariables.size(), 0.0);
 
-            for(auto& VAR : sharedOwnerProblem->nonlinearExpressionVariables)
-                pointNonlinearSubset[VAR->properties.nonlinearVariableIndex] = point[VAR->index];
+            for(size_t i = 0; i < tapeVariables.size(); i++)
+                pointNonlinearSubset[i] = point[tapeVariables[i]->index];
 
             CppAD::sparse_rcv<std::vector<size_t>, std::vector<double>> subset(nonlinearGradientSparsityPattern);
-            sharedOwnerProblem->ADFunctions.subgraph_jac_rev(pointNonlinearSubset, subset);
+            tape.subgraph_jac_rev(pointNonlinearSubset, subset);
 
             const std::vector<size_t>& col(subset.col());
             const std::vector<double>& value(subset.val());
@@ -691,25 +789,30 @@ SparseVariableVector NonlinearConstraint::calculateGradient(const VectorDouble&
                 if(coefficient == 0.0)
                     continue;
 
-                auto VAR = sharedOwnerProblem->nonlinearExpressionVariables[col[k]];
-
-                auto element = gradient.emplace(VAR, coefficient);
+                auto VAR = tapeVariables[col[k]];
 
-                if(!element.second)
-                {
-                    // Element already exists for the variable
-                    element.first->second += coefficient;
-                }
+                gradient.add(VAR, coefficient);
             }
         }
     }
 
-    auto result = Utilities::combineSparseVariableVectors(gradient, monomialGradient, signomialGradient);
-
     if(eraseZeroes)
-        Utilities::erase_if<VariablePtr, double>(result, 0.0);
+        gradient.erase(0.0);
 
-    return result;
+    return gradient;
+}
+
+SparseVariableVector NonlinearConstraint::calculateGradientWithoutNonlinearExpression(const VectorDouble& point)
+{
+    SparseVariableVector gradient = QuadraticConstraint::calculateGradient(point, false);
+
+    if(this->properties.hasMonomialTerms)
+        gradient.add(monomialTerms.calculateGradient(point));
+
+    if(this->properties.hasSignomialTerms)
+        gradient.add(signomialTerms.calculateGradient(point));
+
+    return gradient;
 }
 
 void NonlinearConstraint::initializeGradientSparsityPattern()
@@ -756,20 +859,30 @@ void NonlinearConstraint::initializeGradientSparsityPattern()
             assert(sharedOwnerProblem->properties.numberOfNonlinearExpressions > 0);
             assert(this->nonlinearExpressionIndex >= 0);
 
+            auto& tapeVariables
+                = ADFunction ? variablesInNonlinearExpression : sharedOwnerProblem->nonlinearExpressionVariables;
+            auto& tape = ADFunction ? *ADFunction : sharedOwnerProblem->ADFunctions;
+
             // For some reason we need to have all nonlinear variables activated, otherwise not all nonzero elements
             // of the gradient may be detected
-            auto nonlinearVariablesInExpressionMap
-                = std::vector<bool>(sharedOwnerProblem->properties.numberOfVariablesInNonlinearExpressions, true);
+            auto nonlinearVariablesInExpressionMap = std::vector<bool>(tapeVariables.size(), true);
 
-            auto nonlinearFunctionMap
-                = std::vector<bool>(sharedOwnerProblem->properties.numberOfNonlinearExpressions, false);
+            std::vector<bool> nonlinearFunctionMap;
 
-            nonlinearFunctionMap[this->nonlinearExpressionIndex] = true;
+            if(ADFunction)
+            {
+                nonlinearFunctionMap = std::vector<bool>(1, true);
+            }
+            else
+            {
+                nonlinearFunctionMap
+                    = std::vector<bool>(sharedOwnerProblem->properties.numberOfNonlinearExpressions, false);
+                nonlinearFunctionMap[this->nonlinearExpressionIndex] = true;
+            }
 
             CppAD::sparse_rc<std::vector<size_t>> pattern;
 
-            sharedOwnerProblem->ADFunctions.subgraph_sparsity(
-                nonlinearVariablesInExpressionMap, nonlinearFunctionMap, false, pattern);
+            tape.subgraph_sparsity(nonlinearVariablesInExpressionMap, nonlinearFunctionMap, false, pattern);
 
             // Save for later use when calculating gradients
             nonlinearGradientSparsityPattern = pattern;
@@ -778,17 +891,17 @@ void NonlinearConstraint::initializeGradientSparsityPattern()
 
             for(size_t i = 0; i < nonlinearGradientSparsityPattern.nnz(); i++)
             {
-                for(auto& VAR : variablesInNonlinearExpression)
-                {
-                    if((size_t)VAR->properties.nonlinearVariableIndex == variableIndices[i])
-                    {
-                        if(std::find(gradientSparsityPattern->begin(), gradientSparsityPattern->end(), VAR)
-                            == gradientSparsityPattern->end())
-                            gradientSparsityPattern->push_back(VAR);
+                auto& VAR = tapeVariables[variableIndices[i]];
 
-                        continue;
-                    }
-                }
+                // The problem-wide tape also contains variables not in this constraint
+                if(!ADFunction
+                    && std::find(variablesInNonlinearExpression.begin(), variablesInNonlinearExpression.end(), VAR)
+                        == variablesInNonlinearExpression.end())
+                    continue;
+
+                if(std::find(gradientSparsityPattern->begin(), gradientSparsityPattern->end(), VAR)
+                    == gradientSparsityPattern->end())
+                    gradientSparsityPattern->push_back(VAR);
             }
         }
     }
@@ -798,17 +911,7 @@ void NonlinearConstraint::initializeGradientSparsityPattern()
 
 SparseVariableMatrix NonlinearConstraint::calculateHessian(const VectorDouble& point, bool eraseZeroes = true)
 {
-    SparseVariableMatrix hessian = QuadraticConstraint::calculateHessian(point, eraseZeroes);
-
-    if(properties.hasMonomialTerms)
-    {
-        hessian = Utilities::combineSparseVariableMatrices(monomialTerms.calculateHessian(point), hessian);
-    }
-
-    if(properties.hasSignomialTerms)
-    {
-        hessian = Utilities::combineSparseVariableMatrices(signomialTerms.calculateHessian(point), hessian);
-    }
+    SparseVariableMatrix hessian = calculateHessianWithoutNonlinearExpression(point);
 
     if(this->properties.hasNonlinearExpression)
     {
@@ -817,25 +920,43 @@ SparseVariableMatrix NonlinearConstraint::calculateHessian(const VectorDouble& p
 
         if(auto sharedOwnerProblem = ownerProblem.lock())
         {
-            int numberOfNonlinearVariables = sharedOwnerProblem->properties.numberOfVariablesInNonlinearExpressions;
+            auto& tapeVariables
+                = ADFunction ? variablesInNonlinearExpression : sharedOwnerProblem->nonlinearExpressionVariables;
+            auto& tape = ADFunction ? *ADFunction : sharedOwnerProblem->ADFunctions;
+
+            size_t numberOfNonlinearVariables = tapeVariables.size();
 
             std::vector<double> pointNonlinearSubset(numberOfNonlinearVariables, 0.0);
 
-            std::vector<double> weights(sharedOwnerProblem->properties.numberOfNonlinearExpressions, 0.0);
-            weights[this->nonlinearExpressionIndex] = 1.0;
+            for(size_t i = 0; i < numberOfNonlinearVariables; i++)
+                pointNonlinearSubset[i] = point[tapeVariables[i]->index];
+
+            std::vector<double> weights;
 
-            for(auto& VAR : sharedOwnerProblem->nonlinearExpressionVariables)
-                pointNonlinearSubset[VAR->properties.nonlinearVariableIndex] = point[VAR->index];
+            if(ADFunction)
+            {
+                weights = std::vector<double>(1, 1.0);
+            }
+            else
+            {
+                weights = std::vector<double>(sharedOwnerProblem->properties.numberOfNonlinearExpressions, 0.0);
+                weights[this->nonlinearExpressionIndex] = 1.0;
+            }
 
             // TODO: utilize sparsity pattern
-            auto calculatedHessian = sharedOwnerProblem->ADFunctions.SparseHessian(pointNonlinearSubset, weights);
+            auto calculatedHessian = tape.SparseHessian(pointNonlinearSubset, weights);
 
-            for(auto& V1 : variablesInNonlinearExpression)
+            for(size_t i = 0; i < variablesInNonlinearExpression.size(); i++)
             {
-                for(auto& V2 : variablesInNonlinearExpression)
+                auto& V1 = variablesInNonlinearExpression[i];
+
+                for(size_t j = 0; j < variablesInNonlinearExpression.size(); j++)
                 {
-                    size_t hessianIndex = V1->properties.nonlinearVariableIndex * numberOfNonlinearVariables
-                        + V2->properties.nonlinearVariableIndex;
+                    auto& V2 = variablesInNonlinearExpression[j];
+
+                    size_t row = ADFunction ? i : V1->properties.nonlinearVariableIndex;
+                    size_t column = ADFunction ? j : V2->properties.nonlinearVariableIndex;
+                    size_t hessianIndex = row * numberOfNonlinearVariables + column;
 
                     double hessianValue = calculatedHessian[hessianIndex];
 
@@ -845,13 +966,7 @@ SparseVariableMatrix NonlinearConstraint::calculateHessian(const VectorDouble& p
                     // Only save elements above the diagonal since the Hessian is symmetric
                     if(V1->index <= V2->index)
                     {
-                        auto element = hessian.emplace(std::make_pair(V1, V2), hessianValue);
-
-                        if(!element.second)
-                        {
-                            // Element already exists for the variable
-                            element.first->second += hessianValue;
-                        }
+                        hessian.add(std::make_pair(V1, V2), hessianValue);
                     }
                 }
             }
@@ -859,7 +974,24 @@ SparseVariableMatrix NonlinearConstraint::calculateHessian(const VectorDouble& p
     }
 
     if(eraseZeroes)
-        Utilities::erase_if<std::pair<VariablePtr, VariablePtr>, double>(hessian, 0.0);
+        hessian.erase(0.0);
+
+    return (hessian);
+}
+
+SparseVariableMatrix NonlinearConstraint::calculateHessianWithoutNonlinearExpression(const VectorDouble& point)
+{
+    SparseVariableMatrix hessian = QuadraticConstraint::calculateHessian(point, false);
+
+    if(properties.hasMonomialTerms)
+    {
+        hessian.add(monomialTerms.calculateHessian(point));
+    }
+
+    if(properties.hasSignomialTerms)
+    {
+        hessian.add(signomialTerms.calculateHessian(point));
+    }
 
     return (hessian);
 }
@@ -922,20 +1054,30 @@ void NonlinearConstraint::initializeHessianSparsityPattern()
     {
         if(auto sharedOwnerProblem = ownerProblem.lock())
         {
+            auto& tapeVariables
+                = ADFunction ? variablesInNonlinearExpression : sharedOwnerProblem->nonlinearExpressionVariables;
+            auto& tape = ADFunction ? *ADFunction : sharedOwnerProblem->ADFunctions;
+
             // For some reason we need to have all nonlinear variables activated, otherwise not all nonzero elements of
             // the hessian may be detected
-            auto nonlinearVariablesInExpressionMap
-                = std::vector<bool>(sharedOwnerProblem->properties.numberOfVariablesInNonlinearExpressions, true);
+            auto nonlinearVariablesInExpressionMap = std::vector<bool>(tapeVariables.size(), true);
 
-            auto nonlinearFunctionMap
-                = std::vector<bool>(sharedOwnerProblem->properties.numberOfNonlinearExpressions, false);
+            std::vector<bool> nonlinearFunctionMap;
 
-            nonlinearFunctionMap[this->nonlinearExpressionIndex] = true;
+            if(ADFunction)
+            {
+                nonlinearFunctionMap = std::vector<bool>(1, true);
+            }
+            else
+            {
+                nonlinearFunctionMap
+                    = std::vector<bool>(sharedOwnerProblem->properties.numberOfNonlinearExpressions, false);
+                nonlinearFunctionMap[this->nonlinearExpressionIndex] = true;
+            }
 
             CppAD::sparse_rc<std::vector<size_t>> pattern;
 
-            sharedOwnerProblem->ADFunctions.for_hes_sparsity(
-                nonlinearVariablesInExpressionMap, nonlinearFunctionMap, false, pattern);
+            tape.for_hes_sparsity(nonlinearVariablesInExpressionMap, nonlinearFunctionMap, false, pattern);
 
             nonlinearHessianSparsityPattern = pattern;
 
@@ -944,28 +1086,27 @@ void NonlinearConstraint::initializeHessianSparsityPattern()
 
             for(size_t i = 0; i < nonlinearHessianSparsityPattern.nnz(); i++)
             {
-                for(auto& V1 : variablesInNonlinearExpression)
-                {
-                    for(auto& V2 : variablesInNonlinearExpression)
-                    {
-                        if((size_t)V1->properties.nonlinearVariableIndex == rowIndices[i]
-                            && (size_t)V2->properties.nonlinearVariableIndex == colIndices[i])
-                        {
-                            std::pair<VariablePtr, VariablePtr> variablePair;
-
-                            if(V1->index < V2->index)
-                                variablePair = std::make_pair(V1, V2);
-                            else
-                                variablePair = std::make_pair(V2, V1);
-
-                            if(std::find(hessianSparsityPattern->begin(), hessianSparsityPattern->end(), variablePair)
-                                == hessianSparsityPattern->end())
-                                hessianSparsityPattern->push_back(variablePair);
-
-                            continue;
-                        }
-                    }
-                }
+                auto& V1 = tapeVariables[rowIndices[i]];
+                auto& V2 = tapeVariables[colIndices[i]];
+
+                // The problem-wide tape also contains variables not in this constraint
+                if(!ADFunction
+                    && (std::find(variablesInNonlinearExpression.begin(), variablesInNonlinearExpression.end(), V1)
+                            == variablesInNonlinearExpression.end()
+                        || std::find(variablesInNonlinearExpression.begin(), variablesInNonlinearExpression.end(), V2)
+                            == variablesInNonlinearExpression.end()))
+                    continue;
+
+                std::pair<VariablePtr, VariablePtr> variablePair;
+
+                if(V1->index < V2->index)
+                    variablePair = std::make_pair(V1, V2);
+                else
+                    variablePair = std::make_pair(V2, V1);
+
+                if(std::find(hessianSparsityPattern->begin(), hessianSparsityPattern->end(), variablePair)
+                    == hessianSparsityPattern->end())
+                    hessianSparsityPattern->push_back(variablePair);
             }
         }
     }
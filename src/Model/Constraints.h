@@ -19,6 +19,9 @@
 #include "Variables.h"
 #include "Terms.h"
 #include "NonlinearExpressions.h"
+#include "ExpressionTape.h"
+#include "PointBatch.h"
+#include "QuadraticMatrix.h"
 
 #include "cppad/cppad.hpp"
 #include "cppad/utility.hpp"
@@ -129,6 +132,12 @@ public:
     virtual double calculateFunctionValue(const VectorDouble& point) = 0;
     virtual Interval calculateFunctionValue(const IntervalVector& intervalVector) = 0;
 
+    // Calculates the function value in all points in the batch, values is resized to the number of points
+    virtual void calculateFunctionValues(const PointBatch& points, VectorDouble& values) = 0;
+
+    // As above, but without the linear terms and the constant, e.g. when these are known in some other way
+    virtual void calculateNonlinearFunctionValues(const PointBatch& points, VectorDouble& values) = 0;
+
     virtual Interval getConstraintFunctionBounds() = 0;
 
     virtual SparseVariableVector calculateGradient(const VectorDouble& point, bool eraseZeroes) = 0;
@@ -140,6 +149,9 @@ public:
 
     virtual NumericConstraintValue calculateNumericValue(const VectorDouble& point, double correction = 0.0);
 
+    // Creates the constraint value corresponding to an already calculated function value
+    NumericConstraintValue getNumericValue(double functionValue);
+
     bool isFulfilled(const VectorDouble& point) override;
 
     void takeOwnership(ProblemPtr owner) override = 0;
@@ -184,6 +196,8 @@ public:
 
     double calculateFunctionValue(const VectorDouble& point) override;
     Interval calculateFunctionValue(const IntervalVector& intervalVector) override;
+    void calculateFunctionValues(const PointBatch& points, VectorDouble& values) override;
+    void calculateNonlinearFunctionValues(const PointBatch& points, VectorDouble& values) override;
 
     Interval getConstraintFunctionBounds() override;
 
@@ -219,6 +233,9 @@ class QuadraticConstraint : public LinearConstraint
 public:
     QuadraticTerms quadraticTerms;
 
+    // Compiled form of quadraticTerms used when calculating function values, gradients and Hessians
+    QuadraticMatrix quadraticMatrix;
+
     QuadraticConstraint() : LinearConstraint() {};
 
     QuadraticConstraint(int constraintIndex, std::string constraintName, double LHS, double RHS)
@@ -260,8 +277,12 @@ public:
     void add(QuadraticTerms terms);
     void add(QuadraticTermPtr term);
 
+    void updateQuadraticMatrix();
+
     double calculateFunctionValue(const VectorDouble& point) override;
     Interval calculateFunctionValue(const IntervalVector& intervalVector) override;
+    void calculateFunctionValues(const PointBatch& points, VectorDouble& values) override;
+    void calculateNonlinearFunctionValues(const PointBatch& points, VectorDouble& values) override;
 
     Interval getConstraintFunctionBounds() override;
 
@@ -301,6 +322,13 @@ public:
     NonlinearExpressionPtr nonlinearExpression;
     FactorableFunctionPtr factorableFunction;
 
+    // Compiled form of nonlinearExpression used when calculating function values
+    ExpressionTape nonlinearExpressionTape;
+
+    // A tape with only this constraint's nonlinear expression, where the independent variables are those in
+    // variablesInNonlinearExpression. If not recorded, the problem-wide tape is used for gradients and Hessians.
+    std::shared_ptr<CppAD::ADFun<double>> ADFunction;
+
     CppAD::sparse_rc<std::vector<size_t>> nonlinearGradientSparsityPattern;
     CppAD::sparse_rc<std::vector<size_t>> nonlinearHessianSparsityPattern;
 
@@ -390,8 +418,12 @@ public:
     void add(NonlinearExpressionPtr expression);
 
     void updateFactorableFunction();
+    void updateExpressionTape();
+    void updateADFunction(bool optimizeTape);
 
     double calculateFunctionValue(const VectorDouble& point) override;
+    void calculateFunctionValues(const PointBatch& points, VectorDouble& values) override;
+    void calculateNonlinearFunctionValues(const PointBatch& points, VectorDouble& values) override;
 
     Interval getConstraintFunctionBounds() override;
 
@@ -400,6 +432,11 @@ public:
     // Returns the upper triagonal part of the Hessian matrix is sparse representation
     SparseVariableMatrix calculateHessian(const VectorDouble& point, bool eraseZeroes) override;
 
+    // As calculateGradient and calculateHessian but without the nonlinear expression, which can then be differentiated
+    // together with the expressions in other constraints on the problem-wide tape. Zeroes are not erased.
+    SparseVariableVector calculateGradientWithoutNonlinearExpression(const VectorDouble& point);
+    SparseVariableMatrix calculateHessianWithoutNonlinearExpression(const VectorDouble& point);
+
     Interval calculateFunctionValue(const IntervalVector& intervalVector) override;
 
     bool isFulfilled(const VectorDouble& point) override;
@@ -417,6 +454,9 @@ public:
 protected:
     void initializeGradientSparsityPattern() override;
     void initializeHessianSparsityPattern() override;
+
+    // Adds the values of the monomial and signomial terms and the nonlinear expression in all points in the batch
+    void addNonlinearValues(const PointBatch& points, VectorDouble& values);
 };
 
 using NonlinearConstraintPtr = std::shared_ptr<NonlinearConstraint>;
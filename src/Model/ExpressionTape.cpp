@@ -0,0 +1,691 @@
+/**
+   The Supporting Hyperplane Optimization Toolkit (SHOT).
+
+   @author Andreas Lundell, Åbo Akademi University
+
+   @section LICENSE
+   This software is licensed under the Eclipse Public License 2.0.
+   Please see the README and LICENSE files for more information.
+*/
+
+#include "ExpressionTape.h"
+
+#include <algorithm>
+#include <cmath>
+#include <map>
+
+namespace SHOT
+{
+
+static int appendToTape(ExpressionTape& tape, const NonlinearExpressionPtr& expression,
+    std::map<const NonlinearExpression*, int>& nodeIndices)
+{
+    auto existingNode = nodeIndices.find(expression.get());
+
+    if(existingNode != nodeIndices.end())
+        return (existingNode->second);
+
+    ExpressionTapeNode node;
+    node.type = expression->getType();
+
+    std::vector<int> childIndices;
+
+    switch(node.type)
+    {
+    case E_NonlinearExpressionTypes::Constant:
+        node.constant = std::static_pointer_cast<ExpressionConstant>(expression)->constant;
+        break;
+
+    case E_NonlinearExpressionTypes::Variable:
+        node.variableIndex = std::static_pointer_cast<ExpressionVariable>(expression)->variable->index;
+        break;
+
+    case E_NonlinearExpressionTypes::Divide:
+    case E_NonlinearExpressionTypes::Power:
+    {
+        auto binaryExpression = std::static_pointer_cast<ExpressionBinary>(expression);
+        childIndices.push_back(appendToTape(tape, binaryExpression->firstChild, nodeIndices));
+        childIndices.push_back(appendToTape(tape, binaryExpression->secondChild, nodeIndices));
+        break;
+    }
+
+    case E_NonlinearExpressionTypes::Sum:
+    case E_NonlinearExpressionTypes::Product:
+    {
+        auto generalExpression = std::static_pointer_cast<ExpressionGeneral>(expression);
+
+        for(auto& C : generalExpression->children)
+            childIndices.push_back(appendToTape(tape, C, nodeIndices));
+
+        break;
+    }
+
+    default: // The remaining ones are all unary operations
+        childIndices.push_back(
+            appendToTape(tape, std::static_pointer_cast<ExpressionUnary>(expression)->child, nodeIndices));
+        break;
+    }
+
+    node.firstOperand = tape.operands.size();
+    node.numberOfOperands = childIndices.size();
+    tape.operands.insert(tape.operands.end(), childIndices.begin(), childIndices.end());
+
+    int nodeIndex = tape.nodes.size();
+    tape.nodes.push_back(node);
+    nodeIndices.emplace(expression.get(), nodeIndex);
+
+    return (nodeIndex);
+}
+
+// Must give identical results to ExpressionPower::calculate
+static inline double calculatePower(double base, double power)
+{
+    if(std::abs(base - 0.0) <= 1e-10 * std::abs(base))
+        return 0.0;
+
+    if(std::abs(base - 1.0) <= 1e-10 * std::abs(base))
+        return 1.0;
+
+    if(std::abs(power - 0.0) <= 1e-10 * std::abs(base))
+        return 1.0;
+
+    if(std::abs(power - 1.0) <= 1e-10 * std::abs(base))
+        return base;
+
+    return (pow(base, power));
+}
+
+// Must give identical results to ExpressionPower::getBounds
+static Interval calculatePowerBounds(Interval baseBounds, const Interval& powerBounds, bool isConstantPower)
+{
+    if(isConstantPower)
+    {
+        double power = powerBounds.l();
+
+        double intpart;
+        bool isInteger = (std::modf(power, &intpart) == 0.0);
+        int integerValue = (int)round(intpart);
+        bool isEven = (integerValue % 2 == 0);
+
+        if(baseBounds.l() <= 0 && (!isInteger || power < 0))
+            baseBounds.l(SHOT_DBL_SIG_MIN);
+
+        Interval bounds = isInteger ? pow(baseBounds, (int)power) : pow(baseBounds, power);
+
+        if(isInteger && isEven && bounds.l() <= 0.0)
+            bounds.l(0.0);
+
+        return (bounds);
+    }
+
+    if(powerBounds.l() < 0)
+    {
+        if(baseBounds.l() <= 0)
+            baseBounds.l(SHOT_DBL_SIG_MIN);
+    }
+    else if(powerBounds.l() == 0.0)
+    {
+        if(baseBounds.l() <= 0)
+            baseBounds.l(SHOT_DBL_SIG_MIN);
+    }
+
+    return (pow(baseBounds, powerBounds));
+}
+
+// Intersects bound with [lower, upper] and returns false if the intersection is empty. Bounds that are not numbers
+// (e.g. from multiplying zero with infinity) give no information.
+static inline bool intersectBound(Interval& bound, double lower, double upper)
+{
+    if(std::isnan(lower))
+        lower = bound.l();
+
+    if(std::isnan(upper))
+        upper = bound.u();
+
+    lower = std::max(bound.l(), lower);
+    upper = std::min(bound.u(), upper);
+
+    if(lower > upper)
+    {
+        // Small differences are caused by rounding errors, and the bound is then kept as it is
+        return (lower - upper <= 1e-9 * std::max(1.0, std::abs(lower)));
+    }
+
+    bound = Interval(lower, upper);
+    return (true);
+}
+
+static inline bool intersectBound(Interval& bound, const Interval& other)
+{
+    return (intersectBound(bound, other.l(), other.u()));
+}
+
+// Tightens the bound of x given the bound of x^power, where the root with the same sign as x is chosen if possible
+static bool intersectRootBound(Interval& base, const Interval& bound, double power)
+{
+    double intpart;
+    bool isInteger = (std::modf(power, &intpart) == 0.0);
+
+    if(power > 0 && isInteger && (int)round(intpart) % 2 != 0)
+    {
+        auto oddRoot = [power](double value)
+        { return ((value < 0) ? -pow(-value, 1.0 / power) : pow(value, 1.0 / power)); };
+
+        return (intersectBound(base, oddRoot(bound.l()), oddRoot(bound.u())));
+    }
+
+    if(power > 0 && isInteger)
+    {
+        if(bound.u() < 0)
+            return (false);
+
+        double outerRoot = pow(bound.u(), 1.0 / power);
+
+        if(!intersectBound(base, -outerRoot, outerRoot))
+            return (false);
+
+        if(bound.l() <= 0)
+            return (true);
+
+        double innerRoot = pow(bound.l(), 1.0 / power);
+
+        if(base.l() > -innerRoot)
+            return (intersectBound(base, innerRoot, outerRoot));
+
+        if(base.u() < innerRoot)
+            return (intersectBound(base, -outerRoot, -innerRoot));
+
+        return (true);
+    }
+
+    if(power > 0)
+    {
+        // The base must be nonnegative for noninteger powers
+        if(bound.u() < 0)
+            return (true);
+
+        return (intersectBound(base, pow(std::max(bound.l(), 0.0), 1.0 / power), pow(bound.u(), 1.0 / power)));
+    }
+
+    // For negative powers, only positive bases are considered
+    if(power < 0 && base.l() > 0 && bound.l() > 0)
+        return (intersectBound(base, pow(bound.u(), 1.0 / power), pow(bound.l(), 1.0 / power)));
+
+    return (true);
+}
+
+void ExpressionTape::compile(NonlinearExpressionPtr expression)
+{
+    clear();
+
+    if(!expression)
+        return;
+
+    std::map<const NonlinearExpression*, int> nodeIndices;
+    appendToTape(*this, expression, nodeIndices);
+
+    nodes.shrink_to_fit();
+    operands.shrink_to_fit();
+}
+
+void ExpressionTape::clear()
+{
+    nodes.clear();
+    operands.clear();
+}
+
+double ExpressionTape::calculate(const VectorDouble& point) const
+{
+    // The scratch values are kept per thread so that the same tape can be evaluated concurrently
+    thread_local VectorDouble values;
+
+    if(nodes.size() == 0)
+        return (0.0);
+
+    calculate(point, values);
+
+    return (values[nodes.size() - 1]);
+}
+
+void ExpressionTape::calculate(const VectorDouble& point, VectorDouble& values) const
+{
+    if(values.size() < nodes.size())
+        values.resize(nodes.size());
+
+    const int* operandIndices = operands.data();
+    double* nodeValues = values.data();
+
+    for(size_t i = 0; i < nodes.size(); i++)
+    {
+        const auto& N = nodes[i];
+        const int* arguments = operandIndices + N.firstOperand;
+
+        double value;
+
+        switch(N.type)
+        {
+        case E_NonlinearExpressionTypes::Constant:
+            value = N.constant;
+            break;
+
+        case E_NonlinearExpressionTypes::Variable:
+            value = point[N.variableIndex];
+            break;
+
+        case E_NonlinearExpressionTypes::Negate:
+            value = -nodeValues[arguments[0]];
+            break;
+
+        case E_NonlinearExpressionTypes::Invert:
+            value = 1.0 / nodeValues[arguments[0]];
+            break;
+
+        case E_NonlinearExpressionTypes::SquareRoot:
+            value = sqrt(nodeValues[arguments[0]]);
+            break;
+
+        case E_NonlinearExpressionTypes::Log:
+            value = log(nodeValues[arguments[0]]);
+            break;
+
+        case E_NonlinearExpressionTypes::Exp:
+            value = exp(nodeValues[arguments[0]]);
+            break;
+
+        case E_NonlinearExpressionTypes::Square:
+            value = nodeValues[arguments[0]] * nodeValues[arguments[0]];
+            break;
+
+        case E_NonlinearExpressionTypes::Cos:
+            value = cos(nodeValues[arguments[0]]);
+            break;
+
+        case E_NonlinearExpressionTypes::Sin:
+            value = sin(nodeValues[arguments[0]]);
+            break;
+
+        case E_NonlinearExpressionTypes::Tan:
+            value = tan(nodeValues[arguments[0]]);
+            break;
+
+        case E_NonlinearExpressionTypes::ArcCos:
+            value = acos(nodeValues[arguments[0]]);
+            break;
+
+        case E_NonlinearExpressionTypes::ArcSin:
+            value = asin(nodeValues[arguments[0]]);
+            break;
+
+        case E_NonlinearExpressionTypes::ArcTan:
+            value = atan(nodeValues[arguments[0]]);
+            break;
+
+        case E_NonlinearExpressionTypes::Abs:
+            value = fabs(nodeValues[arguments[0]]);
+            break;
+
+        case E_NonlinearExpressionTypes::Divide:
+            value = nodeValues[arguments[0]] / nodeValues[arguments[1]];
+            break;
+
+        case E_NonlinearExpressionTypes::Power:
+            value = calculatePower(nodeValues[arguments[0]], nodeValues[arguments[1]]);
+            break;
+
+        case E_NonlinearExpressionTypes::Sum:
+            value = 0.0;
+
+            for(int j = 0; j < N.numberOfOperands; j++)
+                value += nodeValues[arguments[j]];
+
+            break;
+
+        case E_NonlinearExpressionTypes::Product:
+            value = 1.0;
+
+            for(int j = 0; j < N.numberOfOperands; j++)
+            {
+                double factor = nodeValues[arguments[j]];
+
+                // Same as in the tree, a zero factor makes the whole product zero
+                if(factor == 0.0)
+                {
+                    value = 0.0;
+                    break;
+                }
+
+                value *= factor;
+            }
+
+            break;
+
+        default:
+            value = NAN;
+            break;
+        }
+
+        nodeValues[i] = value;
+    }
+}
+
+void ExpressionTape::calculateBounds(const Variables& variables, IntervalVector& bounds) const
+{
+    if(bounds.size() < nodes.size())
+        bounds.resize(nodes.size());
+
+    const int* operandIndices = operands.data();
+    Interval* nodeBounds = bounds.data();
+
+    for(size_t i = 0; i < nodes.size(); i++)
+    {
+        const auto& N = nodes[i];
+        const int* arguments = operandIndices + N.firstOperand;
+
+        switch(N.type)
+        {
+        case E_NonlinearExpressionTypes::Constant:
+            nodeBounds[i] = Interval(N.constant);
+            break;
+
+        case E_NonlinearExpressionTypes::Variable:
+            nodeBounds[i] = variables[N.variableIndex]->getBound();
+            break;
+
+        case E_NonlinearExpressionTypes::Negate:
+            nodeBounds[i] = -nodeBounds[arguments[0]];
+            break;
+
+        case E_NonlinearExpressionTypes::Invert:
+        {
+            const auto& denominator = nodeBounds[arguments[0]];
+
+            if(denominator.l() * denominator.u() <= 0)
+                nodeBounds[i] = Interval(SHOT_DBL_MIN, SHOT_DBL_MAX);
+            else
+                nodeBounds[i] = 1.0 / denominator;
+
+            break;
+        }
+
+        case E_NonlinearExpressionTypes::SquareRoot:
+        {
+            auto childBounds = nodeBounds[arguments[0]];
+
+            if(childBounds.l() < 0.0)
+                childBounds.l(0.0);
+
+            nodeBounds[i] = sqrt(childBounds);
+            break;
+        }
+
+        case E_NonlinearExpressionTypes::Log:
+        {
+            auto childBounds = nodeBounds[arguments[0]];
+
+            if(childBounds.l() <= 0)
+                childBounds.l(SHOT_DBL_EPS);
+
+            nodeBounds[i] = log(childBounds);
+            break;
+        }
+
+        case E_NonlinearExpressionTypes::Exp:
+            nodeBounds[i] = exp(nodeBounds[arguments[0]]);
+            break;
+
+        case E_NonlinearExpressionTypes::Square:
+            nodeBounds[i] = pow(nodeBounds[arguments[0]], 2);
+            break;
+
+        case E_NonlinearExpressionTypes::Cos:
+            nodeBounds[i] = cos(nodeBounds[arguments[0]]);
+            break;
+
+        case E_NonlinearExpressionTypes::Sin:
+            nodeBounds[i] = sin(nodeBounds[arguments[0]]);
+            break;
+
+        case E_NonlinearExpressionTypes::Tan:
+            nodeBounds[i] = tan(nodeBounds[arguments[0]]);
+            break;
+
+        case E_NonlinearExpressionTypes::ArcCos:
+            nodeBounds[i] = acos(nodeBounds[arguments[0]]);
+            break;
+
+        case E_NonlinearExpressionTypes::ArcSin:
+            nodeBounds[i] = asin(nodeBounds[arguments[0]]);
+            break;
+
+        case E_NonlinearExpressionTypes::ArcTan:
+            nodeBounds[i] = atan(nodeBounds[arguments[0]]);
+            break;
+
+        case E_NonlinearExpressionTypes::Abs:
+            nodeBounds[i] = fabs(nodeBounds[arguments[0]]);
+            break;
+
+        case E_NonlinearExpressionTypes::Divide:
+        {
+            const auto& denominator = nodeBounds[arguments[1]];
+
+            if(denominator.l() * denominator.u() <= 0)
+                nodeBounds[i] = Interval(SHOT_DBL_MIN, SHOT_DBL_MAX);
+            else
+                nodeBounds[i] = nodeBounds[arguments[0]] / denominator;
+
+            break;
+        }
+
+        case E_NonlinearExpressionTypes::Power:
+            nodeBounds[i] = calculatePowerBounds(nodeBounds[arguments[0]], nodeBounds[arguments[1]],
+                nodes[arguments[1]].type == E_NonlinearExpressionTypes::Constant);
+            break;
+
+        case E_NonlinearExpressionTypes::Sum:
+        {
+            Interval sum(0.0);
+
+            for(int j = 0; j < N.numberOfOperands; j++)
+                sum += nodeBounds[arguments[j]];
+
+            nodeBounds[i] = sum;
+            break;
+        }
+
+        case E_NonlinearExpressionTypes::Product:
+        {
+            Interval product(1.0);
+
+            for(int j = 0; j < N.numberOfOperands; j++)
+                product = product * nodeBounds[arguments[j]];
+
+            nodeBounds[i] = product;
+            break;
+        }
+
+        default:
+            nodeBounds[i] = Interval(SHOT_DBL_MIN, SHOT_DBL_MAX);
+            break;
+        }
+    }
+}
+
+Interval ExpressionTape::getBounds(const Variables& variables) const
+{
+    // The scratch bounds are kept per thread so that the same tape can be used concurrently
+    thread_local IntervalVector bounds;
+
+    if(nodes.size() == 0)
+        return (Interval(0.0));
+
+    calculateBounds(variables, bounds);
+
+    return (bounds[nodes.size() - 1]);
+}
+
+bool ExpressionTape::tightenBounds(Interval bound, IntervalVector& bounds) const
+{
+    if(nodes.size() == 0)
+        return (true);
+
+    if(!intersectBound(bounds[nodes.size() - 1], bound))
+        return (false);
+
+    const int* operandIndices = operands.data();
+    Interval* nodeBounds = bounds.data();
+
+    for(int i = (int)nodes.size() - 1; i >= 0; i--)
+    {
+        const auto& N = nodes[i];
+        const int* arguments = operandIndices + N.firstOperand;
+        const Interval nodeBound = nodeBounds[i];
+
+        bool isFeasible = true;
+
+        switch(N.type)
+        {
+        case E_NonlinearExpressionTypes::Negate:
+            isFeasible = intersectBound(nodeBounds[arguments[0]], -nodeBound.u(), -nodeBound.l());
+            break;
+
+        case E_NonlinearExpressionTypes::Invert:
+            if(nodeBound.l() > 0 || nodeBound.u() < 0)
+                isFeasible = intersectBound(nodeBounds[arguments[0]], 1.0 / nodeBound);
+
+            break;
+
+        case E_NonlinearExpressionTypes::SquareRoot:
+            if(nodeBound.u() >= 0)
+            {
+                double lower = std::max(nodeBound.l(), 0.0);
+                isFeasible
+                    = intersectBound(nodeBounds[arguments[0]], lower * lower, nodeBound.u() * nodeBound.u());
+            }
+
+            break;
+
+        case E_NonlinearExpressionTypes::Log:
+            isFeasible = intersectBound(nodeBounds[arguments[0]], exp(nodeBound.l()), exp(nodeBound.u()));
+            break;
+
+        case E_NonlinearExpressionTypes::Exp:
+            if(nodeBound.u() > 0)
+            {
+                isFeasible = intersectBound(nodeBounds[arguments[0]],
+                    (nodeBound.l() > 0) ? log(nodeBound.l()) : -SHOT_DBL_INF, log(nodeBound.u()));
+            }
+
+            break;
+
+        case E_NonlinearExpressionTypes::Square:
+            isFeasible = intersectRootBound(nodeBounds[arguments[0]], nodeBound, 2.0);
+            break;
+
+        case E_NonlinearExpressionTypes::Abs:
+            isFeasible = intersectBound(nodeBounds[arguments[0]], -nodeBound.u(), nodeBound.u());
+            break;
+
+        case E_NonlinearExpressionTypes::Divide:
+        {
+            auto& numerator = nodeBounds[arguments[0]];
+            auto& denominator = nodeBounds[arguments[1]];
+
+            isFeasible = intersectBound(numerator, denominator * nodeBound);
+
+            if(isFeasible && (nodeBound.l() > 0 || nodeBound.u() < 0))
+                isFeasible = intersectBound(denominator, numerator / nodeBound);
+
+            break;
+        }
+
+        case E_NonlinearExpressionTypes::Power:
+        {
+            const auto& exponent = nodes[arguments[1]];
+
+            if(exponent.type == E_NonlinearExpressionTypes::Constant && exponent.constant != 0.0)
+                isFeasible = intersectRootBound(nodeBounds[arguments[0]], nodeBound, exponent.constant);
+
+            break;
+        }
+
+        case E_NonlinearExpressionTypes::Sum:
+        {
+            IntervalSum sum;
+
+            for(int j = 0; j < N.numberOfOperands; j++)
+                sum.add(nodeBounds[arguments[j]]);
+
+            for(int j = 0; j < N.numberOfOperands && isFeasible; j++)
+            {
+                auto othersBound = sum.getSumWithout(nodeBounds[arguments[j]]);
+                isFeasible = intersectBound(
+                    nodeBounds[arguments[j]], nodeBound.l() - othersBound.u(), nodeBound.u() - othersBound.l());
+            }
+
+            break;
+        }
+
+        case E_NonlinearExpressionTypes::Product:
+        {
+            if(N.numberOfOperands == 1)
+            {
+                isFeasible = intersectBound(nodeBounds[arguments[0]], nodeBound);
+                break;
+            }
+
+            for(int j = 0; j < N.numberOfOperands && isFeasible; j++)
+            {
+                Interval othersBound(1.0);
+
+                for(int k = 0; k < N.numberOfOperands; k++)
+                {
+                    if(k != j)
+                        othersBound *= nodeBounds[arguments[k]];
+                }
+
+                // To avoid division by zero
+                if(othersBound.l() <= 0 && othersBound.u() >= 0)
+                    continue;
+
+                isFeasible = intersectBound(nodeBounds[arguments[j]], nodeBound / othersBound);
+            }
+
+            break;
+        }
+
+        default: // No bounds are propagated through the remaining operations
+            break;
+        }
+
+        if(!isFeasible)
+            return (false);
+    }
+
+    return (true);
+}
+
+bool ExpressionTape::tightenVariableBounds(Interval bound, const Variables& variables) const
+{
+    thread_local IntervalVector bounds;
+
+    if(nodes.size() == 0)
+        return (false);
+
+    calculateBounds(variables, bounds);
+
+    if(!tightenBounds(bound, bounds))
+        return (false);
+
+    bool tightened = false;
+
+    for(size_t i = 0; i < nodes.size(); i++)
+    {
+        if(nodes[i].type == E_NonlinearExpressionTypes::Variable)
+            tightened = variables[nodes[i].variableIndex]->tightenBounds(bounds[i]) || tightened;
+    }
+
+    return (tightened);
+}
+
+} // namespace SHOT
@@ -0,0 +1,133 @@
+/**
+   The Supporting Hyperplane Optimization Toolkit (SHOT).
+
+   @author Andreas Lundell, Åbo Akademi University
+
+   @section LICENSE
+   This software is licensed under the Eclipse Public License 2.0.
+   Please see the README and LICENSE files for more information.
+*/
+
+#pragma once
+
+#include "../Structs.h"
+#include "NonlinearExpressions.h"
+
+#include <cmath>
+#include <vector>
+
+namespace SHOT
+{
+
+// A node in the flattened expression; the operands of a node are stored contiguously in ExpressionTape::operands
+// starting at firstOperand and always refer to nodes earlier on the tape
+struct ExpressionTapeNode
+{
+    E_NonlinearExpressionTypes type = E_NonlinearExpressionTypes::Constant;
+
+    int firstOperand = 0;
+    int numberOfOperands = 0;
+
+    int variableIndex = -1; // Only used for variable nodes
+    double constant = 0.0; // Only used for constant nodes
+};
+
+// A compiled representation of a nonlinear expression tree. The tree is flattened once in topological order, after
+// which it can be evaluated with a single pass over a contiguous array without any virtual calls or pointer chasing.
+// Subexpressions shared (as the same pointer) in the tree are only stored once on the tape.
+class ExpressionTape
+{
+public:
+    std::vector<ExpressionTapeNode> nodes;
+    std::vector<int> operands;
+
+    ExpressionTape() = default;
+    ExpressionTape(NonlinearExpressionPtr expression) { compile(expression); };
+
+    void compile(NonlinearExpressionPtr expression);
+    void clear();
+
+    inline bool isCompiled() const { return (nodes.size() > 0); };
+    inline size_t size() const { return (nodes.size()); };
+
+    double calculate(const VectorDouble& point) const;
+
+    // Evaluates the tape and stores the value of each node in values, which is resized if needed
+    void calculate(const VectorDouble& point, VectorDouble& values) const;
+
+    // Calculates the bounds of each node from the current bounds of the variables in the same way as
+    // NonlinearExpression::getBounds, but with a single pass over the tape. The variables are indexed as on the tape.
+    void calculateBounds(const Variables& variables, IntervalVector& bounds) const;
+
+    // Returns the bounds of the whole expression
+    Interval getBounds(const Variables& variables) const;
+
+    // Propagates a bound on the whole expression backwards to the nodes, whose bounds must have been calculated with
+    // calculateBounds. The nodes are traversed in reverse order, so a node is reached only after all expressions it
+    // occurs in, and shared subexpressions get the intersection of the bounds implied by each of them. Returns false if
+    // some bound becomes empty, i.e. the expression cannot take a value within the bound.
+    bool tightenBounds(Interval bound, IntervalVector& bounds) const;
+
+    // Performs the forward and backward propagation and tightens the bounds of the variables with the result. Returns
+    // true if some variable bound was tightened.
+    bool tightenVariableBounds(Interval bound, const Variables& variables) const;
+};
+
+// A sum of intervals from which the sum of all but one of the intervals can be obtained in constant time, e.g. when
+// tightening the bound of each term in a sum. Infinite bounds are counted instead of added, so that they can be
+// removed again.
+class IntervalSum
+{
+public:
+    inline void add(const Interval& interval) { update(interval, 1); };
+    inline void remove(const Interval& interval) { update(interval, -1); };
+
+    inline Interval getSum() const
+    {
+        return (Interval((infiniteLowerBounds > 0) ? -SHOT_DBL_INF : finiteLowerSum,
+            (infiniteUpperBounds > 0) ? SHOT_DBL_INF : finiteUpperSum));
+    };
+
+    // Returns the sum of all intervals except the given one, which must be one of the added intervals
+    inline Interval getSumWithout(const Interval& interval) const
+    {
+        double lower = -SHOT_DBL_INF;
+        double upper = SHOT_DBL_INF;
+
+        if(isInfinite(interval.l()) && infiniteLowerBounds == 1)
+            lower = finiteLowerSum;
+        else if(!isInfinite(interval.l()) && infiniteLowerBounds == 0)
+            lower = finiteLowerSum - interval.l();
+
+        if(isInfinite(interval.u()) && infiniteUpperBounds == 1)
+            upper = finiteUpperSum;
+        else if(!isInfinite(interval.u()) && infiniteUpperBounds == 0)
+            upper = finiteUpperSum - interval.u();
+
+        return (Interval(lower, upper));
+    };
+
+private:
+    double finiteLowerSum = 0.0;
+    double finiteUpperSum = 0.0;
+    int infiniteLowerBounds = 0;
+    int infiniteUpperBounds = 0;
+
+    // Also very large bounds are treated as infinite, since adding them could overflow
+    static inline bool isInfinite(double value) { return (!(std::abs(value) < 1e100)); };
+
+    inline void update(const Interval& interval, int sign)
+    {
+        if(isInfinite(interval.l()))
+            infiniteLowerBounds += sign;
+        else
+            finiteLowerSum += sign * interval.l();
+
+        if(isInfinite(interval.u()))
+            infiniteUpperBounds += sign;
+        else
+            finiteUpperSum += sign * interval.u();
+    };
+};
+
+} // namespace SHOT
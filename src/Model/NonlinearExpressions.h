@@ -19,6 +19,7 @@
 
 #include "cppad/cppad.hpp"
 
+#include <atomic>
 #include <memory>
 #include <optional>
 #include <tuple>
@@ -123,6 +124,20 @@ inline E_Monotonicity getMonotonicityTimesWithConstantFunction(
     return E_Monotonicity::Unknown;
 }
 
+// Identifies the CppAD recording that is active in this thread (zero if none). Since nonlinear expressions can share
+// subexpressions, the factorable function of a node is reused within a recording so that it is only taped once. The
+// identifiers are taken from a common counter so that recordings in different threads never get the same one.
+inline thread_local unsigned int activeFactorableFunctionRecording = 0;
+inline std::atomic<unsigned int> numberOfFactorableFunctionRecordings = 0;
+
+// To be called directly before CppAD::Independent and after the recording has been stopped, respectively
+inline void startFactorableFunctionRecording()
+{
+    activeFactorableFunctionRecording = ++numberOfFactorableFunctionRecordings;
+}
+
+inline void stopFactorableFunctionRecording() { activeFactorableFunctionRecording = 0; }
+
 class NonlinearExpression
 {
 public:
@@ -138,7 +153,21 @@ public:
 
     virtual bool tightenBounds(Interval bound) = 0;
 
-    virtual FactorableFunction getFactorableFunction() = 0;
+    inline FactorableFunction getFactorableFunction()
+    {
+        if(activeFactorableFunctionRecording == 0)
+            return (calculateFactorableFunction());
+
+        if(factorableFunctionRecording != activeFactorableFunctionRecording)
+        {
+            factorableFunction = calculateFactorableFunction();
+            factorableFunctionRecording = activeFactorableFunctionRecording;
+        }
+
+        return (factorableFunction);
+    };
+
+    virtual FactorableFunction calculateFactorableFunction() = 0;
 
     virtual std::ostream& print(std::ostream&) const = 0;
 
@@ -157,6 +186,10 @@ public:
     };
 
     virtual bool operator==(const NonlinearExpression& rhs) const = 0;
+
+private:
+    FactorableFunction factorableFunction;
+    unsigned int factorableFunctionRecording = 0;
 };
 
 using NonlinearExpressionPtr = std::shared_ptr<NonlinearExpression>;
@@ -221,7 +254,7 @@ public:
 
     inline bool tightenBounds([[maybe_unused]] Interval bound) override { return false; };
 
-    inline FactorableFunction getFactorableFunction() override { return constant; };
+    inline FactorableFunction calculateFactorableFunction() override { return constant; };
 
     inline std::ostream& print(std::ostream& stream) const override { return stream << constant; };
 
@@ -263,7 +296,10 @@ public:
         return (variable->calculate(intervalVector));
     };
 
-    inline FactorableFunction getFactorableFunction() override { return *(variable->factorableFunctionVariable); };
+    inline FactorableFunction calculateFactorableFunction() override
+    {
+        return *(variable->factorableFunctionVariable);
+    };
 
     inline Interval getBounds() const override { return (variable->getBound()); };
 
@@ -308,7 +344,7 @@ public:
 
     double calculate(const VectorDouble& point) const override = 0;
     Interval calculate(const IntervalVector& intervalVector) const override = 0;
-    FactorableFunction getFactorableFunction() override = 0;
+    FactorableFunction calculateFactorableFunction() override = 0;
     E_NonlinearExpressionTypes getType() const override = 0;
 
     inline int getNumberOfChildren() const override { return 1; }
@@ -335,7 +371,7 @@ public:
 
     double calculate(const VectorDouble& point) const override = 0;
     Interval calculate(const IntervalVector& intervalVector) const override = 0;
-    FactorableFunction getFactorableFunction() override = 0;
+    FactorableFunction calculateFactorableFunction() override = 0;
     E_NonlinearExpressionTypes getType() const override = 0;
 
     inline int getNumberOfChildren() const override { return 2; }
@@ -362,7 +398,7 @@ public:
 
     double calculate(const VectorDouble& point) const override = 0;
     Interval calculate(const IntervalVector& intervalVector) const override = 0;
-    FactorableFunction getFactorableFunction() override = 0;
+    FactorableFunction calculateFactorableFunction() override = 0;
     E_NonlinearExpressionTypes getType() const override = 0;
 
     inline int getNumberOfChildren() const override { return children.size(); }
@@ -394,7 +430,7 @@ public:
 
     inline bool tightenBounds(Interval bound) override { return (child->tightenBounds(-bound)); };
 
-    inline FactorableFunction getFactorableFunction() override { return (-child->getFactorableFunction()); }
+    inline FactorableFunction calculateFactorableFunction() override { return (-child->getFactorableFunction()); }
 
     inline std::ostream& print(std::ostream& stream) const override
     {
@@ -494,7 +530,7 @@ public:
         return (child->tightenBounds(1.0 / bound));
     };
 
-    inline FactorableFunction getFactorableFunction() override { return (1 / child->getFactorableFunction()); }
+    inline FactorableFunction calculateFactorableFunction() override { return (1 / child->getFactorableFunction()); }
 
     inline std::ostream& print(std::ostream& stream) const override
     {
@@ -587,7 +623,7 @@ public:
         return (child->tightenBounds(interval));
     };
 
-    inline FactorableFunction getFactorableFunction() override { return (sqrt(child->getFactorableFunction())); }
+    inline FactorableFunction calculateFactorableFunction() override { return (sqrt(child->getFactorableFunction())); }
 
     inline std::ostream& print(std::ostream& stream) const override
     {
@@ -683,7 +719,7 @@ public:
 
     inline bool tightenBounds(Interval bound) override { return (child->tightenBounds(exp(bound))); };
 
-    inline FactorableFunction getFactorableFunction() override { return (log(child->getFactorableFunction())); }
+    inline FactorableFunction calculateFactorableFunction() override { return (log(child->getFactorableFunction())); }
 
     inline std::ostream& print(std::ostream& stream) const override
     {
@@ -743,7 +779,7 @@ public:
         return (child->tightenBounds(log(bound)));
     };
 
-    inline FactorableFunction getFactorableFunction() override { return (exp(child->getFactorableFunction())); }
+    inline FactorableFunction calculateFactorableFunction() override { return (exp(child->getFactorableFunction())); }
 
     inline std::ostream& print(std::ostream& stream) const override
     {
@@ -817,7 +853,7 @@ public:
         return (child->tightenBounds(sqrt(bound)));
     };
 
-    inline FactorableFunction getFactorableFunction() override
+    inline FactorableFunction calculateFactorableFunction() override
     {
         return (child->getFactorableFunction() * child->getFactorableFunction());
     }
@@ -894,7 +930,7 @@ public:
 
     inline bool tightenBounds([[maybe_unused]] Interval bound) override { return (false); };
 
-    inline FactorableFunction getFactorableFunction() override { return (sin(child->getFactorableFunction())); }
+    inline FactorableFunction calculateFactorableFunction() override { return (sin(child->getFactorableFunction())); }
 
     inline std::ostream& print(std::ostream& stream) const override
     {
@@ -994,7 +1030,7 @@ public:
 
     inline bool tightenBounds([[maybe_unused]] Interval bound) override { return (false); };
 
-    inline FactorableFunction getFactorableFunction() override { return (cos(child->getFactorableFunction())); }
+    inline FactorableFunction calculateFactorableFunction() override { return (cos(child->getFactorableFunction())); }
 
     inline std::ostream& print(std::ostream& stream) const override
     {
@@ -1094,7 +1130,7 @@ public:
 
     inline bool tightenBounds([[maybe_unused]] Interval bound) override { return (false); };
 
-    inline FactorableFunction getFactorableFunction() override { return (tan(child->getFactorableFunction())); }
+    inline FactorableFunction calculateFactorableFunction() override { return (tan(child->getFactorableFunction())); }
 
     inline std::ostream& print(std::ostream& stream) const override
     {
@@ -1161,7 +1197,7 @@ public:
 
     inline bool tightenBounds([[maybe_unused]] Interval bound) override { return (false); };
 
-    inline FactorableFunction getFactorableFunction() override { return (asin(child->getFactorableFunction())); }
+    inline FactorableFunction calculateFactorableFunction() override { return (asin(child->getFactorableFunction())); }
 
     inline std::ostream& print(std::ostream& stream) const override
     {
@@ -1218,7 +1254,7 @@ public:
 
     inline bool tightenBounds([[maybe_unused]] Interval bound) override { return (false); };
 
-    inline FactorableFunction getFactorableFunction() override { return (acos(child->getFactorableFunction())); }
+    inline FactorableFunction calculateFactorableFunction() override { return (acos(child->getFactorableFunction())); }
 
     inline std::ostream& print(std::ostream& stream) const override
     {
@@ -1276,7 +1312,7 @@ public:
 
     inline bool tightenBounds([[maybe_unused]] Interval bound) override { return (false); };
 
-    inline FactorableFunction getFactorableFunction() override { return (atan(child->getFactorableFunction())); }
+    inline FactorableFunction calculateFactorableFunction() override { return (atan(child->getFactorableFunction())); }
 
     inline std::ostream& print(std::ostream& stream) const override
     {
@@ -1333,7 +1369,7 @@ public:
 
     inline bool tightenBounds([[maybe_unused]] Interval bound) override { return (false); };
 
-    inline FactorableFunction getFactorableFunction() override { return (fabs(child->getFactorableFunction())); }
+    inline FactorableFunction calculateFactorableFunction() override { return (fabs(child->getFactorableFunction())); }
 
     inline std::ostream& print(std::ostream& stream) const override
     {
@@ -1462,7 +1498,7 @@ public:
         return (firstTightened || secondTightened);
     }
 
-    inline FactorableFunction getFactorableFunction() override
+    inline FactorableFunction calculateFactorableFunction() override
     {
         return (firstChild->getFactorableFunction() / secondChild->getFactorableFunction());
     }
@@ -1724,7 +1760,7 @@ public:
         if(rhs.getType() != getType())
             return (false);
 
-        auto expression = dynamic_cast<const ExpressionDivide&>(rhs);
+        auto& expression = dynamic_cast<const ExpressionDivide&>(rhs);
 
         return (expression.firstChild.get() == firstChild.get() && expression.secondChild.get() == secondChild.get());
     };
@@ -1908,7 +1944,7 @@ public:
         return (firstChild->tightenBounds(interval));
     };
 
-    inline FactorableFunction getFactorableFunction() override
+    inline FactorableFunction calculateFactorableFunction() override
     {
         // Special logic for integer powers
         if(secondChild->getType() == E_NonlinearExpressionTypes::Constant)
@@ -1991,7 +2027,7 @@ public:
         if(rhs.getType() != getType())
             return (false);
 
-        auto expression = dynamic_cast<const ExpressionPower&>(rhs);
+        auto& expression = dynamic_cast<const ExpressionPower&>(rhs);
 
         return (expression.firstChild.get() == firstChild.get() && expression.secondChild.get() == secondChild.get());
     };
@@ -2291,7 +2327,7 @@ public:
         return (tightened);
     };
 
-    inline FactorableFunction getFactorableFunction() override
+    inline FactorableFunction calculateFactorableFunction() override
     {
         FactorableFunction funct;
 
@@ -2393,7 +2429,7 @@ public:
         if(rhs.getNumberOfChildren() != getNumberOfChildren())
             return false;
 
-        auto expression = dynamic_cast<const ExpressionSum&>(rhs);
+        auto& expression = dynamic_cast<const ExpressionSum&>(rhs);
 
         for(int i = 0; i < getNumberOfChildren(); i++)
         {
@@ -2510,7 +2546,7 @@ public:
         return (tightened);
     };
 
-    inline FactorableFunction getFactorableFunction() override
+    inline FactorableFunction calculateFactorableFunction() override
     {
         FactorableFunction funct;
 
@@ -2807,7 +2843,7 @@ public:
         if(rhs.getNumberOfChildren() != getNumberOfChildren())
             return false;
 
-        auto expression = dynamic_cast<const ExpressionProduct&>(rhs);
+        auto& expression = dynamic_cast<const ExpressionProduct&>(rhs);
 
         for(int i = 0; i < getNumberOfChildren(); i++)
         {
@@ -261,16 +261,11 @@ SparseVariableVector LinearObjectiveFunction::calculateGradient(
 
     for(auto& T : linearTerms)
     {
-        auto element = gradient.emplace(T->variable, T->coefficient);
-        if(!element.second)
-        {
-            // Element already exists for the variable
-            element.first->second += T->coefficient;
-        }
+        gradient.add(T->variable, T->coefficient);
     }
 
     if(eraseZeroes)
-        Utilities::erase_if<VariablePtr, double>(gradient, 0.0);
+        gradient.erase(0.0);
 
     return gradient;
 }
@@ -326,6 +321,7 @@ void QuadraticObjectiveFunction::add(QuadraticTerms terms)
     {
         quadraticTerms = terms;
         properties.isValid = false;
+        quadraticMatrix.clear();
     }
     else
     {
@@ -340,6 +336,15 @@ void QuadraticObjectiveFunction::add(QuadraticTermPtr term)
 {
     quadraticTerms.push_back(term);
     properties.isValid = false;
+    quadraticMatrix.clear();
+}
+
+void QuadraticObjectiveFunction::updateQuadraticMatrix()
+{
+    if(quadraticTerms.size() > 0)
+        quadraticMatrix.compile(quadraticTerms);
+    else
+        quadraticMatrix.clear();
 }
 
 void QuadraticObjectiveFunction::updateProperties()
@@ -415,7 +420,12 @@ void QuadraticObjectiveFunction::takeOwnership(ProblemPtr owner)
 double QuadraticObjectiveFunction::calculateValue(const VectorDouble& point)
 {
     double value = LinearObjectiveFunction::calculateValue(point);
-    value += quadraticTerms.calculate(point);
+
+    if(quadraticMatrix.isCompiled())
+        value += quadraticMatrix.calculate(point);
+    else
+        value += quadraticTerms.calculate(point);
+
     return value;
 }
 
@@ -430,43 +440,32 @@ SparseVariableVector QuadraticObjectiveFunction::calculateGradient(const VectorD
 {
     SparseVariableVector gradient = LinearObjectiveFunction::calculateGradient(point, eraseZeroes);
 
-    for(auto& T : quadraticTerms)
+    if(quadraticMatrix.isCompiled())
     {
-        if(T->firstVariable == T->secondVariable) // variable squared
+        gradient.add(quadraticMatrix.calculateGradient(point));
+    }
+    else
+    {
+        for(auto& T : quadraticTerms)
         {
-            auto value = 2 * T->coefficient * point[T->firstVariable->index];
-            auto element = gradient.emplace(T->firstVariable, value);
-
-            if(!element.second)
+            if(T->firstVariable == T->secondVariable) // variable squared
             {
-                // Element already exists for the variable
-                element.first->second += value;
+                auto value = 2 * T->coefficient * point[T->firstVariable->index];
+                gradient.add(T->firstVariable, value);
             }
-        }
-        else
-        {
-            auto value = T->coefficient * point[T->secondVariable->index];
-            auto element = gradient.emplace(T->firstVariable, value);
-
-            if(!element.second)
+            else
             {
-                // Element already exists for the variable
-                element.first->second += value;
-            }
-
-            value = T->coefficient * point[T->firstVariable->index];
-            element = gradient.emplace(T->secondVariable, value);
+                auto value = T->coefficient * point[T->secondVariable->index];
+                gradient.add(T->firstVariable, value);
 
-            if(!element.second)
-            {
-                // Element already exists for the variable
-                element.first->second += value;
+                value = T->coefficient * point[T->firstVariable->index];
+                gradient.add(T->secondVariable, value);
             }
         }
     }
 
     if(eraseZeroes)
-        Utilities::erase_if<VariablePtr, double>(gradient, 0.0);
+        gradient.erase(0.0);
 
     return gradient;
 }
@@ -493,6 +492,9 @@ void QuadraticObjectiveFunction::initializeGradientSparsityPattern()
 SparseVariableMatrix QuadraticObjectiveFunction::calculateHessian(
     [[maybe_unused]] const VectorDouble& point, [[maybe_unused]] bool eraseZeroes = true)
 {
+    if(quadraticMatrix.isCompiled())
+        return (quadraticMatrix.getHessian());
+
     SparseVariableMatrix hessian;
 
     for(auto& T : quadraticTerms)
@@ -503,13 +505,7 @@ SparseVariableMatrix QuadraticObjectiveFunction::calculateHessian(
         if(T->firstVariable == T->secondVariable) // variable squared
         {
             auto value = 2 * T->coefficient;
-            auto element = hessian.emplace(std::make_pair(T->firstVariable, T->secondVariable), value);
-
-            if(!element.second)
-            {
-                // Element already exists for the variable
-                element.first->second += value;
-            }
+            hessian.add(std::make_pair(T->firstVariable, T->secondVariable), value);
         }
         else
         {
@@ -517,24 +513,12 @@ SparseVariableMatrix QuadraticObjectiveFunction::calculateHessian(
             if(T->firstVariable->index < T->secondVariable->index)
             {
                 auto value = T->coefficient;
-                auto element = hessian.emplace(std::make_pair(T->firstVariable, T->secondVariable), value);
-
-                if(!element.second)
-                {
-                    // Element already exists for the variable
-                    element.first->second += value;
-                }
+                hessian.add(std::make_pair(T->firstVariable, T->secondVariable), value);
             }
             else
             {
                 auto value = T->coefficient;
-                auto element = hessian.emplace(std::make_pair(T->secondVariable, T->firstVariable), value);
-
-                if(!element.second)
-                {
-                    // Element already exists for the variable
-                    element.first->second += value;
-                }
+                hessian.add(std::make_pair(T->secondVariable, T->firstVariable), value);
             }
         }
     }
@@ -657,6 +641,8 @@ void NonlinearObjectiveFunction::add(NonlinearExpressionPtr expression)
         nonlinearExpression = expression;
     }
 
+    nonlinearExpressionTape.clear();
+
     properties.isValid = false;
 }
 
@@ -665,6 +651,8 @@ void NonlinearObjectiveFunction::updateFactorableFunction()
     factorableFunction = std::make_shared<FactorableFunction>(nonlinearExpression->getFactorableFunction());
 }
 
+void NonlinearObjectiveFunction::updateExpressionTape() { nonlinearExpressionTape.compile(nonlinearExpression); }
+
 void NonlinearObjectiveFunction::updateProperties()
 {
     QuadraticObjectiveFunction::updateProperties();
@@ -758,7 +746,12 @@ double NonlinearObjectiveFunction::calculateValue(const VectorDouble& point)
     value += signomialTerms.calculate(point);
 
     if(this->properties.hasNonlinearExpression)
-        value += nonlinearExpression->calculate(point);
+    {
+        if(nonlinearExpressionTape.isCompiled())
+            value += nonlinearExpressionTape.calculate(point);
+        else
+            value += nonlinearExpression->calculate(point);
+    }
 
     return value;
 }
@@ -784,7 +777,7 @@ Interval NonlinearObjectiveFunction::calculateValue(const IntervalVector& interv
 
 SparseVariableVector NonlinearObjectiveFunction::calculateGradient(const VectorDouble& point, bool eraseZeroes = true)
 {
-    SparseVariableVector gradient = QuadraticObjectiveFunction::calculateGradient(point, eraseZeroes);
+    SparseVariableVector gradient = calculateGradientWithoutNonlinearExpression(point);
 
     if(this->properties.hasNonlinearExpression)
     {
@@ -817,37 +810,28 @@ SparseVariableVector NonlinearObjectiveFunction::calculateGradient(const VectorD
 
                 auto VAR = sharedOwnerProblem->nonlinearExpressionVariables[col[k]];
 
-                auto element = gradient.emplace(VAR, coefficient);
-
-                if(!element.second)
-                {
-                    // Element already exists for the variable
-                    element.first->second += coefficient;
-                }
+                gradient.add(VAR, coefficient);
             }
         }
     }
 
-    SparseVariableVector monomialGradient;
-
-    if(this->properties.hasMonomialTerms)
-    {
-        monomialGradient = monomialTerms.calculateGradient(point);
-    }
+    if(eraseZeroes)
+        gradient.erase(0.0);
 
-    SparseVariableVector signomialGradient;
+    return gradient;
+}
 
-    if(this->properties.hasSignomialTerms)
-    {
-        signomialGradient = signomialTerms.calculateGradient(point);
-    }
+SparseVariableVector NonlinearObjectiveFunction::calculateGradientWithoutNonlinearExpression(const VectorDouble& point)
+{
+    SparseVariableVector gradient = QuadraticObjectiveFunction::calculateGradient(point, false);
 
-    auto result = Utilities::combineSparseVariableVectors(gradient, monomialGradient, signomialGradient);
+    if(this->properties.hasMonomialTerms)
+        gradient.add(monomialTerms.calculateGradient(point));
 
-    if(eraseZeroes)
-        Utilities::erase_if<VariablePtr, double>(gradient, 0.0);
+    if(this->properties.hasSignomialTerms)
+        gradient.add(signomialTerms.calculateGradient(point));
 
-    return result;
+    return gradient;
 }
 
 void NonlinearObjectiveFunction::initializeGradientSparsityPattern()
@@ -980,17 +964,7 @@ void NonlinearObjectiveFunction::initializeGradientSparsityPattern()
 
 SparseVariableMatrix NonlinearObjectiveFunction::calculateHessian(const VectorDouble& point, bool eraseZeroes = true)
 {
-    SparseVariableMatrix hessian = QuadraticObjectiveFunction::calculateHessian(point, eraseZeroes);
-
-    if(properties.hasMonomialTerms)
-    {
-        hessian = Utilities::combineSparseVariableMatrices(monomialTerms.calculateHessian(point), hessian);
-    }
-
-    if(properties.hasSignomialTerms)
-    {
-        hessian = Utilities::combineSparseVariableMatrices(signomialTerms.calculateHessian(point), hessian);
-    }
+    SparseVariableMatrix hessian = calculateHessianWithoutNonlinearExpression(point);
 
     if(this->properties.hasNonlinearExpression)
     {
@@ -1028,13 +1002,7 @@ SparseVariableMatrix NonlinearObjectiveFunction::calculateHessian(const VectorDo
                     // Only save elements above the diagonal since the Hessian is symmetric
                     if(V1->index <= V2->index)
                     {
-                        auto element = hessian.emplace(std::make_pair(V1, V2), hessianValue);
-
-                        if(!element.second)
-                        {
-                            // Element already exists for the variable
-                            element.first->second += hessianValue;
-                        }
+                        hessian.add(std::make_pair(V1, V2), hessianValue);
                     }
                 }
             }
@@ -1044,6 +1012,23 @@ SparseVariableMatrix NonlinearObjectiveFunction::calculateHessian(const VectorDo
     return hessian;
 }
 
+SparseVariableMatrix NonlinearObjectiveFunction::calculateHessianWithoutNonlinearExpression(const VectorDouble& point)
+{
+    SparseVariableMatrix hessian = QuadraticObjectiveFunction::calculateHessian(point, false);
+
+    if(properties.hasMonomialTerms)
+    {
+        hessian.add(monomialTerms.calculateHessian(point));
+    }
+
+    if(properties.hasSignomialTerms)
+    {
+        hessian.add(signomialTerms.calculateHessian(point));
+    }
+
+    return hessian;
+}
+
 void NonlinearObjectiveFunction::initializeHessianSparsityPattern()
 {
     QuadraticObjectiveFunction::initializeHessianSparsityPattern();
@@ -14,6 +14,8 @@
 #include "Variables.h"
 #include "Terms.h"
 #include "NonlinearExpressions.h"
+#include "ExpressionTape.h"
+#include "QuadraticMatrix.h"
 
 #include <vector>
 
@@ -232,6 +234,9 @@ public:
 
     QuadraticTerms quadraticTerms;
 
+    // Compiled form of quadraticTerms used when calculating values, gradients and Hessians
+    QuadraticMatrix quadraticMatrix;
+
     void add(LinearTerms terms) { LinearObjectiveFunction::add(terms); }
 
     void add(LinearTermPtr term) { LinearObjectiveFunction::add(term); }
@@ -239,6 +244,8 @@ public:
     void add(QuadraticTerms terms);
     void add(QuadraticTermPtr term);
 
+    void updateQuadraticMatrix();
+
     void updateProperties() override;
 
     virtual bool isDualUnbounded() override;
@@ -344,6 +351,9 @@ public:
     NonlinearExpressionPtr nonlinearExpression;
     FactorableFunctionPtr factorableFunction;
 
+    // Compiled form of nonlinearExpression used when calculating function values
+    ExpressionTape nonlinearExpressionTape;
+
     CppAD::sparse_rc<std::vector<size_t>> nonlinearGradientSparsityPattern;
     CppAD::sparse_rc<std::vector<size_t>> nonlinearHessianSparsityPattern;
 
@@ -373,6 +383,7 @@ public:
     void add(NonlinearExpressionPtr expression);
 
     void updateFactorableFunction();
+    void updateExpressionTape();
 
     void updateProperties() override;
 
@@ -384,6 +395,11 @@ public:
     SparseVariableVector calculateGradient(const VectorDouble& point, bool eraseZeroes) override;
     SparseVariableMatrix calculateHessian(const VectorDouble& point, bool eraseZeroes) override;
 
+    // As calculateGradient and calculateHessian but without the nonlinear expression, which can then be differentiated
+    // together with the expressions in the constraints on the problem-wide tape. Zeroes are not erased.
+    SparseVariableVector calculateGradientWithoutNonlinearExpression(const VectorDouble& point);
+    SparseVariableMatrix calculateHessianWithoutNonlinearExpression(const VectorDouble& point);
+
     std::ostream& print(std::ostream& stream) const override;
 
 protected:
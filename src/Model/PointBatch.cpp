@@ -0,0 +1,167 @@
+/**
+   The Supporting Hyperplane Optimization Toolkit (SHOT).
+
+   @author Andreas Lundell, Åbo Akademi University
+
+   @section LICENSE
+   This software is licensed under the Eclipse Public License 2.0.
+   Please see the README and LICENSE files for more information.
+*/
+
+#include "PointBatch.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace SHOT
+{
+
+PointBatch::PointBatch(const std::vector<VectorDouble>& points) : points(&points)
+{
+    numberOfPoints = points.size();
+    numberOfVariables = (numberOfPoints > 0) ? points[0].size() : 0;
+
+    variableValues.resize(numberOfVariables * numberOfPoints);
+
+    for(size_t p = 0; p < numberOfPoints; p++)
+    {
+        const double* point = points[p].data();
+
+        for(size_t i = 0; i < numberOfVariables; i++)
+            variableValues[i * numberOfPoints + p] = point[i];
+    }
+}
+
+PointBatch::PointBatch(const std::vector<VectorDouble>& points, const std::vector<int>& variableIndexes)
+{
+    update(points, variableIndexes);
+}
+
+void PointBatch::update(const std::vector<VectorDouble>& points, const std::vector<int>& variableIndexes)
+{
+    this->points = &points;
+
+    numberOfPoints = points.size();
+    numberOfVariables = (numberOfPoints > 0) ? points[0].size() : 0;
+
+    // Only grows the storage, so that the values are not cleared
+    if(variableValues.size() < numberOfVariables * numberOfPoints)
+        variableValues.resize(numberOfVariables * numberOfPoints);
+
+    for(size_t p = 0; p < numberOfPoints; p++)
+    {
+        const double* point = points[p].data();
+
+        for(auto i : variableIndexes)
+            variableValues[i * numberOfPoints + p] = point[i];
+    }
+}
+
+void PointBatch::addValues(const LinearTerms& terms, VectorDouble& values) const
+{
+    VectorDouble sums(numberOfPoints, 0.0);
+    double* sum = sums.data();
+
+    for(auto& T : terms)
+    {
+        const double coefficient = T->coefficient;
+        const double* x = getVariableValues(T->variable->index);
+
+        for(size_t p = 0; p < numberOfPoints; p++)
+            sum[p] += coefficient * x[p];
+    }
+
+    for(size_t p = 0; p < numberOfPoints; p++)
+        values[p] += sum[p];
+}
+
+void PointBatch::addValues(const QuadraticTerms& terms, VectorDouble& values) const
+{
+    VectorDouble sums(numberOfPoints, 0.0);
+    double* sum = sums.data();
+
+    for(auto& T : terms)
+    {
+        const double coefficient = T->coefficient;
+        const double* x1 = getVariableValues(T->firstVariable->index);
+        const double* x2 = getVariableValues(T->secondVariable->index);
+
+        for(size_t p = 0; p < numberOfPoints; p++)
+            sum[p] += coefficient * x1[p] * x2[p];
+    }
+
+    for(size_t p = 0; p < numberOfPoints; p++)
+        values[p] += sum[p];
+}
+
+void PointBatch::addValues(const MonomialTerms& terms, VectorDouble& values) const
+{
+    VectorDouble sums(numberOfPoints, 0.0);
+    VectorDouble termValues(numberOfPoints);
+    double* sum = sums.data();
+    double* termValue = termValues.data();
+
+    for(auto& T : terms)
+    {
+        std::fill(termValues.begin(), termValues.end(), T->coefficient);
+
+        for(auto& V : T->variables)
+        {
+            const double* x = getVariableValues(V->index);
+
+            for(size_t p = 0; p < numberOfPoints; p++)
+                termValue[p] *= x[p];
+        }
+
+        for(size_t p = 0; p < numberOfPoints; p++)
+            sum[p] += termValue[p];
+    }
+
+    for(size_t p = 0; p < numberOfPoints; p++)
+        values[p] += sum[p];
+}
+
+void PointBatch::addValues(const SignomialTerms& terms, VectorDouble& values) const
+{
+    VectorDouble sums(numberOfPoints, 0.0);
+    VectorDouble termValues(numberOfPoints);
+    double* sum = sums.data();
+    double* termValue = termValues.data();
+
+    for(auto& T : terms)
+    {
+        std::fill(termValues.begin(), termValues.end(), T->coefficient);
+
+        for(auto& E : T->elements)
+        {
+            const double power = E->power;
+            const double* x = getVariableValues(E->variable->index);
+
+            for(size_t p = 0; p < numberOfPoints; p++)
+                termValue[p] *= pow(x[p], power);
+        }
+
+        for(size_t p = 0; p < numberOfPoints; p++)
+            sum[p] += termValue[p];
+    }
+
+    for(size_t p = 0; p < numberOfPoints; p++)
+        values[p] += sum[p];
+}
+
+void PointBatch::addValues(const ExpressionTape& tape, VectorDouble& values) const
+{
+    if(!tape.isCompiled())
+        return;
+
+    // The nodes of a tape depend on each other, so here the points are evaluated one at a time
+    VectorDouble nodeValues(tape.size());
+
+    for(size_t p = 0; p < numberOfPoints; p++)
+    {
+        tape.calculate((*points)[p], nodeValues);
+        values[p] += nodeValues[tape.size() - 1];
+    }
+}
+
+} // namespace SHOT
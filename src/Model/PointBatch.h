@@ -0,0 +1,68 @@
+/**
+   The Supporting Hyperplane Optimization Toolkit (SHOT).
+
+   @author Andreas Lundell, Åbo Akademi University
+
+   @section LICENSE
+   This software is licensed under the Eclipse Public License 2.0.
+   Please see the README and LICENSE files for more information.
+*/
+
+#pragma once
+
+#include "../Structs.h"
+#include "Terms.h"
+#include "ExpressionTape.h"
+
+#include <vector>
+
+namespace SHOT
+{
+
+// A set of points stored in a structure-of-arrays layout, i.e. the values of a variable in all points are stored
+// contiguously. This allows the terms of a constraint to be evaluated in all points with tight loops that the compiler
+// can vectorize. The original points are referenced (not copied) since nonlinear expressions are evaluated pointwise,
+// so they must outlive the batch.
+class PointBatch
+{
+public:
+    PointBatch() = default;
+    PointBatch(const std::vector<VectorDouble>& points);
+
+    // Only the values of the given variables are stored, e.g. when the batch is only used to evaluate constraints in
+    // which these are the only variables
+    PointBatch(const std::vector<VectorDouble>& points, const std::vector<int>& variableIndexes);
+
+    // Replaces the points in the batch, where only the values of the given variables are stored as above. The storage
+    // is reused, so a batch updated in each iteration of a loop is only allocated once, and the values of the other
+    // variables are left from earlier points.
+    void update(const std::vector<VectorDouble>& points, const std::vector<int>& variableIndexes);
+
+    inline size_t size() const { return (numberOfPoints); };
+
+    inline const VectorDouble& getPoint(size_t pointIndex) const { return ((*points)[pointIndex]); };
+
+    // Returns the values of the variable in all points
+    inline const double* getVariableValues(int variableIndex) const
+    {
+        return (variableValues.data() + variableIndex * numberOfPoints);
+    };
+
+    // The following add the value of the terms (or expression) in each point to the corresponding element in values,
+    // the sums are formed in the same order as in the pointwise calculate methods so that the results are identical
+    void addValues(const LinearTerms& terms, VectorDouble& values) const;
+    void addValues(const QuadraticTerms& terms, VectorDouble& values) const;
+    void addValues(const MonomialTerms& terms, VectorDouble& values) const;
+    void addValues(const SignomialTerms& terms, VectorDouble& values) const;
+    void addValues(const ExpressionTape& tape, VectorDouble& values) const;
+
+private:
+    const std::vector<VectorDouble>* points = nullptr;
+
+    size_t numberOfPoints = 0;
+    size_t numberOfVariables = 0;
+
+    VectorDouble variableValues;
+};
+
+} // namespace SHOT
@@ -14,10 +14,15 @@
 #include "../Settings.h"
 #include "../Timing.h"
 #include "../Utilities.h"
+#include "../ThreadPool.h"
 #include "../Model/Simplifications.h"
 
 #include "../Tasks/TaskReformulateProblem.h"
 
+#include <functional>
+#include <numeric>
+#include <unordered_map>
+
 namespace SHOT
 {
 
@@ -784,6 +789,7 @@ void Problem::updateFactorableFunctions()
         nonlinearVariableCounter++;
     }
 
+    startFactorableFunctionRecording();
     CppAD::Independent(factorableFunctionVariables);
 
     int nonlinearExpressionCounter = 0;
@@ -812,13 +818,155 @@ void Problem::updateFactorableFunctions()
         objective->nonlinearExpressionIndex = nonlinearExpressionCounter;
     }
 
+    bool optimizeTapes = env->settings->getSetting<bool>("AutomaticDifferentiation.OptimizeTape", "Model");
+
     if(factorableFunctions.size() > 0)
     {
         ADFunctions.Dependent(factorableFunctionVariables, factorableFunctions);
-        // ADFunctions.optimize();
+
+        if(optimizeTapes)
+            ADFunctions.optimize();
     }
 
     CppAD::AD<double>::abort_recording();
+    stopFactorableFunctionRecording();
+
+    // The problem-wide tape is still needed for the objective function
+    if(env->settings->getSetting<bool>("AutomaticDifferentiation.PerConstraintTapes", "Model"))
+    {
+        for(auto& C : constraintsWithNonlinearExpressions)
+            C->updateADFunction(optimizeTapes);
+    }
+}
+
+void Problem::updateExpressionTapes()
+{
+    for(auto& C : nonlinearConstraints)
+    {
+        if(C->properties.hasNonlinearExpression)
+            C->updateExpressionTape();
+    }
+
+    if(auto objective = std::dynamic_pointer_cast<NonlinearObjectiveFunction>(objectiveFunction);
+        objective && objective->properties.hasNonlinearExpression)
+        objective->updateExpressionTape();
+
+    for(auto& V : auxiliaryVariables)
+    {
+        if(V->nonlinearExpression)
+            V->nonlinearExpressionTape.compile(V->nonlinearExpression);
+    }
+
+    if(auxiliaryObjectiveVariable && auxiliaryObjectiveVariable->nonlinearExpression)
+        auxiliaryObjectiveVariable->nonlinearExpressionTape.compile(auxiliaryObjectiveVariable->nonlinearExpression);
+}
+
+void Problem::updateQuadraticMatrices()
+{
+    for(auto& C : quadraticConstraints)
+        C->updateQuadraticMatrix();
+
+    for(auto& C : nonlinearConstraints)
+        C->updateQuadraticMatrix();
+
+    if(auto objective = std::dynamic_pointer_cast<QuadraticObjectiveFunction>(objectiveFunction))
+        objective->updateQuadraticMatrix();
+}
+
+void Problem::shareCommonSubexpressions()
+{
+    // The nonlinear expressions are traversed bottom-up, and each node is replaced by the first equal node found. When
+    // the children of two nodes have already been replaced, the nodes are equal if they are of the same type and have
+    // the same children, which is what operator== compares, so the nodes can be looked up by a hash of these.
+    std::unordered_map<NonlinearExpression*, NonlinearExpressionPtr> visitedNodes;
+    std::unordered_map<size_t, std::vector<NonlinearExpressionPtr>> uniqueNodes;
+
+    auto combineHash = [](size_t& hash, size_t value) { hash ^= value + 0x9e3779b9 + (hash << 6) + (hash >> 2); };
+
+    std::function<NonlinearExpressionPtr(const NonlinearExpressionPtr&)> share
+        = [&](const NonlinearExpressionPtr& expression) -> NonlinearExpressionPtr
+    {
+        if(auto node = visitedNodes.find(expression.get()); node != visitedNodes.end())
+            return (node->second);
+
+        size_t hash = std::hash<int>()((int)expression->getType());
+
+        if(auto constant = std::dynamic_pointer_cast<ExpressionConstant>(expression))
+        {
+            combineHash(hash, std::hash<double>()(constant->constant));
+        }
+        else if(auto variable = std::dynamic_pointer_cast<ExpressionVariable>(expression))
+        {
+            combineHash(hash, std::hash<Variable*>()(variable->variable.get()));
+        }
+        else if(auto unary = std::dynamic_pointer_cast<ExpressionUnary>(expression))
+        {
+            unary->child = share(unary->child);
+            combineHash(hash, std::hash<NonlinearExpression*>()(unary->child.get()));
+        }
+        else if(auto binary = std::dynamic_pointer_cast<ExpressionBinary>(expression))
+        {
+            binary->firstChild = share(binary->firstChild);
+            binary->secondChild = share(binary->secondChild);
+            combineHash(hash, std::hash<NonlinearExpression*>()(binary->firstChild.get()));
+            combineHash(hash, std::hash<NonlinearExpression*>()(binary->secondChild.get()));
+        }
+        else if(auto general = std::dynamic_pointer_cast<ExpressionGeneral>(expression))
+        {
+            for(auto& C : general->children)
+            {
+                C = share(C);
+                combineHash(hash, std::hash<NonlinearExpression*>()(C.get()));
+            }
+        }
+
+        properties.numberOfNonlinearExpressionNodes++;
+
+        auto& candidates = uniqueNodes[hash];
+
+        for(auto& C : candidates)
+        {
+            if(*C == *expression)
+            {
+                visitedNodes.emplace(expression.get(), C);
+                properties.numberOfSharedNonlinearExpressionNodes++;
+                return (C);
+            }
+        }
+
+        candidates.push_back(expression);
+        visitedNodes.emplace(expression.get(), expression);
+
+        return (expression);
+    };
+
+    properties.numberOfNonlinearExpressionNodes = 0;
+    properties.numberOfSharedNonlinearExpressionNodes = 0;
+
+    for(auto& C : nonlinearConstraints)
+    {
+        if(C->nonlinearExpression)
+            C->nonlinearExpression = share(C->nonlinearExpression);
+    }
+
+    if(auto objective = std::dynamic_pointer_cast<NonlinearObjectiveFunction>(objectiveFunction);
+        objective && objective->nonlinearExpression)
+        objective->nonlinearExpression = share(objective->nonlinearExpression);
+
+    for(auto& V : auxiliaryVariables)
+    {
+        if(V->nonlinearExpression)
+            V->nonlinearExpression = share(V->nonlinearExpression);
+    }
+
+    if(auxiliaryObjectiveVariable && auxiliaryObjectiveVariable->nonlinearExpression)
+        auxiliaryObjectiveVariable->nonlinearExpression = share(auxiliaryObjectiveVariable->nonlinearExpression);
+
+    if(properties.numberOfSharedNonlinearExpressionNodes > 0)
+    {
+        env->output->outputDebug(fmt::format(" Shared {} of {} nodes in the nonlinear expressions.",
+            properties.numberOfSharedNonlinearExpressionNodes, properties.numberOfNonlinearExpressionNodes));
+    }
 }
 
 Problem::Problem(EnvironmentPtr env) : env(env) { }
@@ -850,8 +998,13 @@ Problem::~Problem()
 
 void Problem::finalize()
 {
+    // The nonlinear expressions of greater-than constraints are negated in place when the constraints are standardized,
+    // so the subexpressions can only be shared afterwards
     updateProperties();
+    shareCommonSubexpressions();
     updateFactorableFunctions();
+    updateExpressionTapes();
+    updateQuadraticMatrices();
     assert(verifyOwnership());
 
     if(env->settings->getSetting<bool>("Debug.Enable", "Output"))
@@ -1568,6 +1721,77 @@ NumericConstraintValue Problem::getMaxNumericConstraintValue(const VectorDouble&
     return value;
 }
 
+MaxNumericConstraintValues Problem::getMaxNumericConstraintValues(
+    const VectorDouble& point, bool includeLinearConstraints, ThreadPool* threadPool, int maxNumberOfThreads)
+{
+    const size_t chunkSize = 256;
+
+    struct Chunk
+    {
+        std::optional<NumericConstraintValue>* maxValue; // The class of the constraints in the chunk
+        size_t first;
+        size_t last;
+        std::optional<NumericConstraintValue> value;
+    };
+
+    MaxNumericConstraintValues maxValues;
+    std::vector<Chunk> chunks;
+
+    auto addChunks = [&](std::optional<NumericConstraintValue>& maxValue, size_t numberOfConstraints)
+    {
+        for(size_t first = 0; first < numberOfConstraints; first += chunkSize)
+            chunks.push_back(Chunk { &maxValue, first, std::min(first + chunkSize, numberOfConstraints), {} });
+    };
+
+    if(includeLinearConstraints)
+        addChunks(maxValues.linear, linearConstraints.size());
+
+    addChunks(maxValues.quadratic, quadraticConstraints.size());
+    addChunks(maxValues.nonlinear, nonlinearConstraints.size());
+
+    auto evaluateChunk = [&](const auto& constraints, Chunk& chunk)
+    {
+        for(size_t i = chunk.first; i < chunk.last; i++)
+        {
+            auto value = constraints[i]->calculateNumericValue(point);
+
+            if(!chunk.value || value.normalizedValue > chunk.value->normalizedValue)
+                chunk.value = value;
+        }
+    };
+
+    auto evaluate = [&](size_t chunkIndex)
+    {
+        auto& chunk = chunks[chunkIndex];
+
+        if(chunk.maxValue == &maxValues.linear)
+            evaluateChunk(linearConstraints, chunk);
+        else if(chunk.maxValue == &maxValues.quadratic)
+            evaluateChunk(quadraticConstraints, chunk);
+        else
+            evaluateChunk(nonlinearConstraints, chunk);
+    };
+
+    if(threadPool != nullptr && threadPool->getNumberOfThreads() > 1 && chunks.size() > 1)
+    {
+        threadPool->run(chunks.size(), evaluate, maxNumberOfThreads);
+    }
+    else
+    {
+        for(size_t i = 0; i < chunks.size(); i++)
+            evaluate(i);
+    }
+
+    // The chunks are combined in order, so that ties are resolved as when evaluating the constraints one by one
+    for(auto& C : chunks)
+    {
+        if(C.value && (!*C.maxValue || C.value->normalizedValue > (*C.maxValue)->normalizedValue))
+            *C.maxValue = C.value;
+    }
+
+    return (maxValues);
+}
+
 template <typename T>
 NumericConstraintValues Problem::getAllDeviatingConstraints(
     const VectorDouble& point, double tolerance, std::vector<T> constraintSelection, double correction)
@@ -1606,6 +1830,55 @@ NumericConstraintValues Problem::getFractionOfDeviatingNonlinearConstraints(
     return values;
 }
 
+template <typename T>
+std::vector<NumericConstraintValues> Problem::calculateNumericConstraintValues(
+    const PointBatch& points, std::vector<T> constraintSelection)
+{
+    std::vector<NumericConstraintValues> constraintValues(points.size());
+
+    for(auto& CV : constraintValues)
+        CV.reserve(constraintSelection.size());
+
+    VectorDouble functionValues;
+
+    for(auto& C : constraintSelection)
+    {
+        C->calculateFunctionValues(points, functionValues);
+
+        for(size_t p = 0; p < points.size(); p++)
+            constraintValues[p].push_back(C->getNumericValue(functionValues[p]));
+    }
+
+    return constraintValues;
+}
+
+std::vector<NumericConstraintValues> Problem::getFractionOfDeviatingNonlinearConstraints(
+    const std::vector<VectorDouble>& points, double tolerance, double fraction)
+{
+    if(fraction > 1)
+        fraction = 1;
+    else if(fraction < 0)
+        fraction = 0;
+
+    int fractionNumbers = std::max(1, (int)ceil(fraction * this->nonlinearConstraints.size()));
+
+    auto constraintValues = calculateNumericConstraintValues(PointBatch(points), this->nonlinearConstraints);
+
+    for(auto& values : constraintValues)
+    {
+        values.erase(std::remove_if(values.begin(), values.end(),
+                         [&](const NumericConstraintValue& CV) { return (!(CV.normalizedValue > tolerance)); }),
+            values.end());
+
+        std::sort(values.begin(), values.end(), std::greater<NumericConstraintValue>());
+
+        if((int)values.size() > fractionNumbers)
+            values.resize(fractionNumbers);
+    }
+
+    return constraintValues;
+}
+
 NumericConstraintValues Problem::getAllDeviatingNumericConstraints(const VectorDouble& point, double tolerance)
 {
     return getAllDeviatingConstraints(point, tolerance, numericConstraints);
@@ -1742,94 +2015,192 @@ void Problem::saveProblemToFile(std::string filename)
     }
 }
 
-void Problem::doFBBT()
+void Problem::updateFBBTAdjacency(bool useNonlinearConstraints)
 {
-    env->timing->startTimer("BoundTightening");
+    size_t numberOfConstraints = linearConstraints.size() + quadraticConstraints.size()
+        + (useNonlinearConstraints ? nonlinearConstraints.size() : 0);
 
-    double startTime = env->timing->getElapsedTime("BoundTightening");
+    // Constraints are only added to the problem, e.g. from the initial POA, so it is enough to compare the sizes
+    if(FBBTConstraints.size() == numberOfConstraints && FBBTVariableConstraints.size() == allVariables.size())
+        return;
 
-    if(properties.isReformulated)
-    {
-        env->timing->startTimer("BoundTighteningFBBTReformulated");
-        env->output->outputInfo("");
-        env->output->outputInfo(" Performing bound tightening on reformulated problem.");
-    }
-    else
+    FBBTConstraints = NumericConstraints(linearConstraints.begin(), linearConstraints.end());
+    FBBTConstraints.insert(FBBTConstraints.end(), quadraticConstraints.begin(), quadraticConstraints.end());
+
+    if(useNonlinearConstraints)
+        FBBTConstraints.insert(FBBTConstraints.end(), nonlinearConstraints.begin(), nonlinearConstraints.end());
+
+    FBBTConstraintVariables.assign(FBBTConstraints.size(), {});
+    FBBTVariableConstraints.assign(allVariables.size(), {});
+
+    for(size_t j = 0; j < FBBTConstraints.size(); j++)
     {
-        env->timing->startTimer("BoundTighteningFBBTOriginal");
-        env->output->outputInfo("");
-        env->output->outputInfo(" Performing bound tightening on original problem.");
+        auto& C = FBBTConstraints[j];
+        auto& variableIndices = FBBTConstraintVariables[j];
+
+        if(C->properties.hasLinearTerms)
+        {
+            for(auto& T : std::dynamic_pointer_cast<LinearConstraint>(C)->linearTerms)
+                variableIndices.push_back(T->variable->index);
+        }
+
+        if(C->properties.hasQuadraticTerms)
+        {
+            for(auto& T : std::dynamic_pointer_cast<QuadraticConstraint>(C)->quadraticTerms)
+            {
+                variableIndices.push_back(T->firstVariable->index);
+                variableIndices.push_back(T->secondVariable->index);
+            }
+        }
+
+        if(auto nonlinearConstraint = std::dynamic_pointer_cast<NonlinearConstraint>(C))
+        {
+            for(auto& T : nonlinearConstraint->monomialTerms)
+            {
+                for(auto& V : T->variables)
+                    variableIndices.push_back(V->index);
+            }
+
+            for(auto& T : nonlinearConstraint->signomialTerms)
+            {
+                for(auto& E : T->elements)
+                    variableIndices.push_back(E->variable->index);
+            }
+
+            for(auto& V : nonlinearConstraint->variablesInNonlinearExpression)
+                variableIndices.push_back(V->index);
+        }
+
+        std::sort(variableIndices.begin(), variableIndices.end());
+        variableIndices.erase(std::unique(variableIndices.begin(), variableIndices.end()), variableIndices.end());
+
+        for(auto k : variableIndices)
+            FBBTVariableConstraints[k].push_back(j);
     }
+}
 
-    int numberOfIterations = env->settings->getSetting<int>("BoundTightening.FeasibilityBased.MaxIterations", "Model");
-    double timeLimit = env->settings->getSetting<double>("BoundTightening.FeasibilityBased.TimeLimit", "Model");
-    bool useNonlinearBoundTightening
-        = env->settings->getSetting<bool>("BoundTightening.FeasibilityBased.UseNonlinear", "Model");
+int Problem::propagateBounds(
+    std::vector<int> currentPass, int maxPasses, double timeLimit, std::vector<int>& tightenedVariables)
+{
+    auto timer = env->timing->getTimerID("BoundTightening");
 
-    bool stopTightening = false;
+    // The variable bounds when the constraints were last scheduled, used for detecting which variables have been
+    // tightened by a constraint
+    VectorDouble lowerBounds(allVariables.size());
+    VectorDouble upperBounds(allVariables.size());
 
-    double timeEnd = startTime + timeLimit;
+    for(auto& V : allVariables)
+    {
+        lowerBounds[V->index] = V->lowerBound;
+        upperBounds[V->index] = V->upperBound;
+    }
 
-    int numberOfTightenedVariablesBefore = std::count_if(allVariables.begin(), allVariables.end(),
-        [](auto V) { return (V->properties.hasLowerBoundBeenTightened || V->properties.hasUpperBoundBeenTightened); });
+    std::vector<int> nextPass;
+    std::vector<bool> isInNextPass(FBBTConstraints.size(), false);
+    std::vector<bool> isTightened(allVariables.size(), false);
 
     int i = 0;
 
-    for(i = 0; i < numberOfIterations; i++)
+    for(i = 0; i < maxPasses; i++)
     {
-        bool boundsUpdated = false;
+        env->output->outputDebug(fmt::format(
+            "  Bound tightening pass {} of {} with {} constraints.", i + 1, maxPasses, currentPass.size()));
 
-        env->output->outputDebug(fmt::format("  Bound tightening pass {} of {}.", i + 1, numberOfIterations));
+        bool stopTightening = false;
 
-        for(auto& C : linearConstraints)
+        for(auto j : currentPass)
         {
-            if(env->timing->getElapsedTime("BoundTightening") > timeEnd)
+            if(env->timing->getElapsedTime(timer) > timeLimit)
             {
                 stopTightening = true;
                 break;
             }
 
-            boundsUpdated
-                = doFBBTOnConstraint(C, timeEnd - env->timing->getElapsedTime("BoundTightening")) || boundsUpdated;
-        }
+            if(!doFBBTOnConstraint(FBBTConstraints[j], timeLimit))
+                continue;
 
-        if(stopTightening)
-            break;
-
-        for(auto& C : quadraticConstraints)
-        {
-            if(env->timing->getElapsedTime("BoundTightening") > timeEnd)
+            for(auto k : FBBTConstraintVariables[j])
             {
-                stopTightening = true;
-                break;
-            }
+                auto& V = allVariables[k];
 
-            boundsUpdated
-                = doFBBTOnConstraint(C, timeEnd - env->timing->getElapsedTime("BoundTightening")) || boundsUpdated;
-        }
+                if(V->lowerBound == lowerBounds[k] && V->upperBound == upperBounds[k])
+                    continue;
 
-        if(stopTightening)
-            break;
+                lowerBounds[k] = V->lowerBound;
+                upperBounds[k] = V->upperBound;
 
-        if(useNonlinearBoundTightening)
-        {
-            for(auto& C : nonlinearConstraints)
-            {
-                if(env->timing->getElapsedTime("BoundTightening") > timeEnd)
+                if(!isTightened[k])
                 {
-                    stopTightening = true;
-                    break;
+                    isTightened[k] = true;
+                    tightenedVariables.push_back(k);
                 }
 
-                boundsUpdated
-                    = doFBBTOnConstraint(C, timeEnd - env->timing->getElapsedTime("BoundTightening")) || boundsUpdated;
+                for(auto c : FBBTVariableConstraints[k])
+                {
+                    if(!isInNextPass[c])
+                    {
+                        isInNextPass[c] = true;
+                        nextPass.push_back(c);
+                    }
+                }
             }
         }
 
-        if(stopTightening || !boundsUpdated)
+        if(stopTightening || nextPass.empty())
             break;
+
+        std::sort(nextPass.begin(), nextPass.end());
+        currentPass.swap(nextPass);
+        nextPass.clear();
+
+        for(auto j : currentPass)
+            isInNextPass[j] = false;
     }
 
+    return (std::min(i + 1, maxPasses));
+}
+
+void Problem::doFBBT()
+{
+    auto timer = env->timing->getTimerID("BoundTightening");
+
+    env->timing->startTimer(timer);
+
+    double startTime = env->timing->getElapsedTime(timer);
+
+    if(properties.isReformulated)
+    {
+        env->timing->startTimer("BoundTighteningFBBTReformulated");
+        env->output->outputInfo("");
+        env->output->outputInfo(" Performing bound tightening on reformulated problem.");
+    }
+    else
+    {
+        env->timing->startTimer("BoundTighteningFBBTOriginal");
+        env->output->outputInfo("");
+        env->output->outputInfo(" Performing bound tightening on original problem.");
+    }
+
+    int numberOfIterations = env->settings->getSetting<int>("BoundTightening.FeasibilityBased.MaxIterations", "Model");
+    double timeLimit = env->settings->getSetting<double>("BoundTightening.FeasibilityBased.TimeLimit", "Model");
+    bool useNonlinearBoundTightening
+        = env->settings->getSetting<bool>("BoundTightening.FeasibilityBased.UseNonlinear", "Model");
+
+    double timeEnd = startTime + timeLimit;
+
+    int numberOfTightenedVariablesBefore = std::count_if(allVariables.begin(), allVariables.end(),
+        [](auto V) { return (V->properties.hasLowerBoundBeenTightened || V->properties.hasUpperBoundBeenTightened); });
+
+    updateFBBTAdjacency(useNonlinearBoundTightening);
+
+    // All constraints are considered in the first pass, and after that only the ones with a variable whose bound was
+    // tightened in the previous pass. The constraints are always considered in the same order as in a full pass.
+    std::vector<int> currentPass(FBBTConstraints.size());
+    std::iota(currentPass.begin(), currentPass.end(), 0);
+
+    std::vector<int> tightenedVariables;
+    int numberOfPasses = propagateBounds(currentPass, numberOfIterations, timeEnd, tightenedVariables);
+
     int numberOfTightenedVariablesAfter = std::count_if(allVariables.begin(), allVariables.end(),
         [](auto V) { return (V->properties.hasLowerBoundBeenTightened || V->properties.hasUpperBoundBeenTightened); });
 
@@ -1838,23 +2209,78 @@ void Problem::doFBBT()
         env->timing->stopTimer("BoundTighteningFBBTReformulated");
         env->output->outputInfo(fmt::format("  - Bounds for {} variables tightened in {:.2f} s and {} passes.",
             numberOfTightenedVariablesAfter - numberOfTightenedVariablesBefore,
-            env->timing->getElapsedTime("BoundTighteningFBBTReformulated"), i + 1));
+            env->timing->getElapsedTime("BoundTighteningFBBTReformulated"), numberOfPasses));
     }
     else
     {
         env->timing->stopTimer("BoundTighteningFBBTOriginal");
         env->output->outputInfo(fmt::format("  - Bounds for {} variables tightened in {:.2f} s and {} passes.",
             numberOfTightenedVariablesAfter - numberOfTightenedVariablesBefore,
-            env->timing->getElapsedTime("BoundTighteningFBBTOriginal"), i + 1));
+            env->timing->getElapsedTime("BoundTighteningFBBTOriginal"), numberOfPasses));
     }
 
-    env->timing->stopTimer("BoundTightening");
+    env->timing->stopTimer(timer);
+}
+
+std::vector<int> Problem::doIncrementalFBBT(const std::vector<int>& variableIndexes)
+{
+    std::vector<int> tightenedVariables;
+
+    if(variableIndexes.empty())
+        return (tightenedVariables);
+
+    auto timer = env->timing->getTimerID("BoundTightening");
+
+    env->timing->startTimer(timer);
+
+    int numberOfIterations = env->settings->getSetting<int>("BoundTightening.FeasibilityBased.MaxIterations", "Model");
+    double timeLimit = env->settings->getSetting<double>("BoundTightening.FeasibilityBased.TimeLimit", "Model");
+    bool useNonlinearBoundTightening
+        = env->settings->getSetting<bool>("BoundTightening.FeasibilityBased.UseNonlinear", "Model");
+
+    double timeEnd = env->timing->getElapsedTime(timer) + timeLimit;
+
+    updateFBBTAdjacency(useNonlinearBoundTightening);
+
+    // Only the constraints with a variable whose bound has been tightened are considered in the first pass
+    std::vector<int> currentPass;
+
+    for(auto k : variableIndexes)
+    {
+        if(k >= 0 && k < (int)FBBTVariableConstraints.size())
+            currentPass.insert(currentPass.end(), FBBTVariableConstraints[k].begin(), FBBTVariableConstraints[k].end());
+    }
+
+    std::sort(currentPass.begin(), currentPass.end());
+    currentPass.erase(std::unique(currentPass.begin(), currentPass.end()), currentPass.end());
+
+    int numberOfPasses = propagateBounds(currentPass, numberOfIterations, timeEnd, tightenedVariables);
+
+    env->timing->stopTimer(timer);
+
+    env->output->outputDebug(fmt::format("        Bounds for {} variables tightened in {} passes of propagation.",
+        tightenedVariables.size(), numberOfPasses));
+
+    return (tightenedVariables);
 }
 
 bool Problem::doFBBTOnConstraint(NumericConstraintPtr constraint, double timeLimit)
 {
     bool boundsUpdated = false;
 
+    auto timer = env->timing->getTimerID("BoundTightening");
+
+    // The bounds are calculated on the tape if possible, since evaluating them recursively is much slower
+    auto getNonlinearExpressionBounds = [&]()
+    {
+        auto nonlinearConstraint = std::dynamic_pointer_cast<NonlinearConstraint>(constraint);
+
+        if(nonlinearConstraint->nonlinearExpressionTape.isCompiled())
+            return (nonlinearConstraint->nonlinearExpressionTape.getBounds(allVariables));
+
+        return (nonlinearConstraint->nonlinearExpression->getBounds());
+    };
+
     try
     {
         if(constraint->properties.hasLinearTerms)
@@ -1874,28 +2300,36 @@ bool Problem::doFBBTOnConstraint(NumericConstraintPtr constraint, double timeLim
                     += std::dynamic_pointer_cast<NonlinearConstraint>(constraint)->signomialTerms.getBounds();
 
             if(constraint->properties.hasNonlinearExpression)
-                otherTermsBound
-                    += std::dynamic_pointer_cast<NonlinearConstraint>(constraint)->nonlinearExpression->getBounds();
+                otherTermsBound += getNonlinearExpressionBounds();
 
-            auto terms = std::dynamic_pointer_cast<LinearConstraint>(constraint)->linearTerms;
+            auto linearConstraint = std::dynamic_pointer_cast<LinearConstraint>(constraint);
+            auto& terms = linearConstraint->linearTerms;
 
-            for(auto& T : terms)
+            // The term bounds are summed once, so that the bound of the other terms can be obtained in constant time
+            // for each term instead of summing them again
+            IntervalSum termsBound;
+            IntervalVector termBounds(terms.size(), Interval(0.0));
+
+            for(size_t j = 0; j < terms.size(); j++)
+            {
+                if(terms[j]->coefficient == 0.0)
+                    continue;
+
+                termBounds[j] = terms[j]->getBounds();
+                termsBound.add(termBounds[j]);
+            }
+
+            for(size_t j = 0; j < terms.size(); j++)
             {
-                if(env->timing->getElapsedTime("BoundTightening") > timeLimit)
+                auto& T = terms[j];
+
+                if(env->timing->getElapsedTime(timer) > timeLimit)
                     break;
 
                 if(Utilities::isAlmostZero(T->coefficient))
                     continue;
 
-                Interval newBound = otherTermsBound;
-
-                for(auto& T2 : terms)
-                {
-                    if(T2 == T)
-                        continue;
-
-                    newBound += T2->getBounds();
-                }
+                Interval newBound = otherTermsBound + termsBound.getSumWithout(termBounds[j]);
 
                 Interval termBound = Interval(constraint->valueLHS, constraint->valueRHS) - newBound;
 
@@ -1906,11 +2340,16 @@ bool Problem::doFBBTOnConstraint(NumericConstraintPtr constraint, double timeLim
                     boundsUpdated = true;
                     env->output->outputDebug(
                         fmt::format("  bound tightened using linear term in constraint {}.", constraint->name));
+
+                    // The following terms use the tightened bound
+                    termsBound.remove(termBounds[j]);
+                    termBounds[j] = T->getBounds();
+                    termsBound.add(termBounds[j]);
                 }
             }
         }
 
-        if(constraint->properties.hasQuadraticTerms && env->timing->getElapsedTime("BoundTightening") < timeLimit)
+        if(constraint->properties.hasQuadraticTerms && env->timing->getElapsedTime(timer) < timeLimit)
         {
             Interval otherTermsBound(constraint->constant);
 
@@ -1926,14 +2365,13 @@ bool Problem::doFBBTOnConstraint(NumericConstraintPtr constraint, double timeLim
                     += std::dynamic_pointer_cast<NonlinearConstraint>(constraint)->signomialTerms.getBounds();
 
             if(constraint->properties.hasNonlinearExpression)
-                otherTermsBound
-                    += std::dynamic_pointer_cast<NonlinearConstraint>(constraint)->nonlinearExpression->getBounds();
+                otherTermsBound += getNonlinearExpressionBounds();
 
             auto terms = std::dynamic_pointer_cast<QuadraticConstraint>(constraint)->quadraticTerms;
 
             for(auto& T : terms)
             {
-                if(env->timing->getElapsedTime("BoundTightening") > timeLimit)
+                if(env->timing->getElapsedTime(timer) > timeLimit)
                     break;
 
                 if(Utilities::isAlmostZero(T->coefficient))
@@ -1989,7 +2427,7 @@ bool Problem::doFBBTOnConstraint(NumericConstraintPtr constraint, double timeLim
             }
         }
 
-        if(constraint->properties.hasMonomialTerms && env->timing->getElapsedTime("BoundTightening") < timeLimit)
+        if(constraint->properties.hasMonomialTerms && env->timing->getElapsedTime(timer) < timeLimit)
         {
             Interval otherTermsBound(constraint->constant);
 
@@ -2005,14 +2443,13 @@ bool Problem::doFBBTOnConstraint(NumericConstraintPtr constraint, double timeLim
                     += std::dynamic_pointer_cast<NonlinearConstraint>(constraint)->signomialTerms.getBounds();
 
             if(constraint->properties.hasNonlinearExpression)
-                otherTermsBound
-                    += std::dynamic_pointer_cast<NonlinearConstraint>(constraint)->nonlinearExpression->getBounds();
+                otherTermsBound += getNonlinearExpressionBounds();
 
             auto terms = std::dynamic_pointer_cast<NonlinearConstraint>(constraint)->monomialTerms;
 
             for(auto& T : terms)
             {
-                if(env->timing->getElapsedTime("BoundTightening") > timeLimit)
+                if(env->timing->getElapsedTime(timer) > timeLimit)
                     break;
 
                 if(Utilities::isAlmostZero(T->coefficient))
@@ -2059,7 +2496,7 @@ bool Problem::doFBBTOnConstraint(NumericConstraintPtr constraint, double timeLim
             }
         }
 
-        if(constraint->properties.hasSignomialTerms && env->timing->getElapsedTime("BoundTightening") < timeLimit)
+        if(constraint->properties.hasSignomialTerms && env->timing->getElapsedTime(timer) < timeLimit)
         {
             Interval otherTermsBound(constraint->constant);
 
@@ -2075,14 +2512,13 @@ bool Problem::doFBBTOnConstraint(NumericConstraintPtr constraint, double timeLim
                     += std::dynamic_pointer_cast<NonlinearConstraint>(constraint)->monomialTerms.getBounds();
 
             if(constraint->properties.hasNonlinearExpression)
-                otherTermsBound
-                    += std::dynamic_pointer_cast<NonlinearConstraint>(constraint)->nonlinearExpression->getBounds();
+                otherTermsBound += getNonlinearExpressionBounds();
 
             auto terms = std::dynamic_pointer_cast<NonlinearConstraint>(constraint)->signomialTerms;
 
             for(auto& T : terms)
             {
-                if(env->timing->getElapsedTime("BoundTightening") > timeLimit)
+                if(env->timing->getElapsedTime(timer) > timeLimit)
                     break;
 
                 if(Utilities::isAlmostZero(T->coefficient))
@@ -2130,7 +2566,7 @@ bool Problem::doFBBTOnConstraint(NumericConstraintPtr constraint, double timeLim
             }
         }
 
-        if(constraint->properties.hasNonlinearExpression && env->timing->getElapsedTime("BoundTightening") < timeLimit)
+        if(constraint->properties.hasNonlinearExpression && env->timing->getElapsedTime(timer) < timeLimit)
         {
             Interval otherTermsBound(constraint->constant);
 
@@ -2151,8 +2587,13 @@ bool Problem::doFBBTOnConstraint(NumericConstraintPtr constraint, double timeLim
 
             Interval candidate = Interval(constraint->valueLHS, constraint->valueRHS) - otherTermsBound;
 
-            if(std::dynamic_pointer_cast<NonlinearConstraint>(constraint)
-                    ->nonlinearExpression->tightenBounds(candidate))
+            auto nonlinearConstraint = std::dynamic_pointer_cast<NonlinearConstraint>(constraint);
+
+            bool tightened = nonlinearConstraint->nonlinearExpressionTape.isCompiled()
+                ? nonlinearConstraint->nonlinearExpressionTape.tightenVariableBounds(candidate, allVariables)
+                : nonlinearConstraint->nonlinearExpression->tightenBounds(candidate);
+
+            if(tightened)
             {
                 env->output->outputDebug(
                     fmt::format("  bound tightened using nonlinear expression in constraint {}.", constraint->name));
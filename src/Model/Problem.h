@@ -28,6 +28,7 @@
 
 namespace SHOT
 {
+class ThreadPool;
 
 struct ProblemProperties
 {
@@ -67,6 +68,8 @@ struct ProblemProperties
     int numberOfConvexNonlinearConstraints = 0;
     int numberOfNonconvexNonlinearConstraints = 0;
     int numberOfNonlinearExpressions = 0; // This includes a possible nonlinear objective
+    int numberOfNonlinearExpressionNodes = 0; // Before common subexpressions are shared
+    int numberOfSharedNonlinearExpressionNodes = 0; // Nodes replaced by an equal node elsewhere in the problem
 
     int numberOfSpecialOrderedSets = 0;
 
@@ -99,6 +102,14 @@ struct SpecialOrderedSet
 using SpecialOrderedSetPtr = std::shared_ptr<SpecialOrderedSet>;
 using SpecialOrderedSets = std::vector<SpecialOrderedSetPtr>;
 
+// The most deviating constraint of each class of numeric constraints, empty if there are no constraints in the class
+struct MaxNumericConstraintValues
+{
+    std::optional<NumericConstraintValue> linear;
+    std::optional<NumericConstraintValue> quadratic;
+    std::optional<NumericConstraintValue> nonlinear;
+};
+
 class DllExport Problem : public std::enable_shared_from_this<Problem>
 {
 private:
@@ -112,11 +123,28 @@ private:
 
     NonlinearConstraints constraintsWithNonlinearExpressions;
 
+    // The constraints used in FBBT, the variables in each of them and the constraints each variable is in
+    NumericConstraints FBBTConstraints;
+    std::vector<std::vector<int>> FBBTConstraintVariables;
+    std::vector<std::vector<int>> FBBTVariableConstraints;
+
+    void updateFBBTAdjacency(bool useNonlinearConstraints);
+
+    // Performs FBBT on the constraints with the given indexes in FBBTConstraints, and then repeatedly on the
+    // constraints with a variable tightened in the previous pass. Returns the number of passes.
+    int propagateBounds(
+        std::vector<int> currentPass, int maxPasses, double timeLimit, std::vector<int>& tightenedVariables);
+
     void updateVariableBounds(); // This is called by updateVariables()
     void updateVariables();
     void updateConstraints();
     void updateConvexity();
     void updateFactorableFunctions();
+    void updateExpressionTapes();
+    void updateQuadraticMatrices();
+
+    // Replaces equal subexpressions in all nonlinear expressions with a single shared node
+    void shareCommonSubexpressions();
 
     bool verifyOwnership();
 
@@ -239,6 +267,14 @@ public:
     NumericConstraintValue getMaxNumericConstraintValue(const VectorDouble& point,
         const std::vector<NumericConstraint*>& constraintSelection, std::vector<NumericConstraint*>& activeConstraints);
 
+    // Evaluates all the numeric constraints in the point in a single pass. The constraints are divided into chunks,
+    // which are evaluated in the thread pool if one is given (with at most maxNumberOfThreads threads if positive). The
+    // result is the same as with getMaxNumericConstraintValue for each class, i.e. the first of several equally
+    // deviating constraints is returned.
+    MaxNumericConstraintValues getMaxNumericConstraintValues(
+        const VectorDouble& point, bool includeLinearConstraints = true, ThreadPool* threadPool = nullptr,
+        int maxNumberOfThreads = 0);
+
     template <typename T>
     NumericConstraintValues getAllDeviatingConstraints(
         const VectorDouble& point, double tolerance, std::vector<T> constraintSelection, double correction = 0.0);
@@ -246,6 +282,14 @@ public:
     NumericConstraintValues getFractionOfDeviatingNonlinearConstraints(
         const VectorDouble& point, double tolerance, double fraction, double correction = 0.0);
 
+    // Batched versions of the methods above, where all points are evaluated at once and one result per point returned
+    template <typename T>
+    std::vector<NumericConstraintValues> calculateNumericConstraintValues(
+        const PointBatch& points, std::vector<T> constraintSelection);
+
+    std::vector<NumericConstraintValues> getFractionOfDeviatingNonlinearConstraints(
+        const std::vector<VectorDouble>& points, double tolerance, double fraction);
+
     virtual NumericConstraintValues getAllDeviatingNumericConstraints(const VectorDouble& point, double tolerance);
 
     virtual NumericConstraintValues getAllDeviatingLinearConstraints(const VectorDouble& point, double tolerance);
@@ -272,6 +316,10 @@ public:
     void doFBBT();
     bool doFBBTOnConstraint(NumericConstraintPtr constraint, double timeLimit);
 
+    // Propagates the bounds of the given variables, which have been tightened elsewhere, e.g. from an objective
+    // cutoff, through the constraints they are in. Returns the indexes of the variables tightened by the propagation.
+    std::vector<int> doIncrementalFBBT(const std::vector<int>& variableIndexes);
+
     void augmentAuxiliaryVariableValues(VectorDouble& point);
 
     friend std::ostream& operator<<(std::ostream& stream, const Problem& problem);
@@ -0,0 +1,163 @@
+/**
+   The Supporting Hyperplane Optimization Toolkit (SHOT).
+
+   @author Andreas Lundell, Åbo Akademi University
+
+   @section LICENSE
+   This software is licensed under the Eclipse Public License 2.0.
+   Please see the README and LICENSE files for more information.
+*/
+
+#include "QuadraticMatrix.h"
+
+#include <map>
+
+namespace SHOT
+{
+
+void QuadraticMatrix::compile(const QuadraticTerms& terms)
+{
+    clear();
+
+    firstVariableIndexes.reserve(terms.size());
+    secondVariableIndexes.reserve(terms.size());
+    coefficients.reserve(terms.size());
+
+    std::map<int, VariablePtr> variables;
+
+    for(auto& T : terms)
+    {
+        firstVariableIndexes.push_back(T->firstVariable->index);
+        secondVariableIndexes.push_back(T->secondVariable->index);
+        coefficients.push_back(T->coefficient);
+
+        if(T->coefficient == 0.0)
+            continue;
+
+        variables.emplace(T->firstVariable->index, T->firstVariable);
+        variables.emplace(T->secondVariable->index, T->secondVariable);
+    }
+
+    // The rows are ordered on the variable index, so the gradient can be formed by appending its elements
+    std::map<int, int> rowIndexes;
+    rowVariables.reserve(variables.size());
+
+    for(auto& V : variables)
+    {
+        rowIndexes.emplace(V.first, rowVariables.size());
+        rowVariables.push_back(V.second);
+    }
+
+    std::vector<int> rowSizes(rowVariables.size(), 0);
+
+    for(auto& T : terms)
+    {
+        if(T->coefficient == 0.0)
+            continue;
+
+        rowSizes[rowIndexes[T->firstVariable->index]]++;
+
+        if(T->firstVariable != T->secondVariable)
+            rowSizes[rowIndexes[T->secondVariable->index]]++;
+    }
+
+    rowStarts.resize(rowVariables.size() + 1, 0);
+
+    for(size_t i = 0; i < rowVariables.size(); i++)
+        rowStarts[i + 1] = rowStarts[i] + rowSizes[i];
+
+    columnIndexes.resize(rowStarts.back());
+    values.resize(rowStarts.back());
+
+    // The elements in each row are in the same order as the terms, so the sums in the gradient are formed in the same
+    // order as in QuadraticTerms::calculateGradient
+    std::vector<int> nextElements(rowStarts.begin(), rowStarts.end() - 1);
+
+    auto addElement = [&](int row, int column, double value)
+    {
+        columnIndexes[nextElements[row]] = column;
+        values[nextElements[row]] = value;
+        nextElements[row]++;
+    };
+
+    for(auto& T : terms)
+    {
+        if(T->coefficient == 0.0)
+            continue;
+
+        if(T->firstVariable == T->secondVariable) // variable squared
+        {
+            addElement(rowIndexes[T->firstVariable->index], T->firstVariable->index, 2 * T->coefficient);
+            hessian.add(std::make_pair(T->firstVariable, T->secondVariable), 2 * T->coefficient);
+        }
+        else
+        {
+            addElement(rowIndexes[T->firstVariable->index], T->secondVariable->index, T->coefficient);
+            addElement(rowIndexes[T->secondVariable->index], T->firstVariable->index, T->coefficient);
+
+            // Only save elements above the diagonal since the Hessian is symmetric
+            if(T->firstVariable->index < T->secondVariable->index)
+                hessian.add(std::make_pair(T->firstVariable, T->secondVariable), T->coefficient);
+            else
+                hessian.add(std::make_pair(T->secondVariable, T->firstVariable), T->coefficient);
+        }
+    }
+
+    compiled = true;
+}
+
+void QuadraticMatrix::clear()
+{
+    compiled = false;
+
+    firstVariableIndexes.clear();
+    secondVariableIndexes.clear();
+    coefficients.clear();
+
+    rowVariables.clear();
+    rowStarts.clear();
+    columnIndexes.clear();
+    values.clear();
+
+    hessian.clear();
+}
+
+double QuadraticMatrix::calculate(const VectorDouble& point) const
+{
+    const int* first = firstVariableIndexes.data();
+    const int* second = secondVariableIndexes.data();
+    const double* coefficient = coefficients.data();
+    const double* x = point.data();
+    size_t numberOfTerms = coefficients.size();
+
+    double value = 0.0;
+
+    for(size_t k = 0; k < numberOfTerms; k++)
+        value += coefficient[k] * x[first[k]] * x[second[k]];
+
+    return (value);
+}
+
+SparseVariableVector QuadraticMatrix::calculateGradient(const VectorDouble& point) const
+{
+    SparseVariableVector gradient;
+    gradient.reserve(rowVariables.size());
+
+    const int* column = columnIndexes.data();
+    const double* value = values.data();
+    const double* x = point.data();
+
+    for(size_t i = 0; i < rowVariables.size(); i++)
+    {
+        double sum = 0.0;
+
+        for(int k = rowStarts[i]; k < rowStarts[i + 1]; k++)
+            sum += value[k] * x[column[k]];
+
+        gradient.emplace(rowVariables[i], sum);
+    }
+
+    return (gradient);
+}
+
+} // namespace SHOT
\ No newline at end of file
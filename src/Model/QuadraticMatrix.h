@@ -0,0 +1,66 @@
+/**
+   The Supporting Hyperplane Optimization Toolkit (SHOT).
+
+   @author Andreas Lundell, Åbo Akademi University
+
+   @section LICENSE
+   This software is licensed under the Eclipse Public License 2.0.
+   Please see the README and LICENSE files for more information.
+*/
+
+#pragma once
+
+#include "../Structs.h"
+#include "Terms.h"
+#include "Variables.h"
+
+#include <vector>
+
+namespace SHOT
+{
+
+// A compiled representation of a sum of quadratic terms f(x) = sum c_k x_i x_j, which is built when the problem is
+// finalized and must be compiled again if the terms are changed after that.
+//
+// The terms are stored as a structure of arrays in coordinate form and in the same order as in QuadraticTerms, so that
+// the function value is calculated in a single loop over contiguous arrays (which the compiler can vectorize) and is
+// identical to the value calculated from the terms. The symmetric matrix H with f(x) = 0.5 x'Hx is stored in compressed
+// row form, where there is a row for each variable in the terms with nonzero coefficients. The gradient Hx is then
+// calculated row by row without any lookups, and the constant Hessian is only formed once.
+class QuadraticMatrix
+{
+public:
+    QuadraticMatrix() = default;
+    QuadraticMatrix(const QuadraticTerms& terms) { compile(terms); };
+
+    void compile(const QuadraticTerms& terms);
+    void clear();
+
+    inline bool isCompiled() const { return (compiled); };
+
+    inline size_t size() const { return (coefficients.size()); };
+
+    double calculate(const VectorDouble& point) const;
+
+    // Returns the gradient with an element for each variable in the terms with nonzero coefficients
+    SparseVariableVector calculateGradient(const VectorDouble& point) const;
+
+    // Returns the upper triangular part of the Hessian H
+    inline const SparseVariableMatrix& getHessian() const { return (hessian); };
+
+private:
+    bool compiled = false;
+
+    std::vector<int> firstVariableIndexes;
+    std::vector<int> secondVariableIndexes;
+    VectorDouble coefficients;
+
+    Variables rowVariables;
+    std::vector<int> rowStarts;
+    std::vector<int> columnIndexes;
+    VectorDouble values;
+
+    SparseVariableMatrix hessian;
+};
+
+} // namespace SHOT
\ No newline at end of file
@@ -284,18 +284,14 @@ public:
     SparseVariableVector calculateGradient([[maybe_unused]] const VectorDouble& point) const
     {
         SparseVariableVector gradient;
+        gradient.reserve(this->size());
 
         for(auto& T : (*this))
         {
             if(T->coefficient == 0.0)
                 continue;
 
-            auto element = gradient.emplace(T->variable, T->coefficient);
-            if(!element.second)
-            {
-                // Element already exists for the variable
-                element.first->second += T->coefficient;
-            }
+            gradient.add(T->variable, T->coefficient);
         }
 
         return gradient;
@@ -523,35 +519,12 @@ public:
 
             if(T->firstVariable == T->secondVariable) // variable squared
             {
-                auto value = 2 * T->coefficient * point[T->firstVariable->index];
-                auto element = gradient.emplace(T->firstVariable, value);
-
-                if(!element.second)
-                {
-                    // Element already exists for the variable
-                    element.first->second += value;
-                }
+                gradient.add(T->firstVariable, 2 * T->coefficient * point[T->firstVariable->index]);
             }
             else
             {
-                auto value = T->coefficient * point[T->secondVariable->index];
-                auto element = gradient.emplace(T->firstVariable, value);
-
-                if(!element.second)
-                {
-                    // Element already exists for the variable
-                    element.first->second += value;
-                }
-
-                value = T->coefficient * point[T->firstVariable->index];
-
-                element = gradient.emplace(T->secondVariable, value);
-
-                if(!element.second)
-                {
-                    // Element already exists for the variable
-                    element.first->second += value;
-                }
+                gradient.add(T->firstVariable, T->coefficient * point[T->secondVariable->index]);
+                gradient.add(T->secondVariable, T->coefficient * point[T->firstVariable->index]);
             }
         }
 
@@ -774,15 +747,7 @@ public:
                         value *= V3->calculate(point);
                     }
 
-                    std::pair<VariablePtr, VariablePtr> variablePair = std::make_pair(V1, V2);
-
-                    auto element = hessian.emplace(variablePair, value);
-
-                    if(!element.second)
-                    {
-                        // Element already exists for the variable
-                        element.first->second += value;
-                    }
+                    hessian.add(std::make_pair(V1, V2), value);
                 }
             }
         }
@@ -1261,15 +1226,7 @@ public:
                             = E1->power * E2->power / (E1->variable->calculate(point) * E2->variable->calculate(point));
                     }
 
-                    auto variablePair = std::make_pair(E1->variable, E2->variable);
-
-                    auto element = hessian.emplace(variablePair, corrFactor * value);
-
-                    if(!element.second)
-                    {
-                        // Element already exists for the variable
-                        element.first->second += corrFactor * value;
-                    }
+                    hessian.add(std::make_pair(E1->variable, E2->variable), corrFactor * value);
                 }
             }
         }
@@ -12,6 +12,7 @@
 
 #include "../Enums.h"
 #include "../Structs.h"
+#include "../SparseVector.h"
 
 #include <map>
 #include <memory>
@@ -137,8 +138,8 @@ public:
 };
 
 using VariablePtr = std::shared_ptr<Variable>;
-using SparseVariableVector = std::map<VariablePtr, double>;
-using SparseVariableMatrix = std::map<std::pair<VariablePtr, VariablePtr>, double>;
+using SparseVariableVector = SparseVector<VariablePtr>;
+using SparseVariableMatrix = SparseVector<std::pair<VariablePtr, VariablePtr>>;
 
 class Variables : private std::vector<VariablePtr>
 {
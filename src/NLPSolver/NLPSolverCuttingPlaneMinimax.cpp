@@ -259,7 +259,7 @@ E_NLPSolutionStatus NLPSolverCuttingPlaneMinimax::solveProblemInstance()
         for(auto& NCV : constraintValues)
         {
             // Contains the coefficient and variable index for the terms in the generated cut
-            std::map<int, double> elements;
+            SparseIndexVector elements;
 
             double constant = NCV.normalizedValue;
             auto gradient = NCV.constraint->calculateGradient(currSol, true);
@@ -269,13 +269,7 @@ E_NLPSolutionStatus NLPSolverCuttingPlaneMinimax::solveProblemInstance()
                 int variableIndex = G.first->index;
                 double coefficient = G.second;
 
-                auto element = elements.emplace(variableIndex, coefficient);
-
-                if(!element.second)
-                {
-                    // Element already exists for the variable
-                    element.first->second += coefficient;
-                }
+                elements.add(variableIndex, coefficient);
 
                 constant = constant - coefficient * currSol.at(variableIndex);
             }
@@ -10,7 +10,9 @@
 
 #include "NLPSolverIpoptBase.h"
 
+#include <algorithm>
 #include <cstdio>
+#include <map>
 
 #include "../Output.h"
 #include "../Settings.h"
@@ -21,6 +23,45 @@ namespace SHOT
 
 using namespace Ipopt;
 
+// Adds the elements of a gradient to the values in the slots of the corresponding nonzeros. Both are sorted on the
+// variable indexes and all elements have slots, so this is a single pass over both.
+static void addToSlots(
+    const SparseVariableVector& gradient, const std::vector<std::pair<int, int>>& slots, VectorDouble& values)
+{
+    auto slot = slots.begin();
+
+    for(auto& G : gradient)
+    {
+        while(slot != slots.end() && slot->first < G.first->index)
+            ++slot;
+
+        assert(slot != slots.end() && slot->first == G.first->index);
+
+        if(slot != slots.end() && slot->first == G.first->index)
+            values[slot->second] += G.second;
+    }
+}
+
+// As above but for the upper triangular part of a Hessian, and with the values multiplied by a factor
+static void addToSlots(const SparseVariableMatrix& hessian,
+    const std::vector<std::pair<std::pair<int, int>, int>>& slots, double factor, Number* values)
+{
+    auto slot = slots.begin();
+
+    for(auto& E : hessian)
+    {
+        auto element = std::make_pair(E.first.first->index, E.first.second->index);
+
+        while(slot != slots.end() && slot->first < element)
+            ++slot;
+
+        assert(slot != slots.end() && slot->first == element);
+
+        if(slot != slots.end() && slot->first == element)
+            values[slot->second] += factor * E.second;
+    }
+}
+
 void IpoptJournal::PrintImpl(Ipopt::EJournalCategory category, Ipopt::EJournalLevel level, const char* str)
 {
     auto lines = Utilities::splitStringByCharacter(str, '\n');
@@ -200,6 +241,9 @@ bool IpoptProblem::get_starting_point(Index n, [[maybe_unused]] bool init_x, [[m
     assert(init_z == false);
     assert(init_lambda == false);
 
+    // A new solve is started, so nothing calculated in the previous one is used
+    currentPoint.clear();
+
     std::vector<bool> isInitialized(n, false);
 
     for(size_t k = 0; k < startingPointVariableIndexes.size(); k++)
@@ -300,181 +344,492 @@ bool IpoptProblem::get_starting_point(Index n, [[maybe_unused]] bool init_x, [[m
 }
 
 // Returns the value of the objective function
-bool IpoptProblem::eval_f(Index n, const Number* x, [[maybe_unused]] bool new_x, Number& obj_value)
+bool IpoptProblem::eval_f(Index n, const Number* x, bool new_x, Number& obj_value)
 {
-    VectorDouble vectorPoint(n);
+    updateCurrentPoint(n, x, new_x);
 
-    for(int i = 0; i < n; i++)
-        vectorPoint[i] = x[i];
+    if(!isObjectiveValueCalculated)
+    {
+        currentObjectiveValue = sourceProblem->objectiveFunction->calculateValue(currentPoint);
+        isObjectiveValueCalculated = true;
+    }
 
-    obj_value = sourceProblem->objectiveFunction->calculateValue(vectorPoint);
+    obj_value = currentObjectiveValue;
 
     return (true);
 }
 
 // Returns the gradient of the objective function
-bool IpoptProblem::eval_grad_f(Index n, const Number* x, [[maybe_unused]] bool new_x, Number* grad_f)
+bool IpoptProblem::eval_grad_f(Index n, const Number* x, bool new_x, Number* grad_f)
 {
-    VectorDouble vectorPoint(n);
+    updateCurrentPoint(n, x, new_x);
 
-    for(int i = 0; i < n; i++)
-        vectorPoint[i] = x[i];
-
-    for(int i = 0; i < n; i++)
-        grad_f[i] = 0.0;
+    if(!areGradientsCalculated)
+        calculateGradients();
 
-    for(auto& G : sourceProblem->objectiveFunction->calculateGradient(vectorPoint, false))
-        grad_f[G.first->index] = G.second;
+    std::copy(currentObjectiveGradient.begin(), currentObjectiveGradient.end(), grad_f);
 
     return (true);
 }
 
 // Return the value of the constraints
-bool IpoptProblem::eval_g(Index n, const Number* x, [[maybe_unused]] bool new_x, Index m, Number* g)
+bool IpoptProblem::eval_g(Index n, const Number* x, bool new_x, Index m, Number* g)
 {
-    VectorDouble vectorPoint(n);
+    updateCurrentPoint(n, x, new_x);
 
-    for(int i = 0; i < n; i++)
-        vectorPoint[i] = x[i];
+    if(!areConstraintValuesCalculated)
+    {
+        currentConstraintValues.resize(m);
 
-    for(int i = 0; i < m; i++)
-        g[i] = 0.0;
+        for(int i = 0; i < m; i++)
+            currentConstraintValues[i] = sourceProblem->numericConstraints[i]->calculateFunctionValue(currentPoint);
 
-    for(int i = 0; i < m; i++)
-        g[i] = sourceProblem->numericConstraints[i]->calculateFunctionValue(vectorPoint);
+        areConstraintValuesCalculated = true;
+    }
+
+    std::copy(currentConstraintValues.begin(), currentConstraintValues.end(), g);
 
     return (true);
 }
 
 // Return the structure or values of the jacobian
-bool IpoptProblem::eval_jac_g(Index n, const Number* x, [[maybe_unused]] bool new_x, [[maybe_unused]] Index m,
-    Index nele_jac, Index* iRow, Index* jCol, Number* values)
+bool IpoptProblem::eval_jac_g(Index n, const Number* x, bool new_x, [[maybe_unused]] Index m,
+    [[maybe_unused]] Index nele_jac, Index* iRow, Index* jCol, Number* values)
 {
     // The structure
     if(values == nullptr)
     {
-        int counter = 0;
+        if(!isJacobianStructureInitialized)
+            initializeJacobianStructure();
 
-        jacobianCounterPlacement.clear();
+        assert(jacobianRows.size() == (size_t)nele_jac);
 
-        for(auto& C : sourceProblem->numericConstraints)
-        {
-            auto jacobian = C->getGradientSparsityPattern();
+        std::copy(jacobianRows.begin(), jacobianRows.end(), iRow);
+        std::copy(jacobianColumns.begin(), jacobianColumns.end(), jCol);
 
-            for(auto& G : *jacobian)
-            {
-                iRow[counter] = C->index;
-                jCol[counter] = G->index;
+        return (true);
+    }
 
-                jacobianCounterPlacement.emplace(std::make_pair(C->index, G->index), counter);
-                counter++;
-            }
+    // The values
 
-            assert(counter <= nele_jac);
-        }
+    updateCurrentPoint(n, x, new_x);
+
+    if(!areGradientsCalculated)
+        calculateGradients();
+
+    std::copy(currentJacobianValues.begin(), currentJacobianValues.end(), values);
+
+    return (true);
+}
+
+// Return the structure or values of the Hessian of the Langragian
+bool IpoptProblem::eval_h(Index n, const Number* x, bool new_x, Number obj_factor, [[maybe_unused]] Index m,
+    const Number* lambda, [[maybe_unused]] bool new_lambda, Index nele_hess, Index* iRow, Index* jCol, Number* values)
+{
+    // The structure
+    if(values == nullptr)
+    {
+        if(!isHessianStructureInitialized)
+            initializeHessianStructure();
+
+        assert(hessianRows.size() == (size_t)nele_hess);
+
+        std::copy(hessianRows.begin(), hessianRows.end(), iRow);
+        std::copy(hessianColumns.begin(), hessianColumns.end(), jCol);
 
         return (true);
     }
 
     // The values
 
-    VectorDouble vectorPoint(n);
+    updateCurrentPoint(n, x, new_x);
 
-    for(int i = 0; i < n; i++)
-        vectorPoint[i] = x[i];
+    std::fill(values, values + nele_hess, 0.0);
 
-    for(int i = 0; i < nele_jac; i++)
-        values[i] = 0.0;
+    for(auto& [slot, constraintIndex, value] : constantHessianElements)
+        values[slot] += (constraintIndex == -1 ? obj_factor : lambda[constraintIndex]) * value;
 
-    for(auto& C : sourceProblem->numericConstraints)
+    if(obj_factor != 0.0 && !isObjectiveHessianConstant)
     {
-        auto jacobian = C->calculateGradient(vectorPoint, false);
+        if(tapedObjectiveFunction)
+        {
+            addToSlots(tapedObjectiveFunction->calculateHessianWithoutNonlinearExpression(currentPoint),
+                hessianSlots.back(), obj_factor, values);
+        }
+        else
+        {
+            addToSlots(sourceProblem->objectiveFunction->calculateHessian(currentPoint, false), hessianSlots.back(),
+                obj_factor, values);
+        }
+    }
 
-        for(auto& G : jacobian)
+    for(auto& C : tapedConstraints)
+    {
+        if(lambda[C->index] != 0.0)
         {
-            int location = jacobianCounterPlacement[std::make_pair(C->index, G.first->index)];
+            addToSlots(C->calculateHessianWithoutNonlinearExpression(currentPoint), hessianSlots[C->index],
+                lambda[C->index], values);
+        }
+    }
+
+    for(auto& C : otherNonlinearConstraints)
+    {
+        if(lambda[C->index] != 0.0)
+            addToSlots(C->calculateHessian(currentPoint, false), hessianSlots[C->index], lambda[C->index], values);
+    }
 
-            values[location] += G.second;
+    // A single sweep on the tape for the weighted sum of the Hessians of all nonlinear expressions
+    if(tapeHessian.nnz() > 0)
+    {
+        for(size_t i = 0; i < tapeConstraintIndexes.size(); i++)
+            tapeWeights[i] = (tapeConstraintIndexes[i] == -1) ? obj_factor : lambda[tapeConstraintIndexes[i]];
 
-            assert(location < nele_jac);
-            assert(location >= 0);
-        }
+        sourceProblem->ADFunctions.sparse_hes(
+            currentTapePoint, tapeWeights, tapeHessian, tapeHessianPattern, "cppad.symmetric", tapeHessianWork);
+
+        const std::vector<double>& tapeValues(tapeHessian.val());
+
+        for(size_t k = 0; k < tapeValues.size(); k++)
+            values[tapeHessianSlots[k]] += tapeValues[k];
     }
 
     return (true);
 }
 
-// Return the structure or values of the Hessian of the Langragian
-bool IpoptProblem::eval_h(Index n, const Number* x, [[maybe_unused]] bool new_x, Number obj_factor,
-    [[maybe_unused]] Index m, const Number* lambda, [[maybe_unused]] bool new_lambda, Index nele_hess, Index* iRow,
-    Index* jCol, Number* values)
+bool IpoptProblem::hasTape() { return (sourceProblem->ADFunctions.Range() > 0); }
+
+void IpoptProblem::updateCurrentPoint(Index n, const Number* x, bool new_x)
 {
-    // The structure
-    if(values == nullptr)
+    if(!new_x && currentPoint.size() == (size_t)n)
+        return;
+
+    currentPoint.assign(x, x + n);
+
+    if(hasTape())
+    {
+        auto& tapeVariables = sourceProblem->nonlinearExpressionVariables;
+
+        currentTapePoint.resize(tapeVariables.size());
+
+        for(size_t i = 0; i < tapeVariables.size(); i++)
+            currentTapePoint[i] = x[tapeVariables[i]->index];
+    }
+
+    isObjectiveValueCalculated = false;
+    areConstraintValuesCalculated = false;
+    areGradientsCalculated = false;
+}
+
+void IpoptProblem::initializeJacobianStructure()
+{
+    jacobianRows.clear();
+    jacobianColumns.clear();
+    jacobianSlots = std::vector<std::vector<std::pair<int, int>>>(sourceProblem->numericConstraints.size());
+
+    quadraticConstraints.clear();
+    tapedConstraints.clear();
+    otherNonlinearConstraints.clear();
+
+    NumericConstraints linearConstraints;
+
+    for(auto& C : sourceProblem->numericConstraints)
     {
-        int counter = 0;
-        lagrangianHessianCounterPlacement.clear();
+        auto& slots = jacobianSlots[C->index];
 
-        for(auto& E : *sourceProblem->getLagrangianHessianSparsityPattern())
+        for(auto& V : *C->getGradientSparsityPattern())
+            slots.emplace_back(V->index, 0);
+
+        std::sort(slots.begin(), slots.end());
+
+        for(auto& S : slots)
         {
-            assert(E.first->index <= E.second->index);
+            S.second = jacobianRows.size();
+            jacobianRows.push_back(C->index);
+            jacobianColumns.push_back(S.first);
+        }
 
-            iRow[counter] = E.first->index;
-            jCol[counter] = E.second->index;
+        if(C->properties.hasNonlinearExpression)
+        {
+            auto constraint = std::dynamic_pointer_cast<NonlinearConstraint>(C);
 
-            lagrangianHessianCounterPlacement.emplace(std::make_pair(E.first->index, E.second->index), counter);
+            if(hasTape() && constraint->nonlinearExpressionIndex >= 0)
+                tapedConstraints.push_back(constraint);
+            else
+                otherNonlinearConstraints.push_back(C);
+        }
+        else if(C->properties.hasMonomialTerms || C->properties.hasSignomialTerms)
+        {
+            otherNonlinearConstraints.push_back(C);
+        }
+        else if(C->properties.hasQuadraticTerms)
+        {
+            quadraticConstraints.push_back(C);
+        }
+        else
+        {
+            linearConstraints.push_back(C);
+        }
+    }
+
+    // The gradients of the linear constraints are the same in all points
+    constantJacobianValues = VectorDouble(jacobianRows.size(), 0.0);
+    VectorDouble zeroPoint(sourceProblem->properties.numberOfVariables, 0.0);
+
+    for(auto& C : linearConstraints)
+        addToSlots(C->calculateGradient(zeroPoint, false), jacobianSlots[C->index], constantJacobianValues);
+
+    auto objective = std::dynamic_pointer_cast<NonlinearObjectiveFunction>(sourceProblem->objectiveFunction);
+
+    if(hasTape() && objective && objective->properties.hasNonlinearExpression
+        && objective->nonlinearExpressionIndex >= 0)
+        tapedObjectiveFunction = objective;
+    else
+        tapedObjectiveFunction = nullptr;
+
+    tapeJacobianSlots.clear();
+    tapeObjectiveGradientIndexes.clear();
+
+    if(hasTape())
+    {
+        auto& tape = sourceProblem->ADFunctions;
+        auto& tapeVariables = sourceProblem->nonlinearExpressionVariables;
+
+        tapeConstraintIndexes = std::vector<int>(tape.Range(), -1);
+
+        for(auto& C : tapedConstraints)
+            tapeConstraintIndexes[C->nonlinearExpressionIndex] = C->index;
+
+        std::vector<bool> selectDomain(tape.Domain(), true);
+        std::vector<bool> selectRange(tape.Range(), true);
+
+        CppAD::sparse_rc<std::vector<size_t>> pattern;
+        tape.subgraph_sparsity(selectDomain, selectRange, false, pattern);
+
+        const std::vector<size_t>& rows(pattern.row());
+        const std::vector<size_t>& columns(pattern.col());
+
+        std::vector<size_t> subsetRows;
+        std::vector<size_t> subsetColumns;
+
+        for(size_t k = 0; k < pattern.nnz(); k++)
+        {
+            int constraintIndex = tapeConstraintIndexes[rows[k]];
+            int variableIndex = tapeVariables[columns[k]]->index;
+
+            if(constraintIndex == -1)
+            {
+                tapeJacobianSlots.push_back(-1);
+                tapeObjectiveGradientIndexes.push_back(variableIndex);
+            }
+            else
+            {
+                auto& slots = jacobianSlots[constraintIndex];
+                auto slot = std::lower_bound(slots.begin(), slots.end(), std::make_pair(variableIndex, 0));
+
+                // The problem-wide tape also contains variables not in this constraint
+                if(slot == slots.end() || slot->first != variableIndex)
+                    continue;
+
+                tapeJacobianSlots.push_back(slot->second);
+                tapeObjectiveGradientIndexes.push_back(-1);
+            }
 
-            counter++;
+            subsetRows.push_back(rows[k]);
+            subsetColumns.push_back(columns[k]);
         }
 
-        return (true);
+        CppAD::sparse_rc<std::vector<size_t>> subset(tape.Range(), tape.Domain(), subsetRows.size());
+
+        for(size_t k = 0; k < subsetRows.size(); k++)
+            subset.set(k, subsetRows[k], subsetColumns[k]);
+
+        tapeJacobian = CppAD::sparse_rcv<std::vector<size_t>, std::vector<double>>(subset);
     }
 
-    // The values
+    isJacobianStructureInitialized = true;
+}
 
-    VectorDouble vectorPoint(n);
+void IpoptProblem::initializeHessianStructure()
+{
+    if(!isJacobianStructureInitialized)
+        initializeJacobianStructure();
 
-    for(int i = 0; i < n; i++)
-        vectorPoint[i] = x[i];
+    hessianRows.clear();
+    hessianColumns.clear();
+
+    // Only used here, the slots are then found from the sorted slot vectors
+    std::map<std::pair<int, int>, int> lagrangianHessianPlacement;
 
-    for(int i = 0; i < nele_hess; i++)
-        values[i] = 0.0;
+    for(auto& E : *sourceProblem->getLagrangianHessianSparsityPattern())
+    {
+        assert(E.first->index <= E.second->index);
+
+        lagrangianHessianPlacement.emplace(std::make_pair(E.first->index, E.second->index), hessianRows.size());
+
+        hessianRows.push_back(E.first->index);
+        hessianColumns.push_back(E.second->index);
+    }
 
-    if(obj_factor != 0.0)
+    auto getSlots = [&](const std::vector<std::pair<VariablePtr, VariablePtr>>& pattern)
     {
-        for(auto& E : sourceProblem->objectiveFunction->calculateHessian(vectorPoint, false))
+        std::vector<std::pair<std::pair<int, int>, int>> slots;
+
+        for(auto& E : pattern)
         {
-            int location
-                = lagrangianHessianCounterPlacement[std::make_pair(E.first.first->index, E.first.second->index)];
+            auto element = std::make_pair(E.first->index, E.second->index);
+            auto placement = lagrangianHessianPlacement.find(element);
 
-            assert(location < nele_hess);
-            assert(location >= 0);
+            assert(placement != lagrangianHessianPlacement.end());
 
-            values[location] = obj_factor * E.second;
+            if(placement != lagrangianHessianPlacement.end())
+                slots.emplace_back(element, placement->second);
         }
+
+        std::sort(slots.begin(), slots.end());
+
+        return (slots);
+    };
+
+    // The objective function is last
+    hessianSlots = std::vector<std::vector<std::pair<std::pair<int, int>, int>>>(
+        sourceProblem->numericConstraints.size() + 1);
+
+    for(auto& C : tapedConstraints)
+        hessianSlots[C->index] = getSlots(*C->getHessianSparsityPattern());
+
+    for(auto& C : otherNonlinearConstraints)
+        hessianSlots[C->index] = getSlots(*C->getHessianSparsityPattern());
+
+    constantHessianElements.clear();
+
+    auto addConstantElements = [&](const SparseVariableMatrix& hessian, int constraintIndex)
+    {
+        for(auto& E : hessian)
+        {
+            auto placement
+                = lagrangianHessianPlacement.find(std::make_pair(E.first.first->index, E.first.second->index));
+
+            assert(placement != lagrangianHessianPlacement.end());
+
+            if(placement != lagrangianHessianPlacement.end())
+                constantHessianElements.emplace_back(placement->second, constraintIndex, E.second);
+        }
+    };
+
+    VectorDouble zeroPoint(sourceProblem->properties.numberOfVariables, 0.0);
+
+    for(auto& C : quadraticConstraints)
+        addConstantElements(C->calculateHessian(zeroPoint, false), C->index);
+
+    auto& objective = sourceProblem->objectiveFunction;
+
+    isObjectiveHessianConstant = !(objective->properties.hasMonomialTerms || objective->properties.hasSignomialTerms
+        || objective->properties.hasNonlinearExpression);
+
+    if(isObjectiveHessianConstant)
+        addConstantElements(objective->calculateHessian(zeroPoint, false), -1);
+    else
+    {
+        hessianSlots.back() = getSlots(*objective->getHessianSparsityPattern());
     }
 
-    for(auto& C : sourceProblem->numericConstraints)
+    tapeHessianSlots.clear();
+
+    if(hasTape())
     {
-        if(C->properties.classification == E_ConstraintClassification::Linear)
-            continue;
+        auto& tape = sourceProblem->ADFunctions;
+        auto& tapeVariables = sourceProblem->nonlinearExpressionVariables;
 
-        if(lambda[C->index] == 0.0)
-            continue;
+        std::vector<bool> selectDomain(tape.Domain(), true);
+        std::vector<bool> selectRange(tape.Range(), true);
+
+        tape.for_hes_sparsity(selectDomain, selectRange, false, tapeHessianPattern);
+
+        const std::vector<size_t>& rows(tapeHessianPattern.row());
+        const std::vector<size_t>& columns(tapeHessianPattern.col());
+
+        std::vector<size_t> subsetRows;
+        std::vector<size_t> subsetColumns;
 
-        for(auto& E : C->calculateHessian(vectorPoint, false))
+        for(size_t k = 0; k < tapeHessianPattern.nnz(); k++)
         {
-            int location
-                = lagrangianHessianCounterPlacement[std::make_pair(E.first.first->index, E.first.second->index)];
+            auto& V1 = tapeVariables[rows[k]];
+            auto& V2 = tapeVariables[columns[k]];
 
-            assert(location < nele_hess);
-            assert(location >= 0);
+            // Only the upper triangular part is given to Ipopt
+            if(V1->index > V2->index)
+                continue;
+
+            auto placement = lagrangianHessianPlacement.find(std::make_pair(V1->index, V2->index));
+
+            // The pattern of the problem-wide tape may contain elements that are not in any of the expressions
+            if(placement == lagrangianHessianPlacement.end())
+                continue;
 
-            values[location] += lambda[C->index] * E.second;
+            tapeHessianSlots.push_back(placement->second);
+            subsetRows.push_back(rows[k]);
+            subsetColumns.push_back(columns[k]);
         }
+
+        CppAD::sparse_rc<std::vector<size_t>> subset(tape.Domain(), tape.Domain(), subsetRows.size());
+
+        for(size_t k = 0; k < subsetRows.size(); k++)
+            subset.set(k, subsetRows[k], subsetColumns[k]);
+
+        tapeHessian = CppAD::sparse_rcv<std::vector<size_t>, std::vector<double>>(subset);
+        tapeHessianWork.clear();
+        tapeWeights = VectorDouble(tape.Range(), 0.0);
     }
 
-    return (true);
+    isHessianStructureInitialized = true;
+}
+
+void IpoptProblem::calculateGradients()
+{
+    if(!isJacobianStructureInitialized)
+        initializeJacobianStructure();
+
+    currentJacobianValues = constantJacobianValues;
+    currentObjectiveGradient.assign(currentPoint.size(), 0.0);
+
+    auto& objective = sourceProblem->objectiveFunction;
+
+    auto objectiveGradient = tapedObjectiveFunction
+        ? tapedObjectiveFunction->calculateGradientWithoutNonlinearExpression(currentPoint)
+        : objective->calculateGradient(currentPoint, false);
+
+    for(auto& G : objectiveGradient)
+        currentObjectiveGradient[G.first->index] += G.second;
+
+    for(auto& C : quadraticConstraints)
+        addToSlots(C->calculateGradient(currentPoint, false), jacobianSlots[C->index], currentJacobianValues);
+
+    for(auto& C : tapedConstraints)
+    {
+        addToSlots(C->calculateGradientWithoutNonlinearExpression(currentPoint), jacobianSlots[C->index],
+            currentJacobianValues);
+    }
+
+    for(auto& C : otherNonlinearConstraints)
+        addToSlots(C->calculateGradient(currentPoint, false), jacobianSlots[C->index], currentJacobianValues);
+
+    // A single sweep on the tape for the gradients of all nonlinear expressions, including the one in the objective
+    if(tapeJacobian.nnz() > 0)
+    {
+        sourceProblem->ADFunctions.subgraph_jac_rev(currentTapePoint, tapeJacobian);
+
+        const std::vector<double>& tapeValues(tapeJacobian.val());
+
+        for(size_t k = 0; k < tapeValues.size(); k++)
+        {
+            if(tapeJacobianSlots[k] >= 0)
+                currentJacobianValues[tapeJacobianSlots[k]] += tapeValues[k];
+            else
+                currentObjectiveGradient[tapeObjectiveGradientIndexes[k]] += tapeValues[k];
+        }
+    }
+
+    areGradientsCalculated = true;
 }
 
 /*
@@ -15,6 +15,8 @@
 #include "IpIpoptApplication.hpp"
 #include "IpJournalist.hpp"
 
+#include <tuple>
+
 #include "../Model/Problem.h"
 
 namespace SHOT
@@ -136,8 +138,74 @@ private:
 
     ProblemPtr sourceProblem;
 
-    std::map<std::pair<int, int>, int> lagrangianHessianCounterPlacement;
-    std::map<std::pair<int, int>, int> jacobianCounterPlacement;
+    // Ipopt calls the evaluation methods with new_x false if the point is the same as in the previous call, so what
+    // has been calculated in the current point is kept until the point changes
+    VectorDouble currentPoint;
+    VectorDouble currentTapePoint; // The values of the independent variables on the problem-wide tape
+
+    bool isObjectiveValueCalculated = false;
+    bool areConstraintValuesCalculated = false;
+    bool areGradientsCalculated = false;
+
+    double currentObjectiveValue = 0.0;
+    VectorDouble currentConstraintValues;
+    VectorDouble currentObjectiveGradient;
+    VectorDouble currentJacobianValues;
+
+    // The structures are the same in all solves, so they are only created once. The slots of the nonzeros of each
+    // constraint (and of the objective, last in hessianSlots) are sorted on the variable indexes in the same way as the
+    // gradients and Hessians, so these can be added to the value arrays in a single pass without lookups.
+    bool isJacobianStructureInitialized = false;
+    bool isHessianStructureInitialized = false;
+
+    // The nonlinear constraints are those with only quadratic terms (and constant Hessians), those with nonlinear
+    // expressions on the problem-wide tape, and the rest. The linear constraints have constant gradients.
+    NumericConstraints quadraticConstraints;
+    NonlinearConstraints tapedConstraints;
+    NumericConstraints otherNonlinearConstraints;
+
+    // Set if the nonlinear expression in the objective function is on the problem-wide tape
+    NonlinearObjectiveFunctionPtr tapedObjectiveFunction;
+    bool isObjectiveHessianConstant = false;
+
+    std::vector<Ipopt::Index> jacobianRows;
+    std::vector<Ipopt::Index> jacobianColumns;
+    std::vector<std::vector<std::pair<int, int>>> jacobianSlots;
+
+    VectorDouble constantJacobianValues;
+
+    std::vector<Ipopt::Index> hessianRows;
+    std::vector<Ipopt::Index> hessianColumns;
+    std::vector<std::vector<std::pair<std::pair<int, int>, int>>> hessianSlots;
+
+    // The quadratic constraints and a quadratic objective function have constant Hessians. The elements are given as
+    // (slot, constraint index or -1 for the objective function, value).
+    std::vector<std::tuple<int, int, double>> constantHessianElements;
+
+    // The nonlinear expressions in the objective function and all constraints are differentiated together on the
+    // problem-wide tape. For each nonzero there is the slot in the Jacobian values, or -1 if it is in the objective
+    // function in which case there is the variable index in tapeObjectiveGradientIndexes.
+    CppAD::sparse_rcv<std::vector<size_t>, std::vector<double>> tapeJacobian;
+    std::vector<int> tapeJacobianSlots;
+    std::vector<int> tapeObjectiveGradientIndexes;
+
+    // The Hessian of the Lagrangian is calculated in one sweep with the multipliers as weights for the expressions
+    CppAD::sparse_rc<std::vector<size_t>> tapeHessianPattern;
+    CppAD::sparse_rcv<std::vector<size_t>, std::vector<double>> tapeHessian;
+    CppAD::sparse_hes_work tapeHessianWork;
+    std::vector<int> tapeHessianSlots;
+    std::vector<int> tapeConstraintIndexes; // For each expression on the tape, -1 if it is in the objective function
+    VectorDouble tapeWeights;
+
+    bool hasTape();
+
+    void updateCurrentPoint(Ipopt::Index n, const Ipopt::Number* x, bool new_x);
+
+    void initializeJacobianStructure();
+    void initializeHessianStructure();
+
+    // Calculates the gradient of the objective function and the Jacobian of the constraints in the current point
+    void calculateGradients();
 };
 
 class NLPSolverIpoptBase : virtual public INLPSolver
@@ -31,18 +31,8 @@ void PrimalSolver::addPrimalSolutionCandidate(VectorDouble pt, E_PrimalSolutionS
     sol.objValue = env->problem->objectiveFunction->calculateValue(pt);
     sol.iterFound = iter;
 
-    if(env->problem->properties.numberOfNonlinearConstraints > 0)
-    {
-        auto maxDevNonlinear = env->problem->getMaxNumericConstraintValue(pt, env->problem->nonlinearConstraints);
-        sol.maxDevatingConstraintNonlinear
-            = PairIndexValue(maxDevNonlinear.constraint->index, maxDevNonlinear.normalizedValue);
-    }
-
-    if(env->problem->properties.numberOfLinearConstraints > 0)
-    {
-        auto maxDevLinear = env->problem->getMaxNumericConstraintValue(pt, env->problem->linearConstraints);
-        sol.maxDevatingConstraintLinear = PairIndexValue(maxDevLinear.constraint->index, maxDevLinear.normalizedValue);
-    }
+    // These are also used when checking the candidate, unless the point is changed there
+    calculateMaxDeviatingConstraints(pt, sol);
 
     env->primalSolver->primalSolutionCandidates.push_back(sol);
 
@@ -407,62 +397,51 @@ bool PrimalSolver::checkPrimalSolutionPoint(PrimalSolution primalSol)
         || primalSol.sourceType == E_PrimalSolutionSource::MIPCallback
         || primalSol.sourceType == E_PrimalSolutionSource::InteriorPointSearch);
 
-    if(!primalSol.integerRoundingPerformed && !primalSol.boundProjectionPerformed && acceptableType
-        && env->settings->getSetting<bool>("Tolerance.TrustLinearConstraintValues", "Primal"))
+    bool trustLinearConstraints = !primalSol.integerRoundingPerformed && !primalSol.boundProjectionPerformed
+        && acceptableType && env->settings->getSetting<bool>("Tolerance.TrustLinearConstraintValues", "Primal");
+
+    // The constraint values calculated when the candidate was added can be used if the point has not been changed
+    if(primalSol.integerRoundingPerformed || primalSol.boundProjectionPerformed
+        || !primalSol.maxDeviatingConstraintsCalculated)
+    {
+        calculateMaxDeviatingConstraints(tmpPoint, primalSol, !trustLinearConstraints);
+    }
+
+    if(trustLinearConstraints)
     {
         env->output->outputDebug(
             "         Assuming that linear constraints are fulfilled since solution is from a subsolver.");
     }
-    else
+    else if(env->problem->properties.numberOfLinearConstraints > 0)
     {
-        PairIndexValue mostDevLinearConstraints;
+        auto linTol = env->settings->getSetting<double>("Tolerance.LinearConstraint", "Primal");
 
-        if(env->problem->properties.numberOfLinearConstraints > 0)
+        if(primalSol.maxDevatingConstraintLinear.value > linTol)
         {
-            auto maxLinearConstraintValue
-                = env->problem->getMaxNumericConstraintValue(tmpPoint, env->problem->linearConstraints);
-
-            mostDevLinearConstraints.index = maxLinearConstraintValue.constraint->index;
-            mostDevLinearConstraints.value = maxLinearConstraintValue.normalizedValue;
-
-            auto linTol = env->settings->getSetting<double>("Tolerance.LinearConstraint", "Primal");
-
-            if(maxLinearConstraintValue.error > linTol)
-            {
-                auto tmpLine = fmt::format("         Linear constraints are not fulfilled. Most deviating {}: {} > {}.",
-                    maxLinearConstraintValue.constraint->name, maxLinearConstraintValue.error, linTol);
-                env->output->outputDebug(tmpLine);
+            auto tmpLine = fmt::format("         Linear constraints are not fulfilled. Most deviating {}: {} > {}.",
+                primalSol.maxDevatingConstraintLinear.index, primalSol.maxDevatingConstraintLinear.value, linTol);
+            env->output->outputDebug(tmpLine);
 
-                return (false);
-            }
-            else
-            {
-                auto tmpLine = fmt::format("         Linear constraints are fulfilled. Most deviating {}: {} < {}.",
-                    maxLinearConstraintValue.constraint->index, maxLinearConstraintValue.error, linTol);
-                env->output->outputDebug(tmpLine);
-            }
+            return (false);
+        }
+        else
+        {
+            auto tmpLine = fmt::format("         Linear constraints are fulfilled. Most deviating {}: {} < {}.",
+                primalSol.maxDevatingConstraintLinear.index, primalSol.maxDevatingConstraintLinear.value, linTol);
+            env->output->outputDebug(tmpLine);
         }
-
-        primalSol.maxDevatingConstraintLinear = mostDevLinearConstraints;
     }
 
+    auto nonlinTol = env->settings->getSetting<double>("Tolerance.NonlinearConstraint", "Primal");
+
     // Check if quadratic constraints are fulfilled
     if(env->problem->properties.numberOfQuadraticConstraints > 0)
     {
-        PairIndexValue mostDevQuadraticConstraints;
-
-        auto maxQuadraticConstraintValue
-            = env->problem->getMaxNumericConstraintValue(tmpPoint, env->problem->quadraticConstraints);
-
-        mostDevQuadraticConstraints.index = maxQuadraticConstraintValue.constraint->index;
-        mostDevQuadraticConstraints.value = maxQuadraticConstraintValue.normalizedValue;
-
-        auto nonlinTol = env->settings->getSetting<double>("Tolerance.NonlinearConstraint", "Primal");
-
-        if(mostDevQuadraticConstraints.value > nonlinTol)
+        if(primalSol.maxDevatingConstraintQuadratic.value > nonlinTol)
         {
             auto tmpLine = fmt::format("         Quadratic constraints are not fulfilled. Most deviating {}: {} > {}.",
-                maxQuadraticConstraintValue.constraint->index, maxQuadraticConstraintValue.error, nonlinTol);
+                primalSol.maxDevatingConstraintQuadratic.index, primalSol.maxDevatingConstraintQuadratic.value,
+                nonlinTol);
             env->output->outputDebug(tmpLine);
 
             return (false);
@@ -470,30 +449,20 @@ bool PrimalSolver::checkPrimalSolutionPoint(PrimalSolution primalSol)
         else
         {
             auto tmpLine = fmt::format("         Quadratic constraints are fulfilled. Most deviating {}: {} < {}.",
-                maxQuadraticConstraintValue.constraint->index, maxQuadraticConstraintValue.error, nonlinTol);
+                primalSol.maxDevatingConstraintQuadratic.index, primalSol.maxDevatingConstraintQuadratic.value,
+                nonlinTol);
             env->output->outputDebug(tmpLine);
         }
-
-        primalSol.maxDevatingConstraintQuadratic = mostDevQuadraticConstraints;
     }
 
     // Check if nonlinear constraints are fulfilled
     if(env->problem->properties.numberOfNonlinearConstraints > 0)
     {
-        PairIndexValue mostDevNonlinearConstraints;
-
-        auto maxNonlinearConstraintValue
-            = env->problem->getMaxNumericConstraintValue(tmpPoint, env->problem->nonlinearConstraints);
-
-        mostDevNonlinearConstraints.index = maxNonlinearConstraintValue.constraint->index;
-        mostDevNonlinearConstraints.value = maxNonlinearConstraintValue.normalizedValue;
-
-        auto nonlinTol = env->settings->getSetting<double>("Tolerance.NonlinearConstraint", "Primal");
-
-        if(mostDevNonlinearConstraints.value > nonlinTol)
+        if(primalSol.maxDevatingConstraintNonlinear.value > nonlinTol)
         {
             auto tmpLine = fmt::format("         Nonlinear constraints are not fulfilled. Most deviating {}: {} > {}.",
-                maxNonlinearConstraintValue.constraint->index, mostDevNonlinearConstraints.value, nonlinTol);
+                primalSol.maxDevatingConstraintNonlinear.index, primalSol.maxDevatingConstraintNonlinear.value,
+                nonlinTol);
             env->output->outputDebug(tmpLine);
 
             return (false);
@@ -501,11 +470,10 @@ bool PrimalSolver::checkPrimalSolutionPoint(PrimalSolution primalSol)
         else
         {
             auto tmpLine = fmt::format("         Nonlinear constraints are fulfilled. Most deviating {}: {} < {}.",
-                maxNonlinearConstraintValue.constraint->index, mostDevNonlinearConstraints.value, nonlinTol);
+                primalSol.maxDevatingConstraintNonlinear.index, primalSol.maxDevatingConstraintNonlinear.value,
+                nonlinTol);
             env->output->outputDebug(tmpLine);
         }
-
-        primalSol.maxDevatingConstraintNonlinear = mostDevNonlinearConstraints;
     }
 
     primalSol.objValue = tmpObjVal;
@@ -521,6 +489,36 @@ bool PrimalSolver::checkPrimalSolutionPoint(PrimalSolution primalSol)
     return (true);
 }
 
+void PrimalSolver::calculateMaxDeviatingConstraints(
+    const VectorDouble& point, PrimalSolution& solution, bool includeLinearConstraints)
+{
+    int numberOfThreads = env->settings->getSetting<int>("Tolerance.NumberOfThreads", "Primal");
+
+    MaxNumericConstraintValues maxValues;
+
+    // Candidates can be added from several threads, e.g. from MIP solver callbacks, and then the shared pool performs
+    // the tasks in the calling thread if another thread is using it
+    if(numberOfThreads != 1)
+        maxValues = env->problem->getMaxNumericConstraintValues(
+            point, includeLinearConstraints, &env->threadPool, numberOfThreads);
+    else
+        maxValues = env->problem->getMaxNumericConstraintValues(point, includeLinearConstraints);
+
+    if(maxValues.linear)
+        solution.maxDevatingConstraintLinear
+            = PairIndexValue(maxValues.linear->constraint->index, maxValues.linear->normalizedValue);
+
+    if(maxValues.quadratic)
+        solution.maxDevatingConstraintQuadratic
+            = PairIndexValue(maxValues.quadratic->constraint->index, maxValues.quadratic->normalizedValue);
+
+    if(maxValues.nonlinear)
+        solution.maxDevatingConstraintNonlinear
+            = PairIndexValue(maxValues.nonlinear->constraint->index, maxValues.nonlinear->normalizedValue);
+
+    solution.maxDeviatingConstraintsCalculated = includeLinearConstraints;
+}
+
 void PrimalSolver::addFixedNLPCandidate(
     VectorDouble pt, E_PrimalNLPSource source, double objVal, int iter, PairIndexValue maxConstrDev)
 {
@@ -531,42 +529,39 @@ void PrimalSolver::addFixedNLPCandidate(
 
     assert((int)candidate.size() == env->reformulatedProblem->properties.numberOfVariables);
 
-    VectorInteger discretVariableValues;
-    discretVariableValues.reserve(env->reformulatedProblem->properties.numberOfDiscreteVariables);
+    VectorInteger discreteVariableValues;
+    discreteVariableValues.reserve(env->reformulatedProblem->properties.numberOfDiscreteVariables);
 
     for(auto& VAR : env->reformulatedProblem->allVariables)
     {
         if(VAR->properties.type == E_VariableType::Binary || VAR->properties.type == E_VariableType::Integer
             || VAR->properties.type == E_VariableType::Semiinteger)
-            discretVariableValues.push_back(candidate[VAR->index]);
+            discreteVariableValues.push_back(static_cast<int>(std::round(candidate[VAR->index])));
     }
 
-    double pointHash;
+    double pointHash = Utilities::calculateHash(candidate);
 
-    if(env->settings->getSetting<bool>("FixedInteger.OnlyUniqueIntegerCombinations", "Primal"))
-    {
-        pointHash = Utilities::calculateHash(discretVariableValues);
-    }
-    else
-    {
-        pointHash = Utilities::calculateHash(candidate);
-    }
+    PrimalFixedNLPCandidate fixedNLPCandidate { candidate, source, objVal, iter, maxConstrDev, pointHash,
+        std::move(discreteVariableValues) };
 
-    if(!hasFixedNLPCandidateBeenTested(pointHash))
+    if(!hasFixedNLPCandidateBeenTested(fixedNLPCandidate))
     {
-        fixedPrimalNLPCandidates.push_back(
-            PrimalFixedNLPCandidate { candidate, source, objVal, iter, maxConstrDev, pointHash });
+        fixedPrimalNLPCandidates.push_back(std::move(fixedNLPCandidate));
     }
     else
         env->output->outputDebug(
             fmt::format("        Candidate for fixed integer search with hash {} has been used already.", pointHash));
 }
 
-bool PrimalSolver::hasFixedNLPCandidateBeenTested(double hash)
+bool PrimalSolver::hasFixedNLPCandidateBeenTested(const PrimalFixedNLPCandidate& candidate)
 {
+    if(env->settings->getSetting<bool>("FixedInteger.OnlyUniqueIntegerCombinations", "Primal"))
+        return (testedFixedNLPCandidates.count(candidate.discreteVariableValues) > 0);
+
+    // Otherwise the same integer combination can be resolved from a different point
     for(auto& IC : usedPrimalNLPCandidates)
     {
-        if(Utilities::isAlmostEqual(IC.discreteVariablePointHash, hash, 1e-8))
+        if(Utilities::isAlmostEqual(IC.discreteVariablePointHash, candidate.discreteVariablePointHash, 1e-8))
         {
             return (true);
         }
@@ -575,4 +570,76 @@ bool PrimalSolver::hasFixedNLPCandidateBeenTested(double hash)
     return (false);
 }
 
+void PrimalSolver::addTestedFixedNLPCandidate(
+    const PrimalFixedNLPCandidate& candidate, E_NLPSolutionStatus status, double objVal, int iter)
+{
+    usedPrimalNLPCandidates.push_back(candidate);
+    testedFixedNLPCandidates.insert_or_assign(
+        candidate.discreteVariableValues, TestedFixedNLPCandidate { status, objVal, iter });
+}
+
+void PrimalSolver::addAsynchronousTask(AsynchronousTask task) { asynchronousTasks.push_back(std::move(task)); }
+
+void PrimalSolver::startAsynchronousTasks()
+{
+    if(asynchronousTasks.size() == 0 || asynchronousTaskThread.joinable())
+        return;
+
+    env->output->outputDebug(
+        fmt::format("        Starting {} primal heuristics in the background.", asynchronousTasks.size()));
+
+    // The tasks evaluate functions with CppAD at the same time as the main thread
+    setupParallelAD();
+
+    asynchronousTaskThread = std::thread(
+        [this, tasks = std::move(asynchronousTasks)]()
+        {
+            try
+            {
+                for(auto& T : tasks)
+                    asynchronousTaskResults.push_back(T());
+            }
+            catch(...)
+            {
+                asynchronousTaskException = std::current_exception();
+            }
+        });
+
+    asynchronousTasks.clear();
+}
+
+void PrimalSolver::finishAsynchronousTasks()
+{
+    if(asynchronousTaskThread.joinable())
+        asynchronousTaskThread.join();
+
+    // Tasks that were added after the others were started, or when no MIP problem has been solved since
+    for(auto& T : asynchronousTasks)
+        asynchronousTaskResults.push_back(T());
+
+    asynchronousTasks.clear();
+
+    auto results = std::move(asynchronousTaskResults);
+    asynchronousTaskResults.clear();
+
+    for(auto& R : results)
+    {
+        if(R)
+            R();
+    }
+
+    // The results of the tasks that finished before are handled also if a task failed
+    if(asynchronousTaskException)
+    {
+        auto exception = asynchronousTaskException;
+        asynchronousTaskException = nullptr;
+        std::rethrow_exception(exception);
+    }
+}
+
+size_t DiscreteVariableValuesHasher::operator()(const VectorInteger& values) const
+{
+    return (Utilities::calculateFingerprint(values));
+}
+
 } // namespace SHOT
\ No newline at end of file
@@ -13,16 +13,34 @@
 #include "Enums.h"
 #include "Structs.h"
 
+#include <exception>
+#include <functional>
+#include <memory>
+#include <thread>
+#include <unordered_map>
+
 namespace SHOT
 {
 
+struct DiscreteVariableValuesHasher
+{
+    size_t operator()(const VectorInteger& values) const;
+};
+
 class PrimalSolver
 {
 public:
+    // A primal heuristic that can run in a background thread. It returns a function that is called in the main thread
+    // afterwards to handle its results, e.g. to add primal solution candidates.
+    using AsynchronousTask = std::function<std::function<void()>()>;
+
     PrimalSolver(EnvironmentPtr envPtr) { env = envPtr; }
 
     ~PrimalSolver()
     {
+        if(asynchronousTaskThread.joinable())
+            asynchronousTaskThread.join();
+
         primalSolutionCandidates.clear();
         fixedPrimalNLPCandidates.clear();
     }
@@ -40,14 +58,38 @@ public:
     void addFixedNLPCandidate(
         VectorDouble pt, E_PrimalNLPSource source, double objVal, int iter, PairIndexValue maxConstrDev);
 
-    bool hasFixedNLPCandidateBeenTested(double hash);
+    bool hasFixedNLPCandidateBeenTested(const PrimalFixedNLPCandidate& candidate);
+    void addTestedFixedNLPCandidate(
+        const PrimalFixedNLPCandidate& candidate, E_NLPSolutionStatus status, double objVal, int iter);
+
+    // The added tasks are started in a background thread when the next MIP problem is solved, so they must not change
+    // anything that the main thread uses while solving it, e.g. the dual or primal solvers
+    void addAsynchronousTask(AsynchronousTask task);
+    void startAsynchronousTasks();
+
+    // Waits for the started tasks (and performs those not started) and handles their results in the order in which the
+    // tasks were added
+    void finishAsynchronousTasks();
+
+    // Calculates the most deviating linear, quadratic and nonlinear constraints in the point in a single pass and
+    // stores them in the solution
+    void calculateMaxDeviatingConstraints(
+        const VectorDouble& point, PrimalSolution& solution, bool includeLinearConstraints = true);
 
     std::vector<PrimalSolution> primalSolutionCandidates;
     std::vector<PrimalFixedNLPCandidate> fixedPrimalNLPCandidates;
     std::vector<PrimalFixedNLPCandidate> usedPrimalNLPCandidates;
 
+    // The outcome of the fixed NLP problems solved for each combination of discrete variable values
+    std::unordered_map<VectorInteger, TestedFixedNLPCandidate, DiscreteVariableValuesHasher> testedFixedNLPCandidates;
+
 private:
     EnvironmentPtr env;
+
+    std::vector<AsynchronousTask> asynchronousTasks;
+    std::vector<std::function<void()>> asynchronousTaskResults;
+    std::thread asynchronousTaskThread;
+    std::exception_ptr asynchronousTaskException;
 };
 
 } // namespace SHOT
\ No newline at end of file
@@ -829,6 +829,39 @@ void Report::outputProblemInstanceReport()
                 " {:35s}{:<21d}{:s}", " - semiinteger:", env->problem->properties.numberOfSemiintegerVariables, ""));
     }
 
+    if(env->problem->properties.numberOfNonlinearExpressionNodes > 0
+        || env->reformulatedProblem->properties.numberOfNonlinearExpressionNodes > 0)
+    {
+        env->output->outputInfo("");
+
+        int numberOfNodesOrig = env->problem->properties.numberOfNonlinearExpressionNodes
+            - env->problem->properties.numberOfSharedNonlinearExpressionNodes;
+
+        if(isReformulated)
+        {
+            int numberOfNodesRef = env->reformulatedProblem->properties.numberOfNonlinearExpressionNodes
+                - env->reformulatedProblem->properties.numberOfSharedNonlinearExpressionNodes;
+
+            env->output->outputInfo(fmt::format(
+                " {:35s}{:<21d}{:d}", "Number of expression nodes:", numberOfNodesOrig, numberOfNodesRef));
+
+            if(env->problem->properties.numberOfSharedNonlinearExpressionNodes > 0
+                || env->reformulatedProblem->properties.numberOfSharedNonlinearExpressionNodes > 0)
+                env->output->outputInfo(fmt::format(" {:35s}{:<21d}{:d}",
+                    " - removed as common:", env->problem->properties.numberOfSharedNonlinearExpressionNodes,
+                    env->reformulatedProblem->properties.numberOfSharedNonlinearExpressionNodes));
+        }
+        else
+        {
+            env->output->outputInfo(
+                fmt::format(" {:35s}{:<21d}{:s}", "Number of expression nodes:", numberOfNodesOrig, ""));
+
+            if(env->problem->properties.numberOfSharedNonlinearExpressionNodes > 0)
+                env->output->outputInfo(fmt::format(" {:35s}{:<21d}{:s}", " - removed as common:",
+                    env->problem->properties.numberOfSharedNonlinearExpressionNodes, ""));
+        }
+    }
+
     if(env->problem->properties.numberOfSpecialOrderedSets
             + env->reformulatedProblem->properties.numberOfSpecialOrderedSets
         > 0)
@@ -1197,6 +1230,13 @@ void Report::outputSolutionReport()
     {
         env->output->outputInfo(fmt::format(
             " Fixed primal NLP problems solved:               {}", env->solutionStatistics.numberOfProblemsFixedNLP));
+
+        if(env->solutionStatistics.numberOfFixedNLPCandidatesAlreadyTested > 0)
+        {
+            env->output->outputInfo(fmt::format(" - candidates skipped as already tested:         {}",
+                env->solutionStatistics.numberOfFixedNLPCandidatesAlreadyTested));
+        }
+
         env->output->outputInfo("");
     }
 
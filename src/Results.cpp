@@ -11,6 +11,7 @@
 #include "Results.h"
 
 #include <algorithm>
+#include <cstdio>
 #include <limits>
 
 #include "EventHandler.h"
@@ -236,163 +237,99 @@ Results::~Results()
 
 std::string Results::getResultsOSrL()
 {
-    using namespace tinyxml2;
+    tinyxml2::XMLPrinter printer;
+    writeResultsOSrL(printer);
 
-    XMLDocument osrlDocument;
+    return (printer.CStr());
+}
 
-    auto osrlNode = osrlDocument.NewElement("osrl");
-    osrlNode->SetAttribute("xmlns", "os.optimizationservices.org");
-    osrlNode->SetAttribute("xmlns:xsi", "http://www.w3.org/2001/XMLSchema-instance");
-    osrlNode->SetAttribute(
-        "xmlns:schemaLocation", "os.optimizationservices.org http://www.optimizationservices.org/schemas/2.0/OSrL.xsd");
+bool Results::saveResultsOSrL(const std::string& fileName)
+{
+    FILE* file = fopen(fileName.c_str(), "wb");
 
-    osrlDocument.InsertFirstChild(osrlNode);
+    if(file == nullptr)
+        return (false);
 
-    auto generalNode = osrlDocument.NewElement("general");
+    tinyxml2::XMLPrinter printer(file);
+    writeResultsOSrL(printer);
 
-    auto instanceNameNode = osrlDocument.NewElement("instanceName");
-    instanceNameNode->SetText(env->settings->getSetting<std::string>("ProblemName", "Input").c_str());
-    generalNode->InsertFirstChild(instanceNameNode);
+    return (fclose(file) == 0);
+}
 
-    std::stringstream ssSolver;
-    ssSolver << "Supporting Hyperplane Optimization Toolkit, version ";
-    ssSolver << SHOT_VERSION_MAJOR << "." << SHOT_VERSION_MINOR << "." << SHOT_VERSION_PATCH;
-    auto solver = ssSolver.str();
-
-    auto solverInvoked = osrlDocument.NewElement("solverInvoked");
-    solverInvoked->SetText(solver.c_str());
-    generalNode->InsertFirstChild(solverInvoked);
-
-    auto otherResultsNode = osrlDocument.NewElement("otherResults");
-    otherResultsNode->SetAttribute("numberOfOtherResults", "1");
-    auto otherNode = osrlDocument.NewElement("other");
-    otherNode->SetAttribute("name", "UsedOptions");
-    otherNode->SetText(env->settings->getSettingsAsString(false, true).c_str());
-    otherResultsNode->InsertFirstChild(otherNode);
-
-    otherNode = osrlDocument.NewElement("other");
-    otherNode->SetAttribute("name", "DualObjectiveBound");
-    otherNode->SetAttribute("value", globalDualBound);
-    otherNode->SetAttribute("description", "The dual bound for the objective");
-    otherResultsNode->InsertEndChild(otherNode);
-
-    otherNode = osrlDocument.NewElement("other");
-    otherNode->SetAttribute("name", "PrimalObjectiveBound");
-    otherNode->SetAttribute("value", currentPrimalBound);
-    otherNode->SetAttribute("description", "The primal bound for the objective");
-    otherResultsNode->InsertEndChild(otherNode);
-
-    otherNode = osrlDocument.NewElement("other");
-    otherNode->SetAttribute("name", "MaxConstraintError");
-    otherNode->SetAttribute("value", getCurrentIteration()->maxDeviation);
-    otherNode->SetAttribute("description", "The maximal constraint error");
-    otherResultsNode->InsertEndChild(otherNode);
-
-    otherNode = osrlDocument.NewElement("other");
-    otherNode->SetAttribute("name", "AbsoluteOptimalityGap");
-    otherNode->SetAttribute("value", getAbsoluteGlobalObjectiveGap());
-    otherNode->SetAttribute("description", "The absolute optimality gap");
-    otherResultsNode->InsertEndChild(otherNode);
-
-    otherNode = osrlDocument.NewElement("other");
-    otherNode->SetAttribute("name", "RelativeOptimalityGap");
-    otherNode->SetAttribute("value", getRelativeGlobalObjectiveGap());
-    otherNode->SetAttribute("description", "The relative optimality gap");
-    otherResultsNode->InsertEndChild(otherNode);
-
-    otherNode = osrlDocument.NewElement("other");
-    otherNode->SetAttribute("name", "NumberOfLPProblems");
-    otherNode->SetAttribute("value", env->solutionStatistics.numberOfProblemsLP);
-    otherNode->SetAttribute("description", "The number of LP problems solved in the dual strategy");
-    otherResultsNode->InsertEndChild(otherNode);
-
-    otherNode = osrlDocument.NewElement("other");
-    otherNode->SetAttribute("name", "NumberOfQPProblems");
-    otherNode->SetAttribute("value", env->solutionStatistics.numberOfProblemsQP);
-    otherNode->SetAttribute("description", "The number of QP problems solved in the dual strategy");
-    otherResultsNode->InsertEndChild(otherNode);
-
-    otherNode = osrlDocument.NewElement("other");
-    otherNode->SetAttribute("name", "NumberOfFeasibleMILPProblems");
-    otherNode->SetAttribute("value", env->solutionStatistics.numberOfProblemsFeasibleMILP);
-    otherNode->SetAttribute("description", "The number of MILP problems solved to feasibility in the dual strategy");
-    otherResultsNode->InsertEndChild(otherNode);
-
-    otherNode = osrlDocument.NewElement("other");
-    otherNode->SetAttribute("name", "NumberOfFeasibleMIQPProblems");
-    otherNode->SetAttribute("value", env->solutionStatistics.numberOfProblemsFeasibleMIQP);
-    otherNode->SetAttribute("description", "The number of MIQP problems solved to feasibility in the dual strategy");
-    otherResultsNode->InsertEndChild(otherNode);
-
-    otherNode = osrlDocument.NewElement("other");
-    otherNode->SetAttribute("name", "NumberOfOptimalMILPProblems");
-    otherNode->SetAttribute("value", env->solutionStatistics.numberOfProblemsOptimalMILP);
-    otherNode->SetAttribute("description", "The number of MILP problems solved to optimality in the dual strategy");
-    otherResultsNode->InsertEndChild(otherNode);
-
-    otherNode = osrlDocument.NewElement("other");
-    otherNode->SetAttribute("name", "NumberOfOptimalMIQPProblems");
-    otherNode->SetAttribute("value", env->solutionStatistics.numberOfProblemsOptimalMIQP);
-    otherNode->SetAttribute("description", "The number of MIQP problems solved to optimality in the dual strategy");
-    otherResultsNode->InsertEndChild(otherNode);
+// The elements are written directly with the printer, i.e., without creating an XML document in memory first, since
+// the solutions are large for problems with many variables and constraints
+void Results::writeResultsOSrL(tinyxml2::XMLPrinter& printer)
+{
+    auto writeOtherResult = [&](const char* name, auto value, const char* description)
+    {
+        printer.OpenElement("other");
+        printer.PushAttribute("name", name);
+        printer.PushAttribute("value", value);
+        printer.PushAttribute("description", description);
+        printer.CloseElement();
+    };
+
+    printer.OpenElement("osrl");
+    printer.PushAttribute("xmlns", "os.optimizationservices.org");
+    printer.PushAttribute("xmlns:xsi", "http://www.w3.org/2001/XMLSchema-instance");
+    printer.PushAttribute(
+        "xmlns:schemaLocation", "os.optimizationservices.org http://www.optimizationservices.org/schemas/2.0/OSrL.xsd");
+
+    printer.OpenElement("general");
+
+    printer.OpenElement("otherResults");
+    printer.PushAttribute("numberOfOtherResults", "1");
+
+    printer.OpenElement("other");
+    printer.PushAttribute("name", "UsedOptions");
+    printer.PushText(env->settings->getSettingsAsString(false, true).c_str());
+    printer.CloseElement();
+
+    writeOtherResult("DualObjectiveBound", globalDualBound, "The dual bound for the objective");
+    writeOtherResult("PrimalObjectiveBound", currentPrimalBound, "The primal bound for the objective");
+    writeOtherResult("MaxConstraintError", getCurrentIteration()->maxDeviation, "The maximal constraint error");
+    writeOtherResult("AbsoluteOptimalityGap", getAbsoluteGlobalObjectiveGap(), "The absolute optimality gap");
+    writeOtherResult("RelativeOptimalityGap", getRelativeGlobalObjectiveGap(), "The relative optimality gap");
+
+    writeOtherResult("NumberOfLPProblems", env->solutionStatistics.numberOfProblemsLP,
+        "The number of LP problems solved in the dual strategy");
+    writeOtherResult("NumberOfQPProblems", env->solutionStatistics.numberOfProblemsQP,
+        "The number of QP problems solved in the dual strategy");
+    writeOtherResult("NumberOfFeasibleMILPProblems", env->solutionStatistics.numberOfProblemsFeasibleMILP,
+        "The number of MILP problems solved to feasibility in the dual strategy");
+    writeOtherResult("NumberOfFeasibleMIQPProblems", env->solutionStatistics.numberOfProblemsFeasibleMIQP,
+        "The number of MIQP problems solved to feasibility in the dual strategy");
+    writeOtherResult("NumberOfOptimalMILPProblems", env->solutionStatistics.numberOfProblemsOptimalMILP,
+        "The number of MILP problems solved to optimality in the dual strategy");
+    writeOtherResult("NumberOfOptimalMIQPProblems", env->solutionStatistics.numberOfProblemsOptimalMIQP,
+        "The number of MIQP problems solved to optimality in the dual strategy");
 
     int totalNumberOfProblems = env->solutionStatistics.numberOfProblemsLP
         + env->solutionStatistics.numberOfProblemsFeasibleMILP + env->solutionStatistics.numberOfProblemsOptimalMILP
         + env->solutionStatistics.numberOfProblemsQP + env->solutionStatistics.numberOfProblemsFeasibleMIQP
         + env->solutionStatistics.numberOfProblemsOptimalMIQP;
 
-    otherNode = osrlDocument.NewElement("other");
-    otherNode->SetAttribute("name", "TotalNumberOfDualProblems");
-    otherNode->SetAttribute("value", totalNumberOfProblems);
-    otherNode->SetAttribute("description", "The total number of problems solved in the dual strategy");
-    otherResultsNode->InsertEndChild(otherNode);
-
-    otherNode = osrlDocument.NewElement("other");
-    otherNode->SetAttribute("name", "NumberOfNLPProblems");
-    otherNode->SetAttribute("value", env->solutionStatistics.numberOfProblemsFixedNLP);
-    otherNode->SetAttribute("description", "The number of NLP problems solved in the primal strategy");
-    otherResultsNode->InsertEndChild(otherNode);
-
-    otherNode = osrlDocument.NewElement("other");
-    otherNode->SetAttribute("name", "NumberOfPrimalSolutionsFound");
-    otherNode->SetAttribute("value", env->solutionStatistics.numberOfFoundPrimalSolutions);
-    otherNode->SetAttribute("description", "The number of primal solutions found");
-    otherResultsNode->InsertEndChild(otherNode);
-
-    otherNode = osrlDocument.NewElement("other");
-    otherNode->SetAttribute("name", "NumberOfSuccesfulInfeasibilityRepairsPerformed");
-    otherNode->SetAttribute("value", env->solutionStatistics.numberOfSuccessfulDualRepairsPerformed);
-    otherNode->SetAttribute(
-        "description", "The number of sucessful infeasibility repairs performed for nonconvex problems");
-    otherResultsNode->InsertEndChild(otherNode);
-
-    otherNode = osrlDocument.NewElement("other");
-    otherNode->SetAttribute("name", "NumberOfUnsuccesfulInfeasibilityRepairsPerformed");
-    otherNode->SetAttribute("value", env->solutionStatistics.numberOfUnsuccessfulDualRepairsPerformed);
-    otherNode->SetAttribute(
-        "description", "The number of unsucessful infeasibility repairs performed for nonconvex problems");
-    otherResultsNode->InsertEndChild(otherNode);
-
-    otherNode = osrlDocument.NewElement("other");
-    otherNode->SetAttribute("name", "NumberOfReductionCutStepsPerformed");
-    otherNode->SetAttribute("value", env->solutionStatistics.numberOfPrimalReductionsPerformed);
-    otherNode->SetAttribute("description", "The number of reduction cut steps performed for nonconvex problems");
-    otherResultsNode->InsertEndChild(otherNode);
-
-    otherNode = osrlDocument.NewElement("other");
-    otherNode->SetAttribute("name", "numberOfPrimalImprovementsAfterInfeasibilityRepair");
-    otherNode->SetAttribute("value", env->solutionStatistics.numberOfPrimalImprovementsAfterInfeasibilityRepair);
-    otherNode->SetAttribute("description",
+    writeOtherResult(
+        "TotalNumberOfDualProblems", totalNumberOfProblems, "The total number of problems solved in the dual strategy");
+    writeOtherResult("NumberOfNLPProblems", env->solutionStatistics.numberOfProblemsFixedNLP,
+        "The number of NLP problems solved in the primal strategy");
+    writeOtherResult("NumberOfPrimalSolutionsFound", env->solutionStatistics.numberOfFoundPrimalSolutions,
+        "The number of primal solutions found");
+    writeOtherResult("NumberOfSuccesfulInfeasibilityRepairsPerformed",
+        env->solutionStatistics.numberOfSuccessfulDualRepairsPerformed,
+        "The number of sucessful infeasibility repairs performed for nonconvex problems");
+    writeOtherResult("NumberOfUnsuccesfulInfeasibilityRepairsPerformed",
+        env->solutionStatistics.numberOfUnsuccessfulDualRepairsPerformed,
+        "The number of unsucessful infeasibility repairs performed for nonconvex problems");
+    writeOtherResult("NumberOfReductionCutStepsPerformed", env->solutionStatistics.numberOfPrimalReductionsPerformed,
+        "The number of reduction cut steps performed for nonconvex problems");
+    writeOtherResult("numberOfPrimalImprovementsAfterInfeasibilityRepair",
+        env->solutionStatistics.numberOfPrimalImprovementsAfterInfeasibilityRepair,
         "The number of cases where the repairing of infeasibilities for nonconvex problems has directly resulted in "
         "improved primal solutions");
-    otherResultsNode->InsertEndChild(otherNode);
-
-    otherNode = osrlDocument.NewElement("other");
-    otherNode->SetAttribute("name", "numberOfPrimalImprovementsAfterReductionCut");
-    otherNode->SetAttribute("value", env->solutionStatistics.numberOfPrimalImprovementsAfterReductionCut);
-    otherNode->SetAttribute("description",
+    writeOtherResult("numberOfPrimalImprovementsAfterReductionCut",
+        env->solutionStatistics.numberOfPrimalImprovementsAfterReductionCut,
         "The number of cases where the primal reduction cut has directly resulted in improved primal solutions");
-    otherResultsNode->InsertEndChild(otherNode);
 
     auto dualSolver = static_cast<ES_MIPSolver>(env->settings->getSetting<int>("MIP.Solver", "Dual"));
     std::string dualSolverName;
@@ -418,372 +355,254 @@ std::string Results::getResultsOSrL()
     }
 #endif
 
-    otherNode = osrlDocument.NewElement("other");
-    otherNode->SetAttribute("name", "DualSolver");
-    otherNode->SetAttribute("value", (dualSolverName + " " + env->dualSolver->MIPSolver->getSolverVersion()).c_str());
-    otherNode->SetAttribute("description", "The dual solver used");
-    otherResultsNode->InsertEndChild(otherNode);
-
-    otherNode = osrlDocument.NewElement("other");
-    otherNode->SetAttribute("name", "FixedNLPSolver");
-    otherNode->SetAttribute("value", (dualSolverName + " " + env->dualSolver->MIPSolver->getSolverVersion()).c_str());
-    otherNode->SetAttribute("description", "The dual solver used");
-    otherResultsNode->InsertEndChild(otherNode);
+    writeOtherResult("DualSolver", (dualSolverName + " " + env->dualSolver->MIPSolver->getSolverVersion()).c_str(),
+        "The dual solver used");
+    writeOtherResult("FixedNLPSolver", (dualSolverName + " " + env->dualSolver->MIPSolver->getSolverVersion()).c_str(),
+        "The dual solver used");
 
     for(auto& S : this->primalSolutionSourceStatistics)
     {
-        otherNode = osrlDocument.NewElement("other");
+        printer.OpenElement("other");
 
         switch(S.first)
         {
         case E_PrimalSolutionSource::Rootsearch:
-            otherNode->SetAttribute("name", "NumberOfPrimalSolutionsFoundRootSearch");
-            otherNode->SetAttribute("description", "The number of primal solutions found with root search");
+            printer.PushAttribute("name", "NumberOfPrimalSolutionsFoundRootSearch");
+            printer.PushAttribute("description", "The number of primal solutions found with root search");
             break;
         case E_PrimalSolutionSource::RootsearchFixedIntegers:
-            otherNode->SetAttribute("name", "NumberOfPrimalSolutionsFoundRootSearchFixedIntegers");
-            otherNode->SetAttribute(
+            printer.PushAttribute("name", "NumberOfPrimalSolutionsFoundRootSearchFixedIntegers");
+            printer.PushAttribute(
                 "description", "The number of primal solutions found with root search and fixed integers");
             break;
         case E_PrimalSolutionSource::NLPFixedIntegers:
-            otherNode->SetAttribute("name", "NumberOfPrimalSolutionsFoundNLPFixedIntegers");
-            otherNode->SetAttribute(
+            printer.PushAttribute("name", "NumberOfPrimalSolutionsFoundNLPFixedIntegers");
+            printer.PushAttribute(
                 "description", "The number of primal solutions found by solving integer-fixed NLP problems");
             break;
         case E_PrimalSolutionSource::MIPSolutionPool:
-            otherNode->SetAttribute("name", "NumberOfPrimalSolutionsFoundMIPSolutionPool");
-            otherNode->SetAttribute("description", "The number of primal solutions found from the MIP solution pool");
+            printer.PushAttribute("name", "NumberOfPrimalSolutionsFoundMIPSolutionPool");
+            printer.PushAttribute("description", "The number of primal solutions found from the MIP solution pool");
             break;
         case E_PrimalSolutionSource::LPFixedIntegers:
-            otherNode->SetAttribute("name", "NumberOfPrimalSolutionsFoundLPFixedIntegers");
-            otherNode->SetAttribute(
+            printer.PushAttribute("name", "NumberOfPrimalSolutionsFoundLPFixedIntegers");
+            printer.PushAttribute(
                 "description", "The number of primal solutions found by solving integer-fixed LP problems");
             break;
         case E_PrimalSolutionSource::MIPCallback:
-            otherNode->SetAttribute("name", "NumberOfPrimalSolutionsFoundMIPCallback");
-            otherNode->SetAttribute("description", "The number of primal solutions found in MIP callbacks");
+            printer.PushAttribute("name", "NumberOfPrimalSolutionsFoundMIPCallback");
+            printer.PushAttribute("description", "The number of primal solutions found in MIP callbacks");
             break;
         case E_PrimalSolutionSource::InteriorPointSearch:
-            otherNode->SetAttribute("name", "NumberOfPrimalSolutionsFoundInteriorPointSearch");
-            otherNode->SetAttribute(
+            printer.PushAttribute("name", "NumberOfPrimalSolutionsFoundInteriorPointSearch");
+            printer.PushAttribute(
                 "description", "The number of primal solutions found when searching for interior point");
             break;
         default:
-            otherNode->SetAttribute("name", "NumberOfPrimalSolutionsFoundOther");
-            otherNode->SetAttribute("description", "The number of primal solutions found with unknown method");
+            printer.PushAttribute("name", "NumberOfPrimalSolutionsFoundOther");
+            printer.PushAttribute("description", "The number of primal solutions found with unknown method");
             break;
         }
 
-        otherNode->SetAttribute("value", S.second);
-        otherResultsNode->InsertEndChild(otherNode);
+        printer.PushAttribute("value", S.second);
+        printer.CloseElement();
     }
 
-    generalNode->InsertFirstChild(otherResultsNode);
+    printer.CloseElement(); // otherResults
 
-    osrlNode->InsertFirstChild(generalNode);
+    std::stringstream ssSolver;
+    ssSolver << "Supporting Hyperplane Optimization Toolkit, version ";
+    ssSolver << SHOT_VERSION_MAJOR << "." << SHOT_VERSION_MINOR << "." << SHOT_VERSION_PATCH;
+
+    printer.OpenElement("solverInvoked");
+    printer.PushText(ssSolver.str().c_str());
+    printer.CloseElement();
+
+    printer.OpenElement("instanceName");
+    printer.PushText(env->settings->getSetting<std::string>("ProblemName", "Input").c_str());
+    printer.CloseElement();
 
-    auto jobNode = osrlDocument.NewElement("job");
+    printer.CloseElement(); // general
 
-    auto timingInformationNode = osrlDocument.NewElement("timingInformation");
-    int numberOfTimes = 0;
+    printer.OpenElement("job");
+
+    printer.OpenElement("timingInformation");
+    printer.PushAttribute("numberOfTimes", (int)env->timing->timers.size());
 
     for(auto& T : env->timing->timers)
     {
-        auto timeNode = osrlDocument.NewElement("time");
-        timeNode->SetText(T.elapsed());
-        timeNode->SetAttribute("type", T.name.c_str());
-        timeNode->SetAttribute("unit", "second");
-        timeNode->SetAttribute("description", T.description.c_str());
-        timingInformationNode->InsertEndChild(timeNode);
-        numberOfTimes++;
+        printer.OpenElement("time");
+        printer.PushAttribute("type", T.name.c_str());
+        printer.PushAttribute("unit", "second");
+        printer.PushAttribute("description", T.description.c_str());
+        printer.PushText(T.elapsed());
+        printer.CloseElement();
     }
 
-    timingInformationNode->SetAttribute("numberOfTimes", numberOfTimes);
-    jobNode->InsertEndChild(timingInformationNode);
-
-    osrlNode->InsertEndChild(jobNode);
+    printer.CloseElement(); // timingInformation
+    printer.CloseElement(); // job
 
-    auto optimizationNode = osrlDocument.NewElement("optimization");
-    optimizationNode->SetAttribute("numberOfSolutions", (int)primalSolutions.size());
-    optimizationNode->SetAttribute("numberOfVariables", env->problem->properties.numberOfVariables);
-    optimizationNode->SetAttribute("numberOfConstraints",
+    printer.OpenElement("optimization");
+    printer.PushAttribute("numberOfSolutions", (int)primalSolutions.size());
+    printer.PushAttribute("numberOfVariables", env->problem->properties.numberOfVariables);
+    printer.PushAttribute("numberOfConstraints",
         env->problem->properties.numberOfNumericConstraints - env->problem->properties.numberOfAddedLinearizations);
-    optimizationNode->SetAttribute("numberOfObjectives", 1);
-
-    auto solutionNode = osrlDocument.NewElement("solution");
+    printer.PushAttribute("numberOfObjectives", 1);
 
     int numPrimalSols = primalSolutions.size();
 
     int numSaveSolutions = std::min(env->settings->getSetting<int>("SaveNumberOfSolutions", "Output"), numPrimalSols);
 
-    auto statusNode = osrlDocument.NewElement("status");
+    std::string statusType;
+    std::string statusDescription;
+    std::string substatusType;
 
     if(this->terminationReason == E_TerminationReason::AbsoluteGap
         || this->terminationReason == E_TerminationReason::RelativeGap)
     {
-        statusNode->SetAttribute("type", "globallyOptimal");
-        statusNode->SetAttribute("description", "Solved to global optimality");
-
-        statusNode->SetAttribute("numberOfSubstatuses", 1);
-
-        auto substatusNode = osrlDocument.NewElement("substatus");
-        substatusNode->SetAttribute("type", "stoppedByBounds");
-        substatusNode->SetAttribute("description", terminationReasonDescription.c_str());
-        statusNode->InsertFirstChild(substatusNode);
+        statusType = "globallyOptimal";
+        statusDescription = "Solved to global optimality";
+        substatusType = "stoppedByBounds";
     }
     else if(this->terminationReason == E_TerminationReason::ConstraintTolerance)
     {
-        statusNode->SetAttribute("type", "locallyOptimal");
-        statusNode->SetAttribute("description", "Solved to local optimality");
-
-        statusNode->SetAttribute("numberOfSubstatuses", 1);
-
-        auto substatusNode = osrlDocument.NewElement("substatus");
-        substatusNode->SetAttribute("type", "stoppedByBounds");
-        substatusNode->SetAttribute("description", terminationReasonDescription.c_str());
-        statusNode->InsertFirstChild(substatusNode);
+        statusType = "locallyOptimal";
+        statusDescription = "Solved to local optimality";
+        substatusType = "stoppedByBounds";
     }
     else if(hasPrimalSolution())
     {
-        statusNode->SetAttribute("type", "feasible");
-        statusNode->SetAttribute("description", "Feasible solution found");
-
-        if(terminationReasonDescription != "")
-        {
-            statusNode->SetAttribute("numberOfSubstatuses", 1);
-
-            auto substatusNode = osrlDocument.NewElement("substatus");
-            substatusNode->SetAttribute("type", "other");
-            substatusNode->SetAttribute("description", terminationReasonDescription.c_str());
-            statusNode->InsertFirstChild(substatusNode);
-        }
+        statusType = "feasible";
+        statusDescription = "Feasible solution found";
+        substatusType = "other";
     }
     else if(this->terminationReason == E_TerminationReason::InfeasibleProblem)
     {
-        statusNode->SetAttribute("type", "infeasible");
-        statusNode->SetAttribute("description", "No solution found since dual problem is infeasible");
-
-        if(terminationReasonDescription != "")
-        {
-            statusNode->SetAttribute("numberOfSubstatuses", 1);
-
-            auto substatusNode = osrlDocument.NewElement("substatus");
-            substatusNode->SetAttribute("type", "other");
-            substatusNode->SetAttribute("description", terminationReasonDescription.c_str());
-            statusNode->InsertFirstChild(substatusNode);
-        }
+        statusType = "infeasible";
+        statusDescription = "No solution found since dual problem is infeasible";
+        substatusType = "other";
     }
     else if(this->terminationReason == E_TerminationReason::UnboundedProblem)
     {
-        statusNode->SetAttribute("type", "unbounded");
-        statusNode->SetAttribute("description", "No solution found since dual problem is unbounded");
-
-        if(terminationReasonDescription != "")
-        {
-            statusNode->SetAttribute("numberOfSubstatuses", 1);
-
-            auto substatusNode = osrlDocument.NewElement("substatus");
-            substatusNode->SetAttribute("type", "other");
-            substatusNode->SetAttribute("description", terminationReasonDescription.c_str());
-            statusNode->InsertFirstChild(substatusNode);
-        }
+        statusType = "unbounded";
+        statusDescription = "No solution found since dual problem is unbounded";
+        substatusType = "other";
     }
-    else if(this->terminationReason == E_TerminationReason::ObjectiveStagnation)
+    else if(this->terminationReason == E_TerminationReason::ObjectiveStagnation
+        || this->terminationReason == E_TerminationReason::NoDualCutsAdded
+        || this->terminationReason == E_TerminationReason::IterationLimit
+        || this->terminationReason == E_TerminationReason::TimeLimit)
     {
-        statusNode->SetAttribute("type", "other");
-        statusNode->SetAttribute("description", "No solution found");
-
-        if(terminationReasonDescription != "")
-        {
-            statusNode->SetAttribute("numberOfSubstatuses", 1);
-
-            auto substatusNode = osrlDocument.NewElement("substatus");
-            substatusNode->SetAttribute("type", "stoppedByLimit");
-            substatusNode->SetAttribute("description", terminationReasonDescription.c_str());
-            statusNode->InsertFirstChild(substatusNode);
-        }
+        statusType = "other";
+        statusDescription = "No solution found";
+        substatusType = "stoppedByLimit";
     }
-    else if(this->terminationReason == E_TerminationReason::NoDualCutsAdded)
+    else if(this->terminationReason == E_TerminationReason::NumericIssues
+        || this->terminationReason == E_TerminationReason::Error)
     {
-        statusNode->SetAttribute("type", "other");
-        statusNode->SetAttribute("description", "No solution found");
-
-        if(terminationReasonDescription != "")
-        {
-            statusNode->SetAttribute("numberOfSubstatuses", 1);
-
-            auto substatusNode = osrlDocument.NewElement("substatus");
-            substatusNode->SetAttribute("type", "stoppedByLimit");
-            substatusNode->SetAttribute("description", terminationReasonDescription.c_str());
-            statusNode->InsertFirstChild(substatusNode);
-        }
-    }
-    else if(this->terminationReason == E_TerminationReason::IterationLimit)
-    {
-        statusNode->SetAttribute("type", "other");
-        statusNode->SetAttribute("description", "No solution found");
-
-        if(terminationReasonDescription != "")
-        {
-            statusNode->SetAttribute("numberOfSubstatuses", 1);
-
-            auto substatusNode = osrlDocument.NewElement("substatus");
-            substatusNode->SetAttribute("type", "stoppedByLimit");
-            substatusNode->SetAttribute("description", terminationReasonDescription.c_str());
-            statusNode->InsertFirstChild(substatusNode);
-        }
-    }
-    else if(this->terminationReason == E_TerminationReason::TimeLimit)
-    {
-        statusNode->SetAttribute("type", "other");
-        statusNode->SetAttribute("description", "No solution found");
-
-        if(terminationReasonDescription != "")
-        {
-            statusNode->SetAttribute("numberOfSubstatuses", 1);
-
-            auto substatusNode = osrlDocument.NewElement("substatus");
-            substatusNode->SetAttribute("type", "stoppedByLimit");
-            substatusNode->SetAttribute("description", terminationReasonDescription.c_str());
-            statusNode->InsertFirstChild(substatusNode);
-        }
-    }
-    else if(this->terminationReason == E_TerminationReason::NumericIssues)
-    {
-        statusNode->SetAttribute("type", "error");
-        statusNode->SetAttribute("description", "No solution found since an error occured");
-
-        if(terminationReasonDescription != "")
-        {
-            statusNode->SetAttribute("numberOfSubstatuses", 1);
-
-            auto substatusNode = osrlDocument.NewElement("substatus");
-            substatusNode->SetAttribute("type", "stoppedByLimit");
-            substatusNode->SetAttribute("description", terminationReasonDescription.c_str());
-            statusNode->InsertFirstChild(substatusNode);
-        }
+        statusType = "error";
+        statusDescription = "No solution found since an error occured";
+        substatusType = "stoppedByLimit";
     }
     else if(this->terminationReason == E_TerminationReason::UserAbort)
     {
-        statusNode->SetAttribute("type", "other");
-        statusNode->SetAttribute("description", "No solution found due to user abort");
-
-        if(terminationReasonDescription != "")
-        {
-            statusNode->SetAttribute("numberOfSubstatuses", 1);
-
-            auto substatusNode = osrlDocument.NewElement("substatus");
-            substatusNode->SetAttribute("type", "stoppedByLimit");
-            substatusNode->SetAttribute("description", terminationReasonDescription.c_str());
-            statusNode->InsertFirstChild(substatusNode);
-        }
-    }
-    else if(this->terminationReason == E_TerminationReason::Error)
-    {
-        statusNode->SetAttribute("type", "error");
-        statusNode->SetAttribute("description", "No solution found since an error occured");
-
-        if(terminationReasonDescription != "")
-        {
-            statusNode->SetAttribute("numberOfSubstatuses", 1);
-
-            auto substatusNode = osrlDocument.NewElement("substatus");
-            substatusNode->SetAttribute("type", "stoppedByLimit");
-            substatusNode->SetAttribute("description", terminationReasonDescription.c_str());
-            statusNode->InsertFirstChild(substatusNode);
-        }
+        statusType = "other";
+        statusDescription = "No solution found due to user abort";
+        substatusType = "stoppedByLimit";
     }
     else
     {
-        statusNode->SetAttribute("type", "other");
-        statusNode->SetAttribute("description", "Unknown return code obtained from solver");
-
-        if(terminationReasonDescription != "")
-        {
-            statusNode->SetAttribute("numberOfSubstatuses", 1);
-
-            auto substatusNode = osrlDocument.NewElement("substatus");
-            substatusNode->SetAttribute("type", "stoppedByLimit");
-            substatusNode->SetAttribute("description", terminationReasonDescription.c_str());
-            statusNode->InsertFirstChild(substatusNode);
-        }
+        statusType = "other";
+        statusDescription = "Unknown return code obtained from solver";
+        substatusType = "stoppedByLimit";
 
         env->output->outputError(
             fmt::format(" Unknown return code {} obtained from solver.", static_cast<int>(this->terminationReason)));
     }
 
-    solutionNode->InsertFirstChild(statusNode);
+    // The substatus with the termination reason is only omitted if there is no description of it
+    bool hasSubstatus = (statusType == "globallyOptimal" || statusType == "locallyOptimal"
+        || terminationReasonDescription != "");
 
     for(int i = 0; i < numSaveSolutions; i++)
     {
-        if(i > 0)
-        {
-            solutionNode = osrlDocument.NewElement("solution");
-            statusNode = osrlDocument.NewElement("status");
-            statusNode->SetAttribute("type", "feasible");
-            statusNode->SetAttribute("description", "Additional primal solution");
-            solutionNode->InsertFirstChild(statusNode);
-        }
+        auto& solution = primalSolutions.at(i);
 
-        auto objectivesNode = osrlDocument.NewElement("objectives");
+        printer.OpenElement("solution");
 
-        auto objectiveValueNode = osrlDocument.NewElement("values");
-        objectiveValueNode->SetAttribute("numberOfObj", 1);
+        printer.OpenElement("constraints");
+        printer.OpenElement("dualValues");
+        printer.PushAttribute("numberOfCon", (int)env->problem->properties.numberOfNumericConstraints);
 
-        auto objectiveSolutionNode = osrlDocument.NewElement("obj");
-        objectiveSolutionNode->SetAttribute("idx", -1);
-        objectiveSolutionNode->SetText(std::to_string(primalSolutions.at(i).objValue).c_str());
-        objectiveValueNode->InsertFirstChild(objectiveSolutionNode);
-
-        objectivesNode->InsertFirstChild(objectiveValueNode);
-        solutionNode->InsertFirstChild(objectivesNode);
+        for(size_t j = 0; j < env->problem->numericConstraints.size(); j++)
+        {
+            printer.OpenElement("con");
+            printer.PushAttribute("idx", (int)j);
+            printer.PushAttribute("name", env->problem->numericConstraints.at(j)->name.c_str());
+            printer.PushText(std::to_string(
+                env->problem->numericConstraints.at(j)->calculateNumericValue(solution.point).normalizedValue)
+                                 .c_str());
+            printer.CloseElement();
+        }
 
-        auto variablesNode = osrlDocument.NewElement("variables");
+        printer.CloseElement(); // dualValues
+        printer.CloseElement(); // constraints
 
-        auto variableValueNode = osrlDocument.NewElement("values");
-        variableValueNode->SetAttribute("numberOfVar", (int)primalSolutions.at(i).point.size());
+        printer.OpenElement("variables");
+        printer.OpenElement("values");
+        printer.PushAttribute("numberOfVar", (int)solution.point.size());
 
-        for(size_t j = 0; j < primalSolutions.at(i).point.size(); j++)
+        for(size_t j = 0; j < solution.point.size(); j++)
         {
-            auto variableSolutionNode = osrlDocument.NewElement("var");
-            variableSolutionNode->SetAttribute("idx", (int)j);
-            variableSolutionNode->SetAttribute("name", env->problem->allVariables.at(j)->name.c_str());
-            variableSolutionNode->SetText(std::to_string(primalSolutions.at(i).point.at(j)).c_str());
-            variableValueNode->InsertEndChild(variableSolutionNode);
+            printer.OpenElement("var");
+            printer.PushAttribute("idx", (int)j);
+            printer.PushAttribute("name", env->problem->allVariables.at(j)->name.c_str());
+            printer.PushText(std::to_string(solution.point.at(j)).c_str());
+            printer.CloseElement();
         }
 
-        variablesNode->InsertFirstChild(variableValueNode);
-        solutionNode->InsertFirstChild(variablesNode);
+        printer.CloseElement(); // values
+        printer.CloseElement(); // variables
 
-        auto constraintsNode = osrlDocument.NewElement("constraints");
+        printer.OpenElement("objectives");
+        printer.OpenElement("values");
+        printer.PushAttribute("numberOfObj", 1);
+        printer.OpenElement("obj");
+        printer.PushAttribute("idx", -1);
+        printer.PushText(std::to_string(solution.objValue).c_str());
+        printer.CloseElement(); // obj
+        printer.CloseElement(); // values
+        printer.CloseElement(); // objectives
 
-        auto dualValuesNode = osrlDocument.NewElement("dualValues");
-        dualValuesNode->SetAttribute("numberOfCon", (int)env->problem->properties.numberOfNumericConstraints);
+        printer.OpenElement("status");
 
-        for(size_t j = 0; j < env->problem->numericConstraints.size(); j++)
+        if(i == 0)
         {
-            auto dualValueNode = osrlDocument.NewElement("con");
-            dualValueNode->SetAttribute("idx", (int)j);
-            dualValueNode->SetAttribute("name", env->problem->numericConstraints.at(j)->name.c_str());
-            dualValueNode->SetText(std::to_string(env->problem->numericConstraints.at(j)
-                                                      ->calculateNumericValue(primalSolutions.at(i).point)
-                                                      .normalizedValue)
-                                       .c_str());
-            dualValuesNode->InsertEndChild(dualValueNode);
+            printer.PushAttribute("type", statusType.c_str());
+            printer.PushAttribute("description", statusDescription.c_str());
+
+            if(hasSubstatus)
+            {
+                printer.PushAttribute("numberOfSubstatuses", 1);
+
+                printer.OpenElement("substatus");
+                printer.PushAttribute("type", substatusType.c_str());
+                printer.PushAttribute("description", terminationReasonDescription.c_str());
+                printer.CloseElement();
+            }
+        }
+        else
+        {
+            printer.PushAttribute("type", "feasible");
+            printer.PushAttribute("description", "Additional primal solution");
         }
 
-        constraintsNode->InsertFirstChild(dualValuesNode);
-        solutionNode->InsertFirstChild(constraintsNode);
-
-        optimizationNode->InsertEndChild(solutionNode);
+        printer.CloseElement(); // status
+        printer.CloseElement(); // solution
     }
 
-    osrlNode->InsertEndChild(optimizationNode);
-
-    XMLPrinter printer;
-    osrlDocument.Print(&printer);
-
-    return (printer.CStr());
+    printer.CloseElement(); // optimization
+    printer.CloseElement(); // osrl
 }
 
 std::string Results::getResultsTrace()
@@ -950,6 +769,55 @@ std::string Results::getResultsTrace()
 }
 
 std::string Results::getResultsSol()
+{
+    std::stringstream ss;
+    writeResultsSol(ss);
+
+    return (ss.str());
+}
+
+bool Results::saveResultsSol(const std::string& fileName)
+{
+    std::ofstream file(fileName, std::ios::binary);
+
+    if(!file)
+        return (false);
+
+    writeResultsSol(file);
+    file.close();
+
+    return (!file.fail());
+}
+
+// The binary solution file starts with a header of 32 bytes, after which the values of the variables in the primal
+// solution follow as doubles, so that the solution can be memory-mapped directly. The header consists of the eight
+// characters SHOTSOL and a null character, the format version and the model return status as 32-bit integers, the
+// number of variables (zero if there is no primal solution) as a 64-bit unsigned integer and the objective value. All
+// values are in the byte order of the machine.
+bool Results::saveResultsBinary(const std::string& fileName)
+{
+    std::ofstream file(fileName, std::ios::binary);
+
+    if(!file)
+        return (false);
+
+    uint32_t version = 1;
+    int32_t modelReturnStatus = static_cast<int>(getModelReturnStatus());
+    uint64_t numberOfVariables = primalSolution.size();
+    double objectiveValue = hasPrimalSolution() ? currentPrimalBound : NAN;
+
+    file.write("SHOTSOL", 8);
+    file.write(reinterpret_cast<const char*>(&version), sizeof(version));
+    file.write(reinterpret_cast<const char*>(&modelReturnStatus), sizeof(modelReturnStatus));
+    file.write(reinterpret_cast<const char*>(&numberOfVariables), sizeof(numberOfVariables));
+    file.write(reinterpret_cast<const char*>(&objectiveValue), sizeof(objectiveValue));
+    file.write(reinterpret_cast<const char*>(primalSolution.data()), primalSolution.size() * sizeof(double));
+    file.close();
+
+    return (!file.fail());
+}
+
+void Results::writeResultsSol(std::ostream& stream)
 {
     std::string status = "";
     std::string description = "";
@@ -1016,37 +884,87 @@ std::string Results::getResultsSol()
         description = "No solution found since an error occured";
     }
 
-    std::stringstream ss;
-
-    ss << fmt::format("SHOT: {}\n", description);
+    stream << fmt::format("SHOT: {}\n", description);
 
-    ss << "\nOptions\n";
+    stream << "\nOptions\n";
 
-    ss << env->settings->getSetting<std::string>("AMPL.OptionsHeader", "ModelingSystem");
+    stream << env->settings->getSetting<std::string>("AMPL.OptionsHeader", "ModelingSystem");
 
-    ss << fmt::format("{0}\n{1}\n{2}\n{3}\n",
+    stream << fmt::format("{0}\n{1}\n{2}\n{3}\n",
         env->settings->getSetting<int>("AMPL.NumberOfOriginalConstraints", "ModelingSystem"), 0,
         env->problem->properties.numberOfVariables, env->problem->properties.numberOfVariables);
 
     if(this->primalSolution.size() > 0)
     {
         for(auto const& V : this->primalSolution)
-            ss << fmt::format("{}\n", V);
+            stream << fmt::format("{}\n", V);
     }
     else
     {
         {
             for(int i = 0; i < env->problem->properties.numberOfVariables; i++)
-                ss << fmt::format("{}\n", 0);
+                stream << fmt::format("{}\n", 0);
         }
     }
 
-    ss << fmt::format("objno 0 {}", status);
+    stream << fmt::format("objno 0 {}", status);
+}
 
-    return (ss.str());
+void Results::createIteration()
+{
+    iterations.push_back(std::make_shared<Iteration>(env));
+
+    // The points are only used in the next few iterations, so for older iterations they are only kept on file (if at
+    // all) to limit the memory used for large problems and long runs
+    size_t numberOfFullIterations = env->settings->getSetting<int>("IterationHistory.FullIterations", "Output");
+
+    while(numberOfCompactedIterations + numberOfFullIterations < iterations.size())
+    {
+        writeIterationToHistoryFile(iterations[numberOfCompactedIterations]);
+        iterations[numberOfCompactedIterations]->compact();
+        numberOfCompactedIterations++;
+    }
+}
+
+// The file starts with the eight characters SHOTITER and the format version as a 32-bit unsigned integer, followed by
+// one record per iteration as written by Iteration::writeBinary. All values are in the byte order of the machine.
+void Results::writeIterationToHistoryFile(IterationPtr iteration)
+{
+    if(!iterationHistoryFile)
+    {
+        auto fileName = env->settings->getSetting<std::string>("IterationHistory.File", "Output");
+
+        if(fileName == "")
+            return;
+
+        iterationHistoryFile = std::make_unique<std::ofstream>(fileName, std::ios::binary | std::ios::trunc);
+
+        if(!*iterationHistoryFile)
+        {
+            env->output->outputError("        Could not open iteration history file " + fileName);
+            return;
+        }
+
+        uint32_t version = 1;
+        iterationHistoryFile->write("SHOTITER", 8);
+        iterationHistoryFile->write(reinterpret_cast<const char*>(&version), sizeof(version));
+    }
+
+    // Writing does nothing if the file could not be opened
+    iteration->writeBinary(*iterationHistoryFile);
 }
 
-void Results::createIteration() { iterations.push_back(std::make_shared<Iteration>(env)); }
+void Results::saveIterationHistory()
+{
+    if(env->settings->getSetting<std::string>("IterationHistory.File", "Output") == "")
+        return;
+
+    for(size_t i = numberOfCompactedIterations; i < iterations.size(); i++)
+        writeIterationToHistoryFile(iterations[i]);
+
+    if(iterationHistoryFile)
+        iterationHistoryFile->close();
+}
 
 IterationPtr Results::getCurrentIteration() { return (iterations.back()); }
 
@@ -10,6 +10,7 @@
 
 #pragma once
 
+#include <fstream>
 #include <map>
 #include <memory>
 #include <vector>
@@ -71,6 +72,9 @@ public:
     std::vector<IterationPtr> iterations;
     int getNumberOfIterations();
 
+    // Writes the iterations not yet written to the file given by the setting IterationHistory.File
+    void saveIterationHistory();
+
     E_TerminationReason terminationReason = E_TerminationReason::None;
     std::string terminationReasonDescription;
 
@@ -89,6 +93,13 @@ public:
     std::string getResultsTrace();
     std::string getResultsSol();
 
+    // Write the results directly to file without first creating them in memory, returns false if writing fails
+    bool saveResultsOSrL(const std::string& fileName);
+    bool saveResultsSol(const std::string& fileName);
+
+    // Saves the primal solution in a binary format that can be memory-mapped, see Results.cpp for the format
+    bool saveResultsBinary(const std::string& fileName);
+
     void savePrimalSolutionToFile(
         const PrimalSolution& solution, const VectorString& variables, const std::string& fileName);
     void savePrimalSolutionToFile(
@@ -99,6 +110,15 @@ public:
 
 private:
     EnvironmentPtr env;
+
+    void writeResultsOSrL(tinyxml2::XMLPrinter& printer);
+    void writeResultsSol(std::ostream& stream);
+
+    // The iterations before this index have been compacted, i.e., their points have been released
+    size_t numberOfCompactedIterations = 0;
+
+    std::unique_ptr<std::ofstream> iterationHistoryFile;
+    void writeIterationToHistoryFile(IterationPtr iteration);
 };
 
 } // namespace SHOT
\ No newline at end of file
@@ -21,9 +21,6 @@
 
 namespace SHOT
 {
-std::vector<NumericConstraint*> activeConstraints;
-double lastActiveConstraintUpdateValue;
-
 Test::Test(EnvironmentPtr envPtr) : env(envPtr) {}
 
 Test::~Test()
@@ -58,15 +55,15 @@ double Test::operator()(const double x)
 
     auto currentConstraints = getActiveConstraints();
 
-    std::vector<NumericConstraint*> activeConstraints;
+    std::vector<NumericConstraint*> newActiveConstraints;
 
-    auto constraintValue = problem->getMaxNumericConstraintValue(ptNew, currentConstraints, activeConstraints);
+    auto constraintValue = problem->getMaxNumericConstraintValue(ptNew, currentConstraints, newActiveConstraints);
     double calculatedValue = constraintValue.normalizedValue;
 
     if(!constraintValue.isFulfilled && calculatedValue <= lastActiveConstraintUpdateValue
-        && activeConstraints.size() < currentConstraints.size())
+        && newActiveConstraints.size() < currentConstraints.size())
     {
-        setActiveConstraints(activeConstraints);
+        setActiveConstraints(newActiveConstraints);
         lastActiveConstraintUpdateValue = calculatedValue;
     }
 
@@ -89,11 +86,11 @@ double TestObjective::operator()(const double x)
 
 RootsearchMethodBoost::RootsearchMethodBoost(EnvironmentPtr envPtr) : env(envPtr)
 {
-    test = std::make_unique<Test>(env);
     testObjective = std::make_unique<TestObjective>(env);
+    settingMethod = env->settings->getSettingHandle<int>("Rootsearch.Method", "Subsolver");
 }
 
-RootsearchMethodBoost::~RootsearchMethodBoost() { activeConstraints.clear(); }
+RootsearchMethodBoost::~RootsearchMethodBoost() = default;
 
 std::pair<VectorDouble, VectorDouble> RootsearchMethodBoost::findZero(const VectorDouble& ptA, const VectorDouble& ptB,
     int Nmax, double lambdaTol, double constrTol, const NonlinearConstraints constraints,
@@ -125,6 +122,9 @@ std::pair<VectorDouble, VectorDouble> RootsearchMethodBoost::findZero(const Vect
         env->output->outputError("        No constraints selected for root search");
     }
 
+    // A new instance is used in each call so that several root searches can be performed concurrently
+    auto test = std::make_unique<Test>(env);
+
     if(auto sharedProblem = constraints[0]->ownerProblem.lock())
     {
         test->problem = sharedProblem.get();
@@ -170,8 +170,7 @@ std::pair<VectorDouble, VectorDouble> RootsearchMethodBoost::findZero(const Vect
 
     PairDouble r1;
 
-    if(static_cast<ES_RootsearchMethod>(env->settings->getSetting<int>("Rootsearch.Method", "Subsolver"))
-        == ES_RootsearchMethod::BoostTOMS748)
+    if(static_cast<ES_RootsearchMethod>(settingMethod.get()) == ES_RootsearchMethod::BoostTOMS748)
     {
         r1 = boost::math::tools::toms748_solve(*test, 0.0, 1.0, TerminationCondition(lambdaTol), max_iter);
     }
@@ -240,8 +239,7 @@ std::pair<double, double> RootsearchMethodBoost::findZero(const VectorDouble& pt
 
     PairDouble r1;
 
-    if(static_cast<ES_RootsearchMethod>(env->settings->getSetting<int>("Rootsearch.Method", "Subsolver"))
-        == ES_RootsearchMethod::BoostTOMS748)
+    if(static_cast<ES_RootsearchMethod>(settingMethod.get()) == ES_RootsearchMethod::BoostTOMS748)
     {
         r1 = boost::math::tools::toms748_solve(*testObjective, 0.0, 1.0, TerminationCondition(lambdaTol), max_iter);
     }
@@ -11,14 +11,20 @@
 #pragma once
 #include "IRootsearchMethod.h"
 #include "../Environment.h"
+#include "../Settings.h"
 
 namespace SHOT
 {
+// Evaluates the constraints along the line between two points. Since the set of active constraints is updated during
+// the search, a separate instance is used for each root search so that searches can be run in parallel.
 class Test
 {
 private:
     EnvironmentPtr env;
 
+    std::vector<NumericConstraint*> activeConstraints;
+    double lastActiveConstraintUpdateValue = 0.0;
+
 public:
     Problem* problem;
 
@@ -85,8 +91,9 @@ public:
         double lambdaTol, double constrTol, ObjectiveFunctionPtr objectiveFunction) override;
 
 private:
-    std::unique_ptr<Test> test;
     std::unique_ptr<TestObjective> testObjective;
     EnvironmentPtr env;
+
+    SettingHandle<int> settingMethod;
 };
 } // namespace SHOT
\ No newline at end of file
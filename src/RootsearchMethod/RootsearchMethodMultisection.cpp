@@ -0,0 +1,404 @@
+/**
+   The Supporting Hyperplane Optimization Toolkit (SHOT).
+
+   @author Andreas Lundell, Åbo Akademi University
+
+   @section LICENSE
+   This software is licensed under the Eclipse Public License 2.0.
+   Please see the README and LICENSE files for more information.
+*/
+
+#include "RootsearchMethodMultisection.h"
+#include "../Output.h"
+#include "../Settings.h"
+#include "../Model/Problem.h"
+#include "../Model/PointBatch.h"
+#include "../Results.h"
+#include "../PrimalSolver.h"
+#include "../Iteration.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace SHOT
+{
+
+const VectorDouble& MultisectionBracket::getNextPoints(int numberOfPoints)
+{
+    points.clear();
+
+    double width = upper - lower;
+
+    // Three of the points are used for the regula falsi point and the points on both sides of it
+    int numberOfSubintervals = std::max(2, numberOfPoints - 2);
+
+    for(int i = 1; i < numberOfSubintervals; i++)
+        points.push_back(lower + width * i / numberOfSubintervals);
+
+    if(valueLower != valueUpper)
+    {
+        double point = lower + width * valueLower / (valueLower - valueUpper);
+        double distance = 1e-3 * width;
+
+        points.push_back(point - distance);
+        points.push_back(point);
+        points.push_back(point + distance);
+    }
+
+    // When the bracket is very narrow, the points may coincide with each other or with the ends
+    points.erase(std::remove_if(points.begin(), points.end(),
+                     [&](double point) { return (!(point > lower && point < upper)); }),
+        points.end());
+
+    std::sort(points.begin(), points.end());
+    points.erase(std::unique(points.begin(), points.end()), points.end());
+
+    return (points);
+}
+
+std::pair<int, int> MultisectionBracket::update(const VectorDouble& values)
+{
+    bool isLowerPositive = (valueLower > 0);
+
+    double previousPoint = lower;
+    double previousValue = valueLower;
+    int previousIndex = -1;
+
+    for(size_t i = 0; i < points.size(); i++)
+    {
+        if((values[i] > 0) != isLowerPositive)
+        {
+            lower = previousPoint;
+            valueLower = previousValue;
+            upper = points[i];
+            valueUpper = values[i];
+
+            return (std::make_pair(previousIndex, (int)i));
+        }
+
+        previousPoint = points[i];
+        previousValue = values[i];
+        previousIndex = i;
+    }
+
+    // The sign changes between the last point and the upper end
+    lower = previousPoint;
+    valueLower = previousValue;
+
+    return (std::make_pair(previousIndex, -1));
+}
+
+static inline double getNormalizedValue(const NumericConstraint* constraint, double functionValue)
+{
+    return (std::max(functionValue - constraint->valueRHS, constraint->valueLHS - functionValue));
+}
+
+// Adds the indexes of the variables in the terms of the constraint that are not linear
+static void addNonlinearVariableIndexes(
+    NumericConstraint* constraint, std::vector<bool>& isIncluded, std::vector<int>& variableIndexes)
+{
+    auto add = [&](const VariablePtr& variable)
+    {
+        if(!isIncluded[variable->index])
+        {
+            isIncluded[variable->index] = true;
+            variableIndexes.push_back(variable->index);
+        }
+    };
+
+    if(auto quadraticConstraint = dynamic_cast<QuadraticConstraint*>(constraint))
+    {
+        for(auto& T : quadraticConstraint->quadraticTerms)
+        {
+            add(T->firstVariable);
+            add(T->secondVariable);
+        }
+    }
+
+    if(auto nonlinearConstraint = dynamic_cast<NonlinearConstraint*>(constraint))
+    {
+        for(auto& V : nonlinearConstraint->variablesInMonomialTerms)
+            add(V);
+
+        for(auto& V : nonlinearConstraint->variablesInSignomialTerms)
+            add(V);
+
+        for(auto& V : nonlinearConstraint->variablesInNonlinearExpression)
+            add(V);
+    }
+}
+
+RootsearchMethodMultisection::RootsearchMethodMultisection(EnvironmentPtr envPtr) : env(envPtr)
+{
+    settingNumberOfPoints = env->settings->getSettingHandle<int>("Rootsearch.Multisection.NumberOfPoints", "Subsolver");
+}
+
+RootsearchMethodMultisection::~RootsearchMethodMultisection() = default;
+
+std::pair<VectorDouble, VectorDouble> RootsearchMethodMultisection::findZero(const VectorDouble& ptA,
+    const VectorDouble& ptB, int Nmax, double lambdaTol, double constrTol, const NonlinearConstraints constraints,
+    bool addPrimalCandidate = true)
+{
+    std::vector<NumericConstraint*> tmpConstraints;
+    tmpConstraints.reserve(constraints.size());
+
+    for(auto& C : constraints)
+        tmpConstraints.push_back(C.get());
+
+    return (findZero(ptA, ptB, Nmax, lambdaTol, constrTol, tmpConstraints, addPrimalCandidate));
+}
+
+std::pair<VectorDouble, VectorDouble> RootsearchMethodMultisection::findZero(const VectorDouble& ptA,
+    const VectorDouble& ptB, int Nmax, double lambdaTol, [[maybe_unused]] double constrTol,
+    const std::vector<NumericConstraint*> constraints, bool addPrimalCandidate = true)
+{
+    if(ptA.size() != ptB.size())
+    {
+        env->output->outputError("        Root search error: sizes of points vary: " + std::to_string(ptA.size())
+            + " != " + std::to_string(ptB.size()));
+    }
+
+    if(constraints.size() == 0)
+    {
+        env->output->outputError("        No constraints selected for root search");
+        throw Exception("No constraints selected for root search");
+    }
+
+    // Lambda is the weight of ptA, i.e. the lower end of the bracket (lambda = 0) is ptB and the upper ptA
+    struct ActiveConstraint
+    {
+        NumericConstraint* constraint;
+        double linearValueA; // The value of the linear terms and the constant in ptA
+        double linearValueB;
+        double valueLower; // The normalized value in the lower end of the bracket
+        double valueUpper;
+    };
+
+    std::vector<ActiveConstraint> activeConstraints;
+    activeConstraints.reserve(constraints.size());
+
+    double maxValueA = SHOT_DBL_MIN;
+    double maxValueB = SHOT_DBL_MIN;
+
+    for(auto& C : constraints)
+    {
+        auto linearConstraint = dynamic_cast<LinearConstraint*>(C);
+        assert(linearConstraint != nullptr);
+
+        ActiveConstraint active;
+        active.constraint = C;
+        active.linearValueA = linearConstraint->linearTerms.calculate(ptA) + C->constant;
+        active.linearValueB = linearConstraint->linearTerms.calculate(ptB) + C->constant;
+        active.valueLower = getNormalizedValue(C, C->calculateFunctionValue(ptB));
+        active.valueUpper = getNormalizedValue(C, C->calculateFunctionValue(ptA));
+
+        maxValueA = std::max(maxValueA, active.valueUpper);
+        maxValueB = std::max(maxValueB, active.valueLower);
+
+        // A constraint that is fulfilled in both ends can be ignored since it is fulfilled along the whole line if it
+        // is convex
+        if(active.valueLower > 0 || active.valueUpper > 0)
+            activeConstraints.push_back(active);
+    }
+
+    if(activeConstraints.size() == 0) // All constraints are fulfilled.
+    {
+        if(maxValueA > maxValueB)
+            return (std::make_pair(ptB, ptA));
+
+        return (std::make_pair(ptA, ptB));
+    }
+
+    if(maxValueA > 0 && maxValueB > 0)
+        throw Exception("Root search error: both points are infeasible");
+
+    MultisectionBracket bracket(0.0, 1.0, maxValueB, maxValueA);
+
+    std::vector<bool> isVariableIncluded(ptA.size(), false);
+    std::vector<int> variableIndexes;
+
+    for(auto& C : activeConstraints)
+        addNonlinearVariableIndexes(C.constraint, isVariableIncluded, variableIndexes);
+
+    int numberOfPoints = settingNumberOfPoints.get();
+    int iterations = 0;
+    int evaluatedPoints = 0;
+
+    std::vector<VectorDouble> points;
+    PointBatch batch;
+    VectorDouble functionValues;
+    VectorDouble constraintValues;
+    VectorDouble maxValues;
+
+    while(iterations < Nmax && bracket.upper - bracket.lower > lambdaTol)
+    {
+        auto& lambdas = bracket.getNextPoints(numberOfPoints);
+
+        if(lambdas.size() == 0)
+            break;
+
+        iterations++;
+
+        size_t batchSize = lambdas.size();
+        evaluatedPoints += batchSize;
+
+        // The variables not in the active constraints keep the values in ptB, since they are not used
+        points.resize(batchSize, ptB);
+
+        for(size_t p = 0; p < batchSize; p++)
+        {
+            double lambda = lambdas[p];
+            auto& point = points[p];
+
+            for(auto i : variableIndexes)
+                point[i] = lambda * ptA[i] + (1 - lambda) * ptB[i];
+        }
+
+        batch.update(points, variableIndexes);
+
+        constraintValues.resize(activeConstraints.size() * batchSize);
+        maxValues.assign(batchSize, SHOT_DBL_MIN);
+
+        for(size_t c = 0; c < activeConstraints.size(); c++)
+        {
+            auto& C = activeConstraints[c];
+            C.constraint->calculateNonlinearFunctionValues(batch, functionValues);
+
+            for(size_t p = 0; p < batchSize; p++)
+            {
+                double value = functionValues[p] + lambdas[p] * C.linearValueA + (1 - lambdas[p]) * C.linearValueB;
+                value = getNormalizedValue(C.constraint, value);
+
+                constraintValues[c * batchSize + p] = value;
+                maxValues[p] = std::max(maxValues[p], value);
+            }
+        }
+
+        auto [lowerIndex, upperIndex] = bracket.update(maxValues);
+
+        for(size_t c = 0; c < activeConstraints.size(); c++)
+        {
+            if(lowerIndex >= 0)
+                activeConstraints[c].valueLower = constraintValues[c * batchSize + lowerIndex];
+
+            if(upperIndex >= 0)
+                activeConstraints[c].valueUpper = constraintValues[c * batchSize + upperIndex];
+        }
+
+        auto numberOfActiveConstraints = activeConstraints.size();
+
+        activeConstraints.erase(std::remove_if(activeConstraints.begin(), activeConstraints.end(),
+                                    [](const ActiveConstraint& C) { return (C.valueLower <= 0 && C.valueUpper <= 0); }),
+            activeConstraints.end());
+
+        if(activeConstraints.size() < numberOfActiveConstraints)
+        {
+            for(auto i : variableIndexes)
+                isVariableIncluded[i] = false;
+
+            variableIndexes.clear();
+
+            for(auto& C : activeConstraints)
+                addNonlinearVariableIndexes(C.constraint, isVariableIncluded, variableIndexes);
+        }
+    }
+
+    if(iterations == Nmax)
+    {
+        env->output->outputDebug(
+            "        Warning, number of line search iterations " + std::to_string(iterations) + " reached!");
+    }
+    else
+    {
+        env->output->outputTrace("        Line search iterations: " + std::to_string(iterations)
+            + ". Function evaluations: " + std::to_string(evaluatedPoints));
+    }
+
+    auto length = ptA.size();
+    VectorDouble ptLower(length);
+    VectorDouble ptUpper(length);
+
+    for(size_t i = 0; i < length; i++)
+    {
+        ptLower[i] = bracket.lower * ptA[i] + (1 - bracket.lower) * ptB[i];
+        ptUpper[i] = bracket.upper * ptA[i] + (1 - bracket.upper) * ptB[i];
+    }
+
+    // The first point returned is the one where the constraints are fulfilled
+    if(bracket.valueLower > 0)
+        std::swap(ptLower, ptUpper);
+
+    if(addPrimalCandidate)
+    {
+        env->primalSolver->addPrimalSolutionCandidate(
+            ptLower, E_PrimalSolutionSource::Rootsearch, env->results->getCurrentIteration()->iterationNumber);
+    }
+
+    return (std::make_pair(ptLower, ptUpper));
+}
+
+std::pair<double, double> RootsearchMethodMultisection::findZero(const VectorDouble& pt, double objectiveLB,
+    double objectiveUB, int Nmax, double lambdaTol, [[maybe_unused]] double constrTol,
+    ObjectiveFunctionPtr objectiveFunction)
+{
+    // The difference between the objective value and the objective variable is affine in lambda, so here the first
+    // iteration normally finds the root
+    double objectiveValue = objectiveFunction->calculateValue(pt);
+
+    auto calculateValue
+        = [&](double lambda) { return (objectiveValue - (lambda * objectiveLB + (1 - lambda) * objectiveUB)); };
+
+    MultisectionBracket bracket(0.0, 1.0, calculateValue(0.0), calculateValue(1.0));
+
+    if((bracket.valueLower > 0) == (bracket.valueUpper > 0))
+    {
+        if(bracket.valueLower == 0.0)
+            return (std::make_pair(objectiveUB, objectiveUB));
+
+        if(bracket.valueUpper == 0.0)
+            return (std::make_pair(objectiveLB, objectiveLB));
+
+        throw Exception("Root search error: the objective bounds do not bracket the objective value");
+    }
+
+    int numberOfPoints = settingNumberOfPoints.get();
+    int iterations = 0;
+
+    VectorDouble values;
+
+    while(iterations < Nmax && bracket.upper - bracket.lower > lambdaTol)
+    {
+        auto& lambdas = bracket.getNextPoints(numberOfPoints);
+
+        if(lambdas.size() == 0)
+            break;
+
+        iterations++;
+
+        values.resize(lambdas.size());
+
+        for(size_t p = 0; p < lambdas.size(); p++)
+            values[p] = calculateValue(lambdas[p]);
+
+        bracket.update(values);
+    }
+
+    if(iterations == Nmax)
+    {
+        env->output->outputDebug(
+            "        Warning, number of line search iterations " + std::to_string(iterations) + " reached!");
+    }
+    else
+    {
+        env->output->outputTrace("        Line search iterations: " + std::to_string(iterations));
+    }
+
+    double ptNew = bracket.lower * objectiveLB + (1 - bracket.lower) * objectiveUB;
+    double ptNew2 = bracket.upper * objectiveLB + (1 - bracket.upper) * objectiveUB;
+
+    if(ptNew2 < ptNew)
+        return (std::make_pair(ptNew2, ptNew));
+
+    return (std::make_pair(ptNew, ptNew2));
+}
+} // namespace SHOT
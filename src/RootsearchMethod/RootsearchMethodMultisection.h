@@ -0,0 +1,72 @@
+/**
+   The Supporting Hyperplane Optimization Toolkit (SHOT).
+
+   @author Andreas Lundell, Åbo Akademi University
+
+   @section LICENSE
+   This software is licensed under the Eclipse Public License 2.0.
+   Please see the README and LICENSE files for more information.
+*/
+
+#pragma once
+#include "IRootsearchMethod.h"
+#include "../Environment.h"
+#include "../Settings.h"
+
+namespace SHOT
+{
+// A bracket [lower, upper] of a root of a function of lambda, i.e. the function is positive in one end and nonpositive
+// in the other. In each iteration the function is evaluated in several points inside the bracket: the point where the
+// line between the values in the ends is zero (as in regula falsi), two points close to it on either side, and the
+// rest equidistant. The bracket is then replaced by the first subinterval (from lower) where the sign changes. If the
+// regula falsi point is close to the root the bracket shrinks to the small interval around it, and otherwise it still
+// shrinks as with multisection.
+class MultisectionBracket
+{
+public:
+    double lower;
+    double upper;
+
+    double valueLower;
+    double valueUpper;
+
+    MultisectionBracket(double lower, double upper, double valueLower, double valueUpper)
+        : lower(lower), upper(upper), valueLower(valueLower), valueUpper(valueUpper) {};
+
+    // Returns the points (in increasing order) to evaluate in the next iteration, or an empty vector if there are no
+    // more points that can be represented inside the bracket
+    const VectorDouble& getNextPoints(int numberOfPoints);
+
+    // Updates the bracket with the values in the points returned by getNextPoints. Returns the indexes of the points
+    // that are the new lower and upper ends, or -1 if an end has not changed.
+    std::pair<int, int> update(const VectorDouble& values);
+
+private:
+    VectorDouble points;
+};
+
+// Evaluates the root search function for several values of lambda at once. The constraint values are calculated for
+// all the points in one batch, and only the variables in the constraints that are still active are interpolated. The
+// linear terms are affine along the line, so their values are interpolated from the values in the end points instead.
+class RootsearchMethodMultisection : public IRootsearchMethod
+{
+public:
+    RootsearchMethodMultisection(EnvironmentPtr envPtr);
+    ~RootsearchMethodMultisection() override;
+
+    std::pair<VectorDouble, VectorDouble> findZero(const VectorDouble& ptA, const VectorDouble& ptB, int Nmax,
+        double lambdaTol, double constrTol, const NonlinearConstraints constraints, bool addPrimalCandidate) override;
+
+    std::pair<VectorDouble, VectorDouble> findZero(const VectorDouble& ptA, const VectorDouble& ptB, int Nmax,
+        double lambdaTol, double constrTol, const std::vector<NumericConstraint*> constraints,
+        bool addPrimalCandidate) override;
+
+    std::pair<double, double> findZero(const VectorDouble& pt, double objectiveLB, double objectiveUB, int Nmax,
+        double lambdaTol, double constrTol, ObjectiveFunctionPtr objectiveFunction) override;
+
+private:
+    EnvironmentPtr env;
+
+    SettingHandle<int> settingNumberOfPoints;
+};
+} // namespace SHOT
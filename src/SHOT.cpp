@@ -43,14 +43,14 @@ int main(int argc, char* argv[])
     argh::parser cmdl;
     cmdl.add_params({ "--opt", "--osol" });
     cmdl.add_params({ "--osrl", "--trc", "--log" });
-    cmdl.add_params({ "--sol" });
+    cmdl.add_params({ "--sol", "--binsol" });
     cmdl.add_params({ "--docs" });
     cmdl.add_params({ "--debug" });
 
     cmdl.parse(argc, argv);
 
     std::string filename;
-    fs::filesystem::path resultFile, optionsFile, traceFile, logFile, solFile, gdxFile;
+    fs::filesystem::path resultFile, optionsFile, traceFile, logFile, solFile, binarySolFile, gdxFile;
 
     // Read or create the file for the log
     if(cmdl("--log")) // Have specified a log-file
@@ -97,6 +97,8 @@ int main(int argc, char* argv[])
 #ifdef HAS_AMPL
         env->output->outputCritical("   --AMPL                   Activates ASL support. Only to be used with nl-files");
 #endif
+        env->output->outputCritical(
+            "   --binsol [FILE]          Saves the primal solution in binary format to <problemname>.binsol or FILE");
         env->output->outputCritical("   --debug [DIRECTORY]      Saves debug information in the specified directory");
         env->output->outputCritical("                            If DIRECTORY is empty a temporary directory is used");
         env->output->outputCritical("   --log FILE               Sets the filename for the log file");
@@ -145,6 +147,8 @@ int main(int argc, char* argv[])
         env->output->outputCritical("   --tree={single, multi}   Activates single- or multi-tree strategy");
 #elif HAS_GUROBI
 
+        env->output->outputCritical("   --tree={single, multi}   Activates single- or multi-tree strategy");
+#elif HAS_CBC
         env->output->outputCritical("   --tree={single, multi}   Activates single- or multi-tree strategy");
 #endif
         env->output->outputCritical("   --threads=VALUE          Sets the maximum number of threads to use");
@@ -432,6 +436,15 @@ int main(int argc, char* argv[])
             solver.updateSetting("TreeStrategy", "Dual", static_cast<int>(ES_TreeStrategy::SingleTree));
         else if(argValue == "multi")
             solver.updateSetting("TreeStrategy", "Dual", static_cast<int>(ES_TreeStrategy::MultiTree));
+#endif
+#ifdef HAS_CBC
+        if(argValue == "single")
+        {
+            solver.updateSetting("TreeStrategy", "Dual", static_cast<int>(ES_TreeStrategy::SingleTree));
+            solver.updateSetting("Cbc.UseLazyCuts", "Subsolver", true);
+        }
+        else if(argValue == "multi")
+            solver.updateSetting("TreeStrategy", "Dual", static_cast<int>(ES_TreeStrategy::MultiTree));
 #endif
     }
 
@@ -681,6 +694,12 @@ int main(int argc, char* argv[])
             / fs::filesystem::path(solFilename);
     }
 
+    if(cmdl("--binsol")) // Have specified a binary solution file location
+    {
+        binarySolFile = fs::filesystem::path(env->settings->getSetting<std::string>("ResultPath", "Output"))
+            / fs::filesystem::path(cmdl("--binsol").str());
+    }
+
     std::string gdxFilename;
     if(gdxFilename = env->settings->getSetting<std::string>("GAMS.AlternateSolutionsFile", "Output");
         gdxFilename != "") // Have specified an gdx-file location
@@ -709,22 +728,20 @@ int main(int argc, char* argv[])
 
     env->output->outputInfo("");
 
-    std::string osrl = solver.getResultsOSrL();
-
     if(resultFile.empty())
     {
         fs::filesystem::path resultPath(env->settings->getSetting<std::string>("ResultPath", "Output"));
         resultPath /= env->settings->getSetting<std::string>("ProblemName", "Input");
         resultPath = resultPath.replace_extension(".osrl");
 
-        if(!Utilities::writeStringToFile(resultPath.string(), osrl))
+        if(!solver.saveResultsOSrL(resultPath.string()))
             env->output->outputCritical(" Error when writing OSrL file to: " + resultPath.string());
         else
             env->output->outputInfo(" Results written to: " + resultPath.string());
     }
     else
     {
-        if(!Utilities::writeStringToFile(resultFile.string(), osrl))
+        if(!solver.saveResultsOSrL(resultFile.string()))
             env->output->outputCritical(" Error when writing OSrL file to: " + resultFile.string());
         else
             env->output->outputInfo(" Results written to: " + resultFile.string());
@@ -759,27 +776,47 @@ int main(int argc, char* argv[])
 
     if(cmdl["--sol"] || cmdl("--sol") || useASL)
     {
-        std::string sol = solver.getResultsSol();
-
         if(solFile.empty())
         {
             fs::filesystem::path solPath(filename);
             solPath = solPath.replace_extension(".sol");
 
-            if(!Utilities::writeStringToFile(solPath.string(), sol))
+            if(!solver.saveResultsSol(solPath.string()))
                 env->output->outputCritical(" Error when writing AMPL sol file: " + solPath.string());
             else
                 env->output->outputInfo("                     " + solPath.string());
         }
         else
         {
-            if(!Utilities::writeStringToFile(solFile.string(), sol))
+            if(!solver.saveResultsSol(solFile.string()))
                 env->output->outputCritical(" Error when writing AMPL sol file: " + solFile.string());
             else
                 env->output->outputInfo("                     " + solFile.string());
         }
     }
 
+    if(cmdl["--binsol"] || cmdl("--binsol"))
+    {
+        if(binarySolFile.empty())
+        {
+            fs::filesystem::path binarySolPath(env->settings->getSetting<std::string>("ResultPath", "Output"));
+            binarySolPath /= env->settings->getSetting<std::string>("ProblemName", "Input");
+            binarySolPath = binarySolPath.replace_extension(".binsol");
+
+            if(!solver.saveResultsBinary(binarySolPath.string()))
+                env->output->outputCritical(" Error when writing binary solution file: " + binarySolPath.string());
+            else
+                env->output->outputInfo("                     " + binarySolPath.string());
+        }
+        else
+        {
+            if(!solver.saveResultsBinary(binarySolFile.string()))
+                env->output->outputCritical(" Error when writing binary solution file: " + binarySolFile.string());
+            else
+                env->output->outputInfo("                     " + binarySolFile.string());
+        }
+    }
+
     env->output->outputInfo(" Log written to:     " + logFile.string());
 
     if(env->settings->getSetting<bool>("Debug.Enable", "Output"))
@@ -61,6 +61,24 @@ public:
     }
 };
 
+// Refers directly to the stored value of a setting, so that the value can be read without looking up the setting by
+// its name. The handle is obtained once with Settings::getSettingHandle and will see later updates of the setting.
+template <typename T> class SettingHandle
+{
+public:
+    SettingHandle() = default;
+
+    inline const T& get() const { return (*value); };
+    inline bool isResolved() const { return (value != nullptr); };
+
+private:
+    explicit SettingHandle(const T* value) : value(value) { }
+
+    const T* value = nullptr;
+
+    friend class Settings;
+};
+
 class DllExport Settings
 {
 private:
@@ -101,9 +119,9 @@ public:
 
     template <typename T> void updateSetting(std::string name, std::string category, T value);
 
-    // template <typename T> T getSetting(std::string name, std::string category);
-
-    template <typename T> T getSetting(std::string name, std::string category)
+    // The values are stored in maps, whose elements are never moved, so a handle to a value stays valid as long as
+    // the settings object exists
+    template <typename T> SettingHandle<T> getSettingHandle(std::string name, std::string category)
     {
         // Check that setting is of the correct type
         using value_type
@@ -147,7 +165,12 @@ public:
             throw SettingKeyNotFoundException(name, category);
         }
 
-        return (value->second);
+        return (SettingHandle<T>(&value->second));
+    }
+
+    template <typename T> T getSetting(std::string name, std::string category)
+    {
+        return (getSettingHandle<T>(name, category).get());
     }
 
     std::string getSettingDescription(std::string name, std::string category)
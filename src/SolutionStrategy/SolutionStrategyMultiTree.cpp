@@ -34,6 +34,7 @@
 
 #include "../Tasks/TaskSolveIteration.h"
 #include "../Tasks/TaskPresolve.h"
+#include "../Tasks/TaskPerformIncrementalBoundTightening.h"
 
 #include "../Tasks/TaskRepairInfeasibleDualProblem.h"
 
@@ -51,6 +52,7 @@
 #include "../Tasks/TaskSelectHyperplanePointsESH.h"
 #include "../Tasks/TaskSelectHyperplanePointsECP.h"
 #include "../Tasks/TaskAddHyperplanes.h"
+#include "../Tasks/TaskUpdateHyperplanePool.h"
 #include "../Tasks/TaskAddPrimalReductionCut.h"
 #include "../Tasks/TaskCheckMaxNumberOfPrimalReductionCuts.h"
 
@@ -59,6 +61,7 @@
 #include "../Tasks/TaskSelectPrimalCandidatesFromNLP.h"
 #include "../Tasks/TaskSelectPrimalFixedNLPPointsFromSolutionPool.h"
 #include "../Tasks/TaskClearFixedPrimalCandidates.h"
+#include "../Tasks/TaskFinishAsynchronousPrimalHeuristics.h"
 
 #include "../Tasks/TaskUpdateInteriorPoint.h"
 
@@ -86,12 +89,22 @@ SolutionStrategyMultiTree::SolutionStrategyMultiTree(EnvironmentPtr envPtr)
     env->timing->createTimer("DualProblemsIntegerFixed", "  - solving integer-fixed problems");
     env->timing->createTimer("DualProblemsDiscrete", "  - solving MIP problems");
     env->timing->createTimer("DualCutGenerationRootSearch", "  - root search for constraint cuts");
+    env->timing->createTimer("DualCutGenerationRootSearchThreads", "    - summed over all threads");
     env->timing->createTimer("DualObjectiveRootSearch", "  - root search for objective cut");
 
     env->timing->createTimer("PrimalStrategy", "- primal strategy");
     env->timing->createTimer("PrimalBoundStrategyNLP", "  - solving NLP problems");
     env->timing->createTimer("PrimalBoundStrategyRootSearch", "  - performing root searches");
 
+    bool useAsynchronousPrimal = env->settings->getSetting<bool>("Asynchronous.Use", "Primal");
+
+    if(useAsynchronousPrimal)
+    {
+        env->timing->createTimer("PrimalBoundStrategyNLPThreads", "  - solving NLP problems in the background");
+        env->timing->createTimer(
+            "PrimalBoundStrategyRootSearchThreads", "  - performing root searches in the background");
+    }
+
     auto tFinalizeSolution = std::make_shared<TaskSequential>(env);
 
     auto tInitMIPSolver = std::make_shared<TaskInitializeDualSolver>(env, false);
@@ -144,7 +157,8 @@ SolutionStrategyMultiTree::SolutionStrategyMultiTree(EnvironmentPtr envPtr)
     if(env->settings->getSetting<bool>("Rootsearch.Use", "Primal")
         && env->reformulatedProblem->properties.numberOfNonlinearConstraints > 0)
     {
-        auto tSelectPrimRootsearch = std::make_shared<TaskSelectPrimalCandidatesFromRootsearch>(env);
+        auto tSelectPrimRootsearch
+            = std::make_shared<TaskSelectPrimalCandidatesFromRootsearch>(env, useAsynchronousPrimal);
         env->tasks->addTask(tSelectPrimRootsearch, "SelectPrimRootsearch");
         std::dynamic_pointer_cast<TaskSequential>(tFinalizeSolution)->addTask(tSelectPrimRootsearch);
     }
@@ -215,7 +229,8 @@ SolutionStrategyMultiTree::SolutionStrategyMultiTree(EnvironmentPtr envPtr)
         if(NLPProblemSource == ES_PrimalNLPProblemSource::Both
             || NLPProblemSource == ES_PrimalNLPProblemSource::OriginalProblem)
         {
-            auto tSelectPrimNLPCheck = std::make_shared<TaskSelectPrimalCandidatesFromNLP>(env, false);
+            auto tSelectPrimNLPCheck
+                = std::make_shared<TaskSelectPrimalCandidatesFromNLP>(env, false, useAsynchronousPrimal);
             env->tasks->addTask(tSelectPrimNLPCheck, "SelectPrimNLPCheckOriginal");
             std::dynamic_pointer_cast<TaskSequential>(tFinalizeSolution)->addTask(tSelectPrimNLPCheck);
         }
@@ -223,7 +238,8 @@ SolutionStrategyMultiTree::SolutionStrategyMultiTree(EnvironmentPtr envPtr)
         if(NLPProblemSource == ES_PrimalNLPProblemSource::Both
             || NLPProblemSource == ES_PrimalNLPProblemSource::ReformulatedProblem)
         {
-            auto tSelectPrimNLPCheck = std::make_shared<TaskSelectPrimalCandidatesFromNLP>(env, true);
+            auto tSelectPrimNLPCheck
+                = std::make_shared<TaskSelectPrimalCandidatesFromNLP>(env, true, useAsynchronousPrimal);
             env->tasks->addTask(tSelectPrimNLPCheck, "SelectPrimNLPCheckReformulated");
             std::dynamic_pointer_cast<TaskSequential>(tFinalizeSolution)->addTask(tSelectPrimNLPCheck);
         }
@@ -236,6 +252,13 @@ SolutionStrategyMultiTree::SolutionStrategyMultiTree(EnvironmentPtr envPtr)
         env->tasks->addTask(tCheckRelGap, "CheckRelGap");
     }
 
+    // The primal heuristics started in the last iteration, or in the finalization, have no MIP problem to wait for
+    if(useAsynchronousPrimal)
+    {
+        auto tFinishAsynchronousPrimal = std::make_shared<TaskFinishAsynchronousPrimalHeuristics>(env);
+        std::dynamic_pointer_cast<TaskSequential>(tFinalizeSolution)->addTask(tFinishAsynchronousPrimal);
+    }
+
     env->tasks->addTask(tInitializeIteration, "InitIter2");
 
     if(env->settings->getSetting<bool>("TreeStrategy.Multi.Reinitialize", "Dual"))
@@ -280,6 +303,14 @@ SolutionStrategyMultiTree::SolutionStrategyMultiTree(EnvironmentPtr envPtr)
         env->tasks->addTask(tSelectObjectiveHPPts, "SelectObjectiveHPPts");
     }
 
+    // When the MIP problem is reinitialized in each iteration, all hyperplanes are added to it again anyway
+    if(env->settings->getSetting<bool>("HyperplaneCuts.Purge.Use", "Dual")
+        && !env->settings->getSetting<bool>("TreeStrategy.Multi.Reinitialize", "Dual"))
+    {
+        auto tUpdateHyperplanePool = std::make_shared<TaskUpdateHyperplanePool>(env);
+        env->tasks->addTask(tUpdateHyperplanePool, "UpdateHyperplanePool");
+    }
+
     env->tasks->addTask(tAddHPs, "AddHPs");
 
     if(env->settings->getSetting<bool>("HyperplaneCuts.UseIntegerCuts", "Dual"))
@@ -295,6 +326,12 @@ SolutionStrategyMultiTree::SolutionStrategyMultiTree(EnvironmentPtr envPtr)
         env->tasks->addTask(tPresolve, "Presolve2");
     }
 
+    if(env->settings->getSetting<bool>("BoundTightening.FeasibilityBased.UseIncremental", "Model"))
+    {
+        auto tPerformIncrementalBoundTightening = std::make_shared<TaskPerformIncrementalBoundTightening>(env);
+        env->tasks->addTask(tPerformIncrementalBoundTightening, "PerformIncrementalBoundTightening");
+    }
+
     auto tGoto = std::make_shared<TaskGoto>(env, "SolveIter");
     env->tasks->addTask(tGoto, "Goto");
 
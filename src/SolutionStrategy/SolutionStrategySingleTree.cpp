@@ -85,6 +85,7 @@ SolutionStrategySingleTree::SolutionStrategySingleTree(EnvironmentPtr envPtr)
     env->timing->createTimer("DualStrategy", "- dual strategy");
     env->timing->createTimer("DualProblemsDiscrete", "  - solving MIP problems");
     env->timing->createTimer("DualCutGenerationRootSearch", "  - root search for constraint cuts");
+    env->timing->createTimer("DualCutGenerationRootSearchThreads", "    - summed over all threads");
     env->timing->createTimer("DualObjectiveRootSearch", "  - root search for objective cut");
 
     env->timing->createTimer("PrimalStrategy", "- primal strategy");
@@ -70,6 +70,7 @@ Solver::Solver()
     env->timing->createTimer("ProblemReformulation", "- problem reformulation");
     env->timing->createTimer("BoundTightening", "- bound tightening");
     env->timing->createTimer("BoundTighteningPOA", "  - initial outer approximation");
+    env->timing->createTimer("BoundTighteningOBBT", "  - optimization based");
     env->timing->createTimer("BoundTighteningFBBTOriginal", "  - feasibility based (original problem)");
     env->timing->createTimer("BoundTighteningFBBTReformulated", "  - feasibility based (reformulated problem)");
 
@@ -101,6 +102,7 @@ Solver::Solver(std::shared_ptr<spdlog::sinks::sink> consoleSink)
     env->timing->createTimer("ProblemReformulation", "- problem reformulation");
     env->timing->createTimer("BoundTightening", "- bound tightening");
     env->timing->createTimer("BoundTighteningFBBT", "  - feasibility based");
+    env->timing->createTimer("BoundTighteningOBBT", "  - optimization based");
     env->timing->createTimer("BoundTighteningFBBTOriginal", "  - feasibility based (original problem");
     env->timing->createTimer("BoundTighteningFBBTReformulated", "  - feasibility based (reformulated problem");
 
@@ -511,6 +513,15 @@ bool Solver::selectStrategy()
                 solutionStrategy = std::make_unique<SolutionStrategyNLP>(env);
                 env->results->usedSolutionStrategy = E_SolutionStrategy::NLP;
             }
+            else if(static_cast<ES_TreeStrategy>(env->settings->getSetting<int>("TreeStrategy", "Dual"))
+                == ES_TreeStrategy::SingleTree)
+            {
+                env->output->outputDebug(" Using single-tree solution strategy.");
+                solutionStrategy = std::make_unique<SolutionStrategySingleTree>(env);
+                isProblemInitialized = true;
+                env->results->usedSolutionStrategy = E_SolutionStrategy::SingleTree;
+                env->dualSolver->isSingleTree = true;
+            }
             else
             {
                 solutionStrategy = std::make_unique<SolutionStrategyMultiTree>(env);
@@ -628,6 +639,8 @@ bool Solver::selectStrategy()
 
 bool Solver::solveProblem()
 {
+    env->threadPool.setNumberOfThreads(env->settings->getSetting<int>("NumberOfThreads", "Strategy"));
+
     if(env->settings->getSetting<bool>("Debug.Enable", "Output"))
     {
         fs::filesystem::path filename(env->settings->getSetting<std::string>("Debug.Path", "Output"));
@@ -652,6 +665,8 @@ bool Solver::solveProblem()
     assert(solutionStrategy != nullptr); /* would be NULL if setProblem failed */
     isProblemSolved = solutionStrategy->solveProblem();
 
+    env->results->saveIterationHistory();
+
     return (isProblemSolved);
 }
 
@@ -683,6 +698,12 @@ std::string Solver::getResultsTrace() { return (env->results->getResultsTrace())
 
 std::string Solver::getResultsSol() { return (env->results->getResultsSol()); }
 
+bool Solver::saveResultsOSrL(const std::string& fileName) { return (env->results->saveResultsOSrL(fileName)); }
+
+bool Solver::saveResultsSol(const std::string& fileName) { return (env->results->saveResultsSol(fileName)); }
+
+bool Solver::saveResultsBinary(const std::string& fileName) { return (env->results->saveResultsBinary(fileName)); }
+
 void Solver::initializeSettings()
 {
     if(env->settings->settingsInitialized)
@@ -757,6 +778,9 @@ void Solver::initializeSettings()
     env->settings->createSetting("ESH.Rootsearch.ConstraintTolerance", "Dual", 1e-8,
         "Constraint tolerance for when not to add individual hyperplanes", 0, SHOT_DBL_MAX);
 
+    env->settings->createSetting("ESH.Rootsearch.NumberOfThreads", "Dual", 1,
+        "Max number of threads to use for the root searches: 0: Strategy.NumberOfThreads", 0, 999);
+
     env->settings->createSetting(
         "ESH.Rootsearch.UniqueConstraints", "Dual", false, "Allow only one hyperplane per constraint per iteration");
 
@@ -783,6 +807,33 @@ void Solver::initializeSettings()
     env->settings->createSetting("HyperplaneCuts.UseIntegerCuts", "Dual", false,
         "Add integer cuts for infeasible integer-combinations for binary problems");
 
+    env->settings->createSetting("HyperplaneCuts.Purge.ActivityTolerance", "Dual", 1e-6,
+        "A hyperplane is active in a MIP solution if its slack is less than this value", 0.0, SHOT_DBL_MAX);
+
+    env->settings->createSetting("HyperplaneCuts.Purge.InactiveIterations", "Dual", 10,
+        "Number of iterations a hyperplane can be inactive before it is removed from the MIP problem", 1,
+        SHOT_INT_MAX);
+
+    env->settings->createSetting("HyperplaneCuts.Purge.Use", "Dual", false,
+        "Remove inactive hyperplanes for convex constraints from the MIP problem in the multi-tree strategy, and add "
+        "them back when violated");
+
+    env->settings->createSetting("HyperplaneCuts.Selection.MaxParallelism", "Dual", 0.999,
+        "Remove hyperplanes whose coefficients have a larger cosine with those of a selected hyperplane", 0.0, 1.0);
+
+    env->settings->createSetting("HyperplaneCuts.Selection.MaxPerConstraint", "Dual", 10,
+        "Maximal number of hyperplanes to select per constraint and iteration", 1, SHOT_INT_MAX);
+
+    env->settings->createSetting("HyperplaneCuts.Selection.OrthogonalityWeight", "Dual", 0.5,
+        "Weight of the orthogonality to the already selected hyperplanes in the score of a hyperplane", 0.0,
+        SHOT_DBL_MAX);
+
+    env->settings->createSetting("HyperplaneCuts.Selection.SparsityWeight", "Dual", 0.1,
+        "Weight of the fraction of zero coefficients in the score of a hyperplane", 0.0, SHOT_DBL_MAX);
+
+    env->settings->createSetting("HyperplaneCuts.Selection.Use", "Dual", false,
+        "Select the hyperplanes to add based on their efficacy, orthogonality and sparsity");
+
     env->settings->createSetting("HyperplaneCuts.SaveHyperplanePoints", "Dual", false,
         "Whether to save the points in the generated hyperplanes list", false);
 
@@ -963,6 +1014,18 @@ void Solver::initializeSettings()
         "These settings control various aspects of SHOT's representation  for and handling of the provided "
         "optimization model.");
 
+    // Automatic differentiation
+
+    env->settings->createSettingGroup("Model", "AutomaticDifferentiation", "Automatic differentiation",
+        "These settings control how the nonlinear expressions are recorded for calculating gradients and Hessians "
+        "with CppAD.");
+
+    env->settings->createSetting("AutomaticDifferentiation.OptimizeTape", "Model", false,
+        "Optimize the recorded tapes, which takes time initially but may reduce their size");
+
+    env->settings->createSetting("AutomaticDifferentiation.PerConstraintTapes", "Model", false,
+        "Record a separate tape for each nonlinear constraint instead of using one for all constraints");
+
     // Bound tightening
 
     env->settings->createSettingGroup("Model", "BoundTightening", "Bound tightening",
@@ -980,6 +1043,9 @@ void Solver::initializeSettings()
     env->settings->createSetting(
         "BoundTightening.FeasibilityBased.Use", "Model", true, "Peform feasibility-based bound tightening");
 
+    env->settings->createSetting("BoundTightening.FeasibilityBased.UseIncremental", "Model", false,
+        "Propagate bounds tightened by the objective cutoff or MIP presolve in each iteration");
+
     env->settings->createSetting("BoundTightening.FeasibilityBased.UseNonlinear", "Model", true,
         "Peform feasibility-based bound tightening on nonlinear expressions");
 
@@ -1017,6 +1083,22 @@ void Solver::initializeSettings()
 
     env->settings->createSetting("BoundTightening.InitialPOA.TimeLimit", "Model", 5.0, "Time limit for initial POA");
 
+    // Bound tightening: optimization based
+
+    env->settings->createSetting("BoundTightening.OptimizationBased.MaxVariables", "Model", 100,
+        "Maximal number of variables to tighten the bounds of by solving LP problems", 0, SHOT_INT_MAX);
+
+    env->settings->createSetting("BoundTightening.OptimizationBased.NumberOfThreads", "Model", 0,
+        "Max number of LP problems to solve in parallel, each with its own LP solver: 0: "
+        "Strategy.NumberOfThreads",
+        0, 999);
+
+    env->settings->createSetting("BoundTightening.OptimizationBased.TimeLimit", "Model", 5.0,
+        "Time limit for optimization-based bound tightening", 0.0, SHOT_DBL_MAX);
+
+    env->settings->createSetting("BoundTightening.OptimizationBased.Use", "Model", false,
+        "Peform optimization-based bound tightening over the linear constraints and initial POA");
+
     // Convexity settings
 
     env->settings->createSettingGroup(
@@ -1204,6 +1286,12 @@ void Solver::initializeSettings()
     env->settings->createSetting("GAMS.AlternateSolutionsFile", "Output", std::string(),
         "Name of GAMS GDX file to write alternative solutions to", false);
 
+    env->settings->createSetting("IterationHistory.File", "Output", std::string(),
+        "Binary file where the points of all iterations are saved (empty = not saved)", false);
+
+    env->settings->createSetting("IterationHistory.FullIterations", "Output", 20,
+        "Number of latest iterations for which all points are kept in memory", 2, SHOT_INT_MAX);
+
     VectorString enumOutputDirectory;
     enumOutputDirectory.push_back("Problem directory");
     enumOutputDirectory.push_back("Program directory");
@@ -1217,6 +1305,10 @@ void Solver::initializeSettings()
     env->settings->createSettingGroup(
         "Primal", "", "Primal heuristics", "These settings control the primal heuristics used in SHOT.");
 
+    env->settings->createSetting("Asynchronous.Use", "Primal", false,
+        "Perform the primal root searches and fixed NLP problems in the background while the next MIP problem is "
+        "solved (multi-tree strategy)");
+
     env->settings->createSettingGroup("Primal", "FixedInteger", "Fixed-integer (NLP) strategy",
         "The main primal strategy in SHOT is to solve integer-fixed NLP problems. These settings control, e.g., how "
         "often NLP problems are solved.");
@@ -1252,6 +1344,11 @@ void Solver::initializeSettings()
     env->settings->createSetting(
         "FixedInteger.IterationLimit", "Primal", 10000000, "Max number of iterations per call", 0, SHOT_INT_MAX);
 
+    env->settings->createSetting("FixedInteger.NumberOfThreads", "Primal", 1,
+        "Number of fixed NLP problems to solve in parallel, each with its own NLP solver: 0: "
+        "Strategy.NumberOfThreads",
+        0, 999);
+
     env->settings->createSetting("FixedInteger.OnlyUniqueIntegerCombinations", "Primal", true,
         "Whether to resolve with the same integer combination, e.g. for nonconvex problems with different continuous "
         "variable starting points");
@@ -1320,10 +1417,20 @@ void Solver::initializeSettings()
     env->settings->createSetting("Tolerance.NonlinearConstraint", "Primal", 1e-5,
         "Nonlinear constraint tolerance for accepting primal solutions");
 
+    env->settings->createSetting("Tolerance.NumberOfThreads", "Primal", 1,
+        "Max number of threads used when checking the constraints in primal solutions: 0: "
+        "Strategy.NumberOfThreads",
+        0, 999);
+
     // Strategy settings
 
     env->settings->createSettingGroup("Strategy", "", "Strategy", "Overall strategy parameters used in SHOT.");
 
+    env->settings->createSetting("NumberOfThreads", "Strategy", 0,
+        "Max number of threads used for the tasks performed in parallel in SHOT, e.g., root searches and fixed NLP "
+        "problems, but not in the MIP solver: 0: Automatic",
+        0, 999);
+
     env->settings->createSetting("UseRecommendedSettings", "Strategy", true,
         "Modifies some settings to their recommended values based on the strategy");
 
@@ -1524,6 +1631,12 @@ void Solver::initializeSettings()
     env->settings->createSetting("Cbc.Strategy", "Subsolver", 1, "This turns on newer features", enumStrategy, 0);
     enumStrategy.clear();
 
+    env->settings->createSetting("Cbc.UseIncumbentAsMIPStart", "Subsolver", true,
+        "Use the best solution found by Cbc as MIP start in the next iteration if none is provided");
+
+    env->settings->createSetting("Cbc.UseLazyCuts", "Subsolver", false,
+        "Use a lazy cut generator in Cbc so that the single-tree strategy can be used");
+
 #endif
 
     // Subsolver settings: Ipopt
@@ -1576,10 +1689,14 @@ void Solver::initializeSettings()
     VectorString enumRootsearchMethod;
     enumRootsearchMethod.push_back("TOMS748");
     enumRootsearchMethod.push_back("Bisection");
+    enumRootsearchMethod.push_back("Multisection");
     env->settings->createSetting("Rootsearch.Method", "Subsolver", static_cast<int>(ES_RootsearchMethod::BoostTOMS748),
         "Root search method to use", enumRootsearchMethod, 0);
     enumRootsearchMethod.clear();
 
+    env->settings->createSetting("Rootsearch.Multisection.NumberOfPoints", "Subsolver", 4,
+        "Number of points evaluated together in each multisection iteration", 4, 64);
+
     env->settings->createSetting("Rootsearch.TerminationTolerance", "Subsolver", 1e-16,
         "Epsilon lambda tolerance for root search", 0.0, SHOT_DBL_MAX);
 
@@ -1787,8 +1904,10 @@ void Solver::verifySettings()
         MIPSolverDefined = true;
         unboundedVariableBound = 1e50;
 
-        // Some features are not available in Cbc
-        env->settings->updateSetting("TreeStrategy", "Dual", static_cast<int>(ES_TreeStrategy::MultiTree));
+        // Some features are not available in Cbc, and the single-tree strategy is only used if explicitly requested
+        if(!env->settings->getSetting<bool>("Cbc.UseLazyCuts", "Subsolver"))
+            env->settings->updateSetting("TreeStrategy", "Dual", static_cast<int>(ES_TreeStrategy::MultiTree));
+
         env->settings->updateSetting(
             "Reformulation.Quadratics.Strategy", "Model", static_cast<int>(ES_QuadraticProblemStrategy::Nonlinear));
         env->settings->updateSetting(
@@ -87,6 +87,10 @@ public:
     std::string getResultsTrace();
     std::string getResultsSol();
 
+    bool saveResultsOSrL(const std::string& fileName);
+    bool saveResultsSol(const std::string& fileName);
+    bool saveResultsBinary(const std::string& fileName);
+
     void updateSetting(std::string name, std::string category, int value);
     void updateSetting(std::string name, std::string category, std::string value);
     void updateSetting(std::string name, std::string category, double value);
@@ -0,0 +1,176 @@
+/**
+   The Supporting Hyperplane Optimization Toolkit (SHOT).
+
+   @author Andreas Lundell, Åbo Akademi University
+
+   @section LICENSE
+   This software is licensed under the Eclipse Public License 2.0.
+   Please see the README and LICENSE files for more information.
+*/
+
+#pragma once
+
+#include <algorithm>
+#include <memory>
+#include <utility>
+#include <vector>
+
+namespace SHOT
+{
+
+// Orders the keys of a sparse vector. Variables are ordered by their index (and not by their address as in a map
+// with pointer keys), so that the elements are always in the same order
+struct SparseVectorKeyLess
+{
+    inline bool operator()(int first, int second) const { return (first < second); };
+
+    template <typename T>
+    inline bool operator()(const std::shared_ptr<T>& first, const std::shared_ptr<T>& second) const
+    {
+        return (first->index < second->index);
+    };
+
+    template <typename T> inline bool operator()(const std::pair<T, T>& first, const std::pair<T, T>& second) const
+    {
+        if((*this)(first.first, second.first))
+            return (true);
+
+        if((*this)(second.first, first.first))
+            return (false);
+
+        return ((*this)(first.second, second.second));
+    };
+};
+
+// A sparse vector stored as a flat array of (key, value) elements sorted on the key. It is iterated over in the same
+// way as a map, i.e. the elements have the members first and second, but all elements are stored contiguously
+template <typename Key> class SparseVector
+{
+public:
+    using Element = std::pair<Key, double>;
+    using iterator = typename std::vector<Element>::iterator;
+    using const_iterator = typename std::vector<Element>::const_iterator;
+
+    inline iterator begin() { return (elements.begin()); };
+    inline iterator end() { return (elements.end()); };
+    inline const_iterator begin() const { return (elements.begin()); };
+    inline const_iterator end() const { return (elements.end()); };
+
+    inline size_t size() const { return (elements.size()); };
+    inline bool empty() const { return (elements.empty()); };
+
+    inline void clear() { elements.clear(); };
+    inline void reserve(size_t size) { elements.reserve(size); };
+
+    inline iterator find(const Key& key)
+    {
+        auto element = lowerBound(key);
+
+        if(element != elements.end() && !keyLess(key, element->first))
+            return (element);
+
+        return (elements.end());
+    };
+
+    // Same as for a map, i.e. the value is only inserted if there is no element with the key
+    inline std::pair<iterator, bool> emplace(const Key& key, double value)
+    {
+        if(elements.empty() || keyLess(elements.back().first, key))
+        {
+            elements.emplace_back(key, value);
+            return (std::make_pair(elements.end() - 1, true));
+        }
+
+        auto element = lowerBound(key);
+
+        if(!keyLess(key, element->first))
+            return (std::make_pair(element, false));
+
+        return (std::make_pair(elements.emplace(element, key, value), true));
+    };
+
+    // Adds the value to the element with the key, or inserts a new element if there is none. Elements are often
+    // added in increasing key order, in which case this is an append.
+    inline void add(const Key& key, double value)
+    {
+        auto element = emplace(key, value);
+
+        if(!element.second)
+            element.first->second += value;
+    };
+
+    // Adds all the elements in other with a single merge of the two sorted arrays
+    inline void add(const SparseVector<Key>& other)
+    {
+        if(other.empty())
+            return;
+
+        if(elements.empty())
+        {
+            elements = other.elements;
+            return;
+        }
+
+        if(keyLess(elements.back().first, other.elements.front().first))
+        {
+            elements.insert(elements.end(), other.elements.begin(), other.elements.end());
+            return;
+        }
+
+        // The merge is made into a buffer that is kept per thread and reused, so that merging does not normally
+        // require allocating new memory
+        thread_local std::vector<Element> buffer;
+        buffer.clear();
+        buffer.reserve(elements.size() + other.elements.size());
+
+        auto first = elements.begin();
+        auto second = other.elements.begin();
+
+        while(first != elements.end() && second != other.elements.end())
+        {
+            if(keyLess(first->first, second->first))
+            {
+                buffer.push_back(*first);
+                ++first;
+            }
+            else if(keyLess(second->first, first->first))
+            {
+                buffer.push_back(*second);
+                ++second;
+            }
+            else
+            {
+                buffer.emplace_back(first->first, first->second + second->second);
+                ++first;
+                ++second;
+            }
+        }
+
+        buffer.insert(buffer.end(), first, elements.end());
+        buffer.insert(buffer.end(), second, other.elements.end());
+
+        elements.swap(buffer);
+    };
+
+    // Removes all elements with the given value
+    inline void erase(double value)
+    {
+        elements.erase(std::remove_if(elements.begin(), elements.end(),
+                           [value](const Element& element) { return (element.second == value); }),
+            elements.end());
+    };
+
+private:
+    std::vector<Element> elements;
+    SparseVectorKeyLess keyLess;
+
+    inline iterator lowerBound(const Key& key)
+    {
+        return (std::lower_bound(elements.begin(), elements.end(), key,
+            [this](const Element& element, const Key& value) { return (keyLess(element.first, value)); }));
+    };
+};
+
+using SparseIndexVector = SparseVector<int>;
+
+} // namespace SHOT
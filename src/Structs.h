@@ -148,6 +148,7 @@ struct PrimalSolution
     PairIndexValue maxDevatingConstraintLinear { -1, SHOT_DBL_INF };
     PairIndexValue maxDevatingConstraintQuadratic { -1, SHOT_DBL_INF };
     PairIndexValue maxDevatingConstraintNonlinear { -1, SHOT_DBL_INF };
+    bool maxDeviatingConstraintsCalculated = false; // Have the values above been calculated for point?
     double maxIntegerToleranceError; // The maximum integer error before rounding
     bool boundProjectionPerformed = false; // Has the variable bounds been corrected to either upper or lower bounds?
     bool integerRoundingPerformed = false; // Has the integers been rounded?
@@ -162,6 +163,14 @@ struct PrimalFixedNLPCandidate
     int iterFound;
     PairIndexValue maxDevatingConstraint;
     double discreteVariablePointHash;
+    VectorInteger discreteVariableValues; // The rounded values of the discrete variables
+};
+
+struct TestedFixedNLPCandidate
+{
+    E_NLPSolutionStatus status;
+    double objValue; // NAN if no solution was found
+    int iterTested;
 };
 
 struct DualSolution
@@ -227,6 +236,7 @@ struct SolutionStatistics
     int numberOfProblemsMinimaxLP = 0;
 
     int numberOfProblemsFixedNLP = 0;
+    int numberOfFixedNLPCandidatesAlreadyTested = 0;
 
     int numberOfConstraintsRemovedInPresolve = 0;
     int numberOfVariableBoundsTightenedInPresolve = 0;
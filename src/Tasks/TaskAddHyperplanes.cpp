@@ -20,6 +20,9 @@
 #include "../Settings.h"
 #include "../Timing.h"
 
+#include <cmath>
+#include <map>
+
 namespace SHOT
 {
 
@@ -44,19 +47,57 @@ void TaskAddHyperplanes::run()
     {
         int addedHyperplanes = 0;
 
-        for(auto k = env->dualSolver->hyperplaneWaitingList.size(); k > 0; k--)
+        // The last hyperplanes in the waiting list are added first
+        auto& waitingList = env->dualSolver->hyperplaneWaitingList;
+        std::vector<HyperplaneCandidate> hyperplanes;
+        hyperplanes.reserve(waitingList.size());
+
+        for(auto H = waitingList.rbegin(); H != waitingList.rend(); ++H)
+            hyperplanes.push_back(HyperplaneCandidate { *H, std::nullopt });
+
+        if(env->settings->getSetting<bool>("HyperplaneCuts.Selection.Use", "Dual")
+            && env->results->getNumberOfIterations() > 1 && hyperplanes.size() > 1)
+        {
+            auto prevIter = env->results->getPreviousIteration(); // The solved iteration
+
+            // The terms are needed for the scores, and are kept so that they are not calculated again for the cuts.
+            // Hyperplanes whose terms cannot be created are skipped.
+            std::vector<HyperplaneCandidate> candidates;
+            candidates.reserve(hyperplanes.size());
+
+            for(auto& H : hyperplanes)
+            {
+                if(H.hyperplane.source != E_HyperplaneSource::PrimalSolutionSearchInteriorObjective)
+                {
+                    H.terms = env->dualSolver->MIPSolver->createHyperplaneTerms(H.hyperplane);
+
+                    if(!H.terms)
+                        continue;
+                }
+
+                candidates.push_back(std::move(H));
+            }
+
+            hyperplanes = selectHyperplanes(std::move(candidates), prevIter->solutionPoints,
+                env->dualSolver->MIPSolver->getNumberOfVariables());
+        }
+
+        for(auto& H : hyperplanes)
         {
             if(addedHyperplanes >= env->settings->getSetting<int>("HyperplaneCuts.MaxPerIteration", "Dual"))
                 break;
 
-            auto tmpItem = env->dualSolver->hyperplaneWaitingList.at(k - 1);
-
+            auto& tmpItem = H.hyperplane;
             bool cutAddedSuccessfully = false;
 
             if(tmpItem.source == E_HyperplaneSource::PrimalSolutionSearchInteriorObjective)
             {
                 cutAddedSuccessfully = env->dualSolver->MIPSolver->createInteriorHyperplane(tmpItem);
             }
+            else if(H.terms)
+            {
+                cutAddedSuccessfully = env->dualSolver->MIPSolver->createHyperplane(tmpItem, std::move(*H.terms));
+            }
             else
             {
                 cutAddedSuccessfully = env->dualSolver->MIPSolver->createHyperplane(tmpItem);
@@ -91,6 +132,190 @@ void TaskAddHyperplanes::run()
     env->timing->stopTimer("DualStrategy");
 }
 
+std::vector<HyperplaneCandidate> TaskAddHyperplanes::selectHyperplanes(std::vector<HyperplaneCandidate> hyperplanes,
+    const std::vector<SolutionPoint>& solutionPoints, int numberOfVariables)
+{
+    if(solutionPoints.empty() || hyperplanes.size() < 2)
+        return (hyperplanes);
+
+    double maxParallelism = env->settings->getSetting<double>("HyperplaneCuts.Selection.MaxParallelism", "Dual");
+    int maxPerConstraint = env->settings->getSetting<int>("HyperplaneCuts.Selection.MaxPerConstraint", "Dual");
+    double orthogonalityWeight
+        = env->settings->getSetting<double>("HyperplaneCuts.Selection.OrthogonalityWeight", "Dual");
+    double sparsityWeight = env->settings->getSetting<double>("HyperplaneCuts.Selection.SparsityWeight", "Dual");
+
+    std::vector<HyperplaneCandidate> selectedHyperplanes;
+    selectedHyperplanes.reserve(hyperplanes.size());
+
+    std::vector<HyperplaneCandidate> candidates;
+    VectorDouble candidateNorms;
+    VectorDouble candidateEfficacies;
+    VectorDouble candidateDensities;
+
+    double maxEfficacy = 0.0;
+    double densityDivisor = std::max(1, numberOfVariables);
+
+    for(auto& H : hyperplanes)
+    {
+        // These are not created from terms, e.g. the interior objective hyperplanes, and are always added
+        if(!H.terms)
+        {
+            selectedHyperplanes.push_back(std::move(H));
+            continue;
+        }
+
+        auto& terms = *H.terms;
+        double norm = 0.0;
+
+        for(auto& E : terms.first)
+            norm += E.second * E.second;
+
+        norm = std::sqrt(norm);
+
+        if(norm == 0.0 || std::isnan(norm) || std::isinf(norm))
+        {
+            // Let createHyperplane report the problem with the hyperplane
+            selectedHyperplanes.push_back(std::move(H));
+            continue;
+        }
+
+        // The efficacy is the largest distance from the hyperplane to the solutions it cuts off
+        double efficacy = 0.0;
+
+        for(auto& SOL : solutionPoints)
+        {
+            double value = terms.second;
+
+            for(auto& E : terms.first)
+            {
+                if(E.first < (int)SOL.point.size())
+                    value += E.second * SOL.point[E.first];
+            }
+
+            efficacy = std::max(efficacy, value / norm);
+        }
+
+        maxEfficacy = std::max(maxEfficacy, efficacy);
+
+        candidateNorms.push_back(norm);
+        candidateEfficacies.push_back(efficacy);
+        candidateDensities.push_back(terms.first.size() / densityDivisor);
+        candidates.push_back(std::move(H));
+    }
+
+    int numberOfCandidates = candidates.size();
+
+    VectorDouble baseScores(numberOfCandidates);
+
+    for(int i = 0; i < numberOfCandidates; i++)
+    {
+        baseScores[i] = (maxEfficacy > 0.0 ? candidateEfficacies[i] / maxEfficacy : 0.0)
+            + sparsityWeight * (1.0 - candidateDensities[i]);
+    }
+
+    VectorDouble minOrthogonalities(numberOfCandidates, 1.0);
+    std::vector<bool> isRemaining(numberOfCandidates, true);
+    std::map<int, int> numberSelectedPerConstraint;
+    VectorInteger selectedIndexes;
+
+    int numberOfNearParallel = 0;
+    int numberOfExceedingConstraintLimit = 0;
+
+    for(int remaining = numberOfCandidates; remaining > 0;)
+    {
+        int bestIndex = -1;
+        double bestScore = SHOT_DBL_MIN;
+
+        for(int i = 0; i < numberOfCandidates; i++)
+        {
+            if(!isRemaining[i])
+                continue;
+
+            double score = baseScores[i] + orthogonalityWeight * minOrthogonalities[i];
+
+            if(score > bestScore)
+            {
+                bestScore = score;
+                bestIndex = i;
+            }
+        }
+
+        isRemaining[bestIndex] = false;
+        remaining--;
+
+        int constraintIndex = candidates[bestIndex].hyperplane.sourceConstraintIndex;
+
+        if(numberSelectedPerConstraint[constraintIndex] >= maxPerConstraint)
+        {
+            numberOfExceedingConstraintLimit++;
+            continue;
+        }
+
+        numberSelectedPerConstraint[constraintIndex]++;
+
+        // The candidates are moved to the selected ones afterwards, since their terms are needed until then
+        selectedIndexes.push_back(bestIndex);
+
+        auto& selectedElements = candidates[bestIndex].terms->first;
+
+        for(int i = 0; i < numberOfCandidates; i++)
+        {
+            if(!isRemaining[i])
+                continue;
+
+            // Both element vectors are sorted on the variable index
+            double product = 0.0;
+            auto first = selectedElements.begin();
+            auto& candidateElements = candidates[i].terms->first;
+            auto second = candidateElements.begin();
+
+            while(first != selectedElements.end() && second != candidateElements.end())
+            {
+                if(first->first < second->first)
+                {
+                    ++first;
+                }
+                else if(second->first < first->first)
+                {
+                    ++second;
+                }
+                else
+                {
+                    product += first->second * second->second;
+                    ++first;
+                    ++second;
+                }
+            }
+
+            double parallelism = product / (candidateNorms[bestIndex] * candidateNorms[i]);
+
+            // If the hyperplanes are parallel, the one with the larger efficacy is the tighter one, and it has been
+            // selected first unless the difference in efficacy is small
+            if(parallelism > maxParallelism)
+            {
+                isRemaining[i] = false;
+                remaining--;
+                numberOfNearParallel++;
+                continue;
+            }
+
+            minOrthogonalities[i] = std::min(minOrthogonalities[i], 1.0 - std::abs(parallelism));
+        }
+    }
+
+    for(int I : selectedIndexes)
+        selectedHyperplanes.push_back(std::move(candidates[I]));
+
+    if(numberOfNearParallel > 0 || numberOfExceedingConstraintLimit > 0)
+    {
+        env->output->outputDebug(fmt::format("        Hyperplane selection: {} of {} selected, {} removed as almost "
+                                             "parallel and {} exceeding the limit per constraint",
+            selectedHyperplanes.size(), hyperplanes.size(), numberOfNearParallel, numberOfExceedingConstraintLimit));
+    }
+
+    return (selectedHyperplanes);
+}
+
 std::string TaskAddHyperplanes::getType()
 {
     std::string type = typeid(this).name();
@@ -11,8 +11,20 @@
 #pragma once
 #include "TaskBase.h"
 
+#include "../SparseVector.h"
+
+#include <optional>
+#include <utility>
+
 namespace SHOT
 {
+// A hyperplane together with its linear terms and constant, if these have already been calculated
+struct HyperplaneCandidate
+{
+    Hyperplane hyperplane;
+    std::optional<std::pair<SparseIndexVector, double>> terms;
+};
+
 class TaskAddHyperplanes : public TaskBase
 {
 public:
@@ -23,6 +35,12 @@ public:
 
     std::string getType() override;
 
+    // Orders the hyperplanes by a score based on their efficacy in the given solutions, their sparsity and their
+    // orthogonality to the hyperplanes selected before them. Hyperplanes that are almost parallel to a selected one,
+    // and those exceeding the maximum number per constraint, are removed. Candidates without terms are always kept.
+    std::vector<HyperplaneCandidate> selectHyperplanes(std::vector<HyperplaneCandidate> hyperplanes,
+        const std::vector<SolutionPoint>& solutionPoints, int numberOfVariables);
+
 private:
     int itersWithoutAddedHPs;
 };
@@ -45,6 +45,10 @@ void TaskCalculateSolutionChangeNorm::run()
     {
         if(env->results->getNumberOfIterations() > 0 && !env->results->iterations.at(i)->isMIP())
         {
+            // The points of older iterations may have been released
+            if(env->results->iterations.at(i)->hyperplanePoints.size() == 0)
+                return;
+
             auto prevIterSol = env->results->iterations.at(i)->hyperplanePoints.at(0);
 
             double distance = 0;
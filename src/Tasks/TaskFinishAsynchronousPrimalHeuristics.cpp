@@ -0,0 +1,40 @@
+/**
+   The Supporting Hyperplane Optimization Toolkit (SHOT).
+
+   @author Andreas Lundell, Åbo Akademi University
+
+   @section LICENSE
+   This software is licensed under the Eclipse Public License 2.0.
+   Please see the README and LICENSE files for more information.
+*/
+
+#include "TaskFinishAsynchronousPrimalHeuristics.h"
+
+#include "../PrimalSolver.h"
+#include "../Timing.h"
+
+namespace SHOT
+{
+
+TaskFinishAsynchronousPrimalHeuristics::TaskFinishAsynchronousPrimalHeuristics(EnvironmentPtr envPtr)
+    : TaskBase(envPtr)
+{
+}
+
+TaskFinishAsynchronousPrimalHeuristics::~TaskFinishAsynchronousPrimalHeuristics() = default;
+
+void TaskFinishAsynchronousPrimalHeuristics::run()
+{
+    env->timing->startTimer("PrimalStrategy");
+
+    env->primalSolver->finishAsynchronousTasks();
+
+    env->timing->stopTimer("PrimalStrategy");
+}
+
+std::string TaskFinishAsynchronousPrimalHeuristics::getType()
+{
+    std::string type = typeid(this).name();
+    return (type);
+}
+} // namespace SHOT
\ No newline at end of file
@@ -0,0 +1,29 @@
+/**
+   The Supporting Hyperplane Optimization Toolkit (SHOT).
+
+   @author Andreas Lundell, Åbo Akademi University
+
+   @section LICENSE
+   This software is licensed under the Eclipse Public License 2.0.
+   Please see the README and LICENSE files for more information.
+*/
+
+#pragma once
+#include "TaskBase.h"
+
+namespace SHOT
+{
+// Performs the primal heuristics that are waiting to be run in the background, and handles their results
+class TaskFinishAsynchronousPrimalHeuristics : public TaskBase
+{
+public:
+    TaskFinishAsynchronousPrimalHeuristics(EnvironmentPtr envPtr);
+    ~TaskFinishAsynchronousPrimalHeuristics() override;
+
+    void run() override;
+
+    std::string getType() override;
+
+private:
+};
+} // namespace SHOT
\ No newline at end of file
@@ -12,7 +12,10 @@
 
 #include "../Timing.h"
 
+#include "../Settings.h"
+
 #include "../RootsearchMethod/RootsearchMethodBoost.h"
+#include "../RootsearchMethod/RootsearchMethodMultisection.h"
 
 namespace SHOT
 {
@@ -21,7 +24,17 @@ TaskInitializeRootsearch::TaskInitializeRootsearch(EnvironmentPtr envPtr) : Task
 {
     env->timing->startTimer("DualCutGenerationRootSearch");
 
-    env->rootsearchMethod = std::dynamic_pointer_cast<IRootsearchMethod>(std::make_shared<RootsearchMethodBoost>(env));
+    if(static_cast<ES_RootsearchMethod>(env->settings->getSetting<int>("Rootsearch.Method", "Subsolver"))
+        == ES_RootsearchMethod::Multisection)
+    {
+        env->rootsearchMethod
+            = std::dynamic_pointer_cast<IRootsearchMethod>(std::make_shared<RootsearchMethodMultisection>(env));
+    }
+    else
+    {
+        env->rootsearchMethod
+            = std::dynamic_pointer_cast<IRootsearchMethod>(std::make_shared<RootsearchMethodBoost>(env));
+    }
 
     env->timing->stopTimer("DualCutGenerationRootSearch");
 }
@@ -29,6 +29,21 @@
 
 #include "../NLPSolver/NLPSolverSHOT.h"
 
+#ifdef HAS_CPLEX
+#include "../MIPSolver/MIPSolverCplex.h"
+#endif
+
+#ifdef HAS_GUROBI
+#include "../MIPSolver/MIPSolverGurobi.h"
+#endif
+
+#ifdef HAS_CBC
+#include "../MIPSolver/MIPSolverCbc.h"
+#endif
+
+#include <atomic>
+#include <chrono>
+
 namespace SHOT
 {
 
@@ -165,6 +180,12 @@ void TaskPerformBoundTightening::run()
         }
     }
 
+    // Bounds from LP problems are not needed for problems solved by the MIP solver
+    if(env->settings->getSetting<bool>("BoundTightening.OptimizationBased.Use", "Model")
+        && !sourceProblem->properties.isLPProblem && !sourceProblem->properties.isMILPProblem
+        && sourceProblem->properties.numberOfLinearConstraints > 0)
+        performOBBT();
+
     env->timing->stopTimer("BoundTightening");
 }
 
@@ -276,4 +297,246 @@ void TaskPerformBoundTightening::createPOA()
         env->timing->getElapsedTime("BoundTighteningPOA")));
 }
 
+void TaskPerformBoundTightening::performOBBT()
+{
+    env->timing->startTimer("BoundTighteningOBBT");
+
+    env->output->outputInfo(" Performing optimization-based bound tightening.");
+
+    int maxVariables = env->settings->getSetting<int>("BoundTightening.OptimizationBased.MaxVariables", "Model");
+    double timeLimit = env->settings->getSetting<double>("BoundTightening.OptimizationBased.TimeLimit", "Model");
+
+    auto timeEnd = std::chrono::steady_clock::now() + std::chrono::duration<double>(timeLimit);
+
+    std::vector<MIPSolverPtr> LPSolvers;
+
+    if(auto LPSolver = createOBBTSolver())
+        LPSolvers.push_back(LPSolver);
+
+    if(LPSolvers.empty())
+    {
+        env->output->outputInfo("  - No LP solver available for optimization-based bound tightening.");
+        env->timing->stopTimer("BoundTighteningOBBT");
+        return;
+    }
+
+    double unboundedValue = LPSolvers[0]->getUnboundedVariableBoundValue();
+
+    // The variables in nonlinear (including bilinear) terms affect the outer approximation the most, as do unbounded
+    // variables. Binary variables are skipped since they are seldom fixed by an LP problem.
+    std::vector<VariablePtr> variables;
+
+    for(auto& V : sourceProblem->allVariables)
+    {
+        if(V->properties.type == E_VariableType::Binary || V->properties.type == E_VariableType::Semicontinuous
+            || V->properties.type == E_VariableType::Semiinteger || V->lowerBound >= V->upperBound)
+            continue;
+
+        if(V->properties.isNonlinear || V->properties.inQuadraticTerms || V->lowerBound <= -unboundedValue
+            || V->upperBound >= unboundedValue)
+            variables.push_back(V);
+    }
+
+    // If there are too many variables, the ones with the largest domains are selected
+    if((int)variables.size() > maxVariables)
+    {
+        std::stable_sort(variables.begin(), variables.end(),
+            [](const auto& V1, const auto& V2)
+            { return (V1->upperBound - V1->lowerBound > V2->upperBound - V2->lowerBound); });
+
+        variables.resize(maxVariables);
+    }
+
+    // The LP problems are solved in the shared thread pool, whose threads are only started if it is used
+    int numberOfThreads = env->settings->getSetting<int>("BoundTightening.OptimizationBased.NumberOfThreads", "Model");
+    size_t numberOfSolvers = std::min((size_t)env->threadPool.getNumberOfThreads(), variables.size());
+
+    if(numberOfThreads > 0)
+        numberOfSolvers = std::min(numberOfSolvers, (size_t)numberOfThreads);
+
+    while(LPSolvers.size() < numberOfSolvers)
+    {
+        auto LPSolver = createOBBTSolver();
+
+        if(!LPSolver)
+            break;
+
+        LPSolvers.push_back(LPSolver);
+    }
+
+    env->output->outputDebug(fmt::format(
+        "  Tightening the bounds of {} variables with {} LP solvers.", variables.size(), LPSolvers.size()));
+
+    // The bounds are only calculated in the threads and applied afterwards, so the result does not depend on the order
+    // in which the LP problems are solved
+    std::vector<std::optional<double>> lowerBounds(variables.size());
+    std::vector<std::optional<double>> upperBounds(variables.size());
+
+    std::atomic<size_t> nextVariable { 0 };
+    std::atomic<int> numberOfSolvedProblems { 0 };
+
+    auto tightenVariables = [&](size_t j)
+    {
+        auto& LPSolver = LPSolvers[j];
+
+        // Each LP problem is limited to the time remaining, so that a single problem cannot exceed the time limit
+        auto calculateVariableBound = [&](size_t i, bool isLowerBound) -> std::optional<double>
+        {
+            double remainingTime = std::chrono::duration<double>(timeEnd - std::chrono::steady_clock::now()).count();
+
+            if(remainingTime <= 0)
+                return (std::nullopt);
+
+            LPSolver->setTimeLimit(remainingTime);
+            numberOfSolvedProblems++;
+
+            return (LPSolver->calculateVariableBound(variables[i]->index, isLowerBound));
+        };
+
+        for(size_t i = nextVariable++; i < variables.size(); i = nextVariable++)
+        {
+            if(std::chrono::steady_clock::now() > timeEnd)
+                break;
+
+            lowerBounds[i] = calculateVariableBound(i, true);
+            upperBounds[i] = calculateVariableBound(i, false);
+        }
+    };
+
+    if(LPSolvers.size() > 1)
+        env->threadPool.run(LPSolvers.size(), tightenVariables);
+    else
+        tightenVariables(0);
+
+    // The LP solutions are only feasible within the tolerances of the LP solver, so the bounds are relaxed slightly
+    double boundTolerance = env->settings->getSetting<double>("Tolerance.LinearConstraint", "Primal");
+
+    int numberOfTightenedVariables = 0;
+
+    for(size_t i = 0; i < variables.size(); i++)
+    {
+        double lowerBound = SHOT_DBL_MIN;
+        double upperBound = SHOT_DBL_MAX;
+
+        if(lowerBounds[i] && *lowerBounds[i] > -unboundedValue)
+            lowerBound = *lowerBounds[i] - boundTolerance * std::max(1.0, std::abs(*lowerBounds[i]));
+
+        if(upperBounds[i] && *upperBounds[i] < unboundedValue)
+            upperBound = *upperBounds[i] + boundTolerance * std::max(1.0, std::abs(*upperBounds[i]));
+
+        auto& V = variables[i];
+
+        // The bounds of the LP relaxation can be rounded for integer variables
+        if(V->properties.type == E_VariableType::Integer)
+        {
+            if(lowerBound != SHOT_DBL_MIN)
+                lowerBound = std::ceil(lowerBound);
+
+            if(upperBound != SHOT_DBL_MAX)
+                upperBound = std::floor(upperBound);
+        }
+
+        if(lowerBound > upperBound)
+            continue;
+
+        if(!V->tightenBounds(Interval(lowerBound, upperBound)))
+            continue;
+
+        numberOfTightenedVariables++;
+
+        // The bound vectors are also copied when the problem is reformulated
+        if(V->index < (int)sourceProblem->variableBounds.size())
+        {
+            sourceProblem->variableLowerBounds[V->index] = V->lowerBound;
+            sourceProblem->variableUpperBounds[V->index] = V->upperBound;
+            sourceProblem->variableBounds[V->index] = Interval(V->lowerBound, V->upperBound);
+        }
+    }
+
+    env->timing->stopTimer("BoundTighteningOBBT");
+
+    env->output->outputInfo(fmt::format("  - Bounds for {} variables tightened in {:.2f} s and {} LP problems.",
+        numberOfTightenedVariables, env->timing->getElapsedTime("BoundTighteningOBBT"),
+        numberOfSolvedProblems.load()));
+}
+
+MIPSolverPtr TaskPerformBoundTightening::createOBBTSolver()
+{
+    auto solver = static_cast<ES_MIPSolver>(env->settings->getSetting<int>("MIP.Solver", "Dual"));
+
+    MIPSolverPtr LPSolver;
+
+#ifdef HAS_CPLEX
+    if(solver == ES_MIPSolver::Cplex)
+        LPSolver = MIPSolverPtr(std::make_shared<MIPSolverCplex>(env));
+#endif
+
+#ifdef HAS_GUROBI
+    if(solver == ES_MIPSolver::Gurobi)
+        LPSolver = MIPSolverPtr(std::make_shared<MIPSolverGurobi>(env));
+#endif
+
+#ifdef HAS_CBC
+    if(solver == ES_MIPSolver::Cbc)
+        LPSolver = MIPSolverPtr(std::make_shared<MIPSolverCbc>(env));
+#endif
+
+    if(!LPSolver)
+    {
+#ifdef HAS_CBC
+        LPSolver = MIPSolverPtr(std::make_shared<MIPSolverCbc>(env));
+#elif HAS_GUROBI
+        LPSolver = MIPSolverPtr(std::make_shared<MIPSolverGurobi>(env));
+#elif HAS_CPLEX
+        LPSolver = MIPSolverPtr(std::make_shared<MIPSolverCplex>(env));
+#else
+        return (nullptr);
+#endif
+    }
+
+    if(!LPSolver->initializeProblem())
+        return (nullptr);
+
+    bool problemInitialized = true;
+
+    // All variables are continuous, and semicontinuous variables can also be zero
+    for(auto& V : sourceProblem->allVariables)
+    {
+        double lowerBound = V->lowerBound;
+        double upperBound = V->upperBound;
+
+        if(V->properties.type == E_VariableType::Semicontinuous || V->properties.type == E_VariableType::Semiinteger)
+        {
+            lowerBound = std::min({ lowerBound, V->semiBound, 0.0 });
+            upperBound = std::max({ upperBound, V->semiBound, 0.0 });
+        }
+
+        problemInitialized = problemInitialized
+            && LPSolver->addVariable(V->name.c_str(), E_VariableType::Real, lowerBound, upperBound, 0.0);
+    }
+
+    problemInitialized = problemInitialized && LPSolver->initializeObjective() && LPSolver->finalizeObjective(true);
+
+    for(auto& C : sourceProblem->linearConstraints)
+    {
+        problemInitialized = problemInitialized && LPSolver->initializeConstraint();
+
+        for(auto& T : C->linearTerms)
+        {
+            problemInitialized
+                = problemInitialized && LPSolver->addLinearTermToConstraint(T->coefficient, T->variable->index);
+        }
+
+        problemInitialized
+            = problemInitialized && LPSolver->finalizeConstraint(C->name, C->valueLHS, C->valueRHS, C->constant);
+    }
+
+    if(!problemInitialized || !LPSolver->finalizeProblem())
+        return (nullptr);
+
+    LPSolver->initializeSolverSettings();
+
+    return (LPSolver);
+}
+
 } // namespace SHOT
\ No newline at end of file
@@ -34,6 +34,13 @@ public:
 private:
     virtual void createPOA();
 
+    // Tightens the bounds of selected variables by minimizing and maximizing them over the linear constraints in the
+    // problem, which include the initial POA if it has been created
+    void performOBBT();
+
+    // Creates an LP solver for the linear constraints in the problem with the variables relaxed to continuous ones
+    MIPSolverPtr createOBBTSolver();
+
     std::shared_ptr<TaskBase> taskSelectHPPts;
 
     ProblemPtr sourceProblem;
@@ -0,0 +1,138 @@
+/**
+   The Supporting Hyperplane Optimization Toolkit (SHOT).
+
+   @author Andreas Lundell, Åbo Akademi University
+
+   @section LICENSE
+   This software is licensed under the Eclipse Public License 2.0.
+   Please see the README and LICENSE files for more information.
+*/
+
+#include "TaskPerformIncrementalBoundTightening.h"
+
+#include "../DualSolver.h"
+#include "../MIPSolver/IMIPSolver.h"
+#include "../Output.h"
+#include "../Results.h"
+#include "../Settings.h"
+#include "../Timing.h"
+
+#include "../Model/Problem.h"
+
+#include <algorithm>
+
+namespace SHOT
+{
+
+TaskPerformIncrementalBoundTightening::TaskPerformIncrementalBoundTightening(EnvironmentPtr envPtr) : TaskBase(envPtr)
+{
+    auto& objective = env->reformulatedProblem->objectiveFunction;
+
+    lastCutOff = objective->properties.isMinimize ? SHOT_DBL_MAX : SHOT_DBL_MIN;
+
+    // The terms are shared with the objective function, and the constraint is not added to the problem
+    if(objective->properties.classification == E_ObjectiveFunctionClassification::Linear)
+    {
+        auto constraint = std::make_shared<LinearConstraint>(-1, "objective_cutoff", SHOT_DBL_MIN, SHOT_DBL_MAX);
+        constraint->add(std::dynamic_pointer_cast<LinearObjectiveFunction>(objective)->linearTerms);
+        objectiveConstraint = constraint;
+    }
+    else if(objective->properties.classification == E_ObjectiveFunctionClassification::Quadratic)
+    {
+        auto constraint = std::make_shared<QuadraticConstraint>(-1, "objective_cutoff", SHOT_DBL_MIN, SHOT_DBL_MAX);
+        constraint->add(std::dynamic_pointer_cast<QuadraticObjectiveFunction>(objective)->linearTerms);
+        constraint->add(std::dynamic_pointer_cast<QuadraticObjectiveFunction>(objective)->quadraticTerms);
+        objectiveConstraint = constraint;
+    }
+
+    if(objectiveConstraint)
+        objectiveConstraint->constant = objective->constant;
+
+    for(auto& V : env->reformulatedProblem->allVariables)
+    {
+        lowerBounds.push_back(V->lowerBound);
+        upperBounds.push_back(V->upperBound);
+    }
+}
+
+TaskPerformIncrementalBoundTightening::~TaskPerformIncrementalBoundTightening() = default;
+
+void TaskPerformIncrementalBoundTightening::run()
+{
+    auto& problem = env->reformulatedProblem;
+
+    env->timing->startTimer("BoundTightening");
+
+    // An improved cutoff value tightens the bounds of the variables in the objective function
+    if(objectiveConstraint && env->dualSolver->useCutOff)
+    {
+        bool isMinimize = problem->objectiveFunction->properties.isMinimize;
+        double cutOff = env->dualSolver->cutOffToUse;
+
+        if(std::abs(cutOff) < SHOT_DBL_MAX && (isMinimize ? cutOff < lastCutOff : cutOff > lastCutOff))
+        {
+            lastCutOff = cutOff;
+
+            double tolerance = env->settings->getSetting<double>("MIP.CutOff.Tolerance", "Dual");
+
+            if(isMinimize)
+                objectiveConstraint->valueRHS = cutOff + tolerance;
+            else
+                objectiveConstraint->valueLHS = cutOff - tolerance;
+
+            double timeLimit = env->timing->getElapsedTime("BoundTightening")
+                + env->settings->getSetting<double>("BoundTightening.FeasibilityBased.TimeLimit", "Model");
+
+            problem->doFBBTOnConstraint(objectiveConstraint, timeLimit);
+        }
+    }
+
+    env->timing->stopTimer("BoundTightening");
+
+    std::vector<int> tightenedVariables;
+
+    for(auto& V : problem->allVariables)
+    {
+        if(V->lowerBound > lowerBounds[V->index] || V->upperBound < upperBounds[V->index])
+            tightenedVariables.push_back(V->index);
+    }
+
+    if(tightenedVariables.empty())
+        return;
+
+    auto propagatedVariables = problem->doIncrementalFBBT(tightenedVariables);
+
+    tightenedVariables.insert(tightenedVariables.end(), propagatedVariables.begin(), propagatedVariables.end());
+
+    std::sort(tightenedVariables.begin(), tightenedVariables.end());
+    tightenedVariables.erase(
+        std::unique(tightenedVariables.begin(), tightenedVariables.end()), tightenedVariables.end());
+
+    auto& MIPSolver = env->dualSolver->MIPSolver;
+    double unboundedValue = MIPSolver->getUnboundedVariableBoundValue();
+
+    for(auto k : tightenedVariables)
+    {
+        auto& V = problem->allVariables[k];
+
+        lowerBounds[k] = V->lowerBound;
+        upperBounds[k] = V->upperBound;
+
+        // Bounds of semicontinuous variables do not include zero, so they are left as they are
+        if(V->properties.type == E_VariableType::Semicontinuous || V->properties.type == E_VariableType::Semiinteger)
+            continue;
+
+        MIPSolver->updateVariableBound(
+            k, std::max(V->lowerBound, -unboundedValue), std::min(V->upperBound, unboundedValue));
+    }
+
+    env->output->outputDebug(
+        fmt::format("        Bounds for {} variables updated in the MIP problem.", tightenedVariables.size()));
+}
+
+std::string TaskPerformIncrementalBoundTightening::getType()
+{
+    std::string type = typeid(this).name();
+    return (type);
+}
+} // namespace SHOT
\ No newline at end of file
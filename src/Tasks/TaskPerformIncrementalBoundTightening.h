@@ -0,0 +1,41 @@
+/**
+   The Supporting Hyperplane Optimization Toolkit (SHOT).
+
+   @author Andreas Lundell, Åbo Akademi University
+
+   @section LICENSE
+   This software is licensed under the Eclipse Public License 2.0.
+   Please see the README and LICENSE files for more information.
+*/
+
+#pragma once
+#include "TaskBase.h"
+
+#include "../Structs.h"
+
+#include "../Model/Constraints.h"
+
+namespace SHOT
+{
+// Propagates bounds tightened during the solution process through the reformulated problem, and updates the bounds in
+// the MIP solver. The bounds are tightened by the objective cutoff when a better primal solution has been found, or
+// elsewhere, e.g. by the MIP presolve.
+class TaskPerformIncrementalBoundTightening : public TaskBase
+{
+public:
+    TaskPerformIncrementalBoundTightening(EnvironmentPtr envPtr);
+    ~TaskPerformIncrementalBoundTightening() override;
+
+    void run() override;
+    std::string getType() override;
+
+private:
+    // The objective function as a constraint, whose bound is the cutoff value
+    NumericConstraintPtr objectiveConstraint;
+    double lastCutOff;
+
+    // The variable bounds after the last run, used for detecting the bounds tightened elsewhere since then
+    VectorDouble lowerBounds;
+    VectorDouble upperBounds;
+};
+} // namespace SHOT
\ No newline at end of file
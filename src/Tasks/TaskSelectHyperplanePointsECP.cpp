@@ -24,8 +24,16 @@ namespace SHOT
 
 TaskSelectHyperplanePointsECP::TaskSelectHyperplanePointsECP(EnvironmentPtr envPtr) : TaskBase(envPtr)
 {
-    env->timing->startTimer("DualCutGenerationRootSearch");
-    env->timing->stopTimer("DualCutGenerationRootSearch");
+    settingConstraintSelectionFactor
+        = env->settings->getSettingHandle<double>("HyperplaneCuts.ConstraintSelectionFactor", "Dual");
+    settingUniqueConstraints = env->settings->getSettingHandle<bool>("ESH.Rootsearch.UniqueConstraints", "Dual");
+    settingMaxHyperplanesPerIteration = env->settings->getSettingHandle<int>("HyperplaneCuts.MaxPerIteration", "Dual");
+    settingMaxConstraintFactor = env->settings->getSettingHandle<double>("HyperplaneCuts.MaxConstraintFactor", "Dual");
+
+    timerRootsearch = env->timing->getTimerID("DualCutGenerationRootSearch");
+
+    env->timing->startTimer(timerRootsearch);
+    env->timing->stopTimer(timerRootsearch);
 }
 
 TaskSelectHyperplanePointsECP::~TaskSelectHyperplanePointsECP() = default;
@@ -39,18 +47,16 @@ void TaskSelectHyperplanePointsECP::run(std::vector<SolutionPoint> solPoints)
 
     env->output->outputDebug("        Selecting cutting planes using the ECP method:");
 
-    env->timing->startTimer("DualCutGenerationRootSearch");
+    env->timing->startTimer(timerRootsearch);
 
     int addedHyperplanes = 0;
     auto currIter = env->results->getCurrentIteration(); // The unsolved new iteration
 
-    auto constraintSelectionFactor
-        = env->settings->getSetting<double>("HyperplaneCuts.ConstraintSelectionFactor", "Dual");
-    bool useUniqueConstraints = env->settings->getSetting<bool>("ESH.Rootsearch.UniqueConstraints", "Dual");
+    auto constraintSelectionFactor = settingConstraintSelectionFactor.get();
+    bool useUniqueConstraints = settingUniqueConstraints.get();
 
-    int maxHyperplanesPerIter = env->settings->getSetting<int>("HyperplaneCuts.MaxPerIteration", "Dual");
-    double constraintMaxSelectionFactor
-        = env->settings->getSetting<double>("HyperplaneCuts.MaxConstraintFactor", "Dual");
+    int maxHyperplanesPerIter = settingMaxHyperplanesPerIteration.get();
+    double constraintMaxSelectionFactor = settingMaxConstraintFactor.get();
 
     // Contains boolean array that indicates if a constraint has been added or not
     std::vector<bool> hyperplaneAddedToConstraint(
@@ -59,16 +65,25 @@ void TaskSelectHyperplanePointsECP::run(std::vector<SolutionPoint> solPoints)
     std::vector<std::tuple<int, NumericConstraintValue>> selectedNumericValues;
     std::vector<std::tuple<int, NumericConstraintValue>> nonconvexSelectedNumericValues;
 
+    // Evaluate the nonlinear constraints in all solution points as one batch
+    std::vector<VectorDouble> points;
+    points.reserve(solPoints.size());
+
+    for(auto& SP : solPoints)
+        points.push_back(SP.point);
+
+    auto allNumericConstraintValues
+        = env->reformulatedProblem->getFractionOfDeviatingNonlinearConstraints(points, 0.0, constraintSelectionFactor);
+
     for(size_t i = 0; i < solPoints.size(); i++)
     {
-        auto numericConstraintValues = env->reformulatedProblem->getFractionOfDeviatingNonlinearConstraints(
-            solPoints.at(i).point, 0.0, constraintSelectionFactor);
+        auto& numericConstraintValues = allNumericConstraintValues[i];
 
         for(auto& NCV : numericConstraintValues)
         {
             if(addedHyperplanes >= maxHyperplanesPerIter)
             {
-                env->timing->stopTimer("DualCutGenerationRootSearch");
+                env->timing->stopTimer(timerRootsearch);
                 break;
             }
 
@@ -246,7 +261,7 @@ void TaskSelectHyperplanePointsECP::run(std::vector<SolutionPoint> solPoints)
         env->output->outputDebug("         All nonlinear constraints fulfilled, so no constraint cuts added.");
     }
 
-    env->timing->stopTimer("DualCutGenerationRootSearch");
+    env->timing->stopTimer(timerRootsearch);
 }
 
 std::string TaskSelectHyperplanePointsECP::getType()
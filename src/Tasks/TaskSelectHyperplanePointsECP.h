@@ -12,6 +12,8 @@
 #include "TaskBase.h"
 
 #include "../Structs.h"
+#include "../Settings.h"
+#include "../Timing.h"
 
 namespace SHOT
 {
@@ -27,5 +29,11 @@ public:
     std::string getType() override;
 
 private:
+    SettingHandle<double> settingConstraintSelectionFactor;
+    SettingHandle<bool> settingUniqueConstraints;
+    SettingHandle<int> settingMaxHyperplanesPerIteration;
+    SettingHandle<double> settingMaxConstraintFactor;
+
+    TimerID timerRootsearch;
 };
 } // namespace SHOT
\ No newline at end of file
@@ -20,6 +20,9 @@
 
 #include "../Model/Problem.h"
 
+#include "../PrimalSolver.h"
+#include "../ThreadPool.h"
+
 #include "TaskSelectHyperplanePointsECP.h"
 #include "../RootsearchMethod/IRootsearchMethod.h"
 
@@ -28,8 +31,26 @@ namespace SHOT
 
 TaskSelectHyperplanePointsESH::TaskSelectHyperplanePointsESH(EnvironmentPtr envPtr) : TaskBase(envPtr)
 {
-    env->timing->startTimer("DualCutGenerationRootSearch");
-    env->timing->stopTimer("DualCutGenerationRootSearch");
+    settingConstraintSelectionFactor
+        = env->settings->getSettingHandle<double>("HyperplaneCuts.ConstraintSelectionFactor", "Dual");
+    settingUniqueConstraints = env->settings->getSettingHandle<bool>("ESH.Rootsearch.UniqueConstraints", "Dual");
+    settingRootMaxIterations = env->settings->getSettingHandle<int>("Rootsearch.MaxIterations", "Subsolver");
+    settingRootTerminationTolerance
+        = env->settings->getSettingHandle<double>("Rootsearch.TerminationTolerance", "Subsolver");
+    settingRootActiveConstraintTolerance
+        = env->settings->getSettingHandle<double>("Rootsearch.ActiveConstraintTolerance", "Subsolver");
+    settingMaxHyperplanesPerIteration = env->settings->getSettingHandle<int>("HyperplaneCuts.MaxPerIteration", "Dual");
+    settingRootsearchConstraintTolerance
+        = env->settings->getSettingHandle<double>("ESH.Rootsearch.ConstraintTolerance", "Dual");
+    settingMaxConstraintFactor = env->settings->getSettingHandle<double>("HyperplaneCuts.MaxConstraintFactor", "Dual");
+    settingUseMaxFunction = env->settings->getSettingHandle<bool>("ESH.Rootsearch.UseMaxFunction", "Dual");
+    settingNumberOfThreads = env->settings->getSettingHandle<int>("ESH.Rootsearch.NumberOfThreads", "Dual");
+
+    timerRootsearch = env->timing->getTimerID("DualCutGenerationRootSearch");
+    timerRootsearchThreads = env->timing->getTimerID("DualCutGenerationRootSearchThreads");
+
+    env->timing->startTimer(timerRootsearch);
+    env->timing->stopTimer(timerRootsearch);
 }
 
 TaskSelectHyperplanePointsESH::~TaskSelectHyperplanePointsESH() = default;
@@ -43,7 +64,7 @@ void TaskSelectHyperplanePointsESH::run(std::vector<SolutionPoint> solPoints)
 
     env->output->outputDebug("        Selecting separating hyperplanes using the ESH method:");
 
-    env->timing->startTimer("DualCutGenerationRootSearch");
+    env->timing->startTimer(timerRootsearch);
 
     if(env->dualSolver->interiorPts.size() == 0)
     {
@@ -53,7 +74,7 @@ void TaskSelectHyperplanePointsESH::run(std::vector<SolutionPoint> solPoints)
         env->output->outputDebug("         Adding cutting plane since no interior point is known.");
         tSelectHPPts->run(solPoints);
 
-        env->timing->stopTimer("DualCutGenerationRootSearch");
+        env->timing->stopTimer(timerRootsearch);
         return;
     }
     else if(env->solutionStatistics.numberOfIterationsWithDualStagnation > 2
@@ -65,26 +86,22 @@ void TaskSelectHyperplanePointsESH::run(std::vector<SolutionPoint> solPoints)
         env->output->outputDebug("         Adding cutting plane since the dual has stagnated.");
         tSelectHPPts->run(solPoints);
 
-        env->timing->stopTimer("DualCutGenerationRootSearch");
+        env->timing->stopTimer(timerRootsearch);
         return;
     }
 
     int addedHyperplanes = 0;
     auto currIter = env->results->getCurrentIteration(); // The unsolved new iteration
 
-    auto constraintSelectionFactor
-        = env->settings->getSetting<double>("HyperplaneCuts.ConstraintSelectionFactor", "Dual");
-    bool useUniqueConstraints = env->settings->getSetting<bool>("ESH.Rootsearch.UniqueConstraints", "Dual");
+    auto constraintSelectionFactor = settingConstraintSelectionFactor.get();
+    bool useUniqueConstraints = settingUniqueConstraints.get();
 
-    int rootMaxIter = env->settings->getSetting<int>("Rootsearch.MaxIterations", "Subsolver");
-    double rootTerminationTolerance = env->settings->getSetting<double>("Rootsearch.TerminationTolerance", "Subsolver");
-    double rootActiveConstraintTolerance
-        = env->settings->getSetting<double>("Rootsearch.ActiveConstraintTolerance", "Subsolver");
-    int maxHyperplanesPerIter = env->settings->getSetting<int>("HyperplaneCuts.MaxPerIteration", "Dual");
-    double rootsearchConstraintTolerance
-        = env->settings->getSetting<double>("ESH.Rootsearch.ConstraintTolerance", "Dual");
-    double constraintMaxSelectionFactor
-        = env->settings->getSetting<double>("HyperplaneCuts.MaxConstraintFactor", "Dual");
+    rootMaxIter = settingRootMaxIterations.get();
+    rootTerminationTolerance = settingRootTerminationTolerance.get();
+    rootActiveConstraintTolerance = settingRootActiveConstraintTolerance.get();
+    int maxHyperplanesPerIter = settingMaxHyperplanesPerIteration.get();
+    double rootsearchConstraintTolerance = settingRootsearchConstraintTolerance.get();
+    double constraintMaxSelectionFactor = settingMaxConstraintFactor.get();
 
     // Contains boolean array that indicates if a constraint has been added or not
     std::vector<bool> hyperplaneAddedToConstraint(
@@ -93,16 +110,27 @@ void TaskSelectHyperplanePointsESH::run(std::vector<SolutionPoint> solPoints)
     std::vector<std::tuple<int, int, NumericConstraintValues>> selectedNumericValues;
     std::vector<std::tuple<int, int, NumericConstraintValues>> nonconvexSelectedNumericValues;
 
-    bool useMaxFunction = env->settings->getSetting<bool>("ESH.Rootsearch.UseMaxFunction", "Dual");
+    bool useMaxFunction = settingUseMaxFunction.get();
+
+    bool useParallelRootsearch = (settingNumberOfThreads.get() != 1 && env->threadPool.getNumberOfThreads() > 1);
 
     if(useMaxFunction)
         constraintSelectionFactor = 1.0;
 
+    // The constraints are evaluated in all solution points at once since the solution pool can contain many points
+    std::vector<VectorDouble> points;
+    points.reserve(solPoints.size());
+
+    for(auto& SP : solPoints)
+        points.push_back(SP.point);
+
+    auto allNumericConstraintValues
+        = env->reformulatedProblem->getFractionOfDeviatingNonlinearConstraints(points, 0.0, constraintSelectionFactor);
+
     // First find the interior point - solution point - constraint combination that will be used for root search
     for(size_t i = 0; i < solPoints.size(); i++)
     {
-        auto numericConstraintValues = env->reformulatedProblem->getFractionOfDeviatingNonlinearConstraints(
-            solPoints.at(i).point, 0.0, constraintSelectionFactor);
+        auto& numericConstraintValues = allNumericConstraintValues[i];
 
         if(numericConstraintValues.size() == 0)
             continue;
@@ -110,7 +138,7 @@ void TaskSelectHyperplanePointsESH::run(std::vector<SolutionPoint> solPoints)
         if(addedHyperplanes >= maxHyperplanesPerIter)
         {
             env->output->outputDebug("        Not generating hyperplane using ESH: Max number already added.");         
-            env->timing->stopTimer("DualCutGenerationRootSearch");
+            env->timing->stopTimer(timerRootsearch);
             break;
         }
 
@@ -202,6 +230,53 @@ void TaskSelectHyperplanePointsESH::run(std::vector<SolutionPoint> solPoints)
         }
     }
 
+    std::vector<Rootsearch> rootsearches;
+    std::vector<std::optional<std::pair<VectorDouble, VectorDouble>>> rootsearchResults;
+    size_t nextRootsearchResult = 0;
+
+    // Uses the results from the parallel root searches if available, otherwise performs the root search directly
+    auto findZero = [&](int solutionPtIndex, int interiorPtIndex, const std::vector<NumericConstraint*>& constraints)
+        -> std::optional<std::pair<VectorDouble, VectorDouble>>
+    {
+        if(!useParallelRootsearch)
+        {
+            env->timing->startTimer(timerRootsearch);
+            auto result = performRootsearch(env->dualSolver->interiorPts.at(interiorPtIndex)->point,
+                solPoints.at(solutionPtIndex).point, constraints, true);
+            env->timing->stopTimer(timerRootsearch);
+
+            return (result);
+        }
+
+        // Since each root search gives at most one hyperplane, a batch not larger than the number of hyperplanes that
+        // can still be added only contains root searches that would also be performed when not in parallel
+        if(nextRootsearchResult == rootsearchResults.size())
+        {
+            size_t numberOfRootsearches = std::min(rootsearches.size() - nextRootsearchResult,
+                (size_t)std::max(1, maxHyperplanesPerIter - addedHyperplanes));
+
+            auto results
+                = performRootsearchesInParallel(solPoints, rootsearches, nextRootsearchResult, numberOfRootsearches);
+
+            rootsearchResults.insert(rootsearchResults.end(), std::make_move_iterator(results.begin()),
+                std::make_move_iterator(results.end()));
+        }
+
+        auto result = rootsearchResults.at(nextRootsearchResult++);
+
+        // The primal solver is not thread safe, so the candidates are added here and only for the results used
+        if(result)
+        {
+            env->primalSolver->addPrimalSolutionCandidate(result->first, E_PrimalSolutionSource::Rootsearch,
+                env->results->getCurrentIteration()->iterationNumber);
+        }
+
+        return (result);
+    };
+
+    if(useParallelRootsearch)
+        rootsearches = getRootsearches(selectedNumericValues, useMaxFunction);
+
     // First try to do root search on convex constraints only
     for(auto& values : selectedNumericValues)
     {
@@ -221,24 +296,14 @@ void TaskSelectHyperplanePointsESH::run(std::vector<SolutionPoint> solPoints)
             for(auto& NCV : std::get<2>(values))
                 currentConstraints.push_back(NCV.constraint.get());
 
-            try
+            if(auto rootsearchResult = findZero(solutionPtIndex, interiorPtIndex, currentConstraints))
             {
-                env->timing->startTimer("DualCutGenerationRootSearch");
-                auto xNewc = env->rootsearchMethod->findZero(env->dualSolver->interiorPts.at(interiorPtIndex)->point,
-                    solPoints.at(solutionPtIndex).point, rootMaxIter, rootTerminationTolerance,
-                    rootActiveConstraintTolerance, currentConstraints, true);
-
-                env->timing->stopTimer("DualCutGenerationRootSearch");
-                internalPoint = xNewc.first;
-                externalPoint = xNewc.second;
+                internalPoint = rootsearchResult->first;
+                externalPoint = rootsearchResult->second;
             }
-            catch(std::exception&)
+            else
             {
-                env->timing->stopTimer("DualCutGenerationRootSearch");
                 externalPoint = solPoints.at(solutionPtIndex).point;
-
-                env->output->outputDebug(
-                    "         Cannot find solution with rootsearch, using solution point instead.");
             }
 
             auto externalConstraintValue = env->reformulatedProblem->getMaxNumericConstraintValue(
@@ -309,24 +374,14 @@ void TaskSelectHyperplanePointsESH::run(std::vector<SolutionPoint> solPoints)
                 std::vector<NumericConstraint*> currentConstraint;
                 currentConstraint.push_back(std::dynamic_pointer_cast<NumericConstraint>(NCV.constraint).get());
 
-                try
+                if(auto rootsearchResult = findZero(solutionPtIndex, interiorPtIndex, currentConstraint))
                 {
-                    env->timing->startTimer("DualCutGenerationRootSearch");
-                    auto xNewc = env->rootsearchMethod->findZero(
-                        env->dualSolver->interiorPts.at(interiorPtIndex)->point, solPoints.at(solutionPtIndex).point,
-                        rootMaxIter, rootTerminationTolerance, rootActiveConstraintTolerance, currentConstraint, true);
-
-                    env->timing->stopTimer("DualCutGenerationRootSearch");
-                    internalPoint = xNewc.first;
-                    externalPoint = xNewc.second;
+                    internalPoint = rootsearchResult->first;
+                    externalPoint = rootsearchResult->second;
                 }
-                catch(std::exception&)
+                else
                 {
-                    env->timing->stopTimer("DualCutGenerationRootSearch");
                     externalPoint = solPoints.at(solutionPtIndex).point;
-
-                    env->output->outputDebug(
-                        "         Cannot find solution with rootsearch, using solution point instead.");
                 }
 
                 auto externalConstraintValue = NCV.constraint->calculateNumericValue(externalPoint);
@@ -395,6 +450,13 @@ void TaskSelectHyperplanePointsESH::run(std::vector<SolutionPoint> solPoints)
     {
         env->output->outputDebug("         Could not add hyperplane for convex constraints");
 
+        if(useParallelRootsearch)
+        {
+            rootsearches = getRootsearches(nonconvexSelectedNumericValues, useMaxFunction);
+            rootsearchResults.clear();
+            nextRootsearchResult = 0;
+        }
+
         for(auto& values : nonconvexSelectedNumericValues)
         {
             int solutionPtIndex = std::get<0>(values);
@@ -413,24 +475,14 @@ void TaskSelectHyperplanePointsESH::run(std::vector<SolutionPoint> solPoints)
                 for(auto& NCV : std::get<2>(values))
                     currentConstraints.push_back(NCV.constraint.get());
 
-                try
+                if(auto rootsearchResult = findZero(solutionPtIndex, interiorPtIndex, currentConstraints))
                 {
-                    env->timing->startTimer("DualCutGenerationRootSearch");
-                    auto xNewc = env->rootsearchMethod->findZero(
-                        env->dualSolver->interiorPts.at(interiorPtIndex)->point, solPoints.at(solutionPtIndex).point,
-                        rootMaxIter, rootTerminationTolerance, rootActiveConstraintTolerance, currentConstraints, true);
-
-                    env->timing->stopTimer("DualCutGenerationRootSearch");
-                    internalPoint = xNewc.first;
-                    externalPoint = xNewc.second;
+                    internalPoint = rootsearchResult->first;
+                    externalPoint = rootsearchResult->second;
                 }
-                catch(std::exception&)
+                else
                 {
-                    env->timing->stopTimer("DualCutGenerationRootSearch");
                     externalPoint = solPoints.at(solutionPtIndex).point;
-
-                    env->output->outputDebug(
-                        "         Cannot find solution with rootsearch, using solution point instead.");
                 }
 
                 auto externalConstraintValue = env->reformulatedProblem->getMaxNumericConstraintValue(
@@ -528,25 +580,14 @@ void TaskSelectHyperplanePointsESH::run(std::vector<SolutionPoint> solPoints)
                     std::vector<NumericConstraint*> currentConstraint;
                     currentConstraint.push_back(std::dynamic_pointer_cast<NumericConstraint>(NCV.constraint).get());
 
-                    try
+                    if(auto rootsearchResult = findZero(solutionPtIndex, interiorPtIndex, currentConstraint))
                     {
-                        env->timing->startTimer("DualCutGenerationRootSearch");
-                        auto xNewc
-                            = env->rootsearchMethod->findZero(env->dualSolver->interiorPts.at(interiorPtIndex)->point,
-                                solPoints.at(solutionPtIndex).point, rootMaxIter, rootTerminationTolerance,
-                                rootActiveConstraintTolerance, currentConstraint, true);
-
-                        env->timing->stopTimer("DualCutGenerationRootSearch");
-                        internalPoint = xNewc.first;
-                        externalPoint = xNewc.second;
+                        internalPoint = rootsearchResult->first;
+                        externalPoint = rootsearchResult->second;
                     }
-                    catch(std::exception&)
+                    else
                     {
-                        env->timing->stopTimer("DualCutGenerationRootSearch");
                         externalPoint = solPoints.at(solutionPtIndex).point;
-
-                        env->output->outputDebug(
-                            "         Cannot find solution with rootsearch, using solution point instead.");
                     }
 
                     auto externalConstraintValue = NCV.constraint->calculateNumericValue(externalPoint);
@@ -667,7 +708,83 @@ void TaskSelectHyperplanePointsESH::run(std::vector<SolutionPoint> solPoints)
         env->output->outputDebug("         All nonlinear constraints fulfilled, so no constraint cuts added.");
     }
 
-    env->timing->stopTimer("DualCutGenerationRootSearch");
+    env->timing->stopTimer(timerRootsearch);
+}
+
+std::optional<std::pair<VectorDouble, VectorDouble>> TaskSelectHyperplanePointsESH::performRootsearch(
+    const VectorDouble& interiorPoint, const VectorDouble& solutionPoint,
+    const std::vector<NumericConstraint*>& constraints, bool addPrimalCandidate)
+{
+    try
+    {
+        return (env->rootsearchMethod->findZero(interiorPoint, solutionPoint, rootMaxIter, rootTerminationTolerance,
+            rootActiveConstraintTolerance, constraints, addPrimalCandidate));
+    }
+    catch(std::exception&)
+    {
+        env->output->outputDebug("         Cannot find solution with rootsearch, using solution point instead.");
+    }
+
+    return (std::nullopt);
+}
+
+std::vector<TaskSelectHyperplanePointsESH::Rootsearch> TaskSelectHyperplanePointsESH::getRootsearches(
+    const std::vector<std::tuple<int, int, NumericConstraintValues>>& selectedNumericValues, bool useMaxFunction)
+{
+    std::vector<Rootsearch> rootsearches;
+
+    for(auto& values : selectedNumericValues)
+    {
+        if(useMaxFunction)
+        {
+            std::vector<NumericConstraint*> currentConstraints;
+
+            for(auto& NCV : std::get<2>(values))
+                currentConstraints.push_back(NCV.constraint.get());
+
+            rootsearches.emplace_back(std::get<0>(values), std::get<1>(values), currentConstraints);
+        }
+        else
+        {
+            for(auto& NCV : std::get<2>(values))
+            {
+                if(NCV.error <= 0.0)
+                    continue;
+
+                rootsearches.emplace_back(
+                    std::get<0>(values), std::get<1>(values), std::vector<NumericConstraint*> { NCV.constraint.get() });
+            }
+        }
+    }
+
+    return (rootsearches);
+}
+
+std::vector<std::optional<std::pair<VectorDouble, VectorDouble>>>
+    TaskSelectHyperplanePointsESH::performRootsearchesInParallel(const std::vector<SolutionPoint>& solPoints,
+        const std::vector<Rootsearch>& rootsearches, size_t first, size_t numberOfRootsearches)
+{
+    std::vector<std::optional<std::pair<VectorDouble, VectorDouble>>> results(numberOfRootsearches);
+
+    env->timing->startTimer(timerRootsearch);
+
+    // Each root search uses its own evaluator, and the results are stored by index so that they do not depend on the
+    // order in which the threads finish
+    env->threadPool.run(numberOfRootsearches,
+        [&](size_t i)
+        {
+            ScopedThreadTimer timer(*env->timing, timerRootsearchThreads);
+
+            auto& [solutionPtIndex, interiorPtIndex, currentConstraints] = rootsearches[first + i];
+
+            results[i] = performRootsearch(env->dualSolver->interiorPts.at(interiorPtIndex)->point,
+                solPoints.at(solutionPtIndex).point, currentConstraints, false);
+        },
+        settingNumberOfThreads.get());
+
+    env->timing->stopTimer(timerRootsearch);
+
+    return (results);
 }
 
 std::string TaskSelectHyperplanePointsESH::getType()
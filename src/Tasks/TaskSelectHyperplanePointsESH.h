@@ -11,10 +11,18 @@
 #pragma once
 #include "TaskBase.h"
 
+#include "../Model/Constraints.h"
+#include "../Settings.h"
+#include "../Timing.h"
+
+#include <optional>
+#include <tuple>
+
 namespace SHOT
 {
 
 class Constraint;
+class NumericConstraint;
 class TaskSelectHyperplanePointsECP;
 
 class TaskSelectHyperplanePointsESH : public TaskBase
@@ -31,5 +39,44 @@ public:
 private:
     std::unique_ptr<TaskSelectHyperplanePointsECP> tSelectHPPts;
     std::vector<Constraint*> nonlinearConstraints;
+
+    int rootMaxIter;
+    double rootTerminationTolerance;
+    double rootActiveConstraintTolerance;
+
+    // The settings are read in every iteration, so they are resolved once in the constructor
+    SettingHandle<double> settingConstraintSelectionFactor;
+    SettingHandle<bool> settingUniqueConstraints;
+    SettingHandle<int> settingRootMaxIterations;
+    SettingHandle<double> settingRootTerminationTolerance;
+    SettingHandle<double> settingRootActiveConstraintTolerance;
+    SettingHandle<int> settingMaxHyperplanesPerIteration;
+    SettingHandle<double> settingRootsearchConstraintTolerance;
+    SettingHandle<double> settingMaxConstraintFactor;
+    SettingHandle<bool> settingUseMaxFunction;
+    SettingHandle<int> settingNumberOfThreads;
+
+    TimerID timerRootsearch;
+    // The time of the parallel root searches summed over the threads, i.e. not the elapsed time
+    TimerID timerRootsearchThreads;
+
+    // Returns the interior and exterior points found, or nothing if the root search failed
+    std::optional<std::pair<VectorDouble, VectorDouble>> performRootsearch(const VectorDouble& interiorPoint,
+        const VectorDouble& solutionPoint, const std::vector<NumericConstraint*>& constraints,
+        bool addPrimalCandidate);
+
+    // Solution point index, interior point index and constraints for a root search
+    using Rootsearch = std::tuple<int, int, std::vector<NumericConstraint*>>;
+
+    // Returns the root searches for the selected combinations in the same order as the combinations (and their
+    // constraints) are traversed when creating the hyperplanes
+    std::vector<Rootsearch> getRootsearches(
+        const std::vector<std::tuple<int, int, NumericConstraintValues>>& selectedNumericValues, bool useMaxFunction);
+
+    // Performs the given number of root searches starting from the first one using the thread pool, the results are
+    // returned in the same order as the root searches
+    std::vector<std::optional<std::pair<VectorDouble, VectorDouble>>> performRootsearchesInParallel(
+        const std::vector<SolutionPoint>& solPoints, const std::vector<Rootsearch>& rootsearches, size_t first,
+        size_t numberOfRootsearches);
 };
 } // namespace SHOT
\ No newline at end of file
@@ -18,6 +18,7 @@
 #include "../Results.h"
 #include "../Settings.h"
 #include "../Solver.h"
+#include "../ThreadPool.h"
 #include "../Timing.h"
 #include "../Utilities.h"
 
@@ -41,12 +42,15 @@
 namespace SHOT
 {
 
-TaskSelectPrimalCandidatesFromNLP::TaskSelectPrimalCandidatesFromNLP(EnvironmentPtr envPtr, bool useReformulatedProblem)
-    : TaskBase(envPtr)
+TaskSelectPrimalCandidatesFromNLP::TaskSelectPrimalCandidatesFromNLP(
+    EnvironmentPtr envPtr, bool useReformulatedProblem, bool asynchronous)
+    : TaskBase(envPtr), isAsynchronous(asynchronous)
 {
     env->timing->startTimer("PrimalStrategy");
     env->timing->startTimer("PrimalBoundStrategyNLP");
 
+    timerFixedNLPThreads = env->timing->getTimerID("PrimalBoundStrategyNLPThreads");
+
     originalNLPTime = env->settings->getSetting<double>("FixedInteger.Frequency.Time", "Primal");
     originalNLPIter = env->settings->getSetting<int>("FixedInteger.Frequency.Iteration", "Primal");
 
@@ -190,10 +194,6 @@ std::string TaskSelectPrimalCandidatesFromNLP::getType()
 
 bool TaskSelectPrimalCandidatesFromNLP::solveFixedNLP()
 {
-    auto currIter = env->results->getCurrentIteration();
-
-    std::vector<PrimalFixedNLPCandidate> testPts;
-
     env->output->outputDebug("        Solving fixed NLP problem:");
 
     if(env->primalSolver->fixedPrimalNLPCandidates.size() == 0)
@@ -203,304 +203,501 @@ bool TaskSelectPrimalCandidatesFromNLP::solveFixedNLP()
         return (false);
     }
 
-    int counter = 0;
+    initializeNLPSolverPool();
+
+    bool onlyUniqueIntegerCombinations
+        = env->settings->getSetting<bool>("FixedInteger.OnlyUniqueIntegerCombinations", "Primal");
+
+    std::vector<PrimalFixedNLPCandidate> selectedCandidates;
 
     for(auto& CAND : env->primalSolver->fixedPrimalNLPCandidates)
     {
-        VectorDouble fixedVariableValues(discreteVariableIndexes.size());
+        // The same integer combination may be among the candidates several times, or have been tested since the
+        // candidate was added, and then the NLP problem need not be solved again
+        bool isDuplicate = env->primalSolver->hasFixedNLPCandidateBeenTested(CAND);
 
-        int sizeOfVariableVector = sourceProblem->properties.numberOfVariables;
+        if(auto tested = env->primalSolver->testedFixedNLPCandidates.find(CAND.discreteVariableValues);
+            isDuplicate && tested != env->primalSolver->testedFixedNLPCandidates.end())
+        {
+            env->output->outputDebug(
+                fmt::format("         Integer combination already tested in iteration {} with objective value {}.",
+                    tested->second.iterTested, tested->second.objValue));
+        }
+
+        for(auto& C : selectedCandidates)
+        {
+            if(onlyUniqueIntegerCombinations ? C.discreteVariableValues == CAND.discreteVariableValues
+                                             : C.point == CAND.point)
+                isDuplicate = true;
+        }
 
-        // TODO: remove?
-        if(env->settings->getSetting<bool>("FixedInteger.UsePresolveBounds", "Primal"))
+        if(isDuplicate)
         {
-            env->output->outputDebug("         Updating variable bounds from MIP presolve.");
-            for(auto& V : env->reformulatedProblem->allVariables)
+            env->solutionStatistics.numberOfFixedNLPCandidatesAlreadyTested++;
+            continue;
+        }
+
+        selectedCandidates.push_back(CAND);
+    }
+
+    auto snapshot = createFixedNLPSnapshot();
+
+    if(isAsynchronous)
+    {
+        // The candidates are copied, since the candidate list is cleared before the problems are solved
+        env->primalSolver->addAsynchronousTask(
+            [this, candidates = std::move(selectedCandidates), snapshot = std::move(snapshot)]()
             {
-                if(V->index > sizeOfVariableVector)
-                    continue;
+                ScopedThreadTimer timer(*env->timing, timerFixedNLPThreads);
+                auto results = solveFixedNLPCandidates(candidates, snapshot);
+
+                return (std::function<void()>(
+                    [this, candidates, results = std::move(results)]()
+                    {
+                        for(size_t i = 0; i < candidates.size(); i++)
+                            handleFixedNLPResult(candidates[i], results[i]);
+                    }));
+            });
+
+        return (true);
+    }
 
-                if(V->properties.hasUpperBoundBeenTightened)
-                {
-                    NLPSolver->updateVariableUpperBound(V->index, V->upperBound);
-                }
+    auto results = solveFixedNLPCandidates(selectedCandidates, snapshot);
 
-                if(V->properties.hasLowerBoundBeenTightened)
-                {
-                    NLPSolver->updateVariableLowerBound(V->index, V->upperBound);
-                }
-            }
-        }
+    // The results are handled in the same order as the candidates, so the primal solutions and cuts found do not
+    // depend on which solve finishes first
+    for(size_t i = 0; i < selectedCandidates.size(); i++)
+        handleFixedNLPResult(selectedCandidates[i], results[i]);
 
-        VectorInteger startingPointIndexes(sizeOfVariableVector);
-        VectorDouble startingPointValues(sizeOfVariableVector);
+    return (true);
+}
 
-        // Sets the fixed values for discrete variables
-        for(size_t k = 0; k < discreteVariableIndexes.size(); k++)
-        {
-            int currVarIndex = discreteVariableIndexes.at(k);
+TaskSelectPrimalCandidatesFromNLP::FixedNLPSnapshot TaskSelectPrimalCandidatesFromNLP::createFixedNLPSnapshot()
+{
+    FixedNLPSnapshot snapshot;
 
-            auto tmpSolPt = std::round(CAND.point.at(currVarIndex));
+    snapshot.iterationNumber = env->results->getCurrentIteration()->iterationNumber;
 
-            fixedVariableValues.at(k) = tmpSolPt;
+    // TODO: remove?
+    if(env->settings->getSetting<bool>("FixedInteger.UsePresolveBounds", "Primal"))
+    {
+        int sizeOfVariableVector = sourceProblem->properties.numberOfVariables;
 
-            // Sets the starting point to the fixed value
-            if(env->settings->getSetting<bool>("FixedInteger.Warmstart", "Primal"))
-            {
-                startingPointIndexes.at(currVarIndex) = currVarIndex;
-                startingPointValues.at(currVarIndex) = tmpSolPt;
-            }
+        for(auto& V : env->reformulatedProblem->allVariables)
+        {
+            if(V->index > sizeOfVariableVector)
+                continue;
+
+            if(V->properties.hasUpperBoundBeenTightened)
+                snapshot.tightenedUpperBounds.emplace_back(V->index, V->upperBound);
+
+            if(V->properties.hasLowerBoundBeenTightened)
+                snapshot.tightenedLowerBounds.emplace_back(V->index, V->lowerBound);
         }
+    }
 
-        if(env->settings->getSetting<bool>("FixedInteger.Warmstart", "Primal"))
+    return (snapshot);
+}
+
+std::vector<TaskSelectPrimalCandidatesFromNLP::FixedNLPResult>
+    TaskSelectPrimalCandidatesFromNLP::solveFixedNLPCandidates(
+        const std::vector<PrimalFixedNLPCandidate>& candidates, const FixedNLPSnapshot& snapshot)
+{
+    std::vector<FixedNLPResult> results(candidates.size());
+
+    // The candidates are solved in batches of one candidate per NLP solver
+    for(size_t i = 0; i < candidates.size(); i += NLPSolvers.size())
+    {
+        size_t batchSize = std::min(NLPSolvers.size(), candidates.size() - i);
+
+        if(batchSize > 1)
         {
+            env->threadPool.run(batchSize,
+                [&](size_t j)
+                {
+                    results[i + j]
+                        = solveFixedNLPCandidate(candidates[i + j], *NLPSolvers[j], (int)(i + j), snapshot);
+                });
+        }
+        else
+        {
+            results[i] = solveFixedNLPCandidate(candidates[i], *NLPSolvers[0], (int)i, snapshot);
+        }
+    }
+
+    return (results);
+}
+
+void TaskSelectPrimalCandidatesFromNLP::initializeNLPSolverPool()
+{
+    if(NLPSolvers.size() > 0)
+        return;
+
+    // Only Ipopt can be used in several threads. The SHOT NLP solver performs a full solution process with its own MIP
+    // solver, which is not thread-safe for all MIP solvers (e.g. Cbc), and for GAMS all instances would use the same
+    // modeling object.
+    if(env->results->usedPrimalNLPSolver != ES_PrimalNLPSolver::Ipopt)
+    {
+        if(isAsynchronous)
             env->output->outputDebug(
-                "         Setting warm start for continuous variable to candidate solution value.");
+                "        Fixed NLP problems cannot be solved in the background with this NLP solver.");
 
-            for(auto& V : sourceProblem->realVariables)
-            {
-                startingPointIndexes.at(V->index) = V->index;
-                startingPointValues.at(V->index) = CAND.point.at(V->index);
-            }
+        isAsynchronous = false;
+        NLPSolvers.push_back(NLPSolver);
+        return;
+    }
 
-            if(env->settings->getSetting<bool>("Debug.Enable", "Output"))
-            {
-                auto filename = fmt::format("{}/primalnlp{}_warmstart_{}.txt",
-                    env->settings->getSetting<std::string>("Debug.Path", "Output"),
-                    env->results->getCurrentIteration()->iterationNumber - 1, counter);
+#ifdef HAS_IPOPT
+    int numberOfThreads = env->settings->getSetting<int>("FixedInteger.NumberOfThreads", "Primal");
 
-                Utilities::saveVariablePointVectorToFile(startingPointValues, variableNames, filename);
-            }
+    // Ipopt instances can only be solved at the same time if the linear solver is thread-safe, which e.g. the HSL
+    // solvers MA27 and MA57 are, but not the default MUMPS
+    auto linearSolver = static_cast<ES_IpoptSolver>(env->settings->getSetting<int>("Ipopt.LinearSolver", "Subsolver"));
 
-            NLPSolver->setStartingPoint(startingPointIndexes, startingPointValues);
-        }
+    if(numberOfThreads != 1 && linearSolver != ES_IpoptSolver::ma27 && linearSolver != ES_IpoptSolver::ma57)
+    {
+        env->output->outputDebug(
+            "        Fixed NLP problems are solved in sequence since the Ipopt linear solver is not thread-safe.");
+        numberOfThreads = 1;
+    }
 
-        NLPSolver->fixVariables(discreteVariableIndexes, fixedVariableValues);
+    if(numberOfThreads != 1 || isAsynchronous)
+        setupParallelAD();
 
-        if(env->settings->getSetting<bool>("Debug.Enable", "Output"))
+    // The shared thread pool limits the number of problems solved at the same time
+    int numberOfSolvers = env->threadPool.getNumberOfThreads();
+
+    if(numberOfThreads > 0)
+        numberOfSolvers = std::min(numberOfSolvers, numberOfThreads);
+
+    // When solving in the background, the main thread uses the problem at the same time, so then also the first Ipopt
+    // instance needs its own copy of it
+    if(!isAsynchronous)
+        NLPSolvers.push_back(NLPSolver);
+
+    while((int)NLPSolvers.size() < numberOfSolvers)
+    {
+        // Ipopt evaluates the functions in the problem it is given, so each instance needs its own copy
+        std::shared_ptr<INLPSolver> solver
+            = std::make_shared<NLPSolverIpoptRelaxed>(env, sourceProblem->createCopy(env, false, false, true));
+
+        for(auto& V : sourceProblem->allVariables)
         {
-            std::string filename = env->settings->getSetting<std::string>("Debug.Path", "Output") + "/primalnlp"
-                + std::to_string(currIter->iterationNumber) + "_" + std::to_string(counter);
-            NLPSolver->saveProblemToFile(filename + ".txt");
-            NLPSolver->saveOptionsToFile(filename + ".osrl");
+            solver->updateVariableLowerBound(V->index, V->lowerBound);
+            solver->updateVariableUpperBound(V->index, V->upperBound);
         }
 
-        auto solvestatus = NLPSolver->solveProblem();
+        NLPSolvers.push_back(solver);
+    }
+#endif
+
+    env->output->outputDebug(
+        fmt::format("        Using {} NLP solvers for the fixed NLP problems.", NLPSolvers.size()));
+}
+
+TaskSelectPrimalCandidatesFromNLP::FixedNLPResult TaskSelectPrimalCandidatesFromNLP::solveFixedNLPCandidate(
+    const PrimalFixedNLPCandidate& candidate, INLPSolver& solver, int counter, const FixedNLPSnapshot& snapshot)
+{
+    VectorDouble fixedVariableValues(discreteVariableIndexes.size());
+
+    int sizeOfVariableVector = sourceProblem->properties.numberOfVariables;
+
+    if(snapshot.tightenedLowerBounds.size() > 0 || snapshot.tightenedUpperBounds.size() > 0)
+    {
+        env->output->outputDebug("         Updating variable bounds from MIP presolve.");
+
+        for(auto& B : snapshot.tightenedUpperBounds)
+            solver.updateVariableUpperBound(B.index, B.value);
+
+        for(auto& B : snapshot.tightenedLowerBounds)
+            solver.updateVariableLowerBound(B.index, B.value);
+    }
+
+    VectorInteger startingPointIndexes(sizeOfVariableVector);
+    VectorDouble startingPointValues(sizeOfVariableVector);
 
-        NLPSolver->unfixVariables();
-        env->solutionStatistics.numberOfProblemsFixedNLP++;
+    // Sets the fixed values for discrete variables
+    for(size_t k = 0; k < discreteVariableIndexes.size(); k++)
+    {
+        int currVarIndex = discreteVariableIndexes.at(k);
+
+        auto tmpSolPt = std::round(candidate.point.at(currVarIndex));
 
-        std::string source = (sourceIsReformulatedProblem) ? "R" : "O";
+        fixedVariableValues.at(k) = tmpSolPt;
 
-        std::string sourceDesc;
-        switch(CAND.sourceType)
+        // Sets the starting point to the fixed value
+        if(env->settings->getSetting<bool>("FixedInteger.Warmstart", "Primal"))
         {
-        case E_PrimalNLPSource::FirstSolution:
-            env->output->outputDebug("         Source from candidate point is first MIP solution point.");
-            sourceDesc = "SOLPT-" + source;
-            break;
-        case E_PrimalNLPSource::FeasibleSolution:
-            env->output->outputDebug("         Source from candidate point is MIP solution pool.");
-            sourceDesc = "FEASP-" + source;
-            break;
-        case E_PrimalNLPSource::InfeasibleSolution:
-            env->output->outputDebug("         Source from candidate point is infeasible MIP solution.");
-            sourceDesc = "UNFEA-" + source;
-            break;
-        case E_PrimalNLPSource::SmallestDeviationSolution:
-            env->output->outputDebug(
-                "         Source from candidate point is MIP solution with smallest nonlinear error.");
-            sourceDesc = "SMDEV-" + source;
-            break;
-        case E_PrimalNLPSource::FirstSolutionNewDualBound:
-            env->output->outputDebug(
-                "         Source from candidate point is first MIP solution point which gave dual bound update.");
-            sourceDesc = "NEWDB-" + source;
-            break;
-        default:
-            break;
+            startingPointIndexes.at(currVarIndex) = currVarIndex;
+            startingPointValues.at(currVarIndex) = tmpSolPt;
         }
+    }
 
-        switch(solvestatus)
+    if(env->settings->getSetting<bool>("FixedInteger.Warmstart", "Primal"))
+    {
+        env->output->outputDebug("         Setting warm start for continuous variable to candidate solution value.");
+
+        for(auto& V : sourceProblem->realVariables)
         {
-        case E_NLPSolutionStatus::Optimal:
-            env->output->outputDebug(fmt::format(
-                "         Optimal solution {} found to fixed NLP problem.", NLPSolver->getObjectiveValue()));
-            break;
+            startingPointIndexes.at(V->index) = V->index;
+            startingPointValues.at(V->index) = candidate.point.at(V->index);
+        }
 
-        case E_NLPSolutionStatus::Feasible:
-            env->output->outputDebug(fmt::format(
-                "         Feasible solution {} found to fixed NLP problem.", NLPSolver->getObjectiveValue()));
-            break;
+        if(env->settings->getSetting<bool>("Debug.Enable", "Output"))
+        {
+            auto filename = fmt::format("{}/primalnlp{}_warmstart_{}.txt",
+                env->settings->getSetting<std::string>("Debug.Path", "Output"),
+                snapshot.iterationNumber - 1, counter);
 
-        case E_NLPSolutionStatus::Infeasible:
-            env->output->outputDebug("         Fixed NLP problem is infeasible.");
-            break;
+            Utilities::saveVariablePointVectorToFile(startingPointValues, variableNames, filename);
+        }
 
-        case E_NLPSolutionStatus::Unbounded:
-            env->output->outputDebug("         Fixed NLP problem is unbounded.");
-            break;
+        solver.setStartingPoint(startingPointIndexes, startingPointValues);
+    }
 
-        case E_NLPSolutionStatus::TimeLimit:
-            env->output->outputDebug("         Time limit hit when solving fixed NLP problem.");
-            break;
+    solver.fixVariables(discreteVariableIndexes, fixedVariableValues);
 
-        case E_NLPSolutionStatus::IterationLimit:
-            env->output->outputDebug("         Iteration limit hit when solving fixed NLP problem.");
-            break;
+    if(env->settings->getSetting<bool>("Debug.Enable", "Output"))
+    {
+        std::string filename = env->settings->getSetting<std::string>("Debug.Path", "Output") + "/primalnlp"
+            + std::to_string(snapshot.iterationNumber) + "_" + std::to_string(counter);
+        solver.saveProblemToFile(filename + ".txt");
+        solver.saveOptionsToFile(filename + ".osrl");
+    }
 
-        case E_NLPSolutionStatus::Error:
-            env->output->outputDebug("         Error ocurred when solving fixed NLP problem.");
-            break;
+    FixedNLPResult result;
+    result.status = solver.solveProblem();
 
-        default:
+    if(result.status != E_NLPSolutionStatus::Error && result.status != E_NLPSolutionStatus::Unbounded
+        && result.status != E_NLPSolutionStatus::Infeasible)
+    {
+        result.objectiveValue = solver.getObjectiveValue();
+        result.solution = solver.getSolution();
+    }
 
-            break;
-        }
+    solver.unfixVariables();
 
-        if(solvestatus == E_NLPSolutionStatus::Feasible || solvestatus == E_NLPSolutionStatus::Optimal)
-        {
-            double tmpObj = NLPSolver->getObjectiveValue();
-            auto variableSolution = NLPSolver->getSolution();
+    return (result);
+}
 
-            env->primalSolver->addPrimalSolutionCandidate(
-                variableSolution, E_PrimalSolutionSource::NLPFixedIntegers, currIter->iterationNumber);
+void TaskSelectPrimalCandidatesFromNLP::handleFixedNLPResult(
+    const PrimalFixedNLPCandidate& CAND, const FixedNLPResult& result)
+{
+    auto currIter = env->results->getCurrentIteration();
+    auto solvestatus = result.status;
 
-            if(sourceProblem->properties.numberOfNonlinearConstraints > 0
-                || sourceProblem->properties.numberOfQuadraticConstraints > 0)
-            {
-                auto mostDevConstr = sourceProblem->getMostDeviatingNonlinearOrQuadraticConstraint(variableSolution);
+    env->solutionStatistics.numberOfProblemsFixedNLP++;
 
-                env->output->outputDebug(fmt::format("         Max error {} from nonlinear or quadratic constraint {}.",
-                    mostDevConstr->normalizedValue, mostDevConstr->constraint->name));
+    std::string source = (sourceIsReformulatedProblem) ? "R" : "O";
 
-                env->report->outputIterationDetail(env->solutionStatistics.numberOfProblemsFixedNLP,
-                    ("NLP" + sourceDesc), env->timing->getElapsedTime("Total"), currIter->numHyperplanesAdded,
-                    currIter->totNumHyperplanes, env->results->getCurrentDualBound(), env->results->getPrimalBound(),
-                    env->results->getAbsoluteGlobalObjectiveGap(), env->results->getRelativeGlobalObjectiveGap(),
-                    tmpObj, mostDevConstr->constraint->index, mostDevConstr->normalizedValue,
-                    E_IterationLineType::PrimalNLP);
-            }
-            else
-            {
-                env->report->outputIterationDetail(env->solutionStatistics.numberOfProblemsFixedNLP,
-                    ("NLP" + sourceDesc), env->timing->getElapsedTime("Total"), currIter->numHyperplanesAdded,
-                    currIter->totNumHyperplanes, env->results->getCurrentDualBound(), env->results->getPrimalBound(),
-                    env->results->getAbsoluteGlobalObjectiveGap(), env->results->getRelativeGlobalObjectiveGap(),
-                    tmpObj,
-                    -1, // Not shown
-                    0.0, // Not shown
-                    E_IterationLineType::PrimalNLP);
-            }
+    std::string sourceDesc;
+    switch(CAND.sourceType)
+    {
+    case E_PrimalNLPSource::FirstSolution:
+        env->output->outputDebug("         Source from candidate point is first MIP solution point.");
+        sourceDesc = "SOLPT-" + source;
+        break;
+    case E_PrimalNLPSource::FeasibleSolution:
+        env->output->outputDebug("         Source from candidate point is MIP solution pool.");
+        sourceDesc = "FEASP-" + source;
+        break;
+    case E_PrimalNLPSource::InfeasibleSolution:
+        env->output->outputDebug("         Source from candidate point is infeasible MIP solution.");
+        sourceDesc = "UNFEA-" + source;
+        break;
+    case E_PrimalNLPSource::SmallestDeviationSolution:
+        env->output->outputDebug("         Source from candidate point is MIP solution with smallest nonlinear error.");
+        sourceDesc = "SMDEV-" + source;
+        break;
+    case E_PrimalNLPSource::FirstSolutionNewDualBound:
+        env->output->outputDebug(
+            "         Source from candidate point is first MIP solution point which gave dual bound update.");
+        sourceDesc = "NEWDB-" + source;
+        break;
+    default:
+        break;
+    }
 
-            // Add integer cut.
-            if(env->settings->getSetting<bool>("HyperplaneCuts.UseIntegerCuts", "Dual")
-                && sourceProblem->properties.numberOfDiscreteVariables > 0)
-                createIntegerCut(CAND.point);
+    switch(solvestatus)
+    {
+    case E_NLPSolutionStatus::Optimal:
+        env->output->outputDebug(
+            fmt::format("         Optimal solution {} found to fixed NLP problem.", result.objectiveValue));
+        break;
 
-            if(env->settings->getSetting<bool>("FixedInteger.CreateInfeasibilityCut", "Primal"))
-                createInfeasibilityCut(variableSolution);
-        }
-        else if(solvestatus == E_NLPSolutionStatus::Error || solvestatus == E_NLPSolutionStatus::Unbounded
-            || solvestatus == E_NLPSolutionStatus::Infeasible)
+    case E_NLPSolutionStatus::Feasible:
+        env->output->outputDebug(
+            fmt::format("         Feasible solution {} found to fixed NLP problem.", result.objectiveValue));
+        break;
+
+    case E_NLPSolutionStatus::Infeasible:
+        env->output->outputDebug("         Fixed NLP problem is infeasible.");
+        break;
+
+    case E_NLPSolutionStatus::Unbounded:
+        env->output->outputDebug("         Fixed NLP problem is unbounded.");
+        break;
+
+    case E_NLPSolutionStatus::TimeLimit:
+        env->output->outputDebug("         Time limit hit when solving fixed NLP problem.");
+        break;
+
+    case E_NLPSolutionStatus::IterationLimit:
+        env->output->outputDebug("         Iteration limit hit when solving fixed NLP problem.");
+        break;
+
+    case E_NLPSolutionStatus::Error:
+        env->output->outputDebug("         Error ocurred when solving fixed NLP problem.");
+        break;
+
+    default:
+
+        break;
+    }
+
+    double objectiveValue = NAN;
+
+    if(solvestatus == E_NLPSolutionStatus::Feasible || solvestatus == E_NLPSolutionStatus::Optimal)
+    {
+        double tmpObj = result.objectiveValue;
+        auto& variableSolution = result.solution;
+
+        objectiveValue = tmpObj;
+
+        env->primalSolver->addPrimalSolutionCandidate(
+            variableSolution, E_PrimalSolutionSource::NLPFixedIntegers, currIter->iterationNumber);
+
+        if(sourceProblem->properties.numberOfNonlinearConstraints > 0
+            || sourceProblem->properties.numberOfQuadraticConstraints > 0)
         {
-            env->report->outputIterationDetail(env->solutionStatistics.numberOfProblemsFixedNLP, ("NLP" + sourceDesc),
-                env->timing->getElapsedTime("Total"), currIter->numHyperplanesAdded, currIter->totNumHyperplanes,
-                env->results->getCurrentDualBound(), env->results->getPrimalBound(),
-                env->results->getAbsoluteGlobalObjectiveGap(), env->results->getRelativeGlobalObjectiveGap(), NAN, -1,
-                NAN, E_IterationLineType::PrimalNLP);
+            auto mostDevConstr = sourceProblem->getMostDeviatingNonlinearOrQuadraticConstraint(variableSolution);
+
+            env->output->outputDebug(fmt::format("         Max error {} from nonlinear or quadratic constraint {}.",
+                mostDevConstr->normalizedValue, mostDevConstr->constraint->name));
+
+            env->report->outputIterationDetail(env->solutionStatistics.numberOfProblemsFixedNLP,
+                ("NLP" + sourceDesc), env->timing->getElapsedTime("Total"), currIter->numHyperplanesAdded,
+                currIter->totNumHyperplanes, env->results->getCurrentDualBound(), env->results->getPrimalBound(),
+                env->results->getAbsoluteGlobalObjectiveGap(), env->results->getRelativeGlobalObjectiveGap(),
+                tmpObj, mostDevConstr->constraint->index, mostDevConstr->normalizedValue,
+                E_IterationLineType::PrimalNLP);
         }
-        else if(sourceProblem->properties.numberOfNonlinearConstraints > 0
-            || sourceProblem->properties.numberOfQuadraticConstraints > 0)
+        else
         {
-            double tmpObj = NLPSolver->getObjectiveValue();
+            env->report->outputIterationDetail(env->solutionStatistics.numberOfProblemsFixedNLP,
+                ("NLP" + sourceDesc), env->timing->getElapsedTime("Total"), currIter->numHyperplanesAdded,
+                currIter->totNumHyperplanes, env->results->getCurrentDualBound(), env->results->getPrimalBound(),
+                env->results->getAbsoluteGlobalObjectiveGap(), env->results->getRelativeGlobalObjectiveGap(),
+                tmpObj,
+                -1, // Not shown
+                0.0, // Not shown
+                E_IterationLineType::PrimalNLP);
+        }
 
-            auto variableSolution = NLPSolver->getSolution();
+        // Add integer cut.
+        if(env->settings->getSetting<bool>("HyperplaneCuts.UseIntegerCuts", "Dual")
+            && sourceProblem->properties.numberOfDiscreteVariables > 0)
+            createIntegerCut(CAND.point);
 
-            if(variableSolution.size() > 0)
-            {
-                auto mostDevConstr = sourceProblem->getMostDeviatingNonlinearOrQuadraticConstraint(variableSolution);
+        if(env->settings->getSetting<bool>("FixedInteger.CreateInfeasibilityCut", "Primal"))
+            createInfeasibilityCut(variableSolution);
+    }
+    else if(solvestatus == E_NLPSolutionStatus::Error || solvestatus == E_NLPSolutionStatus::Unbounded
+        || solvestatus == E_NLPSolutionStatus::Infeasible)
+    {
+        env->report->outputIterationDetail(env->solutionStatistics.numberOfProblemsFixedNLP, ("NLP" + sourceDesc),
+            env->timing->getElapsedTime("Total"), currIter->numHyperplanesAdded, currIter->totNumHyperplanes,
+            env->results->getCurrentDualBound(), env->results->getPrimalBound(),
+            env->results->getAbsoluteGlobalObjectiveGap(), env->results->getRelativeGlobalObjectiveGap(), NAN, -1,
+            NAN, E_IterationLineType::PrimalNLP);
+    }
+    else if(sourceProblem->properties.numberOfNonlinearConstraints > 0
+        || sourceProblem->properties.numberOfQuadraticConstraints > 0)
+    {
+        double tmpObj = result.objectiveValue;
 
-                if(env->settings->getSetting<bool>("FixedInteger.CreateInfeasibilityCut", "Primal"))
-                    createInfeasibilityCut(variableSolution);
+        auto& variableSolution = result.solution;
 
-                env->report->outputIterationDetail(env->solutionStatistics.numberOfProblemsFixedNLP,
-                    ("NLP" + sourceDesc), env->timing->getElapsedTime("Total"), currIter->numHyperplanesAdded,
-                    currIter->totNumHyperplanes, env->results->getCurrentDualBound(), env->results->getPrimalBound(),
-                    env->results->getAbsoluteGlobalObjectiveGap(), env->results->getRelativeGlobalObjectiveGap(),
-                    tmpObj, mostDevConstr->constraint->index, mostDevConstr->normalizedValue,
-                    E_IterationLineType::PrimalNLP);
-            }
-            else
-            {
-                env->report->outputIterationDetail(env->solutionStatistics.numberOfProblemsFixedNLP,
-                    ("NLP" + sourceDesc), env->timing->getElapsedTime("Total"), currIter->numHyperplanesAdded,
-                    currIter->totNumHyperplanes, env->results->getCurrentDualBound(), env->results->getPrimalBound(),
-                    env->results->getAbsoluteGlobalObjectiveGap(), env->results->getRelativeGlobalObjectiveGap(), NAN,
-                    -1, NAN, E_IterationLineType::PrimalNLP);
-            }
+        if(variableSolution.size() > 0)
+        {
+            auto mostDevConstr = sourceProblem->getMostDeviatingNonlinearOrQuadraticConstraint(variableSolution);
+
+            if(env->settings->getSetting<bool>("FixedInteger.CreateInfeasibilityCut", "Primal"))
+                createInfeasibilityCut(variableSolution);
+
+            env->report->outputIterationDetail(env->solutionStatistics.numberOfProblemsFixedNLP,
+                ("NLP" + sourceDesc), env->timing->getElapsedTime("Total"), currIter->numHyperplanesAdded,
+                currIter->totNumHyperplanes, env->results->getCurrentDualBound(), env->results->getPrimalBound(),
+                env->results->getAbsoluteGlobalObjectiveGap(), env->results->getRelativeGlobalObjectiveGap(),
+                tmpObj, mostDevConstr->constraint->index, mostDevConstr->normalizedValue,
+                E_IterationLineType::PrimalNLP);
         }
         else
         {
+            env->report->outputIterationDetail(env->solutionStatistics.numberOfProblemsFixedNLP,
+                ("NLP" + sourceDesc), env->timing->getElapsedTime("Total"), currIter->numHyperplanesAdded,
+                currIter->totNumHyperplanes, env->results->getCurrentDualBound(), env->results->getPrimalBound(),
+                env->results->getAbsoluteGlobalObjectiveGap(), env->results->getRelativeGlobalObjectiveGap(), NAN,
+                -1, NAN, E_IterationLineType::PrimalNLP);
+        }
+    }
+    else
+    {
 
-            auto variableSolution = NLPSolver->getSolution();
+        auto& variableSolution = result.solution;
 
-            if(variableSolution.size() > 0)
-            {
-                env->report->outputIterationDetail(env->solutionStatistics.numberOfProblemsFixedNLP,
-                    ("NLP" + sourceDesc), env->timing->getElapsedTime("Total"), currIter->numHyperplanesAdded,
-                    currIter->totNumHyperplanes, env->results->getCurrentDualBound(), env->results->getPrimalBound(),
-                    env->results->getAbsoluteGlobalObjectiveGap(), env->results->getRelativeGlobalObjectiveGap(), NAN,
-                    -1, NAN, E_IterationLineType::PrimalNLP);
-            }
+        if(variableSolution.size() > 0)
+        {
+            env->report->outputIterationDetail(env->solutionStatistics.numberOfProblemsFixedNLP,
+                ("NLP" + sourceDesc), env->timing->getElapsedTime("Total"), currIter->numHyperplanesAdded,
+                currIter->totNumHyperplanes, env->results->getCurrentDualBound(), env->results->getPrimalBound(),
+                env->results->getAbsoluteGlobalObjectiveGap(), env->results->getRelativeGlobalObjectiveGap(), NAN,
+                -1, NAN, E_IterationLineType::PrimalNLP);
         }
+    }
 
-        if(env->settings->getSetting<bool>("FixedInteger.Frequency.Dynamic", "Primal"))
+    if(env->settings->getSetting<bool>("FixedInteger.Frequency.Dynamic", "Primal"))
+    {
+        if(solvestatus == E_NLPSolutionStatus::Optimal || solvestatus == E_NLPSolutionStatus::Feasible)
         {
-            if(solvestatus == E_NLPSolutionStatus::Optimal || solvestatus == E_NLPSolutionStatus::Feasible)
-            {
-                int iters = std::max(
-                    std::ceil(env->settings->getSetting<int>("FixedInteger.Frequency.Iteration", "Primal") * 0.98),
-                    originalNLPIter);
+            int iters = std::max(
+                std::ceil(env->settings->getSetting<int>("FixedInteger.Frequency.Iteration", "Primal") * 0.98),
+                originalNLPIter);
 
-                if(iters > std::max(0.1 * this->originalIterFrequency, 1.0))
-                    env->settings->updateSetting("FixedInteger.Frequency.Iteration", "Primal", iters);
+            if(iters > std::max(0.1 * this->originalIterFrequency, 1.0))
+                env->settings->updateSetting("FixedInteger.Frequency.Iteration", "Primal", iters);
 
-                double interval = std::max(
-                    0.9 * env->settings->getSetting<double>("FixedInteger.Frequency.Time", "Primal"), originalNLPTime);
+            double interval = std::max(
+                0.9 * env->settings->getSetting<double>("FixedInteger.Frequency.Time", "Primal"), originalNLPTime);
 
-                if(interval > 0.1 * this->originalTimeFrequency)
-                    env->settings->updateSetting("FixedInteger.Frequency.Time", "Primal", interval);
+            if(interval > 0.1 * this->originalTimeFrequency)
+                env->settings->updateSetting("FixedInteger.Frequency.Time", "Primal", interval);
 
-                env->output->outputDebug(fmt::format(
-                    "         Iteration frequency updated to {} and time frequency updated to {} ", iters, interval));
-            }
-            else
-            {
-                int iters
-                    = std::ceil(env->settings->getSetting<int>("FixedInteger.Frequency.Iteration", "Primal") * 1.02);
+            env->output->outputDebug(fmt::format(
+                "         Iteration frequency updated to {} and time frequency updated to {} ", iters, interval));
+        }
+        else
+        {
+            int iters
+                = std::ceil(env->settings->getSetting<int>("FixedInteger.Frequency.Iteration", "Primal") * 1.02);
 
-                if(iters < 10 * this->originalIterFrequency)
-                    env->settings->updateSetting("FixedInteger.Frequency.Iteration", "Primal", iters);
+            if(iters < 10 * this->originalIterFrequency)
+                env->settings->updateSetting("FixedInteger.Frequency.Iteration", "Primal", iters);
 
-                double interval = 1.1 * env->settings->getSetting<double>("FixedInteger.Frequency.Time", "Primal");
+            double interval = 1.1 * env->settings->getSetting<double>("FixedInteger.Frequency.Time", "Primal");
 
-                if(interval < 10 * this->originalTimeFrequency)
-                    env->settings->updateSetting("FixedInteger.Frequency.Time", "Primal", interval);
+            if(interval < 10 * this->originalTimeFrequency)
+                env->settings->updateSetting("FixedInteger.Frequency.Time", "Primal", interval);
 
-                env->output->outputDebug(fmt::format(
-                    "         Iteration frequency updated to {} and time frequency updated to {} ", iters, interval));
-            }
+            env->output->outputDebug(fmt::format(
+                "         Iteration frequency updated to {} and time frequency updated to {} ", iters, interval));
         }
-
-        env->solutionStatistics.numberOfIterationsWithoutNLPCallMIP = 0;
-        env->solutionStatistics.timeLastFixedNLPCall = env->timing->getElapsedTime("Total");
-        counter++;
-
-        env->primalSolver->usedPrimalNLPCandidates.push_back(CAND);
     }
 
-    return (true);
+    env->solutionStatistics.numberOfIterationsWithoutNLPCallMIP = 0;
+    env->solutionStatistics.timeLastFixedNLPCall = env->timing->getElapsedTime("Total");
+
+    env->primalSolver->addTestedFixedNLPCandidate(CAND, solvestatus, objectiveValue, currIter->iterationNumber);
 }
 
 void TaskSelectPrimalCandidatesFromNLP::createInfeasibilityCut(const VectorDouble variableSolution)
@@ -16,6 +16,7 @@
 #include <vector>
 
 #include "../Structs.h"
+#include "../Timing.h"
 
 namespace SHOT
 {
@@ -24,19 +25,57 @@ class INLPSolver;
 class TaskSelectPrimalCandidatesFromNLP : public TaskBase
 {
 public:
-    TaskSelectPrimalCandidatesFromNLP(EnvironmentPtr envPtr, bool useReformulatedProblem);
+    // If asynchronous, the fixed NLP problems are solved in the background while the next MIP problem is solved
+    TaskSelectPrimalCandidatesFromNLP(EnvironmentPtr envPtr, bool useReformulatedProblem, bool asynchronous = false);
     ~TaskSelectPrimalCandidatesFromNLP() override;
     void run() override;
     std::string getType() override;
 
 private:
+    // The outcome of solving the fixed NLP problem for a candidate
+    struct FixedNLPResult
+    {
+        E_NLPSolutionStatus status = E_NLPSolutionStatus::Error;
+        double objectiveValue = NAN;
+        VectorDouble solution;
+    };
+
+    // The data used when solving the fixed NLP problems that the main thread can change meanwhile, so it is copied
+    // before the problems are solved
+    struct FixedNLPSnapshot
+    {
+        int iterationNumber = 0;
+
+        // The bounds tightened in the MIP presolve, if they are used
+        std::vector<PairIndexValue> tightenedLowerBounds;
+        std::vector<PairIndexValue> tightenedUpperBounds;
+    };
+
     virtual bool solveFixedNLP();
 
+    FixedNLPSnapshot createFixedNLPSnapshot();
+
+    // Creates the additional NLP solvers used to solve several candidates in parallel, each with its own problem
+    void initializeNLPSolverPool();
+
+    std::vector<FixedNLPResult> solveFixedNLPCandidates(
+        const std::vector<PrimalFixedNLPCandidate>& candidates, const FixedNLPSnapshot& snapshot);
+
+    // Uses the given solver and snapshot instead of the primal and dual solvers or any problem data that can change,
+    // so it can be called for different candidates and solvers in parallel
+    FixedNLPResult solveFixedNLPCandidate(const PrimalFixedNLPCandidate& candidate, INLPSolver& solver, int counter,
+        const FixedNLPSnapshot& snapshot);
+
+    void handleFixedNLPResult(const PrimalFixedNLPCandidate& candidate, const FixedNLPResult& result);
+
     void createInfeasibilityCut(const VectorDouble point);
     void createIntegerCut(VectorDouble point);
 
     std::shared_ptr<INLPSolver> NLPSolver;
 
+    // All NLP solvers that can be used in parallel, the first one is NLPSolver
+    std::vector<std::shared_ptr<INLPSolver>> NLPSolvers;
+
     VectorInteger discreteVariableIndexes;
     std::vector<VectorDouble> testedPoints;
     VectorDouble fixPoint;
@@ -56,5 +95,8 @@ private:
 
     ProblemPtr sourceProblem;
     bool sourceIsReformulatedProblem = false;
+
+    bool isAsynchronous = false;
+    TimerID timerFixedNLPThreads;
 };
 } // namespace SHOT
\ No newline at end of file
@@ -24,9 +24,11 @@
 namespace SHOT
 {
 
-TaskSelectPrimalCandidatesFromRootsearch::TaskSelectPrimalCandidatesFromRootsearch(EnvironmentPtr envPtr)
-    : TaskBase(envPtr)
+TaskSelectPrimalCandidatesFromRootsearch::TaskSelectPrimalCandidatesFromRootsearch(
+    EnvironmentPtr envPtr, bool asynchronous)
+    : TaskBase(envPtr), isAsynchronous(asynchronous)
 {
+    timerRootsearchThreads = env->timing->getTimerID("PrimalBoundStrategyRootSearchThreads");
 }
 
 TaskSelectPrimalCandidatesFromRootsearch::~TaskSelectPrimalCandidatesFromRootsearch() = default;
@@ -46,66 +48,101 @@ void TaskSelectPrimalCandidatesFromRootsearch::run(std::vector<SolutionPoint> so
     if((currIter->isMIP() && env->results->getRelativeGlobalObjectiveGap() > 1e-10)
         || env->results->usedSolutionStrategy == E_SolutionStrategy::NLP)
     {
+        // The interior points are copied, since they may be updated before the root searches are performed in the
+        // background
+        std::vector<VectorDouble> interiorPoints;
+
+        for(auto& IP : env->dualSolver->interiorPts)
+            interiorPoints.push_back(IP->point);
+
+        if(isAsynchronous)
+        {
+            env->primalSolver->addAsynchronousTask(
+                [this, solPoints = std::move(solPoints), interiorPoints = std::move(interiorPoints)]()
+                {
+                    ScopedThreadTimer timer(*env->timing, timerRootsearchThreads);
+                    auto points = findPrimalPoints(solPoints, interiorPoints);
+
+                    return (std::function<void()>(
+                        [this, points = std::move(points)]()
+                        {
+                            for(auto& P : points)
+                            {
+                                env->primalSolver->addPrimalSolutionCandidate(P, E_PrimalSolutionSource::Rootsearch,
+                                    env->results->getCurrentIteration()->iterationNumber);
+                            }
+                        }));
+                });
+
+            return;
+        }
+
         env->timing->startTimer("PrimalStrategy");
         env->timing->startTimer("PrimalBoundStrategyRootSearch");
 
-        for(auto& P : solPoints)
+        for(auto& P : findPrimalPoints(solPoints, interiorPoints))
+        {
+            env->primalSolver->addPrimalSolutionCandidate(
+                P, E_PrimalSolutionSource::Rootsearch, env->results->getCurrentIteration()->iterationNumber);
+        }
+
+        env->timing->stopTimer("PrimalStrategy");
+        env->timing->stopTimer("PrimalBoundStrategyRootSearch");
+    }
+}
+
+std::vector<VectorDouble> TaskSelectPrimalCandidatesFromRootsearch::findPrimalPoints(
+    const std::vector<SolutionPoint>& solPoints, const std::vector<VectorDouble>& interiorPoints)
+{
+    std::vector<VectorDouble> primalPoints;
+
+    for(auto& P : solPoints)
+    {
+        for(auto& IP : interiorPoints)
         {
-            for(auto& IP : env->dualSolver->interiorPts)
+            auto xNLP = IP;
+
+            assert(xNLP.size() == P.point.size());
+
+            for(auto& V : env->reformulatedProblem->binaryVariables)
             {
-                auto xNLP = IP->point;
+                xNLP.at(V->index) = P.point.at(V->index);
+            }
 
-                auto solPoint = P.point;
+            for(auto& V : env->reformulatedProblem->integerVariables)
+            {
+                xNLP.at(V->index) = P.point.at(V->index);
+            }
 
-                assert(xNLP.size() == solPoint.size());
+            for(auto& V : env->reformulatedProblem->semiintegerVariables)
+            {
+                xNLP.at(V->index) = P.point.at(V->index);
+            }
 
-                for(auto& V : env->reformulatedProblem->binaryVariables)
-                {
-                    xNLP.at(V->index) = P.point.at(V->index);
-                }
+            auto maxDevNLP2 = env->reformulatedProblem->getMaxNumericConstraintValue(
+                xNLP, env->reformulatedProblem->numericConstraints);
+            auto maxDevMIP = env->reformulatedProblem->getMaxNumericConstraintValue(
+                P.point, env->reformulatedProblem->numericConstraints);
 
-                for(auto& V : env->reformulatedProblem->integerVariables)
+            if(maxDevNLP2.normalizedValue < 0 && maxDevMIP.normalizedValue > 0)
+            {
+                try
                 {
-                    xNLP.at(V->index) = P.point.at(V->index);
-                }
+                    auto xNewc = env->rootsearchMethod->findZero(xNLP, P.point,
+                        env->settings->getSetting<int>("Rootsearch.MaxIterations", "Subsolver"),
+                        env->settings->getSetting<double>("Rootsearch.TerminationTolerance", "Subsolver"), 0,
+                        env->reformulatedProblem->nonlinearConstraints, false);
 
-                for(auto& V : env->reformulatedProblem->semiintegerVariables)
-                {
-                    xNLP.at(V->index) = P.point.at(V->index);
+                    primalPoints.push_back(xNewc.first);
                 }
-
-                auto maxDevNLP2 = env->reformulatedProblem->getMaxNumericConstraintValue(
-                    xNLP, env->reformulatedProblem->numericConstraints);
-                auto maxDevMIP = env->reformulatedProblem->getMaxNumericConstraintValue(
-                    P.point, env->reformulatedProblem->numericConstraints);
-
-                if(maxDevNLP2.normalizedValue < 0 && maxDevMIP.normalizedValue > 0)
+                catch(std::exception&)
                 {
-                    std::pair<VectorDouble, VectorDouble> xNewc;
-
-                    try
-                    {
-                        env->timing->startTimer("PrimalBoundStrategyRootSearch");
-                        xNewc = env->rootsearchMethod->findZero(xNLP, P.point,
-                            env->settings->getSetting<int>("Rootsearch.MaxIterations", "Subsolver"),
-                            env->settings->getSetting<double>("Rootsearch.TerminationTolerance", "Subsolver"), 0,
-                            env->reformulatedProblem->nonlinearConstraints, false);
-
-                        env->timing->stopTimer("PrimalBoundStrategyRootSearch");
-
-                        env->primalSolver->addPrimalSolutionCandidate(xNewc.first, E_PrimalSolutionSource::Rootsearch,
-                            env->results->getCurrentIteration()->iterationNumber);
-                    }
-                    catch(std::exception&)
-                    {
-                        env->output->outputDebug("        Cannot find solution with primal rootsearch.");
-                    }
+                    env->output->outputDebug("        Cannot find solution with primal rootsearch.");
                 }
             }
-
-            env->timing->stopTimer("PrimalStrategy");
-            env->timing->stopTimer("PrimalBoundStrategyRootSearch");
         }
     }
+
+    return (primalPoints);
 }
 } // namespace SHOT
\ No newline at end of file
@@ -12,13 +12,15 @@
 #include "TaskBase.h"
 
 #include "../Structs.h"
+#include "../Timing.h"
 
 namespace SHOT
 {
 class TaskSelectPrimalCandidatesFromRootsearch : public TaskBase
 {
 public:
-    TaskSelectPrimalCandidatesFromRootsearch(EnvironmentPtr envPtr);
+    // If asynchronous, the root searches are performed in the background while the next MIP problem is solved
+    TaskSelectPrimalCandidatesFromRootsearch(EnvironmentPtr envPtr, bool asynchronous = false);
     ~TaskSelectPrimalCandidatesFromRootsearch() override;
     void run() override;
     virtual void run(std::vector<SolutionPoint> solPoints);
@@ -26,5 +28,11 @@ public:
     std::string getType() override;
 
 private:
+    // Only evaluates the problem and does not use the primal or dual solvers, so it can be called in the background
+    std::vector<VectorDouble> findPrimalPoints(
+        const std::vector<SolutionPoint>& solPoints, const std::vector<VectorDouble>& interiorPoints);
+
+    bool isAsynchronous = false;
+    TimerID timerRootsearchThreads;
 };
 } // namespace SHOT
\ No newline at end of file
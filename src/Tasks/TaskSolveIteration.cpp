@@ -13,6 +13,7 @@
 #include "../DualSolver.h"
 #include "../Iteration.h"
 #include "../Output.h"
+#include "../PrimalSolver.h"
 #include "../Report.h"
 #include "../Results.h"
 #include "../Settings.h"
@@ -124,8 +125,15 @@ void TaskSolveIteration::run()
     }
 
     env->output->outputDebug("        Solving dual problem.");
+
+    // Primal heuristics from the previous iteration are performed while the MIP solver is running, and the primal
+    // solutions they find are used from the next iteration
+    env->primalSolver->startAsynchronousTasks();
+
     auto solStatus = env->dualSolver->MIPSolver->solveProblem();
 
+    env->primalSolver->finishAsynchronousTasks();
+
     // Must update the pointer to the current iteration if we use the lazy
     // strategy since new iterations have been created when solving
     if(static_cast<ES_TreeStrategy>(env->settings->getSetting<int>("TreeStrategy", "Dual"))
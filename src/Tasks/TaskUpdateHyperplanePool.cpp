@@ -0,0 +1,45 @@
+/**
+   The Supporting Hyperplane Optimization Toolkit (SHOT).
+
+   @author Andreas Lundell, Åbo Akademi University
+
+   @section LICENSE
+   This software is licensed under the Eclipse Public License 2.0.
+   Please see the README and LICENSE files for more information.
+*/
+
+#include "TaskUpdateHyperplanePool.h"
+
+#include "../DualSolver.h"
+#include "../Iteration.h"
+#include "../MIPSolver/IMIPSolver.h"
+#include "../Results.h"
+#include "../Timing.h"
+
+namespace SHOT
+{
+
+TaskUpdateHyperplanePool::TaskUpdateHyperplanePool(EnvironmentPtr envPtr) : TaskBase(envPtr) { }
+
+TaskUpdateHyperplanePool::~TaskUpdateHyperplanePool() = default;
+
+void TaskUpdateHyperplanePool::run()
+{
+    auto prevIter = env->results->getPreviousIteration(); // The solved iteration
+
+    if(prevIter->solutionPoints.empty())
+        return;
+
+    env->timing->startTimer("DualStrategy");
+
+    env->dualSolver->MIPSolver->updateHyperplanePool(prevIter->solutionPoints);
+
+    env->timing->stopTimer("DualStrategy");
+}
+
+std::string TaskUpdateHyperplanePool::getType()
+{
+    std::string type = typeid(this).name();
+    return (type);
+}
+} // namespace SHOT
\ No newline at end of file
@@ -0,0 +1,230 @@
+/**
+   The Supporting Hyperplane Optimization Toolkit (SHOT).
+
+   @author Andreas Lundell, Åbo Akademi University
+
+   @section LICENSE
+   This software is licensed under the Eclipse Public License 2.0.
+   Please see the README and LICENSE files for more information.
+*/
+
+#include "ThreadPool.h"
+#include "Structs.h"
+
+#include <algorithm>
+
+#include "cppad/cppad.hpp"
+
+namespace SHOT
+{
+
+static int getAvailableNumberOfThreads(int numberOfThreads)
+{
+    if(numberOfThreads <= 0)
+        numberOfThreads = std::max(1, (int)std::thread::hardware_concurrency());
+
+    // The tasks can evaluate functions with CppAD, which only supports a limited number of threads. The main thread and
+    // one other thread (the background primal heuristics) may use CppAD besides the worker threads.
+    return (std::min(numberOfThreads, CPPAD_MAX_NUM_THREADS - 1));
+}
+
+ThreadPool::ThreadPool(int numberOfThreads) : numberOfThreads(getAvailableNumberOfThreads(numberOfThreads)) { }
+
+ThreadPool::~ThreadPool() { stopWorkers(); }
+
+void ThreadPool::setNumberOfThreads(int numberOfThreads)
+{
+    this->numberOfThreads = getAvailableNumberOfThreads(numberOfThreads);
+}
+
+void ThreadPool::startWorkers(int numberOfWorkers)
+{
+    // The calling thread also takes part in the work
+    for(int i = 0; i < numberOfWorkers; i++)
+        workers.emplace_back(&ThreadPool::workerLoop, this, i, generation);
+}
+
+void ThreadPool::stopWorkers()
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        isStopping = true;
+    }
+
+    workAvailable.notify_all();
+
+    for(auto& W : workers)
+        W.join();
+
+    workers.clear();
+    isStopping = false;
+}
+
+void ThreadPool::run(size_t numberOfTasks, const std::function<void(size_t)>& task, int maxNumberOfThreads)
+{
+    if(numberOfTasks == 0)
+        return;
+
+    int poolSize = numberOfThreads;
+    int numberOfThreadsUsed = (maxNumberOfThreads > 0) ? std::min(maxNumberOfThreads, poolSize) : poolSize;
+    numberOfThreadsUsed = (int)std::min((size_t)numberOfThreadsUsed, numberOfTasks);
+
+    if(numberOfThreadsUsed <= 1 || isRunning.exchange(true))
+    {
+        for(size_t i = 0; i < numberOfTasks; i++)
+            task(i);
+
+        return;
+    }
+
+    if((int)workers.size() != poolSize - 1)
+    {
+        stopWorkers();
+        startWorkers(poolSize - 1);
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+
+        currentTask = &task;
+        currentNumberOfTasks = numberOfTasks;
+        nextTask = 0;
+        firstException = nullptr;
+        activeWorkers = numberOfThreadsUsed - 1;
+        busyWorkers = activeWorkers;
+        generation++;
+    }
+
+    workAvailable.notify_all();
+
+    performTasks();
+
+    std::exception_ptr exception;
+
+    {
+        std::unique_lock<std::mutex> lock(mutex);
+        workFinished.wait(lock, [this] { return (busyWorkers == 0); });
+
+        currentTask = nullptr;
+        exception = firstException;
+    }
+
+    isRunning = false;
+
+    if(exception)
+        std::rethrow_exception(exception);
+}
+
+void ThreadPool::workerLoop(int workerIndex, size_t lastGeneration)
+{
+    while(true)
+    {
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            workAvailable.wait(lock, [&] { return (isStopping || generation != lastGeneration); });
+
+            if(isStopping)
+                return;
+
+            lastGeneration = generation;
+
+            // Fewer threads than there are in the pool can be used
+            if(workerIndex >= activeWorkers)
+                continue;
+        }
+
+        performTasks();
+
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            busyWorkers--;
+        }
+
+        workFinished.notify_one();
+    }
+}
+
+void ThreadPool::performTasks()
+{
+    for(size_t i = nextTask++; i < currentNumberOfTasks; i = nextTask++)
+    {
+        try
+        {
+            (*currentTask)(i);
+        }
+        catch(...)
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+
+            if(!firstException)
+                firstException = std::current_exception();
+        }
+    }
+}
+
+// CppAD identifies the threads by numbers from zero (the main thread) up to the number of threads given in the setup.
+// The other threads get the first free number when they first use CppAD, and release it when they end.
+static std::mutex parallelADMutex;
+static std::thread::id parallelADMainThread;
+static std::vector<bool> isParallelADThreadNumberUsed;
+static std::atomic<int> numberOfParallelADThreads { 0 };
+
+class ParallelADThreadNumber
+{
+public:
+    ParallelADThreadNumber()
+    {
+        std::lock_guard<std::mutex> lock(parallelADMutex);
+
+        auto freeNumber
+            = std::find(isParallelADThreadNumberUsed.begin() + 1, isParallelADThreadNumberUsed.end(), false);
+
+        if(freeNumber == isParallelADThreadNumberUsed.end())
+            throw Exception("Too many threads are using CppAD at the same time.");
+
+        *freeNumber = true;
+        number = freeNumber - isParallelADThreadNumberUsed.begin();
+        numberOfParallelADThreads++;
+    }
+
+    ~ParallelADThreadNumber()
+    {
+        std::lock_guard<std::mutex> lock(parallelADMutex);
+
+        isParallelADThreadNumberUsed[number] = false;
+        numberOfParallelADThreads--;
+    }
+
+    size_t number;
+};
+
+static size_t getParallelADThreadNumber()
+{
+    if(std::this_thread::get_id() == parallelADMainThread)
+        return (0);
+
+    thread_local ParallelADThreadNumber threadNumber;
+    return (threadNumber.number);
+}
+
+// CppAD is in parallel mode as long as another thread than the main thread is using it
+static bool isParallelADInParallel() { return (getParallelADThreadNumber() != 0 || numberOfParallelADThreads > 0); }
+
+void setupParallelAD()
+{
+    static std::once_flag isSetup;
+
+    std::call_once(isSetup,
+        []()
+        {
+            parallelADMainThread = std::this_thread::get_id();
+            isParallelADThreadNumberUsed.assign(CPPAD_MAX_NUM_THREADS, false);
+            isParallelADThreadNumberUsed[0] = true;
+
+            CppAD::thread_alloc::parallel_setup(
+                CPPAD_MAX_NUM_THREADS, isParallelADInParallel, getParallelADThreadNumber);
+            CppAD::parallel_ad<double>();
+        });
+}
+
+} // namespace SHOT
\ No newline at end of file
@@ -0,0 +1,81 @@
+/**
+   The Supporting Hyperplane Optimization Toolkit (SHOT).
+
+   @author Andreas Lundell, Åbo Akademi University
+
+   @section LICENSE
+   This software is licensed under the Eclipse Public License 2.0.
+   Please see the README and LICENSE files for more information.
+*/
+
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace SHOT
+{
+
+// A fixed set of worker threads that are kept alive between calls, so that many short parallel loops (e.g. once per
+// iteration) do not have to pay for creating threads each time
+class ThreadPool
+{
+public:
+    // If numberOfThreads is zero, the number of hardware threads is used. The number of threads is at most one less
+    // than the number of threads supported by CppAD.
+    ThreadPool(int numberOfThreads = 0);
+    ~ThreadPool();
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    // The worker threads are (re)started with the new number of threads the next time tasks are run
+    void setNumberOfThreads(int numberOfThreads);
+
+    inline int getNumberOfThreads() const { return (numberOfThreads); };
+
+    // Calls task(i) for i = 0, ..., numberOfTasks - 1 in some order in the pool threads (and the calling thread) and
+    // returns when all have finished. An exception thrown by a task is rethrown here after the other tasks are done.
+    // At most maxNumberOfThreads threads are used if it is positive. The pool can be shared, and if it is already
+    // running tasks for another caller (or the call is made from a task), the tasks are run in the calling thread.
+    void run(size_t numberOfTasks, const std::function<void(size_t)>& task, int maxNumberOfThreads = 0);
+
+private:
+    void startWorkers(int numberOfWorkers);
+    void stopWorkers();
+
+    void workerLoop(int workerIndex, size_t lastGeneration);
+    void performTasks();
+
+    std::atomic<int> numberOfThreads;
+    std::atomic<bool> isRunning { false };
+
+    std::vector<std::thread> workers;
+
+    std::mutex mutex;
+    std::condition_variable workAvailable;
+    std::condition_variable workFinished;
+
+    const std::function<void(size_t)>* currentTask = nullptr;
+    size_t currentNumberOfTasks = 0;
+    std::atomic<size_t> nextTask { 0 };
+
+    size_t generation = 0;
+    int activeWorkers = 0;
+    int busyWorkers = 0;
+    bool isStopping = false;
+
+    std::exception_ptr firstException;
+};
+
+// Unless CppAD is told how to identify the threads, it uses the same memory and tapes in all of them. This must be
+// called in the main thread before functions are evaluated with CppAD in several threads at the same time, e.g., in a
+// thread pool, and does nothing if it has already been called.
+void setupParallelAD();
+
+} // namespace SHOT
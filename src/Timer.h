@@ -9,7 +9,9 @@
 */
 
 #pragma once
+#include <atomic>
 #include <chrono>
+#include <cstdint>
 #include <string>
 
 class Timer
@@ -42,15 +44,16 @@ public:
         {
             std::chrono::duration<double> dur = std::chrono::high_resolution_clock::now() - lastStart;
             double tmpTime = dur.count();
-            return (timeElapsed + tmpTime);
+            return (timeElapsed + tmpTime + threadTimeElapsed * 1e-9);
         }
-        return (timeElapsed);
+        return (timeElapsed + threadTimeElapsed * 1e-9);
     }
 
     inline void restart()
     {
         isRunning = true;
         timeElapsed = 0.0;
+        threadTimeElapsed = 0;
         lastStart = std::chrono::high_resolution_clock::now();
     }
 
@@ -76,10 +79,15 @@ public:
         lastStart = std::chrono::high_resolution_clock::now();
     }
 
+    // Adds time measured by another thread. Unlike the other methods this can be called by several threads at once.
+    inline void add(std::chrono::nanoseconds duration) { threadTimeElapsed += duration.count(); }
+
     std::string description;
     std::string name;
 
 private:
     double timeElapsed;
     bool isRunning;
+
+    std::atomic<int64_t> threadTimeElapsed { 0 };
 };
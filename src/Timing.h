@@ -12,12 +12,18 @@
 #include "Environment.h"
 #include "Timer.h"
 
-#include <algorithm>
-#include <vector>
+#include <chrono>
+#include <deque>
+#include <string>
+#include <unordered_map>
 
 namespace SHOT
 {
 
+// Identifies a timer so that it can be started and stopped without looking it up by name. A negative ID means that
+// there is no such timer, and then all operations on it do nothing.
+using TimerID = int;
+
 class Timing
 {
 public:
@@ -25,64 +31,122 @@ public:
 
     inline ~Timing() { timers.clear(); }
 
-    inline void createTimer(std::string name, std::string description) { timers.emplace_back(name, description); }
-
-    inline void startTimer(std::string name)
+    // If a timer with the name already exists, it is kept and its ID returned
+    inline TimerID createTimer(std::string name, std::string description)
     {
-        auto timer = std::find_if(timers.begin(), timers.end(), [name](Timer const& T) { return (T.name == name); });
+        auto existingTimer = timerIDs.find(name);
 
-        if(timer == timers.end())
-        {
-            // env->output->outputError("Timer with name  \"" + name + "\" not found!");
-            return;
-        }
+        if(existingTimer != timerIDs.end())
+            return (existingTimer->second);
+
+        TimerID timerID = (TimerID)timers.size();
+        timers.emplace_back(name, description);
+        timerIDs.emplace(name, timerID);
 
-        timer->start();
+        return (timerID);
     }
 
-    inline void stopTimer(std::string name)
+    inline TimerID getTimerID(const std::string& name) const
     {
-        auto timer = std::find_if(timers.begin(), timers.end(), [name](Timer const& T) { return (T.name == name); });
+        auto timer = timerIDs.find(name);
 
-        if(timer == timers.end())
+        if(timer == timerIDs.end())
         {
-            // env->output->outputError("Timer with name  \"" + name + "\" not found!");
-            return;
+            // env->output->outputError("Timer with name  \"" + name + "\" not found!");
+            return (-1);
         }
 
-        timer->stop();
+        return (timer->second);
     }
 
-    inline void restartTimer(std::string name)
+    // Returns nullptr if there is no timer with the ID
+    inline Timer* getTimer(TimerID timerID) { return ((timerID < 0) ? nullptr : &timers[timerID]); }
+
+    inline void startTimer(TimerID timerID)
     {
-        auto timer = std::find_if(timers.begin(), timers.end(), [name](Timer const& T) { return (T.name == name); });
+        if(timerID >= 0)
+            timers[timerID].start();
+    }
 
-        if(timer == timers.end())
-        {
-            // env->output->outputError("Timer with name  \"" + name + "\" not found!");
-            return;
-        }
+    inline void stopTimer(TimerID timerID)
+    {
+        if(timerID >= 0)
+            timers[timerID].stop();
+    }
 
-        timer->restart();
+    inline void restartTimer(TimerID timerID)
+    {
+        if(timerID >= 0)
+            timers[timerID].restart();
     }
 
-    inline double getElapsedTime(std::string name)
+    inline double getElapsedTime(TimerID timerID) { return ((timerID < 0) ? 0.0 : timers[timerID].elapsed()); }
+
+    // The following look up the timer by name and should not be used in frequently called code
+    inline void startTimer(const std::string& name) { startTimer(getTimerID(name)); }
+
+    inline void stopTimer(const std::string& name) { stopTimer(getTimerID(name)); }
+
+    inline void restartTimer(const std::string& name) { restartTimer(getTimerID(name)); }
+
+    inline double getElapsedTime(const std::string& name) { return (getElapsedTime(getTimerID(name))); }
+
+    // A deque, since the timers are not copyable and pointers to them must remain valid when timers are added
+    std::deque<Timer> timers;
+
+private:
+    EnvironmentPtr env;
+
+    std::unordered_map<std::string, TimerID> timerIDs;
+};
+
+// Starts a timer and stops it at the end of the scope, also if the scope is left by an exception or an early return
+class ScopedTimer
+{
+public:
+    inline ScopedTimer(Timing& timing, TimerID timerID) : timer(timing.getTimer(timerID))
+    {
+        if(timer != nullptr)
+            timer->start();
+    }
+
+    inline ~ScopedTimer()
     {
-        auto timer = std::find_if(timers.begin(), timers.end(), [name](Timer const& T) { return (T.name == name); });
+        if(timer != nullptr)
+            timer->stop();
+    }
 
-        if(timer == timers.end())
-        {
-            // env->output->outputError("Timer with name  \"" + name + "\" not found!");
-            return (0.0);
-        }
+    ScopedTimer(const ScopedTimer&) = delete;
+    ScopedTimer& operator=(const ScopedTimer&) = delete;
 
-        return (timer->elapsed());
+private:
+    Timer* timer;
+};
+
+// Measures the time of a scope in the current thread and adds it to a timer at the end of the scope. Several threads
+// can do this for the same timer at once, and the timer then gets the sum of their times. The clock is not read at all
+// if the timer does not exist.
+class ScopedThreadTimer
+{
+public:
+    inline ScopedThreadTimer(Timing& timing, TimerID timerID) : timer(timing.getTimer(timerID))
+    {
+        if(timer != nullptr)
+            start = std::chrono::high_resolution_clock::now();
     }
 
-    std::vector<Timer> timers;
+    inline ~ScopedThreadTimer()
+    {
+        if(timer != nullptr)
+            timer->add(std::chrono::high_resolution_clock::now() - start);
+    }
+
+    ScopedThreadTimer(const ScopedThreadTimer&) = delete;
+    ScopedThreadTimer& operator=(const ScopedThreadTimer&) = delete;
 
 private:
-    EnvironmentPtr env;
+    Timer* timer;
+    std::chrono::time_point<std::chrono::high_resolution_clock> start;
 };
 
 } // namespace SHOT
\ No newline at end of file
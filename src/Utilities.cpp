@@ -9,14 +9,17 @@
 */
 
 #include <chrono>
+#include <cstdint>
 #include <fstream>
 #include <iomanip>
 #include <iostream>
 #include <limits>
+#include <mutex>
 #include <random>
 #include <numeric>
 
 #include "Utilities.h"
+#include "Model/Variables.h"
 
 #include <boost/functional/hash/hash.hpp>
 
@@ -509,6 +512,7 @@ auto randomNumberBetween = [](double low, double high) {
 };
 
 VectorDouble hashComparisonVector;
+std::mutex hashComparisonVectorMutex;
 
 template double calculateHash(VectorDouble const& point);
 template double calculateHash(VectorInteger const& point);
@@ -517,6 +521,9 @@ template <typename T> double calculateHash(std::vector<T> const& point)
 {
     auto length = point.size();
 
+    // Hashes can be calculated in several threads, e.g. by the NLP solvers solving fixed NLP problems in parallel
+    std::lock_guard<std::mutex> lock(hashComparisonVectorMutex);
+
     if(hashComparisonVector.size() < length)
     {
         std::generate_n(std::back_inserter(hashComparisonVector), length - hashComparisonVector.size(),
@@ -528,6 +535,22 @@ template <typename T> double calculateHash(std::vector<T> const& point)
     return (scalarProduct);
 }
 
+size_t calculateFingerprint(const VectorInteger& values)
+{
+    uint64_t fingerprint = values.size();
+
+    // Each value is mixed into the fingerprint with the finalizer of the splitmix64 generator
+    for(auto V : values)
+    {
+        fingerprint += static_cast<uint64_t>(static_cast<uint32_t>(V)) + 0x9e3779b97f4a7c15ULL;
+        fingerprint = (fingerprint ^ (fingerprint >> 30)) * 0xbf58476d1ce4e5b9ULL;
+        fingerprint = (fingerprint ^ (fingerprint >> 27)) * 0x94d049bb133111ebULL;
+        fingerprint = fingerprint ^ (fingerprint >> 31);
+    }
+
+    return (static_cast<size_t>(fingerprint));
+}
+
 bool isAlmostEqual(double x, double y, const double epsilon) { return std::abs(x - y) <= epsilon * std::abs(x); }
 
 bool isAlmostZero(double x, const double epsilon) { return std::abs(x) < epsilon; }
@@ -549,29 +572,8 @@ bool isInteger(double value)
 
 SparseVariableVector combineSparseVariableVectors(const SparseVariableVector& first, const SparseVariableVector& second)
 {
-    SparseVariableVector result;
-
-    for(auto& G : first)
-    {
-        auto element = result.emplace(G.first, G.second);
-
-        if(!element.second)
-        {
-            // Element already exists for the variable
-            element.first->second += G.second;
-        }
-    }
-
-    for(auto& G : second)
-    {
-        auto element = result.emplace(G.first, G.second);
-
-        if(!element.second)
-        {
-            // Element already exists for the variable
-            element.first->second += G.second;
-        }
-    }
+    SparseVariableVector result = first;
+    result.add(second);
 
     return result;
 }
@@ -579,40 +581,9 @@ SparseVariableVector combineSparseVariableVectors(const SparseVariableVector& fi
 SparseVariableVector combineSparseVariableVectors(
     const SparseVariableVector& first, const SparseVariableVector& second, const SparseVariableVector& third)
 {
-    SparseVariableVector result;
-
-    for(auto& G : first)
-    {
-        auto element = result.emplace(G.first, G.second);
-
-        if(!element.second)
-        {
-            // Element already exists for the variable
-            element.first->second += G.second;
-        }
-    }
-
-    for(auto& G : second)
-    {
-        auto element = result.emplace(G.first, G.second);
-
-        if(!element.second)
-        {
-            // Element already exists for the variable
-            element.first->second += G.second;
-        }
-    }
-
-    for(auto& G : third)
-    {
-        auto element = result.emplace(G.first, G.second);
-
-        if(!element.second)
-        {
-            // Element already exists for the variable
-            element.first->second += G.second;
-        }
-    }
+    SparseVariableVector result = first;
+    result.add(second);
+    result.add(third);
 
     return result;
 }
@@ -620,29 +591,8 @@ SparseVariableVector combineSparseVariableVectors(
 SparseVariableMatrix combineSparseVariableMatrices(
     const SparseVariableMatrix& first, const SparseVariableMatrix& second)
 {
-    SparseVariableMatrix result;
-
-    for(auto& G : first)
-    {
-        auto element = result.emplace(G.first, G.second);
-
-        if(!element.second)
-        {
-            // Element already exists for the variable
-            element.first->second += G.second;
-        }
-    }
-
-    for(auto& G : second)
-    {
-        auto element = result.emplace(G.first, G.second);
-
-        if(!element.second)
-        {
-            // Element already exists for the variable
-            element.first->second += G.second;
-        }
-    }
+    SparseVariableMatrix result = first;
+    result.add(second);
 
     return result;
 }
@@ -650,40 +600,9 @@ SparseVariableMatrix combineSparseVariableMatrices(
 SparseVariableMatrix combineSparseVariableMatrices(
     const SparseVariableMatrix& first, const SparseVariableMatrix& second, const SparseVariableMatrix& third)
 {
-    SparseVariableMatrix result;
-
-    for(auto& G : first)
-    {
-        auto element = result.emplace(G.first, G.second);
-
-        if(!element.second)
-        {
-            // Element already exists for the variable
-            element.first->second += G.second;
-        }
-    }
-
-    for(auto& G : second)
-    {
-        auto element = result.emplace(G.first, G.second);
-
-        if(!element.second)
-        {
-            // Element already exists for the variable
-            element.first->second += G.second;
-        }
-    }
-
-    for(auto& G : third)
-    {
-        auto element = result.emplace(G.first, G.second);
-
-        if(!element.second)
-        {
-            // Element already exists for the variable
-            element.first->second += G.second;
-        }
-    }
+    SparseVariableMatrix result = first;
+    result.add(second);
+    result.add(third);
 
     return result;
 }
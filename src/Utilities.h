@@ -17,13 +17,14 @@
 #include <vector>
 
 #include "Structs.h"
+#include "SparseVector.h"
 
 namespace SHOT
 {
 class Variable;
 using VariablePtr = std::shared_ptr<Variable>;
-using SparseVariableVector = std::map<VariablePtr, double>;
-using SparseVariableMatrix = std::map<std::pair<VariablePtr, VariablePtr>, double>;
+using SparseVariableVector = SparseVector<VariablePtr>;
+using SparseVariableMatrix = SparseVector<std::pair<VariablePtr, VariablePtr>>;
 }
 
 namespace SHOT::Utilities
@@ -109,6 +110,10 @@ template <typename K, typename V> inline void erase_if(std::map<K, V>& mapOfElem
 
 template <typename T> double calculateHash(std::vector<T> const& point);
 
+// A 64-bit fingerprint of integer values, e.g. the values of the discrete variables in a point. Unlike calculateHash
+// it is exact, i.e. equal values always give the same fingerprint, but different values can still (rarely) collide
+size_t calculateFingerprint(const VectorInteger& values);
+
 bool isAlmostEqual(double x, double y, const double epsilon);
 
 bool isAlmostZero(double x, const double epsilon = std::numeric_limits<double>::epsilon());
@@ -8,6 +8,7 @@
    Please see the README and LICENSE files for more information.
 */
 
+#include "../src/DualSolver.h"
 #include "../src/Results.h"
 #include "../src/Solver.h"
 #include "../src/TaskHandler.h"
@@ -15,6 +16,12 @@
 
 #include "../src/Model/Problem.h"
 #include "../src/Model/ObjectiveFunction.h"
+#include "../src/Model/Constraints.h"
+#include "../src/Model/Terms.h"
+#include "../src/Model/Variables.h"
+
+#include "../src/MIPSolver/MIPSolverCbc.h"
+#include "../src/Tasks/TaskPerformBoundTightening.h"
 
 #include <iostream>
 
@@ -151,6 +158,222 @@ bool CbcTerminationCallbackTest(std::string filename)
     return (true);
 }
 
+bool CbcOBBTTest(int numberOfThreads)
+{
+    bool passed = true;
+
+    std::unique_ptr<Solver> solver = std::make_unique<Solver>();
+    auto env = solver->getEnvironment();
+
+    solver->updateSetting("MIP.Solver", "Dual", static_cast<int>(ES_MIPSolver::Cbc));
+    solver->updateSetting("BoundTightening.InitialPOA.Use", "Model", false);
+    solver->updateSetting("BoundTightening.FeasibilityBased.Use", "Model", false);
+    solver->updateSetting("BoundTightening.OptimizationBased.Use", "Model", true);
+    solver->updateSetting("BoundTightening.OptimizationBased.NumberOfThreads", "Model", numberOfThreads);
+
+    env->threadPool.setNumberOfThreads(numberOfThreads);
+
+    // min x + y s.t. x * y <= 6, x + 2 y <= 7, x - y >= 0, where x is continuous and y integer
+    auto problem = std::make_shared<SHOT::Problem>(env);
+    env->problem = problem;
+
+    auto var_x = std::make_shared<SHOT::Variable>("x", 0, SHOT::E_VariableType::Real, 0.0, 10.0);
+    auto var_y = std::make_shared<SHOT::Variable>("y", 1, SHOT::E_VariableType::Integer, 0.0, 10.0);
+    SHOT::Variables variables = { var_x, var_y };
+    problem->add(variables);
+
+    SHOT::LinearObjectiveFunctionPtr objectiveFunction
+        = std::make_shared<SHOT::LinearObjectiveFunction>(SHOT::E_ObjectiveFunctionDirection::Minimize);
+    objectiveFunction->add(std::make_shared<SHOT::LinearTerm>(1.0, var_x));
+    objectiveFunction->add(std::make_shared<SHOT::LinearTerm>(1.0, var_y));
+    problem->add(objectiveFunction);
+
+    auto linearConstraint1 = std::make_shared<SHOT::LinearConstraint>(0, "c0", SHOT_DBL_MIN, 7.0);
+    linearConstraint1->add(std::make_shared<SHOT::LinearTerm>(1.0, var_x));
+    linearConstraint1->add(std::make_shared<SHOT::LinearTerm>(2.0, var_y));
+    problem->add(linearConstraint1);
+
+    auto linearConstraint2 = std::make_shared<SHOT::LinearConstraint>(1, "c1", 0.0, SHOT_DBL_MAX);
+    linearConstraint2->add(std::make_shared<SHOT::LinearTerm>(1.0, var_x));
+    linearConstraint2->add(std::make_shared<SHOT::LinearTerm>(-1.0, var_y));
+    problem->add(linearConstraint2);
+
+    auto quadraticConstraint = std::make_shared<SHOT::QuadraticConstraint>(2, "c2", SHOT_DBL_MIN, 6.0);
+    quadraticConstraint->add(std::make_shared<SHOT::QuadraticTerm>(1.0, var_x, var_y));
+    problem->add(quadraticConstraint);
+
+    problem->finalize();
+
+    auto taskPerformBoundTightening = std::make_unique<TaskPerformBoundTightening>(env, problem);
+    taskPerformBoundTightening->run();
+
+    for(auto& V : problem->allVariables)
+        std::cout << V->name << ": [" << V->lowerBound << ", " << V->upperBound << "]\n";
+
+    // The LP bounds are x <= 7 and y <= 7/3, and the latter is rounded down since y is integer
+    if(var_x->upperBound < 7.0 || var_x->upperBound > 7.0 + 1e-5)
+    {
+        std::cout << "The upper bound of x was not tightened correctly.\n";
+        passed = false;
+    }
+
+    if(var_y->upperBound != 2.0)
+    {
+        std::cout << "The upper bound of the integer variable y was not tightened and rounded down.\n";
+        passed = false;
+    }
+
+    if(var_x->lowerBound != 0.0 || var_y->lowerBound != 0.0)
+    {
+        std::cout << "The lower bounds were changed although they cannot be tightened.\n";
+        passed = false;
+    }
+
+    if(problem->variableUpperBounds[var_y->index] != var_y->upperBound)
+    {
+        std::cout << "The bound vectors of the problem were not updated.\n";
+        passed = false;
+    }
+
+    return passed;
+}
+
+bool CbcHyperplanePoolTest()
+{
+    bool passed = true;
+
+    std::unique_ptr<Solver> solver = std::make_unique<Solver>();
+    auto env = solver->getEnvironment();
+
+    int inactiveIterations = 3;
+
+    // The hyperplanes are only removed from the problem in the multi-tree strategy, where they are not lazy
+    solver->updateSetting("TreeStrategy", "Dual", static_cast<int>(ES_TreeStrategy::MultiTree));
+    solver->updateSetting("HyperplaneCuts.Purge.Use", "Dual", true);
+    solver->updateSetting("HyperplaneCuts.Purge.InactiveIterations", "Dual", inactiveIterations);
+
+    // Otherwise the iterations need a problem to get the initial primal bound
+    env->results->currentPrimalBound = 0.0;
+    env->results->createIteration();
+
+    // The MIP problem has the variables x and y in [0, 20], and the hyperplane added is x + y <= 10
+    auto MIPSolver = std::make_shared<MIPSolverCbc>(env);
+
+    bool problemInitialized = MIPSolver->initializeProblem()
+        && MIPSolver->addVariable("x", E_VariableType::Real, 0.0, 20.0, 0.0)
+        && MIPSolver->addVariable("y", E_VariableType::Real, 0.0, 20.0, 0.0) && MIPSolver->initializeObjective()
+        && MIPSolver->finalizeObjective(true) && MIPSolver->finalizeProblem();
+
+    if(!problemInitialized)
+    {
+        std::cout << "Could not create the MIP problem.\n";
+        return (false);
+    }
+
+    MIPSolver->initializeSolverSettings();
+
+    auto constraint = std::make_shared<QuadraticConstraint>(0, "c0", SHOT_DBL_MIN, 10.0);
+
+    Hyperplane hyperplane;
+    hyperplane.sourceConstraint = constraint;
+    hyperplane.sourceConstraintIndex = constraint->index;
+    hyperplane.source = E_HyperplaneSource::MIPOptimalRootsearch;
+    hyperplane.isSourceConvex = true;
+    hyperplane.pointHash = 1234.5;
+
+    SparseIndexVector elements;
+    elements.emplace(0, 1.0);
+    elements.emplace(1, 1.0);
+
+    if(!MIPSolver->createHyperplane(hyperplane, std::make_pair(elements, -10.0)))
+    {
+        std::cout << "Could not add the hyperplane to the MIP problem.\n";
+        return (false);
+    }
+
+    env->dualSolver->addGeneratedHyperplane(hyperplane);
+
+    // The hyperplane is in the MIP problem if the maximum of x is 10, and removed if it is 20
+    auto isHyperplaneInProblem = [&]()
+    {
+        auto upperBound = MIPSolver->calculateVariableBound(0, false);
+
+        if(!upperBound)
+        {
+            std::cout << "Could not calculate the upper bound of x.\n";
+            passed = false;
+            return (false);
+        }
+
+        return (std::abs(*upperBound - 10.0) < 1e-6);
+    };
+
+    // The hyperplane is inactive in the solution (0, 0), and is removed after the given number of iterations
+    SolutionPoint inactiveSolution;
+    inactiveSolution.point = { 0.0, 0.0 };
+
+    for(int i = 0; i < inactiveIterations; i++)
+    {
+        env->results->createIteration();
+
+        if(!isHyperplaneInProblem())
+        {
+            std::cout << "The hyperplane was removed after " << i << " inactive iterations.\n";
+            passed = false;
+        }
+
+        MIPSolver->updateHyperplanePool({ inactiveSolution });
+    }
+
+    if(isHyperplaneInProblem())
+    {
+        std::cout << "The hyperplane was not removed after " << inactiveIterations << " inactive iterations.\n";
+        passed = false;
+    }
+
+    // The removed hyperplane is still registered as generated, so that the same hyperplane is not added as a new one
+    if(!env->dualSolver->hasHyperplaneBeenAdded(hyperplane.pointHash, hyperplane.sourceConstraintIndex))
+    {
+        std::cout << "The removed hyperplane is not in the index of generated hyperplanes.\n";
+        passed = false;
+    }
+
+    // The hyperplane is violated in the solution (10, 10), and is added back
+    SolutionPoint violatingSolution;
+    violatingSolution.point = { 10.0, 10.0 };
+
+    env->results->createIteration();
+    MIPSolver->updateHyperplanePool({ violatingSolution });
+
+    if(!isHyperplaneInProblem())
+    {
+        std::cout << "The violated hyperplane was not added back.\n";
+        passed = false;
+    }
+
+    // A hyperplane that has been added back is kept in the problem to avoid cycling
+    for(int i = 0; i < inactiveIterations + 1; i++)
+    {
+        env->results->createIteration();
+        MIPSolver->updateHyperplanePool({ inactiveSolution });
+    }
+
+    if(!isHyperplaneInProblem())
+    {
+        std::cout << "The hyperplane added back was removed again.\n";
+        passed = false;
+    }
+
+    if(env->dualSolver->generatedHyperplanes.size() != 1
+        || !env->dualSolver->hasHyperplaneBeenAdded(hyperplane.pointHash, hyperplane.sourceConstraintIndex))
+    {
+        std::cout << "The index of generated hyperplanes was changed by the hyperplane pool.\n";
+        passed = false;
+    }
+
+    return passed;
+}
+
 int CbcTest(int argc, char* argv[])
 {
     int defaultchoice = 1;
@@ -205,6 +428,16 @@ int CbcTest(int argc, char* argv[])
         passed = CbcTest1("data/ncvx_min_ndiv.nl", -13.0);
         std::cout << "Finished test to solve nonconvex maximization problem 'ncvx_min_ndiv.nl'." << std::endl;
         break;
+    case 8:
+        std::cout << "Starting test to tighten bounds on a bilinear problem with OBBT using Cbc:" << std::endl;
+        passed = CbcOBBTTest(1) && CbcOBBTTest(2);
+        std::cout << "Finished test to tighten bounds on a bilinear problem with OBBT using Cbc." << std::endl;
+        break;
+    case 9:
+        std::cout << "Starting test to remove and add back hyperplanes in Cbc:" << std::endl;
+        passed = CbcHyperplanePoolTest();
+        std::cout << "Finished test to remove and add back hyperplanes in Cbc." << std::endl;
+        break;
     default:
         passed = false;
         std::cout << "Test #" << choice << " does not exist!\n";
@@ -10,16 +10,21 @@
 
 #include "../src/Solver.h"
 #include "../src/Environment.h"
+#include "../src/PrimalSolver.h"
 #include "../src/Settings.h"
 
 #include "../src/Model/Variables.h"
 #include "../src/Model/Terms.h"
 #include "../src/Model/Constraints.h"
 #include "../src/Model/NonlinearExpressions.h"
+#include "../src/Model/ExpressionTape.h"
+#include "../src/Model/QuadraticMatrix.h"
 #include "../src/Model/Problem.h"
 
 #include "../src/Tasks/TaskReformulateProblem.h"
 
+#include <map>
+#include <random>
 #include <sstream>
 
 using namespace SHOT;
@@ -34,6 +39,14 @@ bool ModelTestCreateProblem2();
 bool ModelTestCreateProblem3();
 bool ModelTestConvexity();
 bool ModelTestCopy();
+bool ModelTestSparseVector();
+bool ModelTestBoundTightening();
+bool ModelTestCommonSubexpressions();
+bool ModelTestQuadraticMatrix();
+bool ModelTestIncrementalBoundTightening();
+bool ModelTestCommonSubexpressionsNegation();
+bool ModelTestMaxDeviatingConstraints();
+bool ModelTestTestedIntegerCombinations();
 
 bool TestReadProblem(const std::string& problemFile);
 bool TestRootsearch(const std::string& problemFile);
@@ -89,6 +102,30 @@ int ModelTest(int argc, char* argv[])
     case 10:
         passed = ModelTestCopy();
         break;
+    case 11:
+        passed = ModelTestSparseVector();
+        break;
+    case 12:
+        passed = ModelTestBoundTightening();
+        break;
+    case 13:
+        passed = ModelTestCommonSubexpressions();
+        break;
+    case 14:
+        passed = ModelTestQuadraticMatrix();
+        break;
+    case 15:
+        passed = ModelTestIncrementalBoundTightening();
+        break;
+    case 16:
+        passed = ModelTestCommonSubexpressionsNegation();
+        break;
+    case 17:
+        passed = ModelTestMaxDeviatingConstraints();
+        break;
+    case 18:
+        passed = ModelTestTestedIntegerCombinations();
+        break;
     default:
         passed = false;
         std::cout << "Test #" << choice << " does not exist!\n";
@@ -1187,3 +1224,728 @@ bool ModelTestCopy()
 
     return passed;
 }
+
+bool ModelTestSparseVector()
+{
+    bool passed = true;
+
+    std::mt19937 engine(1);
+    std::uniform_int_distribution<int> indexDistribution(0, 49);
+    std::uniform_real_distribution<double> valueDistribution(-10.0, 10.0);
+
+    SHOT::SparseIndexVector first, second;
+    std::map<int, double> reference;
+
+    std::cout << "Adding random elements to sparse vectors:\n";
+
+    for(int i = 0; i < 200; i++)
+    {
+        int index = indexDistribution(engine);
+        double value = valueDistribution(engine);
+
+        if(i % 2 == 0)
+            first.add(index, value);
+        else
+            second.add(index, value);
+
+        reference[index] += value;
+    }
+
+    first.add(second);
+
+    // Every fifth element is set to zero to check that these are removed
+    int counter = 0;
+
+    for(auto& E : first)
+    {
+        if(counter++ % 5 == 0)
+        {
+            E.second = 0.0;
+            reference[E.first] = 0.0;
+        }
+    }
+
+    first.erase(0.0);
+
+    for(auto it = reference.begin(); it != reference.end();)
+    {
+        if(it->second == 0.0)
+            it = reference.erase(it);
+        else
+            it++;
+    }
+
+    std::cout << "Number of elements: " << first.size() << " (should be " << reference.size() << ").\n";
+
+    if(first.size() != reference.size())
+        passed = false;
+
+    auto element = first.begin();
+
+    for(auto& R : reference)
+    {
+        if(element == first.end())
+            break;
+
+        if(element->first != R.first || std::abs(element->second - R.second) > 1e-12)
+        {
+            std::cout << "Element (" << element->first << "," << element->second << ") differs from ("
+                      << R.first << "," << R.second << ").\n";
+            passed = false;
+        }
+
+        if(first.find(R.first) != element)
+        {
+            std::cout << "Element " << R.first << " not found.\n";
+            passed = false;
+        }
+
+        element++;
+    }
+
+    std::cout << "Checking that variables are ordered on their index:\n";
+
+    SHOT::VariablePtr var_x = std::make_shared<SHOT::Variable>("x", 2, SHOT::E_VariableType::Real, 0.0, 1.0);
+    SHOT::VariablePtr var_y = std::make_shared<SHOT::Variable>("y", 0, SHOT::E_VariableType::Real, 0.0, 1.0);
+    SHOT::VariablePtr var_z = std::make_shared<SHOT::Variable>("z", 1, SHOT::E_VariableType::Real, 0.0, 1.0);
+
+    SHOT::SparseVariableVector gradient;
+    gradient.add(var_x, 1.0);
+    gradient.add(var_y, 2.0);
+    gradient.add(var_z, 3.0);
+    gradient.add(var_x, 4.0);
+
+    int previousIndex = -1;
+
+    for(auto& G : gradient)
+    {
+        std::cout << G.first->name << ": " << G.second << '\n';
+
+        if(G.first->index <= previousIndex)
+            passed = false;
+
+        previousIndex = G.first->index;
+    }
+
+    if(gradient.size() != 3 || gradient.find(var_x)->second != 5.0)
+        passed = false;
+
+    return passed;
+}
+
+bool ModelTestBoundTightening()
+{
+    bool passed = true;
+
+    std::cout << "Checking sums of intervals:\n";
+
+    SHOT::IntervalSum sum;
+    SHOT::IntervalVector intervals = { SHOT::Interval(1.0, 2.0), SHOT::Interval(-3.0, SHOT_DBL_INF),
+        SHOT::Interval(-SHOT_DBL_INF, 4.0), SHOT::Interval(0.5, 0.5) };
+
+    for(auto& I : intervals)
+        sum.add(I);
+
+    auto withoutSecond = sum.getSumWithout(intervals[1]);
+    auto withoutThird = sum.getSumWithout(intervals[2]);
+
+    std::cout << "Sum without second: " << withoutSecond << " (should be [-inf, 6.5]).\n";
+    std::cout << "Sum without third: " << withoutThird << " (should be [-1.5, inf]).\n";
+
+    if(withoutSecond.l() != -SHOT_DBL_INF || withoutSecond.u() != 6.5 || withoutThird.l() != -1.5
+        || withoutThird.u() != SHOT_DBL_INF)
+        passed = false;
+
+    auto var_x = std::make_shared<SHOT::Variable>("x", 0, SHOT::E_VariableType::Real, -10.0, 10.0);
+    auto var_y = std::make_shared<SHOT::Variable>("y", 1, SHOT::E_VariableType::Real, -10.0, 10.0);
+    auto var_z = std::make_shared<SHOT::Variable>("z", 2, SHOT::E_VariableType::Real, 0.5, 10.0);
+    SHOT::Variables variables { var_x, var_y, var_z };
+
+    auto expr_x = std::make_shared<SHOT::ExpressionVariable>(var_x);
+    auto expr_y = std::make_shared<SHOT::ExpressionVariable>(var_y);
+    auto expr_z = std::make_shared<SHOT::ExpressionVariable>(var_z);
+
+    // exp(x) + y^2 + (xz)^2 + (xz)^2, where the subexpression (xz)^2 is shared
+    auto square = std::make_shared<SHOT::ExpressionSquare>(std::make_shared<SHOT::ExpressionProduct>(expr_x, expr_z));
+    SHOT::NonlinearExpressions terms { std::make_shared<SHOT::ExpressionExp>(expr_x),
+        std::make_shared<SHOT::ExpressionSquare>(expr_y), square, square };
+    SHOT::NonlinearExpressionPtr expression = std::make_shared<SHOT::ExpressionSum>(terms);
+
+    SHOT::ExpressionTape tape(expression);
+    SHOT::Interval bound(-SHOT_DBL_INF, 4.0);
+
+    std::cout << "Tightening the bounds of the variables in " << expression << " <= 4:\n";
+
+    bool tightened = tape.tightenVariableBounds(bound, variables);
+
+    for(auto& V : variables)
+        std::cout << V->name << ": [" << V->lowerBound << ", " << V->upperBound << "]\n";
+
+    if(!tightened || var_x->upperBound > log(4.0) + 1e-10 || var_y->lowerBound < -2.0 - 1e-10
+        || var_y->upperBound > 2.0 + 1e-10 || var_x->lowerBound < -4.0 - 1e-10)
+    {
+        std::cout << "The bounds were not tightened as expected.\n";
+        passed = false;
+    }
+
+    // No feasible point in the original bounds may be cut off
+    std::mt19937 engine(1);
+    std::uniform_real_distribution<double> distribution(0.0, 1.0);
+
+    for(int i = 0; i < 100000; i++)
+    {
+        SHOT::VectorDouble point { -10.0 + 20.0 * distribution(engine), -10.0 + 20.0 * distribution(engine),
+            0.5 + 9.5 * distribution(engine) };
+
+        if(tape.calculate(point) > 4.0)
+            continue;
+
+        for(auto& V : variables)
+        {
+            if(point[V->index] < V->lowerBound - 1e-10 || point[V->index] > V->upperBound + 1e-10)
+            {
+                std::cout << "Feasible point with " << V->name << " = " << point[V->index] << " was cut off.\n";
+                passed = false;
+                break;
+            }
+        }
+    }
+
+    std::cout << "Checking that an infeasible bound is detected:\n";
+
+    SHOT::IntervalVector nodeBounds;
+    tape.calculateBounds(variables, nodeBounds);
+
+    if(tape.tightenBounds(SHOT::Interval(-SHOT_DBL_INF, -1.0), nodeBounds))
+        passed = false;
+
+    return passed;
+}
+
+bool ModelTestCommonSubexpressions()
+{
+    bool passed = true;
+
+    std::unique_ptr<Solver> solver = std::make_unique<Solver>();
+    auto env = solver->getEnvironment();
+    SHOT::ProblemPtr problem = std::make_shared<SHOT::Problem>(env);
+    env->problem = problem;
+
+    auto var_x = std::make_shared<SHOT::Variable>("x", 0, SHOT::E_VariableType::Real, -2.0, 2.0);
+    auto var_y = std::make_shared<SHOT::Variable>("y", 1, SHOT::E_VariableType::Real, -2.0, 2.0);
+    SHOT::Variables variables { var_x, var_y };
+    problem->add(variables);
+
+    SHOT::LinearObjectiveFunctionPtr objectiveFunction
+        = std::make_shared<SHOT::LinearObjectiveFunction>(SHOT::E_ObjectiveFunctionDirection::Minimize);
+    objectiveFunction->add(std::make_shared<SHOT::LinearTerm>(1.0, var_x));
+    problem->add(objectiveFunction);
+
+    // exp(xy) + (xy)^2 <= 10 and exp(xy) <= 5, where all subexpressions are created separately
+    auto createProduct = [&]()
+    {
+        return (std::make_shared<SHOT::ExpressionProduct>(
+            std::make_shared<SHOT::ExpressionVariable>(var_x), std::make_shared<SHOT::ExpressionVariable>(var_y)));
+    };
+
+    SHOT::NonlinearExpressionPtr expression1
+        = std::make_shared<SHOT::ExpressionSum>(std::make_shared<SHOT::ExpressionExp>(createProduct()),
+            std::make_shared<SHOT::ExpressionSquare>(createProduct()));
+    SHOT::NonlinearExpressionPtr expression2 = std::make_shared<SHOT::ExpressionExp>(createProduct());
+
+    auto constraint1 = std::make_shared<SHOT::NonlinearConstraint>(0, "c1", expression1, SHOT_DBL_MIN, 10.0);
+    auto constraint2 = std::make_shared<SHOT::NonlinearConstraint>(1, "c2", expression2, SHOT_DBL_MIN, 5.0);
+    problem->add(constraint1);
+    problem->add(constraint2);
+
+    problem->finalize();
+
+    std::cout << "Problem created:\n\n";
+    std::cout << problem << '\n';
+
+    // Before sharing there are 9 + 4 nodes, afterwards the nodes x, y, xy, exp(xy), (xy)^2 and the sum remain
+    std::cout << "Number of nodes: " << problem->properties.numberOfNonlinearExpressionNodes << " (should be 13).\n";
+    std::cout << "Number of shared nodes: " << problem->properties.numberOfSharedNonlinearExpressionNodes
+              << " (should be 7).\n";
+
+    if(problem->properties.numberOfNonlinearExpressionNodes != 13
+        || problem->properties.numberOfSharedNonlinearExpressionNodes != 7)
+        passed = false;
+
+    auto sum = std::dynamic_pointer_cast<SHOT::ExpressionSum>(constraint1->nonlinearExpression);
+
+    if(!sum || sum->children[0] != constraint2->nonlinearExpression)
+    {
+        std::cout << "The subexpression exp(xy) is not shared between the constraints!\n";
+        passed = false;
+    }
+
+    SHOT::VectorDouble point { 0.5, 1.5 };
+    double product = point[0] * point[1];
+
+    double value = constraint1->calculateFunctionValue(point);
+    std::cout << "\nFunction value in first constraint: " << value << '\n';
+
+    if(std::abs(value - (exp(product) + product * product)) > 1e-10)
+        passed = false;
+
+    auto gradient = constraint1->calculateGradient(point, true);
+
+    for(auto const& G : gradient)
+    {
+        std::cout << G.first->name << ":  " << G.second << '\n';
+
+        double otherValue = (G.first == var_x) ? point[1] : point[0];
+
+        if(std::abs(G.second - (exp(product) + 2.0 * product) * otherValue) > 1e-10)
+            passed = false;
+    }
+
+    return passed;
+}
+
+bool ModelTestQuadraticMatrix()
+{
+    bool passed = true;
+
+    std::mt19937 generator(1);
+    std::uniform_real_distribution<double> valueDistribution(-2.0, 2.0);
+
+    int numberOfVariables = 50;
+    SHOT::Variables variables;
+
+    for(int i = 0; i < numberOfVariables; i++)
+    {
+        variables.push_back(std::make_shared<SHOT::Variable>(
+            "x" + std::to_string(i), i, SHOT::E_VariableType::Real, -10.0, 10.0));
+    }
+
+    // Random squares and bilinear terms, where some pairs occur several times and some coefficients are zero
+    SHOT::QuadraticTerms terms;
+
+    for(int k = 0; k < 400; k++)
+    {
+        double coefficient = (k % 37 == 0) ? 0.0 : valueDistribution(generator);
+        terms.push_back(std::make_shared<SHOT::QuadraticTerm>(coefficient,
+            variables[generator() % numberOfVariables], variables[generator() % numberOfVariables]));
+    }
+
+    SHOT::VectorDouble point(numberOfVariables);
+
+    for(auto& P : point)
+        P = valueDistribution(generator);
+
+    SHOT::QuadraticMatrix matrix(terms);
+
+    // The sums are formed in the same order, so the results should be identical
+    double value = terms.calculate(point);
+    double matrixValue = matrix.calculate(point);
+
+    std::cout << "Value from terms: " << value << ", from matrix: " << matrixValue << '\n';
+
+    if(value != matrixValue)
+        passed = false;
+
+    auto gradient = terms.calculateGradient(point);
+    auto matrixGradient = matrix.calculateGradient(point);
+
+    std::cout << "Number of gradient elements from terms: " << gradient.size()
+              << ", from matrix: " << matrixGradient.size() << '\n';
+
+    if(gradient.size() != matrixGradient.size())
+    {
+        passed = false;
+    }
+    else
+    {
+        auto element = matrixGradient.begin();
+
+        for(auto const& G : gradient)
+        {
+            if(G.first != element->first || G.second != element->second)
+            {
+                std::cout << "Gradient element for " << G.first->name << " differs: " << G.second << " and "
+                          << element->second << '\n';
+                passed = false;
+            }
+
+            ++element;
+        }
+    }
+
+    // Compare with the Hessian calculated from the terms of a constraint without a compiled matrix
+    auto constraint = std::make_shared<SHOT::QuadraticConstraint>(0, "c", terms, SHOT_DBL_MIN, 0.0);
+    auto hessian = constraint->calculateHessian(point, true);
+    auto& matrixHessian = matrix.getHessian();
+
+    std::cout << "Number of Hessian elements from terms: " << hessian.size()
+              << ", from matrix: " << matrixHessian.size() << '\n';
+
+    if(hessian.size() != matrixHessian.size())
+    {
+        passed = false;
+    }
+    else
+    {
+        auto element = matrixHessian.begin();
+
+        for(auto const& H : hessian)
+        {
+            if(H.first != element->first || H.second != element->second)
+                passed = false;
+
+            ++element;
+        }
+    }
+
+    constraint->updateQuadraticMatrix();
+
+    if(!constraint->quadraticMatrix.isCompiled() || constraint->calculateFunctionValue(point) != value)
+    {
+        std::cout << "The constraint does not use the compiled matrix correctly!\n";
+        passed = false;
+    }
+
+    return passed;
+}
+
+
+bool ModelTestIncrementalBoundTightening()
+{
+    bool passed = true;
+
+    std::unique_ptr<Solver> solver = std::make_unique<Solver>();
+    auto env = solver->getEnvironment();
+    SHOT::ProblemPtr problem = std::make_shared<SHOT::Problem>(env);
+    env->problem = problem;
+
+    // x0 <= x1 <= x2 <= x3 and y + z <= 20, where y and z are not connected to the other variables
+    SHOT::Variables variables;
+
+    for(int i = 0; i < 4; i++)
+    {
+        variables.push_back(
+            std::make_shared<SHOT::Variable>("x" + std::to_string(i), i, SHOT::E_VariableType::Real, 0.0, 10.0));
+    }
+
+    auto var_y = std::make_shared<SHOT::Variable>("y", 4, SHOT::E_VariableType::Real, 0.0, 20.0);
+    auto var_z = std::make_shared<SHOT::Variable>("z", 5, SHOT::E_VariableType::Real, 0.0, 20.0);
+    variables.push_back(var_y);
+    variables.push_back(var_z);
+    problem->add(variables);
+
+    SHOT::LinearObjectiveFunctionPtr objectiveFunction
+        = std::make_shared<SHOT::LinearObjectiveFunction>(SHOT::E_ObjectiveFunctionDirection::Minimize);
+    objectiveFunction->add(std::make_shared<SHOT::LinearTerm>(-1.0, variables[0]));
+    problem->add(objectiveFunction);
+
+    for(int i = 0; i < 3; i++)
+    {
+        auto constraint = std::make_shared<SHOT::LinearConstraint>(i, "c" + std::to_string(i), SHOT_DBL_MIN, 0.0);
+        constraint->add(std::make_shared<SHOT::LinearTerm>(1.0, variables[i]));
+        constraint->add(std::make_shared<SHOT::LinearTerm>(-1.0, variables[i + 1]));
+        problem->add(constraint);
+    }
+
+    auto constraint = std::make_shared<SHOT::LinearConstraint>(3, "c3", SHOT_DBL_MIN, 20.0);
+    constraint->add(std::make_shared<SHOT::LinearTerm>(1.0, var_y));
+    constraint->add(std::make_shared<SHOT::LinearTerm>(1.0, var_z));
+    problem->add(constraint);
+
+    problem->finalize();
+
+    // The bound is tightened elsewhere, e.g. by an objective cutoff, and then propagated
+    variables[3]->upperBound = 5.0;
+
+    auto tightenedVariables = problem->doIncrementalFBBT({ 3 });
+
+    for(auto& V : variables)
+        std::cout << V->name << ": [" << V->lowerBound << ", " << V->upperBound << "]\n";
+
+    std::sort(tightenedVariables.begin(), tightenedVariables.end());
+
+    if(tightenedVariables != std::vector<int> { 0, 1, 2 })
+    {
+        std::cout << "The tightened variables are not the expected ones.\n";
+        passed = false;
+    }
+
+    for(int i = 0; i < 3; i++)
+    {
+        if(variables[i]->upperBound != 5.0 || variables[i]->lowerBound != 0.0)
+        {
+            std::cout << "The bounds of " << variables[i]->name << " were not propagated correctly.\n";
+            passed = false;
+        }
+    }
+
+    if(var_y->upperBound != 20.0 || var_z->upperBound != 20.0)
+    {
+        std::cout << "Variables not connected to the tightened one were changed.\n";
+        passed = false;
+    }
+
+    return passed;
+}
+
+bool ModelTestCommonSubexpressionsNegation()
+{
+    bool passed = true;
+
+    std::unique_ptr<Solver> solver = std::make_unique<Solver>();
+    auto env = solver->getEnvironment();
+    SHOT::ProblemPtr problem = std::make_shared<SHOT::Problem>(env);
+    env->problem = problem;
+
+    auto var_x = std::make_shared<SHOT::Variable>("x", 0, SHOT::E_VariableType::Real, -2.0, 2.0);
+    auto var_y = std::make_shared<SHOT::Variable>("y", 1, SHOT::E_VariableType::Real, -2.0, 2.0);
+    SHOT::Variables variables { var_x, var_y };
+    problem->add(variables);
+
+    SHOT::LinearObjectiveFunctionPtr objectiveFunction
+        = std::make_shared<SHOT::LinearObjectiveFunction>(SHOT::E_ObjectiveFunctionDirection::Minimize);
+    objectiveFunction->add(std::make_shared<SHOT::LinearTerm>(1.0, var_x));
+    problem->add(objectiveFunction);
+
+    // xy + 2 >= 1 and xy + 2 <= 10, where the first constraint is negated when it is standardized. The product and the
+    // constant would be shared between the constraints if the expressions were shared before this.
+    auto createExpression = [&]()
+    {
+        return (std::make_shared<SHOT::ExpressionSum>(
+            std::make_shared<SHOT::ExpressionProduct>(
+                std::make_shared<SHOT::ExpressionVariable>(var_x), std::make_shared<SHOT::ExpressionVariable>(var_y)),
+            std::make_shared<SHOT::ExpressionConstant>(2.0)));
+    };
+
+    auto constraint1 = std::make_shared<SHOT::NonlinearConstraint>(0, "c1", createExpression(), 1.0, SHOT_DBL_MAX);
+    auto constraint2 = std::make_shared<SHOT::NonlinearConstraint>(1, "c2", createExpression(), SHOT_DBL_MIN, 10.0);
+    problem->add(constraint1);
+    problem->add(constraint2);
+
+    problem->finalize();
+
+    std::cout << "Problem created:\n\n";
+    std::cout << problem << '\n';
+
+    SHOT::VectorDouble point { 0.5, 1.5 };
+    double value = point[0] * point[1] + 2.0;
+
+    double value1 = constraint1->calculateFunctionValue(point);
+    double value2 = constraint2->calculateFunctionValue(point);
+
+    std::cout << "Function value in first constraint: " << value1 << " (should be " << -value << ").\n";
+    std::cout << "Function value in second constraint: " << value2 << " (should be " << value << ").\n";
+
+    if(std::abs(value1 + value) > 1e-10 || std::abs(value2 - value) > 1e-10)
+        passed = false;
+
+    if(constraint1->valueRHS != -1.0 || constraint2->valueRHS != 10.0)
+    {
+        std::cout << "The constraints have not been standardized as expected.\n";
+        passed = false;
+    }
+
+    return passed;
+}
+
+bool ModelTestMaxDeviatingConstraints()
+{
+    bool passed = true;
+
+    std::unique_ptr<Solver> solver = std::make_unique<Solver>();
+    auto env = solver->getEnvironment();
+    SHOT::ProblemPtr problem = std::make_shared<SHOT::Problem>(env);
+    env->problem = problem;
+
+    auto var_x = std::make_shared<SHOT::Variable>("x", 0, SHOT::E_VariableType::Real, -10.0, 10.0);
+    auto var_y = std::make_shared<SHOT::Variable>("y", 1, SHOT::E_VariableType::Real, -10.0, 10.0);
+    SHOT::Variables variables { var_x, var_y };
+    problem->add(variables);
+
+    SHOT::LinearObjectiveFunctionPtr objectiveFunction
+        = std::make_shared<SHOT::LinearObjectiveFunction>(SHOT::E_ObjectiveFunctionDirection::Minimize);
+    objectiveFunction->add(std::make_shared<SHOT::LinearTerm>(1.0, var_x));
+    problem->add(objectiveFunction);
+
+    // The point (2, 1) deviates the most from the linear constraints 100 and 270, which are in different chunks when
+    // evaluated in parallel, and the first of them should be selected in both cases
+    int numberOfLinearConstraints = 300;
+
+    for(int i = 0; i < numberOfLinearConstraints; i++)
+    {
+        SHOT::LinearTerms linearTerms;
+        linearTerms.add(std::make_shared<SHOT::LinearTerm>(1.0, var_x));
+        linearTerms.add(std::make_shared<SHOT::LinearTerm>(1.0, var_y));
+
+        double deviation = (i == 100 || i == 270) ? 2.0 : 0.5;
+
+        problem->add(std::make_shared<SHOT::LinearConstraint>(
+            i, "l" + std::to_string(i), linearTerms, SHOT_DBL_MIN, 3.0 - deviation));
+    }
+
+    // x^2 + y^2 <= 4 and xy <= -3 deviate by 1 and 5
+    SHOT::QuadraticTerms quadraticTerms1;
+    quadraticTerms1.add(std::make_shared<SHOT::QuadraticTerm>(1.0, var_x, var_x));
+    quadraticTerms1.add(std::make_shared<SHOT::QuadraticTerm>(1.0, var_y, var_y));
+    problem->add(std::make_shared<SHOT::QuadraticConstraint>(300, "q1", quadraticTerms1, SHOT_DBL_MIN, 4.0));
+
+    SHOT::QuadraticTerms quadraticTerms2;
+    quadraticTerms2.add(std::make_shared<SHOT::QuadraticTerm>(1.0, var_x, var_y));
+    problem->add(std::make_shared<SHOT::QuadraticConstraint>(301, "q2", quadraticTerms2, SHOT_DBL_MIN, -3.0));
+
+    // exp(x) <= 1 deviates by e^2 - 1 and exp(y) <= 10 is fulfilled
+    problem->add(std::make_shared<SHOT::NonlinearConstraint>(302, "n1",
+        std::make_shared<SHOT::ExpressionExp>(std::make_shared<SHOT::ExpressionVariable>(var_x)), SHOT_DBL_MIN,
+        1.0));
+    problem->add(std::make_shared<SHOT::NonlinearConstraint>(303, "n2",
+        std::make_shared<SHOT::ExpressionExp>(std::make_shared<SHOT::ExpressionVariable>(var_y)), SHOT_DBL_MIN,
+        10.0));
+
+    problem->finalize();
+
+    SHOT::VectorDouble point { 2.0, 1.0 };
+
+    auto checkSolution = [&](const SHOT::PrimalSolution& solution, bool includeLinearConstraints)
+    {
+        bool correct = true;
+
+        std::cout << "Most deviating linear constraint: " << solution.maxDevatingConstraintLinear.index << " ("
+                  << solution.maxDevatingConstraintLinear.value << ")\n";
+        std::cout << "Most deviating quadratic constraint: " << solution.maxDevatingConstraintQuadratic.index << " ("
+                  << solution.maxDevatingConstraintQuadratic.value << ")\n";
+        std::cout << "Most deviating nonlinear constraint: " << solution.maxDevatingConstraintNonlinear.index << " ("
+                  << solution.maxDevatingConstraintNonlinear.value << ")\n";
+
+        if(includeLinearConstraints)
+        {
+            if(solution.maxDevatingConstraintLinear.index != 100
+                || std::abs(solution.maxDevatingConstraintLinear.value - 2.0) > 1e-10)
+                correct = false;
+        }
+        else if(solution.maxDevatingConstraintLinear.index != -1)
+        {
+            correct = false;
+        }
+
+        if(solution.maxDevatingConstraintQuadratic.index != 301
+            || std::abs(solution.maxDevatingConstraintQuadratic.value - 5.0) > 1e-10)
+            correct = false;
+
+        if(solution.maxDevatingConstraintNonlinear.index != 302
+            || std::abs(solution.maxDevatingConstraintNonlinear.value - (std::exp(2.0) - 1.0)) > 1e-10)
+            correct = false;
+
+        if(solution.maxDeviatingConstraintsCalculated != includeLinearConstraints)
+            correct = false;
+
+        if(!correct)
+            std::cout << "The most deviating constraints are not the expected ones.\n";
+
+        return (correct);
+    };
+
+    // The shared thread pool is otherwise as large as the number of hardware threads, which can be one
+    env->threadPool.setNumberOfThreads(4);
+
+    SHOT::PrimalSolver primalSolver(env);
+
+    for(int numberOfThreads : { 1, 4 })
+    {
+        env->settings->updateSetting("Tolerance.NumberOfThreads", "Primal", numberOfThreads);
+
+        for(bool includeLinearConstraints : { true, false })
+        {
+            std::cout << "\nUsing " << numberOfThreads << " threads and "
+                      << (includeLinearConstraints ? "including" : "excluding") << " the linear constraints:\n";
+
+            SHOT::PrimalSolution solution;
+            primalSolver.calculateMaxDeviatingConstraints(point, solution, includeLinearConstraints);
+
+            if(!checkSolution(solution, includeLinearConstraints))
+                passed = false;
+        }
+    }
+
+    return passed;
+}
+
+bool ModelTestTestedIntegerCombinations()
+{
+    bool passed = true;
+
+    std::unique_ptr<Solver> solver = std::make_unique<Solver>();
+    auto env = solver->getEnvironment();
+    SHOT::ProblemPtr problem = std::make_shared<SHOT::Problem>(env);
+    env->reformulatedProblem = problem;
+
+    env->settings->updateSetting("FixedInteger.OnlyUniqueIntegerCombinations", "Primal", true);
+
+    auto var_x = std::make_shared<SHOT::Variable>("x", 0, SHOT::E_VariableType::Real, 0.0, 10.0);
+    auto var_y = std::make_shared<SHOT::Variable>("y", 1, SHOT::E_VariableType::Binary, 0.0, 1.0);
+    auto var_z = std::make_shared<SHOT::Variable>("z", 2, SHOT::E_VariableType::Integer, 0.0, 10.0);
+    SHOT::Variables variables { var_x, var_y, var_z };
+    problem->add(variables);
+
+    SHOT::LinearObjectiveFunctionPtr objectiveFunction
+        = std::make_shared<SHOT::LinearObjectiveFunction>(SHOT::E_ObjectiveFunctionDirection::Minimize);
+    objectiveFunction->add(std::make_shared<SHOT::LinearTerm>(1.0, var_x));
+    problem->add(objectiveFunction);
+
+    problem->finalize();
+
+    SHOT::PrimalSolver primalSolver(env);
+
+    // The first candidate is added and its integer combination (1, 2) tested
+    primalSolver.addFixedNLPCandidate(
+        { 0.5, 1.0, 2.0 }, SHOT::E_PrimalNLPSource::FirstSolution, 0.5, 1, SHOT::PairIndexValue(-1, 0.0));
+
+    if(primalSolver.fixedPrimalNLPCandidates.size() != 1)
+    {
+        std::cout << "The first candidate was not added.\n";
+        return (false);
+    }
+
+    primalSolver.addTestedFixedNLPCandidate(
+        primalSolver.fixedPrimalNLPCandidates[0], SHOT::E_NLPSolutionStatus::Optimal, 0.5, 1);
+    primalSolver.fixedPrimalNLPCandidates.clear();
+
+    // The same integer combination in another point, where the discrete variables are rounded, is skipped
+    primalSolver.addFixedNLPCandidate({ 3.5, 0.9999999, 2.0000001 }, SHOT::E_PrimalNLPSource::FeasibleSolution, 3.5,
+        2, SHOT::PairIndexValue(-1, 0.0));
+
+    if(primalSolver.fixedPrimalNLPCandidates.size() != 0)
+    {
+        std::cout << "A candidate with an already tested integer combination was added.\n";
+        passed = false;
+    }
+
+    // A new integer combination is not skipped, also if the continuous variable is the same as before
+    primalSolver.addFixedNLPCandidate(
+        { 0.5, 1.0, 3.0 }, SHOT::E_PrimalNLPSource::FeasibleSolution, 0.5, 2, SHOT::PairIndexValue(-1, 0.0));
+
+    if(primalSolver.fixedPrimalNLPCandidates.size() != 1
+        || primalSolver.fixedPrimalNLPCandidates[0].discreteVariableValues != SHOT::VectorInteger { 1, 3 })
+    {
+        std::cout << "A candidate with a new integer combination was not added.\n";
+        passed = false;
+    }
+
+    // The outcome of the tested combination is found through its fingerprint
+    auto tested = primalSolver.testedFixedNLPCandidates.find(SHOT::VectorInteger { 1, 2 });
+
+    if(tested == primalSolver.testedFixedNLPCandidates.end() || tested->second.iterTested != 1
+        || tested->second.status != SHOT::E_NLPSolutionStatus::Optimal)
+    {
+        std::cout << "The tested integer combination was not found.\n";
+        passed = false;
+    }
+
+    if(primalSolver.testedFixedNLPCandidates.count(SHOT::VectorInteger { 1, 3 }) != 0
+        || primalSolver.testedFixedNLPCandidates.count(SHOT::VectorInteger { 2, 1 }) != 0)
+    {
+        std::cout << "An integer combination that has not been tested was found.\n";
+        passed = false;
+    }
+
+    return passed;
+}
\ No newline at end of file
@@ -22,11 +22,13 @@ namespace fs = std;
 namespace fs = std::experimental;
 #endif
 
+#include <chrono>
 #include <iostream>
 
 using namespace SHOT;
 
 bool SettingsTestOptions(bool useOSiL);
+bool SettingsTestHandles();
 
 int SettingsTest(int argc, char* argv[])
 {
@@ -57,6 +59,11 @@ int SettingsTest(int argc, char* argv[])
         passed = SettingsTestOptions(false);
         std::cout << "Finished test to read and write opt files." << std::endl;
         break;
+    case 3:
+        std::cout << "Starting test to access settings through handles:" << std::endl;
+        passed = SettingsTestHandles();
+        std::cout << "Finished test to access settings through handles." << std::endl;
+        break;
     default:
         passed = false;
         std::cout << "Test #" << choice << " does not exist!\n";
@@ -120,4 +127,78 @@ bool SettingsTestOptions(bool useOSiL)
     }
 
     return passed;
-}
\ No newline at end of file
+}
+// Test that setting handles give the same values as the lookup by name, and compare the time of the two
+bool SettingsTestHandles()
+{
+    bool passed = true;
+
+    std::unique_ptr<Solver> solver = std::make_unique<Solver>();
+    auto settings = solver->getEnvironment()->settings;
+
+    auto doubleHandle = settings->getSettingHandle<double>("HyperplaneCuts.ConstraintSelectionFactor", "Dual");
+    auto integerHandle = settings->getSettingHandle<int>("HyperplaneCuts.MaxPerIteration", "Dual");
+    auto booleanHandle = settings->getSettingHandle<bool>("ESH.Rootsearch.UseMaxFunction", "Dual");
+    auto stringHandle = settings->getSettingHandle<std::string>("Debug.Path", "Output");
+
+    if(doubleHandle.get() != settings->getSetting<double>("HyperplaneCuts.ConstraintSelectionFactor", "Dual")
+        || integerHandle.get() != settings->getSetting<int>("HyperplaneCuts.MaxPerIteration", "Dual")
+        || booleanHandle.get() != settings->getSetting<bool>("ESH.Rootsearch.UseMaxFunction", "Dual")
+        || stringHandle.get() != settings->getSetting<std::string>("Debug.Path", "Output"))
+    {
+        std::cout << "The values from the handles differ from the ones obtained by name." << std::endl;
+        passed = false;
+    }
+
+    // The handles should see updates of the settings
+    settings->updateSetting("HyperplaneCuts.MaxPerIteration", "Dual", integerHandle.get() + 1);
+    settings->updateSetting("ESH.Rootsearch.UseMaxFunction", "Dual", !booleanHandle.get());
+
+    if(integerHandle.get() != settings->getSetting<int>("HyperplaneCuts.MaxPerIteration", "Dual")
+        || booleanHandle.get() != settings->getSetting<bool>("ESH.Rootsearch.UseMaxFunction", "Dual"))
+    {
+        std::cout << "The values from the handles were not updated." << std::endl;
+        passed = false;
+    }
+
+    try
+    {
+        settings->getSettingHandle<int>("NotASetting", "Dual");
+
+        std::cout << "No exception thrown for a setting that does not exist." << std::endl;
+        passed = false;
+    }
+    catch(SettingKeyNotFoundException&)
+    {
+    }
+
+    const int numberOfLookups = 1000000;
+
+    double checksumByName = 0.0;
+    auto byNameStart = std::chrono::high_resolution_clock::now();
+
+    for(int i = 0; i < numberOfLookups; i++)
+        checksumByName += settings->getSetting<double>("HyperplaneCuts.ConstraintSelectionFactor", "Dual");
+
+    std::chrono::duration<double> byNameTime = std::chrono::high_resolution_clock::now() - byNameStart;
+
+    double checksumByHandle = 0.0;
+    auto byHandleStart = std::chrono::high_resolution_clock::now();
+
+    for(int i = 0; i < numberOfLookups; i++)
+        checksumByHandle += doubleHandle.get();
+
+    std::chrono::duration<double> byHandleTime = std::chrono::high_resolution_clock::now() - byHandleStart;
+
+    std::cout << "Read a setting " << numberOfLookups << " times:" << std::endl;
+    std::cout << "  by name:   " << 1e9 * byNameTime.count() / numberOfLookups << " ns per lookup" << std::endl;
+    std::cout << "  by handle: " << 1e9 * byHandleTime.count() / numberOfLookups << " ns per lookup" << std::endl;
+
+    if(checksumByName != checksumByHandle)
+    {
+        std::cout << "The sums of the values differ." << std::endl;
+        passed = false;
+    }
+
+    return passed;
+}
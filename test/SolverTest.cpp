@@ -10,9 +10,11 @@
 
 #include "../src/Solver.h"
 #include "../src/Environment.h"
+#include "../src/DualSolver.h"
 #include "../src/Results.h"
 #include "../src/Structs.h"
 #include "../src/TaskHandler.h"
+#include "../src/Timing.h"
 #include "../src/Utilities.h"
 #include "../src/Model/Simplifications.h"
 
@@ -26,9 +28,17 @@
 #include "../src/ModelingSystem/ModelingSystemAMPL.h"
 
 #include "../src/RootsearchMethod/RootsearchMethodBoost.h"
+#include "../src/RootsearchMethod/RootsearchMethodMultisection.h"
 
+#include "../src/Tasks/TaskAddHyperplanes.h"
 #include "../src/Tasks/TaskReformulateProblem.h"
 
+#include <chrono>
+#include <cstring>
+#include <functional>
+#include <random>
+#include <thread>
+
 using namespace SHOT;
 
 bool ReadProblem(std::string filename)
@@ -217,6 +227,889 @@ bool TestGradient(const std::string& problemFile)
     return passed;
 }
 
+// Creates a solver for the benchmarks and reads the problem, after the settings have been updated by the given function
+static std::unique_ptr<Solver> createBenchmarkSolver(
+    const std::string& problemFile, const std::function<void(Solver&)>& updateSettings = nullptr)
+{
+    std::unique_ptr<Solver> solver = std::make_unique<Solver>();
+
+    solver->updateSetting("Console.LogLevel", "Output", static_cast<int>(E_LogLevel::Error));
+
+    if(updateSettings)
+        updateSettings(*solver);
+
+    if(!solver->setProblem(problemFile))
+    {
+        std::cout << "Error while reading problem";
+        return (nullptr);
+    }
+
+    return (solver);
+}
+
+// Random points within the variable bounds limited to [-10, 10], always the same for a problem
+static std::vector<VectorDouble> createBenchmarkPoints(const ProblemPtr& problem, int numberOfPoints)
+{
+    std::mt19937 generator(1);
+    std::vector<VectorDouble> points(numberOfPoints);
+
+    for(auto& P : points)
+    {
+        for(auto& V : problem->allVariables)
+        {
+            double lowerBound = std::max(V->lowerBound, -10.0);
+            double upperBound = std::min(V->upperBound, 10.0);
+            P.push_back(std::uniform_real_distribution<double>(lowerBound, std::max(lowerBound, upperBound))(generator));
+        }
+    }
+
+    return (points);
+}
+
+// Compares a value calculated in a benchmark to the reference value with a relative tolerance, where NaN equals NaN
+static bool isBenchmarkValueEqual(double value, double referenceValue, double tolerance)
+{
+    if(std::isnan(value) || std::isnan(referenceValue))
+        return (std::isnan(value) && std::isnan(referenceValue));
+
+    return (std::abs(value - referenceValue) <= tolerance * std::max(1.0, std::abs(referenceValue)));
+}
+
+bool BenchmarkExpressionTape(const std::string& problemFile)
+{
+    bool passed = true;
+
+    std::cout << "Reading problem:  " << problemFile << '\n';
+
+    auto solver = createBenchmarkSolver(problemFile);
+
+    if(!solver)
+        return (false);
+
+    auto env = solver->getEnvironment();
+
+    int numberOfPoints = 2000;
+    auto points = createBenchmarkPoints(env->problem, numberOfPoints);
+
+    NonlinearConstraints constraints;
+
+    for(auto& C : env->problem->nonlinearConstraints)
+    {
+        if(C->properties.hasNonlinearExpression && C->nonlinearExpressionTape.isCompiled())
+            constraints.push_back(C);
+    }
+
+    int numberOfNodes = 0;
+
+    for(auto& C : constraints)
+        numberOfNodes += C->nonlinearExpressionTape.size();
+
+    double treeChecksum = 0.0;
+    auto treeStart = std::chrono::high_resolution_clock::now();
+
+    for(auto& P : points)
+    {
+        for(auto& C : constraints)
+            treeChecksum += C->nonlinearExpression->calculate(P);
+    }
+
+    std::chrono::duration<double> treeTime = std::chrono::high_resolution_clock::now() - treeStart;
+
+    double tapeChecksum = 0.0;
+    auto tapeStart = std::chrono::high_resolution_clock::now();
+
+    for(auto& P : points)
+    {
+        for(auto& C : constraints)
+            tapeChecksum += C->nonlinearExpressionTape.calculate(P);
+    }
+
+    std::chrono::duration<double> tapeTime = std::chrono::high_resolution_clock::now() - tapeStart;
+
+    for(auto& P : points)
+    {
+        for(auto& C : constraints)
+        {
+            double treeValue = C->nonlinearExpression->calculate(P);
+            double tapeValue = C->nonlinearExpressionTape.calculate(P);
+
+            if(!isBenchmarkValueEqual(tapeValue, treeValue, 1e-12))
+            {
+                std::cout << "Tape value " << tapeValue << " differs from tree value " << treeValue
+                          << " for constraint " << C->name << '\n';
+                passed = false;
+            }
+        }
+    }
+
+    std::cout << "Evaluated " << constraints.size() << " nonlinear expressions (" << numberOfNodes
+              << " tape nodes) in " << numberOfPoints << " points:\n";
+    std::cout << "  tree: " << treeTime.count() << " s (checksum " << treeChecksum << ")\n";
+    std::cout << "  tape: " << tapeTime.count() << " s (checksum " << tapeChecksum << ")\n";
+
+    return passed;
+}
+
+bool BenchmarkBatchEvaluation(const std::string& problemFile)
+{
+    bool passed = true;
+
+    std::cout << "Reading problem:  " << problemFile << '\n';
+
+    auto solver = createBenchmarkSolver(problemFile);
+
+    if(!solver)
+        return (false);
+
+    auto env = solver->getEnvironment();
+
+    // Roughly the size of a MIP solution pool
+    int numberOfPoints = 64;
+    int numberOfRounds = 100;
+
+    auto points = createBenchmarkPoints(env->problem, numberOfPoints);
+
+    auto& constraints = env->problem->numericConstraints;
+
+    double pointwiseChecksum = 0.0;
+    auto pointwiseStart = std::chrono::high_resolution_clock::now();
+
+    for(int r = 0; r < numberOfRounds; r++)
+    {
+        for(auto& P : points)
+        {
+            for(auto& C : constraints)
+                pointwiseChecksum += C->calculateFunctionValue(P);
+        }
+    }
+
+    std::chrono::duration<double> pointwiseTime = std::chrono::high_resolution_clock::now() - pointwiseStart;
+
+    double batchChecksum = 0.0;
+    auto batchStart = std::chrono::high_resolution_clock::now();
+
+    for(int r = 0; r < numberOfRounds; r++)
+    {
+        PointBatch batch(points);
+        VectorDouble values;
+
+        for(auto& C : constraints)
+        {
+            C->calculateFunctionValues(batch, values);
+
+            for(auto& V : values)
+                batchChecksum += V;
+        }
+    }
+
+    std::chrono::duration<double> batchTime = std::chrono::high_resolution_clock::now() - batchStart;
+
+    if(!isBenchmarkValueEqual(batchChecksum, pointwiseChecksum, 1e-9))
+    {
+        std::cout << "Batch checksum " << batchChecksum << " differs from pointwise checksum " << pointwiseChecksum
+                  << '\n';
+        passed = false;
+    }
+
+    // The batched values should be the same as the pointwise ones since the sums are formed in the same order
+    auto constraintValues = env->problem->getFractionOfDeviatingNonlinearConstraints(points, -SHOT_DBL_MAX, 1.0);
+
+    for(size_t p = 0; p < points.size(); p++)
+    {
+        auto pointwiseValues = env->problem->getFractionOfDeviatingNonlinearConstraints(points[p], -SHOT_DBL_MAX, 1.0);
+
+        if(pointwiseValues.size() != constraintValues[p].size())
+        {
+            std::cout << "Different number of constraint values in point " << p << '\n';
+            passed = false;
+            continue;
+        }
+
+        for(size_t i = 0; i < pointwiseValues.size(); i++)
+        {
+            double pointwiseValue = pointwiseValues[i].functionValue;
+            double batchValue = constraintValues[p][i].functionValue;
+
+            if(pointwiseValues[i].constraint != constraintValues[p][i].constraint
+                || !isBenchmarkValueEqual(batchValue, pointwiseValue, 1e-12))
+            {
+                std::cout << "Batch value " << batchValue << " differs from pointwise value " << pointwiseValue
+                          << " for constraint " << pointwiseValues[i].constraint->name << '\n';
+                passed = false;
+            }
+        }
+    }
+
+    std::cout << "Evaluated " << constraints.size() << " constraints in " << numberOfPoints << " points "
+              << numberOfRounds << " times:\n";
+    std::cout << "  pointwise: " << pointwiseTime.count() << " s (checksum " << pointwiseChecksum << ")\n";
+    std::cout << "  batch:     " << batchTime.count() << " s (checksum " << batchChecksum << ")\n";
+
+    return passed;
+}
+
+bool BenchmarkAutomaticDifferentiation(const std::string& problemFile)
+{
+    bool passed = true;
+
+    int numberOfPoints = 200;
+    std::vector<VectorDouble> points;
+
+    // Variable index and gradient value for each constraint in each point in the first mode tested
+    std::vector<std::vector<SparseVariableVector>> referenceGradients;
+
+    std::vector<std::pair<bool, bool>> modes = { { false, false }, { false, true }, { true, false }, { true, true } };
+
+    std::cout << "Reading problem:  " << problemFile << '\n';
+
+    for(auto& [perConstraintTapes, optimizeTape] : modes)
+    {
+        auto solver = createBenchmarkSolver(problemFile,
+            [perConstraintTapes = perConstraintTapes, optimizeTape = optimizeTape](Solver& S)
+            {
+                S.updateSetting("AutomaticDifferentiation.PerConstraintTapes", "Model", perConstraintTapes);
+                S.updateSetting("AutomaticDifferentiation.OptimizeTape", "Model", optimizeTape);
+            });
+
+        if(!solver)
+            return (false);
+
+        auto problem = solver->getEnvironment()->problem;
+
+        if(points.size() == 0)
+            points = createBenchmarkPoints(problem, numberOfPoints);
+
+        std::cout << (perConstraintTapes ? "Per-constraint tapes" : "Problem-wide tape")
+                  << (optimizeTape ? " (optimized):\n" : ":\n");
+
+        if(!perConstraintTapes)
+            std::cout << "  tape size: " << problem->ADFunctions.size_var() << " variables\n";
+
+        std::vector<std::vector<SparseVariableVector>> gradients;
+
+        for(auto& C : problem->nonlinearConstraints)
+        {
+            if(!C->properties.hasNonlinearExpression || C->variablesInNonlinearExpression.size() == 0)
+                continue;
+
+            gradients.emplace_back();
+
+            auto start = std::chrono::high_resolution_clock::now();
+
+            for(auto& P : points)
+                gradients.back().push_back(C->calculateGradient(P, true));
+
+            std::chrono::duration<double> time = std::chrono::high_resolution_clock::now() - start;
+
+            std::cout << "  constraint " << C->name << ": ";
+
+            if(C->ADFunction)
+                std::cout << "tape size " << C->ADFunction->size_var() << " variables, ";
+
+            std::cout << "gradient time " << 1e6 * time.count() / numberOfPoints << " us\n";
+        }
+
+        if(referenceGradients.size() == 0)
+        {
+            referenceGradients = gradients;
+            continue;
+        }
+
+        for(size_t i = 0; i < gradients.size(); i++)
+        {
+            for(size_t j = 0; j < gradients[i].size(); j++)
+            {
+                for(auto& [VAR, value] : gradients[i][j])
+                {
+                    auto reference = std::find_if(referenceGradients[i][j].begin(), referenceGradients[i][j].end(),
+                        [&](const auto& element) { return (element.first->index == VAR->index); });
+
+                    double referenceValue = (reference == referenceGradients[i][j].end()) ? 0.0 : reference->second;
+
+                    if(!isBenchmarkValueEqual(value, referenceValue, 1e-8))
+                    {
+                        std::cout << "Gradient element " << value << " for variable " << VAR->name
+                                  << " differs from the one calculated with the problem-wide tape " << referenceValue
+                                  << '\n';
+                        passed = false;
+                    }
+                }
+
+                if(gradients[i][j].size() != referenceGradients[i][j].size())
+                {
+                    std::cout << "Different number of nonzero gradient elements for constraint " << i << '\n';
+                    passed = false;
+                }
+            }
+        }
+    }
+
+    return passed;
+}
+
+bool BenchmarkRootsearch(const std::string& problemFile)
+{
+    bool passed = true;
+
+    std::cout << "Reading problem:  " << problemFile << '\n';
+
+    auto solver = createBenchmarkSolver(problemFile);
+
+    if(!solver)
+        return (false);
+
+    auto env = solver->getEnvironment();
+
+    std::vector<NumericConstraint*> constraints;
+
+    for(auto& C : env->problem->nonlinearConstraints)
+        constraints.push_back(C.get());
+
+    // Random points are divided into those that fulfill the nonlinear constraints and those that do not, and a root
+    // search is performed between pairs of these
+    std::vector<VectorDouble> feasiblePoints;
+    std::vector<VectorDouble> infeasiblePoints;
+
+    for(auto& point : createBenchmarkPoints(env->problem, 1000))
+    {
+        std::vector<NumericConstraint*> activeConstraints;
+        auto value = env->problem->getMaxNumericConstraintValue(point, constraints, activeConstraints);
+
+        if(std::isnan(value.normalizedValue))
+            continue;
+
+        if(value.normalizedValue <= 0)
+            feasiblePoints.push_back(point);
+        else
+            infeasiblePoints.push_back(point);
+    }
+
+    if(feasiblePoints.size() == 0 || infeasiblePoints.size() == 0)
+    {
+        std::cout << "No pairs of feasible and infeasible points found.\n";
+        return (passed);
+    }
+
+    int numberOfSearches = std::min(64, (int)infeasiblePoints.size());
+    int numberOfRounds = 20;
+
+    auto boostRootsearch = std::make_unique<RootsearchMethodBoost>(env);
+    auto multisectionRootsearch = std::make_unique<RootsearchMethodMultisection>(env);
+
+    std::vector<std::pair<VectorDouble, VectorDouble>> boostRoots(numberOfSearches);
+    std::vector<std::pair<VectorDouble, VectorDouble>> multisectionRoots(numberOfSearches);
+
+    auto boostStart = std::chrono::high_resolution_clock::now();
+
+    for(int r = 0; r < numberOfRounds; r++)
+    {
+        for(int i = 0; i < numberOfSearches; i++)
+        {
+            boostRoots[i] = boostRootsearch->findZero(feasiblePoints[i % feasiblePoints.size()], infeasiblePoints[i],
+                100, 1e-12, 0, constraints, false);
+        }
+    }
+
+    std::chrono::duration<double> boostTime = std::chrono::high_resolution_clock::now() - boostStart;
+
+    auto multisectionStart = std::chrono::high_resolution_clock::now();
+
+    for(int r = 0; r < numberOfRounds; r++)
+    {
+        for(int i = 0; i < numberOfSearches; i++)
+        {
+            multisectionRoots[i] = multisectionRootsearch->findZero(
+                feasiblePoints[i % feasiblePoints.size()], infeasiblePoints[i], 100, 1e-12, 0, constraints, false);
+        }
+    }
+
+    std::chrono::duration<double> multisectionTime = std::chrono::high_resolution_clock::now() - multisectionStart;
+
+    // The constraints in the test problems are convex, so both methods should find the same root
+    for(int i = 0; i < numberOfSearches; i++)
+    {
+        for(size_t j = 0; j < boostRoots[i].first.size(); j++)
+        {
+            if(!isBenchmarkValueEqual(multisectionRoots[i].first[j], boostRoots[i].first[j], 1e-6))
+            {
+                std::cout << "The roots found in search " << i << " differ for variable " << j << ": "
+                          << multisectionRoots[i].first[j] << " and " << boostRoots[i].first[j] << '\n';
+                passed = false;
+                break;
+            }
+        }
+
+        std::vector<NumericConstraint*> activeConstraints;
+        auto value
+            = env->problem->getMaxNumericConstraintValue(multisectionRoots[i].first, constraints, activeConstraints);
+
+        if(value.normalizedValue > 1e-9)
+        {
+            std::cout << "The interior point returned by search " << i << " does not fulfill the constraints\n";
+            passed = false;
+        }
+    }
+
+    std::cout << "Performed " << numberOfSearches << " root searches " << numberOfRounds << " times:\n";
+    std::cout << "  TOMS748:      " << boostTime.count() << " s\n";
+    std::cout << "  multisection: " << multisectionTime.count() << " s\n";
+
+    return passed;
+}
+
+bool BenchmarkCutIndex()
+{
+    bool passed = true;
+
+    // Synthetic hyperplanes for 100 constraints and the objective, with hashes of the same magnitude as those given by
+    // Utilities::calculateHash
+    std::mt19937 generator(1);
+    std::uniform_int_distribution<int> constraintDistribution(-1, 99);
+    std::uniform_real_distribution<double> hashDistribution(1.0, 1e4);
+
+    int numberOfHyperplanes = 100000;
+    std::vector<std::pair<int, double>> hyperplanes;
+
+    for(int i = 0; i < numberOfHyperplanes; i++)
+        hyperplanes.emplace_back(constraintDistribution(generator), hashDistribution(generator));
+
+    // Every other query is a hash of an added hyperplane with a relative perturbation inside or just outside the
+    // tolerance, and the rest are new hashes
+    std::uniform_real_distribution<double> perturbationDistribution(-2e-8, 2e-8);
+    std::vector<std::pair<int, double>> queries;
+
+    for(int i = 0; i < numberOfHyperplanes; i++)
+    {
+        if(i % 2 == 0)
+        {
+            auto& H = hyperplanes[generator() % numberOfHyperplanes];
+            queries.emplace_back(H.first, H.second * (1.0 + perturbationDistribution(generator)));
+        }
+        else
+        {
+            queries.emplace_back(constraintDistribution(generator), hashDistribution(generator));
+        }
+    }
+
+    HashedCutIndex index;
+    int numberOfFoundHashes = 0;
+
+    auto indexStart = std::chrono::high_resolution_clock::now();
+
+    for(auto& H : hyperplanes)
+        index.add(H.first, H.second);
+
+    for(auto& Q : queries)
+    {
+        if(index.contains(Q.first, Q.second))
+            numberOfFoundHashes++;
+    }
+
+    std::chrono::duration<double> indexTime = std::chrono::high_resolution_clock::now() - indexStart;
+
+    // The linear search previously used is too slow for all queries, so it is only compared on some of them
+    int numberOfComparedQueries = 1000;
+
+    auto linearStart = std::chrono::high_resolution_clock::now();
+
+    for(int i = 0; i < numberOfComparedQueries; i++)
+    {
+        bool found = false;
+
+        for(auto& H : hyperplanes)
+        {
+            if(H.first == queries[i].first && Utilities::isAlmostEqual(H.second, queries[i].second, 1e-8))
+            {
+                found = true;
+                break;
+            }
+        }
+
+        if(found != index.contains(queries[i].first, queries[i].second))
+        {
+            std::cout << "The index and the linear search differ for query " << i << '\n';
+            passed = false;
+        }
+    }
+
+    std::chrono::duration<double> linearTime = std::chrono::high_resolution_clock::now() - linearStart;
+
+    if(index.contains(hyperplanes[0].first + 100, hyperplanes[0].second))
+    {
+        std::cout << "A hash was found for the wrong constraint\n";
+        passed = false;
+    }
+
+    index.clear();
+
+    if(index.size() != 0 || index.contains(hyperplanes[0].first, hyperplanes[0].second))
+    {
+        std::cout << "The index is not empty after clearing it\n";
+        passed = false;
+    }
+
+    std::cout << "Added " << numberOfHyperplanes << " hashes and found " << numberOfFoundHashes << " of "
+              << queries.size() << " queried:\n";
+    std::cout << "  index:         " << indexTime.count() << " s\n";
+    std::cout << "  linear search: " << linearTime.count() << " s for " << numberOfComparedQueries << " queries\n";
+
+    return passed;
+}
+
+bool TestTimers()
+{
+    bool passed = true;
+
+    auto solver = std::make_unique<SHOT::Solver>();
+    auto env = solver->getEnvironment();
+
+    auto timerID = env->timing->createTimer("TestTimer", "test timer");
+
+    if(env->timing->createTimer("TestTimer", "test timer") != timerID
+        || env->timing->getTimerID("TestTimer") != timerID)
+    {
+        std::cout << "Creating a timer again or looking it up by name did not give the same ID\n";
+        passed = false;
+    }
+
+    // Operations on a timer that does not exist should do nothing
+    auto missingTimerID = env->timing->getTimerID("MissingTimer");
+
+    env->timing->startTimer(missingTimerID);
+    env->timing->stopTimer("MissingTimer");
+
+    {
+        ScopedTimer timer(*env->timing, missingTimerID);
+        ScopedThreadTimer threadTimer(*env->timing, missingTimerID);
+    }
+
+    if(missingTimerID >= 0 || env->timing->getElapsedTime(missingTimerID) != 0.0)
+    {
+        std::cout << "A timer that does not exist was found\n";
+        passed = false;
+    }
+
+    {
+        ScopedTimer timer(*env->timing, timerID);
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+
+    double elapsed = env->timing->getElapsedTime(timerID);
+
+    if(elapsed < 0.009)
+    {
+        std::cout << "The scoped timer measured " << elapsed << " s, but at least 0.01 s was expected\n";
+        passed = false;
+    }
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+
+    if(env->timing->getElapsedTime("TestTimer") != elapsed)
+    {
+        std::cout << "The scoped timer was not stopped at the end of the scope\n";
+        passed = false;
+    }
+
+    // The times measured by the threads are summed, so the timer should get about four times the elapsed time
+    int numberOfThreads = 4;
+    std::vector<std::thread> threads;
+
+    env->timing->restartTimer(timerID);
+    env->timing->stopTimer(timerID);
+
+    for(int i = 0; i < numberOfThreads; i++)
+    {
+        threads.emplace_back(
+            [&]()
+            {
+                ScopedThreadTimer timer(*env->timing, timerID);
+                std::this_thread::sleep_for(std::chrono::milliseconds(10));
+            });
+    }
+
+    for(auto& T : threads)
+        T.join();
+
+    elapsed = env->timing->getElapsedTime(timerID);
+
+    if(elapsed < 0.009 * numberOfThreads)
+    {
+        std::cout << "The threads measured " << elapsed << " s in total, but at least " << 0.01 * numberOfThreads
+                  << " s was expected\n";
+        passed = false;
+    }
+
+    int numberOfCalls = 1000000;
+
+    auto startTime = std::chrono::high_resolution_clock::now();
+
+    for(int i = 0; i < numberOfCalls; i++)
+    {
+        env->timing->startTimer("TestTimer");
+        env->timing->stopTimer("TestTimer");
+    }
+
+    std::chrono::duration<double> nameTime = std::chrono::high_resolution_clock::now() - startTime;
+    startTime = std::chrono::high_resolution_clock::now();
+
+    for(int i = 0; i < numberOfCalls; i++)
+    {
+        env->timing->startTimer(timerID);
+        env->timing->stopTimer(timerID);
+    }
+
+    std::chrono::duration<double> idTime = std::chrono::high_resolution_clock::now() - startTime;
+
+    std::cout << "Start and stop by name: " << 1e9 * nameTime.count() / numberOfCalls << " ns\n";
+    std::cout << "Start and stop by ID:   " << 1e9 * idTime.count() / numberOfCalls << " ns\n";
+
+    return passed;
+}
+
+bool TestIterationHistory()
+{
+    bool passed = true;
+
+    auto solver = std::make_unique<SHOT::Solver>();
+    auto env = solver->getEnvironment();
+
+    std::string fileName = "iterationhistory.bin";
+    env->settings->updateSetting("IterationHistory.FullIterations", "Output", 3);
+    env->settings->updateSetting("IterationHistory.File", "Output", fileName);
+
+    // Otherwise the iterations need a problem to get the initial primal bound
+    env->results->currentPrimalBound = 0.0;
+
+    int numberOfIterations = 10;
+    int numberOfVariables = 5;
+
+    for(int i = 0; i < numberOfIterations; i++)
+    {
+        env->results->createIteration();
+        auto iteration = env->results->getCurrentIteration();
+
+        // Every other iteration is infeasible, i.e., has no solution points
+        if(i % 2 == 0)
+        {
+            SolutionPoint solution;
+            solution.point = VectorDouble(numberOfVariables, i);
+            solution.hashValue = i;
+            iteration->solutionPoints.push_back(solution);
+        }
+
+        iteration->constraintDeviations = VectorDouble(numberOfVariables, 0.0);
+        iteration->hyperplanePoints.push_back(VectorDouble(numberOfVariables, i));
+    }
+
+    for(int i = 0; i < numberOfIterations; i++)
+    {
+        auto iteration = env->results->iterations[i];
+        bool shouldBeCompacted = i < numberOfIterations - 3;
+
+        if(iteration->isCompacted != shouldBeCompacted || iteration->hyperplanePoints.empty() != shouldBeCompacted)
+        {
+            std::cout << "Iteration " << i + 1 << " was not compacted as expected\n";
+            passed = false;
+        }
+
+        // The solution points are kept with their hashes
+        if(i % 2 == 0
+            && (iteration->solutionPoints.size() != 1 || iteration->solutionPoints[0].hashValue != i
+                || iteration->solutionPoints[0].point.empty() != shouldBeCompacted))
+        {
+            std::cout << "The solution point in iteration " << i + 1 << " is not the expected one\n";
+            passed = false;
+        }
+    }
+
+    if(env->results->getPreviousIteration()->hyperplanePoints.size() != 1)
+    {
+        std::cout << "The points of the previous iteration are not available\n";
+        passed = false;
+    }
+
+    if(auto iteration = env->results->getLastFeasibleIteration();
+        !iteration || iteration.value()->iterationNumber != numberOfIterations - 1)
+    {
+        std::cout << "The last feasible iteration is not the expected one\n";
+        passed = false;
+    }
+
+    env->results->saveIterationHistory();
+
+    // The header, and per iteration the scalars, the solution point, constraint deviations and hyperplane point
+    size_t iterationSize = 5 * sizeof(int32_t) + sizeof(uint8_t) + 5 * sizeof(double) + 4 * sizeof(uint32_t)
+        + 2 * numberOfVariables * sizeof(double);
+    size_t solutionPointSize = sizeof(int32_t) + sizeof(uint8_t) + 3 * sizeof(double) + sizeof(uint32_t)
+        + numberOfVariables * sizeof(double);
+    size_t expectedSize = 8 + sizeof(uint32_t) + numberOfIterations * iterationSize
+        + (numberOfIterations / 2) * solutionPointSize;
+
+    auto contents = Utilities::getFileAsString(fileName);
+
+    if(contents.size() != expectedSize || contents.substr(0, 8) != "SHOTITER")
+    {
+        std::cout << "The iteration history file has size " << contents.size() << " instead of " << expectedSize
+                  << '\n';
+        passed = false;
+    }
+
+    return passed;
+}
+
+bool TestResultFiles(const std::string& problemFile)
+{
+    bool passed = true;
+
+    auto solver = std::make_unique<SHOT::Solver>();
+    auto env = solver->getEnvironment();
+
+    if(!solver->setProblem(problemFile) || !solver->solveProblem() || solver->getPrimalSolutions().size() == 0)
+    {
+        std::cout << "Could not solve problem " << problemFile << '\n';
+        return false;
+    }
+
+    // The timing information differs between the calls, so only the solutions are compared
+    auto osrl = solver->getResultsOSrL();
+
+    if(!solver->saveResultsOSrL("streamed.osrl"))
+    {
+        std::cout << "Could not write results to OSrL file.\n";
+        return false;
+    }
+
+    auto savedOsrl = Utilities::getFileAsString("streamed.osrl");
+
+    if(osrl.find("<optimization") == std::string::npos
+        || osrl.substr(osrl.find("<optimization")) != savedOsrl.substr(savedOsrl.find("<optimization")))
+    {
+        std::cout << "The saved OSrL file differs from the results created in memory.\n";
+        passed = false;
+    }
+
+    if(!solver->saveResultsSol("streamed.sol") || Utilities::getFileAsString("streamed.sol") != solver->getResultsSol())
+    {
+        std::cout << "The saved sol file differs from the results created in memory.\n";
+        passed = false;
+    }
+
+    if(!solver->saveResultsBinary("solution.binsol"))
+    {
+        std::cout << "Could not write binary solution file.\n";
+        return false;
+    }
+
+    auto binarySolution = Utilities::getFileAsString("solution.binsol");
+    auto& primalSolution = env->results->primalSolution;
+
+    uint64_t numberOfVariables = 0;
+    double objectiveValue = 0.0;
+
+    if(binarySolution.size() == 32 + primalSolution.size() * sizeof(double))
+    {
+        std::memcpy(&numberOfVariables, binarySolution.data() + 16, sizeof(numberOfVariables));
+        std::memcpy(&objectiveValue, binarySolution.data() + 24, sizeof(objectiveValue));
+    }
+
+    if(binarySolution.compare(0, 8, std::string("SHOTSOL\0", 8)) != 0 || numberOfVariables != primalSolution.size()
+        || objectiveValue != env->results->getPrimalBound()
+        || std::memcmp(binarySolution.data() + 32, primalSolution.data(), primalSolution.size() * sizeof(double))
+            != 0)
+    {
+        std::cout << "The binary solution file does not contain the primal solution.\n";
+        passed = false;
+    }
+
+    return passed;
+}
+
+bool TestHyperplaneSelection()
+{
+    bool passed = true;
+
+    auto solver = std::make_unique<SHOT::Solver>();
+    auto env = solver->getEnvironment();
+
+    env->settings->updateSetting("HyperplaneCuts.Selection.MaxParallelism", "Dual", 0.999);
+    env->settings->updateSetting("HyperplaneCuts.Selection.MaxPerConstraint", "Dual", 1);
+
+    // The hyperplanes are given as sum_i a_i x_i + b <= 0, and are all violated in the solution point
+    auto createCandidate = [](int constraintIndex, std::vector<std::pair<int, double>> elements, double constant)
+    {
+        Hyperplane hyperplane;
+        hyperplane.sourceConstraintIndex = constraintIndex;
+        hyperplane.source = E_HyperplaneSource::MIPOptimalRootsearch;
+
+        SparseIndexVector terms;
+
+        for(auto& E : elements)
+            terms.emplace(E.first, E.second);
+
+        return (HyperplaneCandidate { hyperplane, std::make_pair(terms, constant) });
+    };
+
+    std::vector<HyperplaneCandidate> candidates;
+    candidates.push_back(createCandidate(0, { { 0, 1.0 }, { 1, 1.0 } }, -2.0));
+    candidates.push_back(createCandidate(0, { { 0, 1.0 }, { 1, 1.01 } }, -2.1)); // Almost parallel to the first
+    candidates.push_back(createCandidate(1, { { 0, 1.0 } }, -1.0));
+    candidates.push_back(createCandidate(1, { { 1, 1.0 } }, -1.0)); // Exceeds the limit for constraint 1
+    candidates.push_back(createCandidate(2, { { 0, 1.0 }, { 1, -1.0 } }, 1.0));
+
+    // The interior objective hyperplanes have no terms and are always kept
+    Hyperplane interiorHyperplane;
+    interiorHyperplane.sourceConstraintIndex = -1;
+    interiorHyperplane.source = E_HyperplaneSource::PrimalSolutionSearchInteriorObjective;
+    candidates.push_back(HyperplaneCandidate { interiorHyperplane, std::nullopt });
+
+    SolutionPoint solution;
+    solution.point = { 2.0, 2.0 };
+
+    auto task = std::make_unique<TaskAddHyperplanes>(env);
+    auto selected = task->selectHyperplanes(candidates, { solution }, 2);
+
+    // The selected hyperplanes are identified by their constraint and the coefficient of the second variable
+    std::vector<std::pair<int, double>> selectedHyperplanes;
+
+    for(auto& H : selected)
+    {
+        double coefficient = 0.0;
+
+        if(H.terms)
+        {
+            if(auto E = H.terms->first.find(1); E != H.terms->first.end())
+                coefficient = E->second;
+        }
+
+        std::cout << "Selected hyperplane for constraint " << H.hyperplane.sourceConstraintIndex
+                  << " with coefficient " << coefficient << " for the second variable\n";
+
+        selectedHyperplanes.emplace_back(H.hyperplane.sourceConstraintIndex, coefficient);
+    }
+
+    // The most efficient hyperplane is selected first, the orthogonal one for constraint 2 is preferred to those for
+    // constraint 1, and of the latter only the first one is kept due to the limit per constraint
+    std::vector<std::pair<int, double>> expectedHyperplanes = { { -1, 0.0 }, { 0, 1.0 }, { 2, -1.0 }, { 1, 0.0 } };
+
+    if(selectedHyperplanes != expectedHyperplanes)
+    {
+        std::cout << "The selected hyperplanes are not the expected ones.\n";
+        passed = false;
+    }
+
+    // The terms are kept for the selected hyperplanes, so they do not need to be calculated again for the cuts
+    for(auto& H : selected)
+    {
+        if(H.hyperplane.sourceConstraintIndex >= 0 && (!H.terms || H.terms->first.empty()))
+        {
+            std::cout << "The terms of a selected hyperplane were not kept.\n";
+            passed = false;
+        }
+    }
+
+    return passed;
+}
+
 bool CreateAndSolveProblem()
 {
     bool passed = true;
@@ -463,6 +1356,61 @@ int SolverTest(int argc, char* argv[])
         passed = ReadProblem("data/meanvarxsc.osil");
         std::cout << "Finished test to read OSiL file with semicont. variables." << std::endl;
         break;
+    case 7:
+        std::cout << "Starting benchmark of compiled expression tapes:" << std::endl;
+        passed = BenchmarkExpressionTape("data/synthes1.osil");
+        passed = BenchmarkExpressionTape("data/tls2.osil") && passed;
+        passed = BenchmarkExpressionTape("data/fo7.osil") && passed;
+        passed = BenchmarkExpressionTape("data/ncvx_min_div.nl") && passed;
+        std::cout << "Finished benchmark of compiled expression tapes." << std::endl;
+        break;
+    case 8:
+        std::cout << "Starting benchmark of batched constraint evaluation:" << std::endl;
+        passed = BenchmarkBatchEvaluation("data/synthes1.osil");
+        passed = BenchmarkBatchEvaluation("data/tls2.osil") && passed;
+        passed = BenchmarkBatchEvaluation("data/ex4.osil") && passed;
+        passed = BenchmarkBatchEvaluation("data/ncvx_min_div.nl") && passed;
+        std::cout << "Finished benchmark of batched constraint evaluation." << std::endl;
+        break;
+    case 9:
+        std::cout << "Starting benchmark of automatic differentiation tapes:" << std::endl;
+        passed = BenchmarkAutomaticDifferentiation("data/synthes1.osil");
+        passed = BenchmarkAutomaticDifferentiation("data/tls2.osil") && passed;
+        passed = BenchmarkAutomaticDifferentiation("data/fo7.osil") && passed;
+        passed = BenchmarkAutomaticDifferentiation("data/ncvx_min_div.nl") && passed;
+        std::cout << "Finished benchmark of automatic differentiation tapes." << std::endl;
+        break;
+    case 10:
+        std::cout << "Starting test of timers:" << std::endl;
+        passed = TestTimers();
+        std::cout << "Finished test of timers." << std::endl;
+        break;
+    case 11:
+        std::cout << "Starting benchmark of root search methods:" << std::endl;
+        passed = BenchmarkRootsearch("data/synthes1.osil");
+        passed = BenchmarkRootsearch("data/tls2.osil") && passed;
+        std::cout << "Finished benchmark of root search methods." << std::endl;
+        break;
+    case 12:
+        std::cout << "Starting benchmark of the index of added cuts:" << std::endl;
+        passed = BenchmarkCutIndex();
+        std::cout << "Finished benchmark of the index of added cuts." << std::endl;
+        break;
+    case 13:
+        std::cout << "Starting test of the iteration history:" << std::endl;
+        passed = TestIterationHistory();
+        std::cout << "Finished test of the iteration history." << std::endl;
+        break;
+    case 14:
+        std::cout << "Starting test of saving the results to file:" << std::endl;
+        passed = TestResultFiles("data/tls2.osil");
+        std::cout << "Finished test of saving the results to file." << std::endl;
+        break;
+    case 15:
+        std::cout << "Starting test of the hyperplane selection:" << std::endl;
+        passed = TestHyperplaneSelection();
+        std::cout << "Finished test of the hyperplane selection." << std::endl;
+        break;
     default:
         passed = false;
         std::cout << "Test #" << choice << " does not exist!\n";